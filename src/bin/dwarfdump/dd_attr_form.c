@@ -26,8 +26,9 @@
 
 #include <config.h>
 
-#include <stdio.h>  /* printf() */
+#include <stdio.h>  /* FILE printf() */
 #include <stdlib.h> /* calloc() free() malloc() */
+#include <string.h> /* memset() */
 
 /* Windows specific header files */
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
@@ -41,6 +42,7 @@
 #include "dd_tsearchbal.h"
 #include "dd_naming.h"
 #include "dd_attr_form.h"
+#include "dd_parallel.h"
 #include "dwarfdump-af-table.h"
 
 #if 0
@@ -347,6 +349,97 @@ record_attr_form_use(
     return;
 }
 
+/*  For --jobs workers (see dd_parallel.c).  The tree
+    keeps its preset entries, a worker only zeroes
+    the counts, then saves the entries it counted. */
+static FILE *job_file;
+static int   job_res;
+static void
+zero_3key_entry(const void * vptr,
+    DW_VISIT x,
+    int level)
+{
+    (void)level;
+    if (x == dwarf_preorder || x == dwarf_leaf) {
+        Three_Key_Entry *m = *(Three_Key_Entry **)vptr;
+        m->count = 0;
+    }
+}
+
+static void
+save_3key_entry(const void * vptr,
+    DW_VISIT x,
+    int level)
+{
+    (void)level;
+    if (x == dwarf_preorder || x == dwarf_leaf) {
+        Three_Key_Entry *m = *(Three_Key_Entry **)vptr;
+        if (!m->count || job_res != DW_DLV_OK) {
+            return;
+        }
+        job_res = dd_job_write(job_file,m,sizeof(*m));
+    }
+}
+
+void
+attr_form_job_reset(void)
+{
+    dwarf_twalk(threekey_attr_form_base,zero_3key_entry);
+}
+
+int
+attr_form_job_save(FILE *f)
+{
+    Three_Key_Entry end;
+
+    job_file = f;
+    job_res = DW_DLV_OK;
+    dwarf_twalk(threekey_attr_form_base,save_3key_entry);
+    job_file = 0;
+    if (job_res != DW_DLV_OK) {
+        return job_res;
+    }
+    /*  A zero count marks the end. */
+    memset(&end,0,sizeof(end));
+    return dd_job_write(f,&end,sizeof(end));
+}
+
+int
+attr_form_job_merge(FILE *f)
+{
+    for (;;) {
+        Three_Key_Entry in;
+        Three_Key_Entry *e = 0;
+        Three_Key_Entry *re = 0;
+        void *ret = 0;
+        int res = 0;
+
+        res = dd_job_read(f,&in,sizeof(in));
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!in.count) {
+            return DW_DLV_OK;
+        }
+        res = make_3key(in.key1,in.key2,in.key3,in.std_or_exten,
+            in.from_tables,in.count,&e);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        ret = dwarf_tsearch(e,&threekey_attr_form_base,
+            std_compare_3key_entry);
+        if (!ret) {
+            free_func_3key_entry(e);
+            return DW_DLV_ERROR;
+        }
+        re = *(Three_Key_Entry **)ret;
+        if (re != e) {
+            re->count += in.count;
+            free_func_3key_entry(e);
+        }
+    }
+}
+
 static Dwarf_Unsigned recordcount = 0;
 static Dwarf_Unsigned recordmax = 0;
 static Three_Key_Entry * tkarray = 0;
@@ -26,6 +26,9 @@
 
 #ifndef ATTR_FORM_H
 #define ATTR_FORM_H
+
+#include <stdio.h> /* FILE */
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -71,6 +74,11 @@ void record_attr_form_use(Dwarf_Debug dbg,
 extern void * threekey_attr_form_base; /* for attr-form combos */
 void print_attr_form_usage(int poe);
 
+/*  For --jobs worker processes, see dd_parallel.c */
+void attr_form_job_reset(void);
+int  attr_form_job_save(FILE *f);
+int  attr_form_job_merge(FILE *f);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
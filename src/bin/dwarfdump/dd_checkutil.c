@@ -104,6 +104,226 @@ kindstring(int kind)
     return name;
 }
 
+/*  The interval index. Addresses are looked up with
+    a binary search over the sorted, merged
+    pIntervals array instead of a linear
+    search of every Bucket_Data. */
+
+/*  Intervals a and b (a.low <= b.low) overlap or
+    abut, so can be merged. */
+static Dwarf_Bool
+IntervalsTouch(Dwarf_Addr a_high,Dwarf_Addr b_low)
+{
+    /*  b_low > a_high >= 0 when the subtraction is done. */
+    return b_low <= a_high || (b_low - 1) == a_high;
+}
+
+/*  Returns the number of intervals whose low is <= addr,
+    so the interval that might contain addr is the one
+    before the returned index. */
+static unsigned long
+IntervalUpperBound(Bucket_Group *pBucketGroup,Dwarf_Addr addr)
+{
+    unsigned long lo = 0;
+    unsigned long hi = pBucketGroup->nIntervals;
+    Bucket_Interval *iv = pBucketGroup->pIntervals;
+
+    while (lo < hi) {
+        unsigned long mid = lo + (hi - lo) / 2;
+
+        if (iv[mid].low <= addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static Dwarf_Bool
+GrowIntervals(Bucket_Group *pBucketGroup,unsigned long needed)
+{
+    unsigned long newcount = 0;
+    Bucket_Interval *newiv = 0;
+
+    if (needed <= pBucketGroup->nIntervalsAlloc) {
+        return TRUE;
+    }
+    newcount = pBucketGroup->nIntervalsAlloc?
+        pBucketGroup->nIntervalsAlloc*2 : 64;
+    while (newcount < needed) {
+        newcount *= 2;
+    }
+    newiv = (Bucket_Interval *)realloc(pBucketGroup->pIntervals,
+        newcount*sizeof(Bucket_Interval));
+    if (!newiv) {
+        return FALSE;
+    }
+    pBucketGroup->pIntervals = newiv;
+    pBucketGroup->nIntervalsAlloc = newcount;
+    return TRUE;
+}
+
+/*  Add [low,high] to a valid interval index,
+    merging it with any intervals it overlaps or abuts. */
+static void
+InsertInterval(Bucket_Group *pBucketGroup,
+    Dwarf_Addr low,Dwarf_Addr high)
+{
+    Bucket_Interval *iv = 0;
+    unsigned long n = pBucketGroup->nIntervals;
+    unsigned long pos = 0;
+    unsigned long start = 0;
+    unsigned long end = 0;
+
+    if (low > high) {
+        /* Matches no address. */
+        return;
+    }
+    pos = IntervalUpperBound(pBucketGroup,low);
+    iv = pBucketGroup->pIntervals;
+    start = pos;
+    if (pos > 0 && IntervalsTouch(iv[pos-1].high,low)) {
+        start = pos - 1;
+        low = iv[start].low;
+    }
+    for (end = pos; end < n && IntervalsTouch(high,iv[end].low);
+        ++end) {
+        if (iv[end].high > high) {
+            high = iv[end].high;
+        }
+    }
+    if (start < pos && iv[start].high > high) {
+        high = iv[start].high;
+    }
+    if (start == end) {
+        /* Nothing to merge with, open a slot. */
+        if (!GrowIntervals(pBucketGroup,n+1)) {
+            pBucketGroup->bIntervalsValid = FALSE;
+            return;
+        }
+        iv = pBucketGroup->pIntervals;
+        memmove(&iv[start+1],&iv[start],
+            (n - start)*sizeof(Bucket_Interval));
+        ++pBucketGroup->nIntervals;
+    } else if (end - start > 1) {
+        /* Several intervals become one. */
+        memmove(&iv[start+1],&iv[end],
+            (n - end)*sizeof(Bucket_Interval));
+        pBucketGroup->nIntervals -= end - start - 1;
+    }
+    iv[start].low = low;
+    iv[start].high = high;
+}
+
+static int
+IntervalCompare(const void *l,const void *r)
+{
+    const Bucket_Interval *li = (const Bucket_Interval *)l;
+    const Bucket_Interval *ri = (const Bucket_Interval *)r;
+
+    if (li->low < ri->low) {
+        return -1;
+    }
+    if (li->low > ri->low) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  (Re)build the interval index from all the entries.
+    Returns FALSE if out of memory, in which case callers
+    fall back to a linear search. */
+static Dwarf_Bool
+BuildIntervals(Bucket_Group *pBucketGroup)
+{
+    unsigned long count = 0;
+    unsigned long in = 0;
+    unsigned long out = 0;
+    int nIndex = 0;
+    Bucket *pBucket = 0;
+    Bucket_Interval *iv = 0;
+
+    if (pBucketGroup->bIntervalsValid) {
+        return TRUE;
+    }
+    for (pBucket = pBucketGroup->pHead; pBucket && pBucket->nEntries;
+        pBucket = pBucket->pNext) {
+        count += pBucket->nEntries;
+    }
+    if (!GrowIntervals(pBucketGroup,count)) {
+        return FALSE;
+    }
+    iv = pBucketGroup->pIntervals;
+    for (pBucket = pBucketGroup->pHead; pBucket && pBucket->nEntries;
+        pBucket = pBucket->pNext) {
+        for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
+            Bucket_Data *pBucketData = &pBucket->Entries[nIndex];
+
+            if (pBucketData->low <= pBucketData->high) {
+                iv[out].low = pBucketData->low;
+                iv[out].high = pBucketData->high;
+                ++out;
+            }
+        }
+    }
+    count = out;
+    if (count > 1) {
+        qsort(iv,count,sizeof(Bucket_Interval),IntervalCompare);
+    }
+    for (in = 0, out = 0; in < count; ++in) {
+        if (out && IntervalsTouch(iv[out-1].high,iv[in].low)) {
+            if (iv[in].high > iv[out-1].high) {
+                iv[out-1].high = iv[in].high;
+            }
+        } else {
+            iv[out++] = iv[in];
+        }
+    }
+    pBucketGroup->nIntervals = out;
+    pBucketGroup->bIntervalsValid = TRUE;
+    return TRUE;
+}
+
+/*  Linear search of the entries, for when the interval
+    index cannot be built. */
+static Dwarf_Bool
+FindAddressLinear(Bucket_Group *pBucketGroup,Dwarf_Addr address)
+{
+    int nIndex = 0;
+    Bucket *pBucket = 0;
+    Bucket_Data *pBucketData = 0;
+
+    for (pBucket = pBucketGroup->pHead; pBucket && pBucket->nEntries;
+        pBucket = pBucket->pNext) {
+
+        for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
+            pBucketData = &pBucket->Entries[nIndex];
+            if (address >= pBucketData->low &&
+                address <= pBucketData->high) {
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/*  Checks if 'address' is inside some bucket entry. */
+static Dwarf_Bool
+FindAddress(Bucket_Group *pBucketGroup,Dwarf_Addr address)
+{
+    unsigned long pos = 0;
+
+    if (!BuildIntervals(pBucketGroup)) {
+        return FindAddressLinear(pBucketGroup,address);
+    }
+    pos = IntervalUpperBound(pBucketGroup,address);
+    if (pos && address <= pBucketGroup->pIntervals[pos-1].high) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
 Bucket_Group *
 AllocateBucketGroup(int kind)
 {
@@ -134,6 +354,8 @@ ReleaseBucketGroup(Bucket_Group *pBucketGroup)
     }
     pBucketGroup->pHead = NULL;
     pBucketGroup->pTail = NULL;
+    free(pBucketGroup->pIntervals);
+    pBucketGroup->pIntervals = NULL;
     free(pBucketGroup);
 }
 
@@ -151,6 +373,9 @@ ResetBucketGroup(Bucket_Group *pBucketGroup)
         pBucket = pBucket->pNext) {
         pBucket->nEntries = 0;
     }
+    /*  Empty, so the (now empty) index is valid. */
+    pBucketGroup->nIntervals = 0;
+    pBucketGroup->bIntervalsValid = TRUE;
     ResetSentinelBucketGroup(pBucketGroup);
 }
 
@@ -262,6 +487,9 @@ AddEntryIntoBucketGroup(Bucket_Group *pBucketGroup,
         pBucketGroup->pTail = pBucket;
         pBucket->nEntries = 1;
         pBucket->Entries[0] = data;
+        if (pBucketGroup->bIntervalsValid) {
+            InsertInterval(pBucketGroup,low,high);
+        }
         return;
     }
     pBucket = pBucketGroup->pTail;
@@ -297,6 +525,9 @@ AddEntryIntoBucketGroup(Bucket_Group *pBucketGroup,
             }
         }
     }
+    if (pBucketGroup->bIntervalsValid) {
+        InsertInterval(pBucketGroup,low,high);
+    }
 }
 
 /*  For Groups where entries are individually deleted, this does
@@ -333,6 +564,9 @@ DeleteKeyInBucketGroup(Bucket_Group *pBucketGroup,Dwarf_Addr key)
                 }
                 pBucket->Entries[nIndex] = data;
                 --pBucket->nEntries;
+                /*  Merged intervals cannot be split again,
+                    rebuild on the next lookup. */
+                pBucketGroup->bIntervalsValid = FALSE;
                 return TRUE;
             }
         }
@@ -349,29 +583,13 @@ Dwarf_Bool
 FindAddressInBucketGroup(Bucket_Group *pBucketGroup,
     Dwarf_Addr address)
 {
-    int nIndex = 0;
-    Bucket *pBucket = 0;
-    Bucket_Data *pBucketData = 0;
-
     if (!pBucketGroup) {
         printf("ERROR FindAdressinBucketGroup passed NULL. "
             "Ignored\n");
         glflags.gf_count_major_errors++;
         return FALSE;
     }
-    /* For now do a linear search */
-    for (pBucket = pBucketGroup->pHead; pBucket && pBucket->nEntries;
-        pBucket = pBucket->pNext) {
-
-        for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
-            pBucketData = &pBucket->Entries[nIndex];
-            if (address >= pBucketData->low &&
-                address <= pBucketData->high) {
-                return TRUE;
-            }
-        }
-    }
-    return FALSE;
+    return FindAddress(pBucketGroup,address);
 }
 
 /*  Search an entry (Bucket Data) in the Bucket Set */
@@ -488,10 +706,6 @@ FindNameInBucketGroup(Bucket_Group *pBucketGroup,char *name)
 Dwarf_Bool
 IsValidInBucketGroup(Bucket_Group *pBucketGroup,Dwarf_Addr address)
 {
-    Bucket *pBucket = 0;
-    Bucket_Data *pBucketData = 0;
-    int nIndex = 0;
-
     if (!pBucketGroup) {
         printf("ERROR IsValidInBucketGroup passed NULL. Ignored\n");
         glflags.gf_count_major_errors++;
@@ -500,18 +714,7 @@ IsValidInBucketGroup(Bucket_Group *pBucketGroup,Dwarf_Addr address)
     /* Check the address is within the allowed limits */
     if (address >= pBucketGroup->lower &&
         address <= pBucketGroup->upper) {
-        pBucket = pBucketGroup->pHead;
-        for ( ;
-            pBucket && pBucket->nEntries;
-            pBucket = pBucket->pNext) {
-            for (nIndex = 0; nIndex < pBucket->nEntries; ++nIndex) {
-                pBucketData = &pBucket->Entries[nIndex];
-                if (address >= pBucketData->low &&
-                    address <= pBucketData->high) {
-                    return TRUE;
-                }
-            }
-        }
+        return FindAddress(pBucketGroup,address);
     }
     return FALSE;
 }
@@ -65,6 +65,13 @@ typedef struct bucket {
     struct bucket *pNext;
 }   Bucket;
 
+/*  A [low,high] address interval (both ends included,
+    as in the address checks on Bucket_Data). */
+typedef struct {
+    Dwarf_Addr low;
+    Dwarf_Addr high;
+} Bucket_Interval;
+
 /* This Forms the head record of a list of Buckets.
 */
 typedef struct {
@@ -76,6 +83,17 @@ typedef struct {
     Bucket_Data *pLast;   /* Last sentinel */
     Bucket *pHead;        /* First bucket in set */
     Bucket *pTail;        /* Last bucket in set */
+
+    /*  The low/high ranges of all the entries, sorted
+        by low and merged so none overlap, so address
+        lookups are a binary search.  Built by the first
+        address lookup and kept up to date by later
+        additions. bIntervalsValid FALSE means it must
+        be rebuilt before use. */
+    Dwarf_Bool bIntervalsValid;
+    unsigned long nIntervals;
+    unsigned long nIntervalsAlloc;
+    Bucket_Interval *pIntervals;
 } Bucket_Group;
 
 Bucket_Group *AllocateBucketGroup(int kind);
@@ -130,6 +130,40 @@ do_all(void)
     glflags.gf_debug_sup_flag = TRUE;
 }
 
+/*  --format-json has records only for .debug_info,
+    .debug_types and .debug_line, so no other section
+    is printed. */
+static void
+json_sections_only(void)
+{
+    glflags.gf_abbrev_flag = FALSE;
+    glflags.gf_aranges_flag = FALSE;
+    glflags.gf_debug_names_flag = FALSE;
+    glflags.gf_eh_frame_flag = FALSE;
+    glflags.gf_frame_flag = FALSE;
+    glflags.gf_gdbindex_flag = FALSE;
+    glflags.gf_gnu_debuglink_flag = FALSE;
+    glflags.gf_debug_gnu_flag = FALSE;
+    glflags.gf_debug_sup_flag = FALSE;
+    glflags.gf_loc_flag = FALSE;
+    glflags.gf_macinfo_flag = FALSE;
+    glflags.gf_macro_flag = FALSE;
+    glflags.gf_pubnames_flag = FALSE;
+    glflags.gf_debug_addr_flag = FALSE;
+    glflags.gf_ranges_flag = FALSE;
+    glflags.gf_reloc_flag = FALSE;
+    glflags.gf_static_func_flag = FALSE;
+    glflags.gf_static_var_flag = FALSE;
+    glflags.gf_string_flag = FALSE;
+    glflags.gf_pubtypes_flag = FALSE;
+    glflags.gf_weakname_flag = FALSE;
+    glflags.gf_header_flag = FALSE;
+    glflags.gf_producer_children_flag = FALSE;
+    glflags.gf_print_str_offsets = FALSE;
+    glflags.gf_print_raw_rnglists = FALSE;
+    glflags.gf_print_raw_loclists = FALSE;
+}
+
 static int
 get_number_value(char *v_in,long int *v_out)
 {
@@ -324,6 +358,7 @@ static void arg_check_tag_attr(void);
 static void arg_check_tag_tag(void);
 static void arg_check_type(void);
 static void arg_check_unique(void);
+static void arg_jobs(void);
 
 #ifdef HAVE_USAGE_TAG_ATTR
 static void arg_check_usage(void);
@@ -344,6 +379,7 @@ static void arg_format_ellipsis(void);
 static void arg_format_expr_ops_joined(void);
 static void arg_format_extensions(void);
 static void arg_format_global_offsets(void);
+static void arg_format_json(void);
 static void arg_format_loc(void);
 static void arg_format_registers(void);
 static void arg_format_suppress_data(void);
@@ -543,6 +579,8 @@ static const char *usage_long_text[] = {
 "                            assumed to be ok (not reported).",
 "-ky  --check-type           Examine type info",
 "-kG  --check-unique         Print only unique errors",
+"     --jobs=<n>             Check the .debug_info CUs using",
+"                            n worker processes",
 #ifdef HAVE_USAGE_TAG_ATTR
 "-ku  --check-usage          Print tag-tree & tag-attr usage",
 "                            (basic format)",
@@ -559,6 +597,10 @@ static const char *usage_long_text[] = {
 "-d   --format-dense            One line per entry (info section)",
 "-e   --format-ellipsis         Short names for tags, attrs etc.",
 "-G   --format-global-offsets   Show global die offsets",
+"     --format-json             Print the -i DIEs and -l line rows",
+"                               as newline-delimited JSON, one",
+"                               object per DIE or row. Nothing",
+"                               else is printed.",
 "-g   --format-loc              (Was loclist support. Do not use.)",
 "     --format-expr-ops-joined  Print each group of DWARF DW_OPs",
 "                               on one line rather than one",
@@ -682,6 +724,9 @@ static const char *usage_long_text[] = {
 "                    dwarf_finish(). Used to test that",
 "                    dwarfdump does dealloc everywhere",
 "                    it should for minimum memory use.",
+"     --load-mmap    Have libdwarf mmap() object section data",
+"                    where possible instead of reading it",
+"                    into malloc() space.",
 "",
 };
 
@@ -714,6 +759,7 @@ OPT_CHECK_TAG_ATTR,           /* -kr  --check-tag-attr      */
 OPT_CHECK_TAG_TAG,            /* -kt  --check-tag-tag       */
 OPT_CHECK_TYPE,               /* -ky  --check-type          */
 OPT_CHECK_UNIQUE,             /* -kG  --check-unique        */
+OPT_JOBS,                     /*      --jobs=<n>            */
 #ifdef HAVE_USAGE_TAG_ATTR
 OPT_CHECK_USAGE,              /* -ku  --check-usage         */
 OPT_CHECK_USAGE_EXTENDED,     /* -kuf --check-usage-extended*/
@@ -735,6 +781,7 @@ OPT_FORMAT_ELLIPSIS,          /* -e   --format-ellipsis        */
 OPT_FORMAT_EXPR_OPS_JOINED,   /*      --format-expr-ops-joined */
 OPT_FORMAT_EXTENSIONS,        /* -C   --format-extensions      */
 OPT_FORMAT_GLOBAL_OFFSETS,    /* -G   --format-global-offsets  */
+OPT_FORMAT_JSON,              /*      --format-json            */
 OPT_FORMAT_LOC,               /* -g   --format-loc             */
 OPT_FORMAT_REGISTERS,         /* -R   --format-registers       */
 OPT_FORMAT_SUPPRESS_DATA,     /* -Q   --format-suppress-data   */
@@ -822,6 +869,7 @@ OPT_SHOW_ARGS,                /*   --show-args               */
 OPT_TRACE,                    /* -# --trace=<num>            */
 
 OPT_ALLOC_TREE_OFF,           /* --suppress-de-alloc-tree */
+OPT_LOAD_MMAP,                /* --load-mmap */
 
 OPT_END
 };
@@ -854,6 +902,7 @@ static struct dwoption longopts[] =  {
 {"check-tag-tag",        dwno_argument, 0, OPT_CHECK_TAG_TAG       },
 {"check-type",           dwno_argument, 0, OPT_CHECK_TYPE          },
 {"check-unique",         dwno_argument, 0, OPT_CHECK_UNIQUE        },
+{"jobs",                 dwrequired_argument, 0, OPT_JOBS          },
 #ifdef HAVE_USAGE_TAG_ATTR
 {"check-usage",          dwno_argument, 0, OPT_CHECK_USAGE         },
 {"check-usage-extended", dwno_argument, 0, OPT_CHECK_USAGE_EXTENDED},
@@ -881,6 +930,8 @@ static struct dwoption longopts[] =  {
     OPT_FORMAT_EXTENSIONS       },
 {"format-global-offsets",    dwno_argument, 0,
     OPT_FORMAT_GLOBAL_OFFSETS   },
+{"format-json",              dwno_argument, 0,
+    OPT_FORMAT_JSON             },
 {"format-loc",               dwno_argument, 0,
     OPT_FORMAT_LOC              },
 {"format-registers",         dwno_argument, 0,
@@ -980,6 +1031,7 @@ OPT_FORMAT_SUPPRESS_OFFSETS },
 {"trace", dwrequired_argument, 0, OPT_TRACE},
 
 {"suppress-de-alloc-tree",dwno_argument,0,OPT_ALLOC_TREE_OFF},
+{"load-mmap",dwno_argument,0,OPT_LOAD_MMAP},
 {0,0,0,0}
 };
 
@@ -1180,6 +1232,13 @@ void arg_format_global_offsets(void)
     glflags.gf_show_global_offsets = TRUE;
 }
 
+/*  Option '--format-json' */
+void arg_format_json(void)
+{
+    suppress_check_dwarf();
+    glflags.gf_format_json = TRUE;
+}
+
 /*  Option '-h' */
 void arg_h_multiple_selection(void)
 {
@@ -1411,6 +1470,26 @@ void arg_check_unique(void)
     glflags.gf_print_unique_errors = TRUE;
 }
 
+/*  Option '--jobs=<n>' */
+void arg_jobs(void)
+{
+    int jobs = 0;
+
+    if (!dwoptarg || !dwoptarg[0]) {
+        printf("\nERROR The --jobs option requires a count\n");
+        glflags.gf_count_major_errors++;
+        return;
+    }
+    jobs = atoi(dwoptarg);
+    if (jobs < 1 || jobs > DD_MAX_JOBS) {
+        printf("\nERROR The --jobs count must be between 1 and %d,"
+            " not %s\n",DD_MAX_JOBS,dwoptarg);
+        glflags.gf_count_major_errors++;
+        return;
+    }
+    glflags.gf_jobs = jobs;
+}
+
 /*  Option '-ki' */
 void arg_check_summary(void)
 {
@@ -2083,19 +2162,20 @@ void arg_show_dwarfdump_conf(void)
 /*  Option '--show-args'
     which causes dwarfdump to print the current
     version of the program, date, and time of the run,
-    and to show the command line arguments. */
+    and to show the command line arguments.
+    Both are printed once all options are known
+    (a --format-json run prints them to stderr). */
 void arg_show_args(void)
 {
     glflags.gf_show_args_flag = TRUE;
-    print_version_details(glflags.program_fullname);
 }
 
 /*  Option '-V' */
 void arg_version(void)
 {
     /* Display dwarfdump compilation date and time */
-    print_version_details(glflags.program_fullname);
     arg_show_args();
+    print_version_details(glflags.program_fullname);
     makename_destructor();
     global_destructors();
     exit(OKAY);
@@ -2510,6 +2590,7 @@ set_command_options(int argc, char *argv[])
         case OPT_CHECK_TAG_TAG:        arg_check_tag_tag();  break;
         case OPT_CHECK_TYPE:           arg_check_type();     break;
         case OPT_CHECK_UNIQUE:         arg_check_unique();   break;
+        case OPT_JOBS:                 arg_jobs();           break;
 #ifdef HAVE_USAGE_TAG_ATTR
         case OPT_CHECK_USAGE:          arg_check_usage();break;
         case OPT_CHECK_USAGE_EXTENDED: arg_check_usage_extended();
@@ -2538,6 +2619,8 @@ set_command_options(int argc, char *argv[])
             arg_format_extensions();       break;
         case OPT_FORMAT_GLOBAL_OFFSETS:
             arg_format_global_offsets();   break;
+        case OPT_FORMAT_JSON:
+            arg_format_json();             break;
         case OPT_FORMAT_LOC:
             arg_format_loc();              break;
         case OPT_FORMAT_REGISTERS:
@@ -2642,6 +2725,10 @@ set_command_options(int argc, char *argv[])
                 record keeping. */
             dwarf_set_de_alloc_flag(FALSE);
             break;
+        case OPT_LOAD_MMAP:
+            /*  Map section data rather than reading it. */
+            glflags.gf_load_mmap = TRUE;
+            break;
 
         default: arg_usage_error = TRUE; break;
         }
@@ -2671,6 +2758,7 @@ static const char *simplestdargs[] ={
 "--show-args",
 "--verbose-more",
 "--suppress-de-alloc-tree",
+"--load-mmap",
 "--suppress-debuglink-crc",
 "--no-follow-debuglink",
 0
@@ -2822,5 +2910,25 @@ process_args(int argc, char *argv[])
             (checking means checking-only). */
         glflags.verbose = 1;
     }
+    if (glflags.gf_format_json) {
+        if (glflags.gf_do_check_dwarf || glflags.gf_search_is_on) {
+            printf("%s: --format-json cannot be combined with "
+                "checking or searching options\n",
+                glflags.program_name);
+            makename_destructor();
+            global_destructors();
+            exit(EXIT_FAILURE);
+        }
+        if (!glflags.gf_info_flag && !glflags.gf_types_flag &&
+            !glflags.gf_line_flag) {
+            glflags.gf_info_flag = TRUE;
+            glflags.gf_line_flag = TRUE;
+        }
+        /*  The JSON records are written where the
+            DIE and line text would have been printed.
+            Nothing else is printed. */
+        json_sections_only();
+        glflags.gf_do_print_dwarf = FALSE;
+    }
     return do_uri_translation(argv[dwoptind],"file-to-process");
 }
@@ -45,6 +45,7 @@
 #include "dd_safe_strcpy.h"
 #include "dd_command_options.h"
 #include "dd_compiler_info.h"
+#include "dd_parallel.h"
 #include "libdwarf_private.h" /* For malloc/calloc debug */
 
 /* Record compilers  whose CU names have been seen.
@@ -202,19 +203,12 @@ print_specific_checks_results(Compiler *pCompiler)
     table and is printed if the '-P' or '--print-producers'
     option is specified in the
     command line. */
-void
-add_cu_name_compiler_target(char *name)
+static void
+append_cu_name(Compiler *pCompiler,const char *name)
 {
     a_name_chain *cu_last = 0;
     a_name_chain *nc = 0;
-    Compiler *pCompiler = 0;
 
-    if (current_compiler < 1) {
-        printf("ERROR Current  compiler set to %d, cannot add "
-            "Compilation unit name.  Giving up.",current_compiler);
-        exit(EXIT_FAILURE);
-    }
-    pCompiler = &compilers_detected[current_compiler];
     cu_last = pCompiler->cu_last;
     /* Record current cu name */
     nc = (a_name_chain *)malloc(sizeof(a_name_chain));
@@ -225,7 +219,7 @@ add_cu_name_compiler_target(char *name)
         glflags.gf_count_major_errors++;
         return;
     }
-    nc->item = makename(name);
+    nc->item = makename((char *)name);
     nc->next = NULL;
     if (cu_last) {
         cu_last->next = nc;
@@ -235,6 +229,57 @@ add_cu_name_compiler_target(char *name)
     pCompiler->cu_last = nc;
 }
 
+void
+add_cu_name_compiler_target(char *name)
+{
+    if (current_compiler < 1) {
+        printf("ERROR Current  compiler set to %d, cannot add "
+            "Compilation unit name.  Giving up.",current_compiler);
+        exit(EXIT_FAILURE);
+    }
+    append_cu_name(&compilers_detected[current_compiler],name);
+}
+
+/*  Returns the compilers_detected index of name,
+    or 0 if the name has not been seen yet. */
+static int
+find_detected_compiler(const char *name)
+{
+    int index = 0;
+
+    for (index = 1; index <= compilers_detected_count; ++index) {
+        const char *dname = compilers_detected[index].name;
+        if (
+#if _WIN32
+            !stricmp(dname,name)
+#else
+            !strcmp(dname, name)
+#endif /* _WIN32 */
+            ) {
+            return index;
+        }
+    }
+    return 0;
+}
+
+/*  Adds a new detected compiler, returning its index,
+    or 0 if the table is full. */
+static int
+add_detected_compiler(const char *name)
+{
+    Compiler *pCompiler = 0;
+
+    if ((compilers_detected_count + 1) >= COMPILER_TABLE_MAX) {
+        return 0;
+    }
+    /* First compiler at position [1] */
+    ++compilers_detected_count;
+    pCompiler = &compilers_detected[compilers_detected_count];
+    reset_compiler_entry(pCompiler);
+    pCompiler->name = makename((char *)name);
+    return compilers_detected_count;
+}
+
 /* Reset a compiler entry, so all fields are properly set */
 void
 reset_compiler_entry(Compiler *compiler)
@@ -257,7 +302,6 @@ reset_compiler_entry(Compiler *compiler)
 void
 update_compiler_target(const char *producer_name)
 {
-    Dwarf_Bool cFound = FALSE;
     int index = 0;
 
     dd_safe_strcpy(glflags.CU_producer,sizeof(glflags.CU_producer),
@@ -290,34 +334,14 @@ update_compiler_target(const char *producer_name)
     }
 
     /* Check for already detected compiler */
-    for (index = 1; index <= compilers_detected_count; ++index) {
-        const char *name = compilers_detected[index].name;
-        if (
-#if _WIN32
-            !stricmp(name,glflags.CU_producer)
-#else
-            !strcmp(name, glflags.CU_producer)
-#endif /* _WIN32 */
-            ) {
-            /* Set current compiler index */
-            current_compiler = index;
-            cFound = TRUE;
-            break;
-        } else {
-        }
-    }
-    if (!cFound) {
+    index = find_detected_compiler(glflags.CU_producer);
+    if (!index) {
         /* Record a new detected compiler name. */
-        if ((compilers_detected_count + 1) < COMPILER_TABLE_MAX) {
-            Compiler *pCompiler = 0;
-            char *cmp = makename(glflags.CU_producer);
-            /*  Set current compiler index,
-                first compiler at position [1] */
-            current_compiler = ++compilers_detected_count;
-            pCompiler = &compilers_detected[current_compiler];
-            reset_compiler_entry(pCompiler);
-            pCompiler->name = cmp;
-        }
+        index = add_detected_compiler(glflags.CU_producer);
+    }
+    if (index) {
+        /* Set current compiler index */
+        current_compiler = index;
     }
 }
 
@@ -329,6 +353,214 @@ clean_up_compilers_detected(void)
     compilers_detected_count = 0;
 }
 
+/*  A --jobs worker starts with no compilers detected
+    and no counts, so what it saves is only what its
+    own CUs added.  Names are owned by makename(),
+    the worker exits without freeing anything. */
+void
+compiler_info_job_reset(void)
+{
+    int index = 0;
+
+    memset(&compilers_detected[0],0,
+        (compilers_detected_count+1)*sizeof(Compiler));
+    compilers_detected_count = 0;
+    current_compiler = -1;
+    for (index = 1; index <= compilers_targeted_count; ++index) {
+        compilers_targeted[index].verified = FALSE;
+    }
+}
+
+static int
+save_compiler(FILE *f,Compiler *pCompiler)
+{
+    a_name_chain *nc = 0;
+    unsigned cucount = 0;
+    int res = 0;
+
+    res = dd_job_write_string(f,pCompiler->name);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dd_job_write(f,&pCompiler->verified,
+        sizeof(pCompiler->verified));
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dd_job_write(f,pCompiler->results,
+        sizeof(pCompiler->results));
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (nc = pCompiler->cu_list; nc; nc = nc->next) {
+        ++cucount;
+    }
+    res = dd_job_write(f,&cucount,sizeof(cucount));
+    for (nc = pCompiler->cu_list; res == DW_DLV_OK && nc;
+        nc = nc->next) {
+        res = dd_job_write_string(f,nc->item);
+    }
+    return res;
+}
+
+int
+compiler_info_job_save(FILE *f)
+{
+    int index = 0;
+    int res = 0;
+    const char *curname = "";
+
+    res = dd_job_write(f,compilers_detected[0].results,
+        sizeof(compilers_detected[0].results));
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dd_job_write(f,&compilers_detected_count,
+        sizeof(compilers_detected_count));
+    for (index = 1; res == DW_DLV_OK &&
+        index <= compilers_detected_count; ++index) {
+        res = save_compiler(f,&compilers_detected[index]);
+    }
+    for (index = 1; res == DW_DLV_OK &&
+        index <= compilers_targeted_count; ++index) {
+        res = dd_job_write(f,&compilers_targeted[index].verified,
+            sizeof(compilers_targeted[index].verified));
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    /*  The compiler of the last CU the worker looked at. */
+    if (current_compiler > 0 &&
+        current_compiler <= compilers_detected_count) {
+        curname = compilers_detected[current_compiler].name;
+    }
+    res = dd_job_write_string(f,curname);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return dd_job_write(f,&current_cu_is_checked_compiler,
+        sizeof(current_cu_is_checked_compiler));
+}
+
+static void
+add_results(Dwarf_Check_Result *to,Dwarf_Check_Result *from)
+{
+    int i = 0;
+
+    for (i = 0; i < LAST_CATEGORY; ++i) {
+        to[i].checks += from[i].checks;
+        to[i].errors += from[i].errors;
+    }
+}
+
+static int
+merge_compiler(FILE *f)
+{
+    char *name = 0;
+    char *cuname = 0;
+    Dwarf_Bool verified = FALSE;
+    Dwarf_Check_Result results[LAST_CATEGORY];
+    unsigned cucount = 0;
+    unsigned i = 0;
+    Compiler *pCompiler = 0;
+    int index = 0;
+    int res = 0;
+
+    res = dd_job_read_string(f,&name);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dd_job_read(f,&verified,sizeof(verified));
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(f,results,sizeof(results));
+    }
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(f,&cucount,sizeof(cucount));
+    }
+    if (res != DW_DLV_OK) {
+        free(name);
+        return res;
+    }
+    index = find_detected_compiler(name);
+    if (!index) {
+        index = add_detected_compiler(name);
+    }
+    free(name);
+    if (index) {
+        pCompiler = &compilers_detected[index];
+        pCompiler->verified |= verified;
+        add_results(pCompiler->results,results);
+    }
+    for (i = 0; i < cucount; ++i) {
+        res = dd_job_read_string(f,&cuname);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (pCompiler) {
+            append_cu_name(pCompiler,cuname);
+        }
+        free(cuname);
+    }
+    return DW_DLV_OK;
+}
+
+/*  Adds a worker's record to the tables.  Workers are
+    merged in CU order, so compilers_detected ends up
+    in the order a serial run would have found them.
+    take_current is TRUE for the worker that checked
+    the last CU. */
+int
+compiler_info_job_merge(FILE *f,Dwarf_Bool take_current)
+{
+    Dwarf_Check_Result results[LAST_CATEGORY];
+    int count = 0;
+    int index = 0;
+    int res = 0;
+    char *curname = 0;
+    Dwarf_Bool checked = FALSE;
+
+    res = dd_job_read(f,results,sizeof(results));
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(f,&count,sizeof(count));
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    add_results(compilers_detected[0].results,results);
+    for (index = 1; index <= count; ++index) {
+        res = merge_compiler(f);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    for (index = 1; index <= compilers_targeted_count; ++index) {
+        Dwarf_Bool verified = FALSE;
+
+        res = dd_job_read(f,&verified,sizeof(verified));
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        compilers_targeted[index].verified |= verified;
+    }
+    res = dd_job_read_string(f,&curname);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dd_job_read(f,&checked,sizeof(checked));
+    if (res == DW_DLV_OK && take_current) {
+        current_compiler = -1;
+        if (curname[0]) {
+            index = find_detected_compiler(curname);
+            if (index) {
+                current_compiler = index;
+            }
+        }
+        current_cu_is_checked_compiler = checked;
+    }
+    free(curname);
+    return res;
+}
+
 /*  Are we checking for errors from the
     compiler of the current compilation unit?
 */
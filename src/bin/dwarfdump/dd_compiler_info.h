@@ -28,6 +28,8 @@
 #ifndef COMPILER_INFO_H
 #define COMPILER_INFO_H
 
+#include <stdio.h> /* FILE */
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -61,6 +63,11 @@ extern void reset_compiler_entry(Compiler *compiler);
 extern void print_checks_results(void);
 extern Dwarf_Bool record_producer(char *name);
 
+/*  For --jobs worker processes, see dd_parallel.c */
+extern void compiler_info_job_reset(void);
+extern int  compiler_info_job_save(FILE *f);
+extern int  compiler_info_job_merge(FILE *f,Dwarf_Bool take_current);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -280,6 +280,8 @@ init_global_flags(void)
     glflags.gf_show_dwarfdump_conf = 0;
 
     glflags.dense = FALSE;
+    glflags.gf_format_json = FALSE;
+    glflags.gf_load_mmap = FALSE;
     glflags.ellipsis = FALSE;
     glflags.show_form_used = FALSE;
 
@@ -292,6 +294,7 @@ init_global_flags(void)
         the -f or -F output to 2 FDEs and 2 CIEs.
     */
     glflags.break_after_n_units = INT_MAX;
+    glflags.gf_jobs = 1;
 
     glflags.section_high_offsets_global =
         &_section_high_offsets_global;
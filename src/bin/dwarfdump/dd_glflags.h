@@ -326,6 +326,13 @@ struct glflags_s {
     int gf_show_dwarfdump_conf;/* Incremented with
         --show-dwarfdump-conf, never decremented */
     Dwarf_Bool dense;
+    /*  --format-json: the -i and -l output is written as
+        newline-delimited JSON (see dd_json.h) instead of
+        text, and nothing else is printed. */
+    Dwarf_Bool gf_format_json;
+    /*  --load-mmap: have libdwarf mmap() section data,
+        see dwarf_set_load_preference(). */
+    Dwarf_Bool gf_load_mmap;
     Dwarf_Bool ellipsis;
     Dwarf_Bool show_form_used;
 
@@ -339,6 +346,12 @@ struct glflags_s {
     */
     int break_after_n_units;
 
+    /*  gf_jobs is the number of worker processes
+        checking .debug_info CUs (--jobs=<n>).
+        1 means check serially in this process. */
+    #define DD_MAX_JOBS 64
+    int gf_jobs;
+
     struct section_high_offsets_s *section_high_offsets_global;
 
     /*  pRangesInfo records the DW_AT_high_pc and DW_AT_low_pc
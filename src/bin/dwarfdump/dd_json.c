@@ -0,0 +1,389 @@
+/*
+  Copyright 2026 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+*/
+
+/*  The --format-json writer.  Pipelines reading dwarfdump
+    output want one record per line and no parsing of
+    the human-oriented text, so the values go straight
+    from libdwarf into json_buf with no printf formatting
+    and no esb.  */
+
+#include <config.h>
+
+#include <stdio.h>  /* FILE fdopen() fflush() fileno() fwrite()
+    stderr stdout */
+#include <string.h> /* strlen() */
+
+#ifdef _WIN32
+#ifdef HAVE_STDAFX_H
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+#include <io.h> /* close() dup() dup2() */
+#elif defined HAVE_UNISTD_H
+#include <unistd.h> /* close() dup() dup2() */
+#endif /* _WIN32 */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_json.h"
+
+/*  Large enough for almost any DIE, a bigger record is
+    handed to stdout in pieces. */
+#define JSON_BUF_SIZE 8192
+
+static char json_buf[JSON_BUF_SIZE];
+static size_t json_len;
+/*  Where records go, stdout when zero. */
+static FILE *json_out;
+/*  TRUE when the next member or array element needs
+    a leading comma. */
+static Dwarf_Bool json_need_comma;
+
+static const char json_hexdigits[] = "0123456789abcdef";
+
+static void
+json_flush(void)
+{
+    if (json_len) {
+        fwrite(json_buf,1,json_len,dd_json_get_output());
+        json_len = 0;
+    }
+}
+
+int
+dd_json_separate_output(void)
+{
+    int fd = -1;
+    FILE *f = 0;
+
+    fflush(stdout);
+    fflush(stderr);
+    fd = dup(fileno(stdout));
+    if (fd < 0) {
+        return DW_DLV_ERROR;
+    }
+    f = fdopen(fd,"w");
+    if (!f) {
+        close(fd);
+        return DW_DLV_ERROR;
+    }
+    if (dup2(fileno(stderr),fileno(stdout)) < 0) {
+        fclose(f);
+        return DW_DLV_ERROR;
+    }
+    json_out = f;
+    return DW_DLV_OK;
+}
+
+FILE *
+dd_json_get_output(void)
+{
+    return json_out?json_out:stdout;
+}
+
+void
+dd_json_set_output(FILE *f)
+{
+    json_out = f;
+}
+
+static void
+json_put(const char *s,size_t len)
+{
+    while (len) {
+        size_t room = JSON_BUF_SIZE - json_len;
+
+        if (!room) {
+            json_flush();
+            room = JSON_BUF_SIZE;
+        }
+        if (room > len) {
+            room = len;
+        }
+        memcpy(json_buf+json_len,s,room);
+        json_len += room;
+        s += room;
+        len -= room;
+    }
+}
+
+static void
+json_putc(char c)
+{
+    if (json_len == JSON_BUF_SIZE) {
+        json_flush();
+    }
+    json_buf[json_len++] = c;
+}
+
+/*  Every value goes through here, so array elements
+    get their comma. */
+static void
+json_value_start(void)
+{
+    if (json_need_comma) {
+        json_putc(',');
+    }
+    json_need_comma = TRUE;
+}
+
+void
+dd_json_begin_record(const char *kind)
+{
+    json_put("{\"kind\":\"",9);
+    json_put(kind,strlen(kind));
+    json_putc('"');
+    json_need_comma = TRUE;
+}
+
+void
+dd_json_end_record(void)
+{
+    json_put("}\n",2);
+    json_need_comma = FALSE;
+    json_flush();
+}
+
+void
+dd_json_key(const char *key)
+{
+    if (json_need_comma) {
+        json_putc(',');
+    }
+    json_putc('"');
+    json_put(key,strlen(key));
+    json_put("\":",2);
+    json_need_comma = FALSE;
+}
+
+/*  Returns the length of the valid UTF-8 multibyte
+    sequence at s, or 0.  The NUL ending s never
+    passes as a continuation byte. */
+static int
+utf8_sequence_length(const unsigned char *s)
+{
+    unsigned char c = s[0];
+    unsigned char lo = 0x80;
+    unsigned char hi = 0xbf;
+    int len = 0;
+    int i = 0;
+
+    if (c >= 0xc2 && c <= 0xdf) {
+        len = 2;
+    } else if (c >= 0xe0 && c <= 0xef) {
+        len = 3;
+        if (c == 0xe0) {
+            lo = 0xa0;
+        } else if (c == 0xed) {
+            /* Not the UTF-16 surrogates */
+            hi = 0x9f;
+        }
+    } else if (c >= 0xf0 && c <= 0xf4) {
+        len = 4;
+        if (c == 0xf0) {
+            lo = 0x90;
+        } else if (c == 0xf4) {
+            hi = 0x8f;
+        }
+    } else {
+        return 0;
+    }
+    if (s[1] < lo || s[1] > hi) {
+        return 0;
+    }
+    for (i = 2; i < len; ++i) {
+        if (s[i] < 0x80 || s[i] > 0xbf) {
+            return 0;
+        }
+    }
+    return len;
+}
+
+void
+dd_json_string(const char *s)
+{
+    const unsigned char *cur = (const unsigned char *)s;
+    const unsigned char *run = cur;
+    char esc[6];
+
+    json_value_start();
+    json_putc('"');
+    esc[0] = '\\';
+    esc[1] = 'u';
+    esc[2] = '0';
+    esc[3] = '0';
+    for ( ; *cur; ) {
+        unsigned char c = *cur;
+        int seqlen = 0;
+
+        if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\') {
+            ++cur;
+            continue;
+        }
+        if (c >= 0x80) {
+            seqlen = utf8_sequence_length(cur);
+            if (seqlen) {
+                cur += seqlen;
+                continue;
+            }
+        }
+        /*  Write the plain run, then the escaped byte. */
+        json_put((const char *)run,(size_t)(cur - run));
+        switch (c) {
+        case '"':  json_put("\\\"",2); break;
+        case '\\': json_put("\\\\",2); break;
+        case '\n': json_put("\\n",2);  break;
+        case '\t': json_put("\\t",2);  break;
+        case '\r': json_put("\\r",2);  break;
+        default:
+            esc[4] = json_hexdigits[c >> 4];
+            esc[5] = json_hexdigits[c & 0xf];
+            json_put(esc,6);
+            break;
+        }
+        ++cur;
+        run = cur;
+    }
+    json_put((const char *)run,(size_t)(cur - run));
+    json_putc('"');
+}
+
+void
+dd_json_unsigned(Dwarf_Unsigned v)
+{
+    char digits[24];
+    char *p = digits + sizeof(digits);
+
+    json_value_start();
+    do {
+        *--p = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v);
+    json_put(p,(size_t)(digits + sizeof(digits) - p));
+}
+
+void
+dd_json_signed(Dwarf_Signed v)
+{
+    Dwarf_Unsigned mag = 0;
+
+    if (v >= 0) {
+        dd_json_unsigned((Dwarf_Unsigned)v);
+        return;
+    }
+    /*  Negating in unsigned arithmetic works for the
+        most negative value too. */
+    mag = 0 - (Dwarf_Unsigned)v;
+    json_value_start();
+    json_putc('-');
+    json_need_comma = FALSE;
+    dd_json_unsigned(mag);
+}
+
+void
+dd_json_bool(Dwarf_Bool v)
+{
+    json_value_start();
+    if (v) {
+        json_put("true",4);
+    } else {
+        json_put("false",5);
+    }
+}
+
+void
+dd_json_null(void)
+{
+    json_value_start();
+    json_put("null",4);
+}
+
+void
+dd_json_bytes(const unsigned char *bytes,Dwarf_Unsigned len)
+{
+    Dwarf_Unsigned i = 0;
+
+    json_value_start();
+    json_putc('"');
+    for (i = 0; i < len; ++i) {
+        json_putc(json_hexdigits[bytes[i] >> 4]);
+        json_putc(json_hexdigits[bytes[i] & 0xf]);
+    }
+    json_putc('"');
+}
+
+void
+dd_json_dwname(const char *name,const char *prefix,
+    Dwarf_Unsigned value)
+{
+    char hex[16];
+    char *p = hex + sizeof(hex);
+
+    if (name) {
+        dd_json_string(name);
+        return;
+    }
+    json_value_start();
+    json_put("\"<Unknown ",10);
+    json_put(prefix,strlen(prefix));
+    json_put(" value 0x",9);
+    do {
+        *--p = json_hexdigits[value & 0xf];
+        value >>= 4;
+    } while (value);
+    json_put(p,(size_t)(hex + sizeof(hex) - p));
+    json_put(">\"",2);
+}
+
+void
+dd_json_begin_array(void)
+{
+    json_value_start();
+    json_putc('[');
+    json_need_comma = FALSE;
+}
+
+void
+dd_json_end_array(void)
+{
+    json_putc(']');
+    json_need_comma = TRUE;
+}
+
+void
+dd_json_begin_object(void)
+{
+    json_value_start();
+    json_putc('{');
+    json_need_comma = FALSE;
+}
+
+void
+dd_json_end_object(void)
+{
+    json_putc('}');
+    json_need_comma = TRUE;
+}
@@ -0,0 +1,87 @@
+/*
+  Copyright 2026 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+*/
+
+#ifndef DD_JSON_H
+#define DD_JSON_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  --format-json: newline-delimited JSON, one object
+    per DIE and per line table row.
+    A record is built in a fixed buffer (never in an esb)
+    and handed to the output when it ends or the buffer
+    fills.
+
+    Keys are string literals from dwarfdump itself and
+    are written as-is.  String values are escaped, with
+    bytes that are not valid UTF-8 written as \u00XX.  */
+
+/*  Called once, before anything is printed.  Records
+    then go to a duplicate of the stdout descriptor and
+    stdout itself is made a duplicate of stderr, so no
+    message printed anywhere in dwarfdump can land
+    between two records.  Returns DW_DLV_ERROR, with
+    nothing changed, if the descriptors cannot be
+    duplicated. */
+int dd_json_separate_output(void);
+/*  The FILE records are written to.  --jobs workers
+    point it at their own temporary file. */
+FILE *dd_json_get_output(void);
+void dd_json_set_output(FILE *f);
+
+void dd_json_begin_record(const char *kind);
+void dd_json_end_record(void);
+
+/*  Starts the member "key": whose value follows. */
+void dd_json_key(const char *key);
+
+/*  Values, either after dd_json_key() or as
+    array elements. */
+void dd_json_string(const char *s);
+void dd_json_unsigned(Dwarf_Unsigned v);
+void dd_json_signed(Dwarf_Signed v);
+void dd_json_bool(Dwarf_Bool v);
+void dd_json_null(void);
+/*  Bytes as a string of hex digit pairs. */
+void dd_json_bytes(const unsigned char *bytes,
+    Dwarf_Unsigned len);
+/*  A DW_AT, DW_TAG etc. name, or "<Unknown prefix
+    value 0x..>" when name is NULL. */
+void dd_json_dwname(const char *name,const char *prefix,
+    Dwarf_Unsigned value);
+
+void dd_json_begin_array(void);
+void dd_json_end_array(void);
+void dd_json_begin_object(void);
+void dd_json_end_object(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* DD_JSON_H */
@@ -50,6 +50,7 @@
 
 #include <config.h>
 
+#include <stdio.h>  /* FILE */
 #include <stdlib.h> /* calloc() free() */
 
 #include "dwarf.h"
@@ -58,6 +59,7 @@
 #include "dd_globals.h"
 #include "dd_tsearchbal.h"
 #include "dd_macrocheck.h"
+#include "dd_parallel.h"
 #include "dd_esb.h"
 
 /*  WARNING: the tree walk functions will, if presented **tree
@@ -546,6 +548,134 @@ clear_macrocheck_statistics(void **tsbase)
     *tsbase = 0;
 }
 
+/*  For --jobs workers (see dd_parallel.c): a worker
+    starts with empty trees and saves every entry its
+    CUs added.  The parent merges entries the way
+    macrocheck_map_insert() and add_macro_area_len()
+    would have updated them in a serial run. */
+static FILE *job_file;
+static int   job_res;
+static void
+macro_walk_save(const void *nodep,const DW_VISIT  which,
+    const int  depth)
+{
+    struct Macrocheck_Map_Entry_s * re =
+        *(struct Macrocheck_Map_Entry_s**)nodep;
+
+    (void)depth;
+    if (which == dwarf_postorder || which == dwarf_endorder) {
+        return;
+    }
+    if (job_res != DW_DLV_OK) {
+        return;
+    }
+    job_res = dd_job_write(job_file,re,sizeof(*re));
+}
+
+void
+macrocheck_job_reset(void)
+{
+    clear_macrocheck_statistics(&macro_check_tree);
+    clear_macrocheck_statistics(&macinfo_check_tree);
+}
+
+static int
+save_one_tree(FILE *f,void **base)
+{
+    Dwarf_Unsigned count = 0;
+
+    count = macro_count_recs(base);
+    job_res = dd_job_write(f,&count,sizeof(count));
+    if (job_res != DW_DLV_OK) {
+        return job_res;
+    }
+    job_file = f;
+    dwarf_twalk(*base,macro_walk_save);
+    job_file = 0;
+    return job_res;
+}
+
+int
+macrocheck_job_save(FILE *f)
+{
+    int res = 0;
+
+    res = dd_job_write(f,&macfile_stack_max_seen,
+        sizeof(macfile_stack_max_seen));
+    if (res == DW_DLV_OK) {
+        res = dd_job_write(f,&macro_import_stack_max_seen,
+            sizeof(macro_import_stack_max_seen));
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = save_one_tree(f,&macro_check_tree);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return save_one_tree(f,&macinfo_check_tree);
+}
+
+static int
+merge_one_tree(FILE *f,void **base)
+{
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dd_job_read(f,&count,sizeof(count));
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < count; ++i) {
+        struct Macrocheck_Map_Entry_s in;
+        struct Macrocheck_Map_Entry_s *re = 0;
+
+        res = dd_job_read(f,&in,sizeof(in));
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        macrocheck_map_insert(in.mp_key,
+            in.mp_refcount_primary,in.mp_refcount_secondary,
+            in.mp_import_linenum,in.mp_import_from_filenum,
+            base);
+        re = macrocheck_map_find(in.mp_key,base);
+        if (!re) {
+            return DW_DLV_ERROR;
+        }
+        re->mp_len = in.mp_len;
+        re->mp_printed |= in.mp_printed;
+    }
+    return DW_DLV_OK;
+}
+
+int
+macrocheck_job_merge(FILE *f)
+{
+    unsigned filemax = 0;
+    unsigned importmax = 0;
+    int res = 0;
+
+    res = dd_job_read(f,&filemax,sizeof(filemax));
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(f,&importmax,sizeof(importmax));
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (filemax > macfile_stack_max_seen) {
+        macfile_stack_max_seen = filemax;
+    }
+    if (importmax > macro_import_stack_max_seen) {
+        macro_import_stack_max_seen = importmax;
+    }
+    res = merge_one_tree(f,&macro_check_tree);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return merge_one_tree(f,&macinfo_check_tree);
+}
+
 void
 print_macro_import_stack(void)
 {
@@ -27,6 +27,8 @@ Copyright 2015-2016 David Anderson. All rights reserved.
 #ifndef MACROCHECK_H
 #define MACROCHECK_H
 
+#include <stdio.h> /* FILE */
+
 /* tsearch trees used in macro checking. */
 extern void * macro_check_tree; /* DWARF5 macros. */
 extern void * macinfo_check_tree; /* DWARF2,3,4 macros */
@@ -121,6 +123,11 @@ int print_macrocheck_statistics(const char *name,void **basep,
     Dwarf_Unsigned section_size);
 void clear_macrocheck_statistics(void **basep);
 
+/*  For --jobs worker processes, see dd_parallel.c */
+void macrocheck_job_reset(void);
+int  macrocheck_job_save(FILE *f);
+int  macrocheck_job_merge(FILE *f);
+
 macfile_entry * macfile_from_array_index( unsigned index);
 
 #endif /* MACROCHECK_H */
@@ -0,0 +1,847 @@
+/*
+  Copyright 2026 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+*/
+
+/*  --jobs=<n> checks the .debug_info CUs in n worker
+    processes.  dwarfdump keeps its check state in
+    globals, so the workers are fork()ed processes
+    rather than threads: each gets a copy of everything.
+
+    Worker k checks the CUs whose DIE offset is in slice k
+    of the section (see print_info_cu_range()).  It starts
+    with zeroed counters and tables, writes what it prints
+    to a temporary file, and at the end saves its counters,
+    tables and the state describing its last CU to a
+    second temporary file.
+
+    Once every worker has finished the parent copies the
+    printed text to stdout in CU order and merges the saved
+    state, also in CU order, so the output and the final
+    summaries match a serial run.  If any worker fails or
+    stopped early (a serial run would have stopped there
+    with an error) the parent discards everything the
+    workers did and does the serial pass itself.
+
+    Only check-mode and --format-json runs (no text
+    printed per DIE) without -kG, searching, -H or a
+    tied file use workers.
+    .debug_types and the other sections are always
+    checked serially.  */
+
+#include <config.h>
+
+#include <limits.h> /* INT_MAX */
+#include <stddef.h> /* offsetof() size_t */
+#include <stdio.h>  /* FILE fflush() fprintf() fread() fwrite()
+    tmpfile() */
+#include <stdlib.h> /* calloc() free() malloc() */
+#include <string.h> /* memcpy() memset() strlen() */
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h> /* dup2() fork() _exit() */
+#endif /* HAVE_UNISTD_H */
+#if defined(HAVE_UNISTD_H) && !defined(_WIN32)
+#include <sys/types.h> /* pid_t */
+#include <sys/wait.h>  /* waitpid() */
+#define DD_HAVE_FORK 1
+#endif /* HAVE_UNISTD_H && !_WIN32 */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_globals.h"
+#include "dd_compiler_info.h"
+#include "dd_attr_form.h"
+#include "dd_json.h"
+#include "dd_macrocheck.h"
+#include "dd_parallel.h"
+
+int
+dd_job_write(FILE *f,const void *p,size_t len)
+{
+    if (len && fwrite(p,1,len,f) != len) {
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dd_job_read(FILE *f,void *p,size_t len)
+{
+    if (len && fread(p,1,len,f) != len) {
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dd_job_write_string(FILE *f,const char *s)
+{
+    size_t len = s? strlen(s):0;
+    int res = 0;
+
+    res = dd_job_write(f,&len,sizeof(len));
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return dd_job_write(f,s,len);
+}
+
+int
+dd_job_read_string(FILE *f,char **s)
+{
+    size_t len = 0;
+    char *str = 0;
+    int res = 0;
+
+    res = dd_job_read(f,&len,sizeof(len));
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    str = (char *)malloc(len+1);
+    if (!str) {
+        return DW_DLV_ERROR;
+    }
+    res = dd_job_read(f,str,len);
+    if (res != DW_DLV_OK) {
+        free(str);
+        return res;
+    }
+    str[len] = 0;
+    *s = str;
+    return DW_DLV_OK;
+}
+
+#ifdef DD_HAVE_FORK
+/*  Every glflags member a worker may change while
+    checking its CUs, and how the parent takes it.
+    JF_LAST members describe the most recent CU: the
+    parent takes them from the worker that checked the
+    last CU, as though it had checked every CU itself.
+    The gf_check flags are here as a .dwp CU turns
+    some of them off (see suppress_irrelevant_checking()).
+    JF_ANY members are set once something is seen,
+    so the parent sets them if any worker did.
+    JF_COUNT members are summed by merge_job_state().
+    JF_RESTORED members are changed and put back.
+    A worker that changed anything else would leave
+    the parent with a state a serial run would not
+    have, see unmerged_change(). */
+#define JF_LAST     1
+#define JF_ANY      2
+#define JF_COUNT    3
+#define JF_RESTORED 4
+
+struct job_field_s {
+    size_t jf_offset;
+    size_t jf_size;
+    int    jf_how;
+};
+
+#define JOB_FIELD(m,how) \
+    { offsetof(struct glflags_s,m),sizeof(glflags.m),how }
+
+static const struct job_field_s job_fields[] = {
+JOB_FIELD(seen_PU,JF_LAST),
+JOB_FIELD(seen_CU,JF_LAST),
+JOB_FIELD(need_CU_name,JF_LAST),
+JOB_FIELD(need_CU_base_address,JF_LAST),
+JOB_FIELD(need_CU_high_address,JF_LAST),
+JOB_FIELD(need_PU_valid_code,JF_LAST),
+JOB_FIELD(in_valid_code,JF_LAST),
+JOB_FIELD(seen_PU_base_address,JF_LAST),
+JOB_FIELD(seen_PU_high_address,JF_LAST),
+JOB_FIELD(PU_base_address,JF_LAST),
+JOB_FIELD(PU_high_address,JF_LAST),
+JOB_FIELD(DIE_offset,JF_LAST),
+JOB_FIELD(DIE_section_offset,JF_LAST),
+JOB_FIELD(DIE_CU_offset,JF_LAST),
+JOB_FIELD(DIE_CU_overall_offset,JF_LAST),
+JOB_FIELD(current_section_id,JF_LAST),
+JOB_FIELD(CU_base_address,JF_LAST),
+JOB_FIELD(CU_low_address,JF_LAST),
+JOB_FIELD(CU_high_address,JF_LAST),
+JOB_FIELD(fde_offset_for_cu_low,JF_LAST),
+JOB_FIELD(fde_offset_for_cu_high,JF_LAST),
+JOB_FIELD(gf_record_dwarf_error,JF_LAST),
+JOB_FIELD(gf_suppress_checking_on_dwp,JF_LAST),
+JOB_FIELD(gf_check_ranges,JF_LAST),
+JOB_FIELD(gf_check_aranges,JF_LAST),
+JOB_FIELD(gf_check_decl_file,JF_LAST),
+JOB_FIELD(gf_check_lines,JF_LAST),
+JOB_FIELD(gf_check_pubname_attr,JF_LAST),
+JOB_FIELD(gf_check_fdes,JF_LAST),
+JOB_FIELD(PU_name,JF_LAST),
+JOB_FIELD(CU_name,JF_LAST),
+JOB_FIELD(CU_producer,JF_LAST),
+JOB_FIELD(gf_debug_addr_missing,JF_ANY),
+JOB_FIELD(check_error,JF_COUNT),
+JOB_FIELD(gf_count_major_errors,JF_COUNT),
+JOB_FIELD(gf_count_macronotes,JF_COUNT),
+JOB_FIELD(dense,JF_RESTORED),
+{0,0,0}
+};
+
+/*  The glflags members a worker saves, in job_fields
+    order. */
+static int
+save_job_fields(FILE *f)
+{
+    const struct job_field_s *jf = job_fields;
+    int res = DW_DLV_OK;
+
+    for ( ; res == DW_DLV_OK && jf->jf_size; ++jf) {
+        if (jf->jf_how == JF_LAST || jf->jf_how == JF_ANY) {
+            res = dd_job_write(f,(char *)&glflags + jf->jf_offset,
+                jf->jf_size);
+        }
+    }
+    return res;
+}
+
+static int
+merge_job_fields(FILE *f,Dwarf_Bool take_cu_state)
+{
+    const struct job_field_s *jf = job_fields;
+    char buf[COMPILE_UNIT_NAME_LEN];
+    int res = DW_DLV_OK;
+
+    for ( ; res == DW_DLV_OK && jf->jf_size; ++jf) {
+        char *member = (char *)&glflags + jf->jf_offset;
+        size_t i = 0;
+
+        if (jf->jf_how != JF_LAST && jf->jf_how != JF_ANY) {
+            continue;
+        }
+        if (jf->jf_size > sizeof(buf)) {
+            return DW_DLV_ERROR;
+        }
+        res = dd_job_read(f,buf,jf->jf_size);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (jf->jf_how == JF_LAST) {
+            if (take_cu_state) {
+                memcpy(member,buf,jf->jf_size);
+            }
+            continue;
+        }
+        for (i = 0; i < jf->jf_size; ++i) {
+            if (buf[i]) {
+                memcpy(member,buf,jf->jf_size);
+                break;
+            }
+        }
+    }
+    return res;
+}
+
+/*  The offset of a byte of glflags that differs from
+    before but is not in job_fields, or -1.  */
+static long
+unmerged_change(const struct glflags_s *before)
+{
+    const char *now = (const char *)&glflags;
+    const char *was = (const char *)before;
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(glflags); ++i) {
+        const struct job_field_s *jf = job_fields;
+
+        if (now[i] == was[i]) {
+            continue;
+        }
+        for ( ; jf->jf_size; ++jf) {
+            if (i >= jf->jf_offset &&
+                i < jf->jf_offset + jf->jf_size) {
+                break;
+            }
+        }
+        if (!jf->jf_size) {
+            return (long)i;
+        }
+    }
+    return -1;
+}
+
+/*  libdwarf keeps the most recent harmless errors
+    in a circular list of fixed size plus a count of
+    all of them, and reading the list empties it. */
+struct harmless_s {
+    unsigned hs_total;
+    unsigned hs_count;
+    char   **hs_msgs;
+};
+
+static void
+free_harmless(struct harmless_s *h)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < h->hs_count; ++i) {
+        free(h->hs_msgs[i]);
+    }
+    free(h->hs_msgs);
+    h->hs_msgs = 0;
+    h->hs_count = 0;
+    h->hs_total = 0;
+}
+
+/*  Takes (and empties) the harmless error list of dbg.
+    The strings are copied, libdwarf reuses its copies. */
+static int
+take_harmless(Dwarf_Debug dbg,struct harmless_s *h)
+{
+    unsigned size = 0;
+    const char **list = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    h->hs_total = 0;
+    h->hs_count = 0;
+    h->hs_msgs = 0;
+    size = dwarf_set_harmless_error_list_size(dbg,0);
+    list = (const char **)calloc(size+2,sizeof(const char *));
+    if (!list) {
+        return DW_DLV_ERROR;
+    }
+    res = dwarf_get_harmless_error_list(dbg,size+2,list,
+        &h->hs_total);
+    if (res == DW_DLV_NO_ENTRY) {
+        free(list);
+        return DW_DLV_OK;
+    }
+    for (i = 0; list[i]; ++i) { }
+    h->hs_msgs = (char **)calloc(i+1,sizeof(char *));
+    if (!h->hs_msgs) {
+        free(list);
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; list[i]; ++i) {
+        h->hs_msgs[i] = strdup(list[i]);
+        if (!h->hs_msgs[i]) {
+            free(list);
+            free_harmless(h);
+            return DW_DLV_ERROR;
+        }
+        ++h->hs_count;
+    }
+    free(list);
+    return DW_DLV_OK;
+}
+
+/*  Appends h to the harmless error list of dbg, leaving
+    the list and the count as if the errors had been
+    reported there.  hs_count is less than hs_total only
+    when the list was full, so the messages pushed out
+    then are pushed out here too. */
+static void
+put_harmless(Dwarf_Debug dbg,struct harmless_s *h)
+{
+    unsigned i = 0;
+
+    for (i = h->hs_count; i < h->hs_total; ++i) {
+        dwarf_insert_harmless_error(dbg,
+            (char *)"(earlier harmless error)");
+    }
+    for (i = 0; i < h->hs_count; ++i) {
+        dwarf_insert_harmless_error(dbg,h->hs_msgs[i]);
+    }
+}
+
+static int
+save_harmless(Dwarf_Debug dbg,FILE *f)
+{
+    struct harmless_s h;
+    unsigned i = 0;
+    int res = 0;
+
+    res = take_harmless(dbg,&h);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dd_job_write(f,&h.hs_total,sizeof(h.hs_total));
+    if (res == DW_DLV_OK) {
+        res = dd_job_write(f,&h.hs_count,sizeof(h.hs_count));
+    }
+    for (i = 0; res == DW_DLV_OK && i < h.hs_count; ++i) {
+        res = dd_job_write_string(f,h.hs_msgs[i]);
+    }
+    free_harmless(&h);
+    return res;
+}
+
+static int
+merge_harmless(Dwarf_Debug dbg,FILE *f)
+{
+    struct harmless_s h;
+    unsigned count = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    memset(&h,0,sizeof(h));
+    res = dd_job_read(f,&h.hs_total,sizeof(h.hs_total));
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(f,&count,sizeof(count));
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    h.hs_msgs = (char **)calloc(count+1,sizeof(char *));
+    if (!h.hs_msgs) {
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < count; ++i) {
+        res = dd_job_read_string(f,&h.hs_msgs[i]);
+        if (res != DW_DLV_OK) {
+            free_harmless(&h);
+            return res;
+        }
+        ++h.hs_count;
+    }
+    put_harmless(dbg,&h);
+    free_harmless(&h);
+    return DW_DLV_OK;
+}
+
+struct job_s {
+    pid_t      jb_pid;
+    FILE      *jb_out;    /* What the worker printed */
+    FILE      *jb_msg;    /* --format-json messages */
+    FILE      *jb_state;  /* What the worker counted */
+    int        jb_complete;
+    long       jb_unmerged; /* See unmerged_change() */
+    Dwarf_Bool jb_cu_seen;
+    struct dd_job_once_s jb_once;
+};
+
+static void
+zero_job_counts(void)
+{
+    glflags.check_error = 0;
+    glflags.gf_count_major_errors = 0;
+    glflags.gf_count_macronotes = 0;
+    compiler_info_job_reset();
+    attr_form_job_reset();
+    macrocheck_job_reset();
+    attributes_encoding_job_reset();
+    tag_usage_job_reset();
+}
+
+static int
+save_job_state(Dwarf_Debug dbg,FILE *f,int complete,
+    long unmerged,Dwarf_Bool cu_seen)
+{
+    struct dd_job_once_s once;
+    int res = 0;
+
+    memset(&once,0,sizeof(once));
+    print_die_job_once_get(&once);
+    res = dd_job_write(f,&complete,sizeof(complete));
+    if (res == DW_DLV_OK) {
+        res = dd_job_write(f,&unmerged,sizeof(unmerged));
+    }
+    if (res == DW_DLV_OK) {
+        res = dd_job_write(f,&cu_seen,sizeof(cu_seen));
+    }
+    if (res == DW_DLV_OK) {
+        res = dd_job_write(f,&once,sizeof(once));
+    }
+    if (res == DW_DLV_OK) {
+        res = dd_job_write(f,&glflags.check_error,
+            sizeof(glflags.check_error));
+    }
+    if (res == DW_DLV_OK) {
+        res = dd_job_write(f,&glflags.gf_count_major_errors,
+            sizeof(glflags.gf_count_major_errors));
+    }
+    if (res == DW_DLV_OK) {
+        res = dd_job_write(f,&glflags.gf_count_macronotes,
+            sizeof(glflags.gf_count_macronotes));
+    }
+    if (res == DW_DLV_OK) {
+        res = save_job_fields(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = compiler_info_job_save(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = attr_form_job_save(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = macrocheck_job_save(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = attributes_encoding_job_save(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = tag_usage_job_save(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = save_harmless(dbg,f);
+    }
+    return res;
+}
+
+/*  The part save_job_state() wrote ahead of the counts. */
+static int
+read_job_header(struct job_s *j)
+{
+    int res = 0;
+
+    rewind(j->jb_state);
+    res = dd_job_read(j->jb_state,&j->jb_complete,
+        sizeof(j->jb_complete));
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(j->jb_state,&j->jb_unmerged,
+            sizeof(j->jb_unmerged));
+    }
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(j->jb_state,&j->jb_cu_seen,
+            sizeof(j->jb_cu_seen));
+    }
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(j->jb_state,&j->jb_once,
+            sizeof(j->jb_once));
+    }
+    return res;
+}
+
+static int
+merge_job_state(Dwarf_Debug dbg,FILE *f,Dwarf_Bool take_cu_state)
+{
+    int check_error = 0;
+    unsigned long major_errors = 0;
+    unsigned long macronotes = 0;
+    int res = 0;
+
+    res = dd_job_read(f,&check_error,sizeof(check_error));
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(f,&major_errors,sizeof(major_errors));
+    }
+    if (res == DW_DLV_OK) {
+        res = dd_job_read(f,&macronotes,sizeof(macronotes));
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    glflags.check_error += check_error;
+    glflags.gf_count_major_errors += major_errors;
+    glflags.gf_count_macronotes += macronotes;
+    res = merge_job_fields(f,take_cu_state);
+    if (res == DW_DLV_OK) {
+        res = compiler_info_job_merge(f,take_cu_state);
+    }
+    if (res == DW_DLV_OK) {
+        res = attr_form_job_merge(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = macrocheck_job_merge(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = attributes_encoding_job_merge(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = tag_usage_job_merge(f);
+    }
+    if (res == DW_DLV_OK) {
+        res = merge_harmless(dbg,f);
+    }
+    return res;
+}
+
+static void
+run_job(Dwarf_Debug dbg,int jobindex,int jobcount,
+    struct job_s *j)
+{
+    struct glflags_s before;
+    Dwarf_Bool cu_seen = FALSE;
+    int complete = FALSE;
+    long unmerged = -1;
+    int res = 0;
+
+    if (j->jb_msg) {
+        /*  Records and messages stay apart, as in
+            the parent. */
+        dd_json_set_output(j->jb_out);
+        if (dup2(fileno(j->jb_msg),fileno(stdout)) < 0) {
+            _exit(1);
+        }
+    } else if (dup2(fileno(j->jb_out),fileno(stdout)) < 0) {
+        _exit(1);
+    }
+    zero_job_counts();
+    memcpy(&before,&glflags,sizeof(before));
+    res = print_info_cu_range(dbg,jobindex,jobcount,&cu_seen);
+    complete = (res == DW_DLV_OK);
+    unmerged = unmerged_change(&before);
+    if (unmerged >= 0) {
+        complete = FALSE;
+    }
+    fflush(stdout);
+    fflush(j->jb_out);
+    res = save_job_state(dbg,j->jb_state,complete,unmerged,
+        cu_seen);
+    if (res != DW_DLV_OK || fflush(j->jb_state)) {
+        _exit(1);
+    }
+    /*  Nothing of this process is needed past here,
+        so skip atexit() and the destructors. */
+    _exit(0);
+}
+
+/*  In a serial run the CU headers would have been read
+    and the section loaded in this process.  Doing that
+    now keeps later sections from reading them again
+    (and reporting their harmless errors a second time). */
+static void
+read_all_cu_headers(Dwarf_Debug dbg)
+{
+    struct harmless_s h;
+    int res = 0;
+
+    res = take_harmless(dbg,&h);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Error err = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            0,0,0,0,0,0,0,0,0,0,&err);
+        if (res != DW_DLV_OK) {
+            DROP_ERROR_INSTANCE(dbg,res,err);
+            break;
+        }
+        dwarf_dealloc_die(cu_die);
+    }
+    /*  The workers already reported these. */
+    dwarf_get_harmless_error_list(dbg,0,0,0);
+    put_harmless(dbg,&h);
+    free_harmless(&h);
+}
+
+/*  A serial run does some checks only the first so
+    many times and prints some notes only once.
+    Workers past the first skip the checks (noting
+    they wanted them) and each prints the notes, so
+    the result is exact only if the first worker used
+    up the checks or nobody else wanted them, and at
+    most one worker printed a note. */
+static Dwarf_Bool
+once_state_exact(struct job_s *jobs,int jobcount,
+    struct dd_job_once_s *merged)
+{
+    int notes = 0;
+    int i = 0;
+
+    *merged = jobs[0].jb_once;
+    for (i = 0; i < jobcount; ++i) {
+        struct dd_job_once_s *o = &jobs[i].jb_once;
+
+        if (i && o->jo_limiter_wanted &&
+            jobs[0].jb_once.jo_check_limiter <=
+            ATTRLIST_SENSIBLE_LIMIT) {
+            return FALSE;
+        }
+        if (o->jo_showed_note) {
+            ++notes;
+            merged->jo_showed_note = TRUE;
+        }
+    }
+    return notes <= 1;
+}
+
+static Dwarf_Bool
+jobs_usable(Dwarf_Debug dbg)
+{
+    Dwarf_Debug tied = 0;
+
+    if (glflags.gf_do_print_dwarf ||
+        glflags.gf_print_unique_errors ||
+        glflags.gf_search_is_on ||
+        glflags.break_after_n_units != INT_MAX) {
+        return FALSE;
+    }
+    dwarf_get_tied_dbg(dbg,&tied,0);
+    if (tied) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static void
+copy_job_output(FILE *from,FILE *to)
+{
+    char buf[8192];
+    size_t len = 0;
+
+    rewind(from);
+    while ((len = fread(buf,1,sizeof(buf),from)) > 0) {
+        fwrite(buf,1,len,to);
+    }
+}
+
+static void
+close_jobs(struct job_s *jobs,int jobcount)
+{
+    int i = 0;
+
+    for (i = 0; i < jobcount; ++i) {
+        if (jobs[i].jb_out) {
+            fclose(jobs[i].jb_out);
+        }
+        if (jobs[i].jb_msg) {
+            fclose(jobs[i].jb_msg);
+        }
+        if (jobs[i].jb_state) {
+            fclose(jobs[i].jb_state);
+        }
+    }
+    free(jobs);
+}
+
+int
+print_infos_in_jobs(Dwarf_Debug dbg)
+{
+    int jobcount = glflags.gf_jobs;
+    struct job_s *jobs = 0;
+    struct dd_job_once_s once;
+    Dwarf_Bool ok = TRUE;
+    int last = 0;
+    int i = 0;
+
+    if (!jobs_usable(dbg)) {
+        return DW_DLV_NO_ENTRY;
+    }
+    jobs = (struct job_s *)calloc(jobcount,sizeof(struct job_s));
+    if (!jobs) {
+        return DW_DLV_NO_ENTRY;
+    }
+    for (i = 0; i < jobcount; ++i) {
+        jobs[i].jb_out = tmpfile();
+        jobs[i].jb_state = tmpfile();
+        if (!jobs[i].jb_out || !jobs[i].jb_state) {
+            close_jobs(jobs,jobcount);
+            return DW_DLV_NO_ENTRY;
+        }
+        if (glflags.gf_format_json) {
+            jobs[i].jb_msg = tmpfile();
+            if (!jobs[i].jb_msg) {
+                close_jobs(jobs,jobcount);
+                return DW_DLV_NO_ENTRY;
+            }
+        }
+    }
+    /*  Else the workers would print what is buffered too. */
+    fflush(stdout);
+    fflush(stderr);
+    fflush(dd_json_get_output());
+    for (i = 0; i < jobcount; ++i) {
+        pid_t pid = fork();
+
+        if (pid < 0) {
+            ok = FALSE;
+            break;
+        }
+        if (!pid) {
+            run_job(dbg,i,jobcount,&jobs[i]);
+        }
+        jobs[i].jb_pid = pid;
+    }
+    for (i = 0; i < jobcount; ++i) {
+        int status = 0;
+
+        if (!jobs[i].jb_pid) {
+            continue;
+        }
+        if (waitpid(jobs[i].jb_pid,&status,0) != jobs[i].jb_pid ||
+            !WIFEXITED(status) || WEXITSTATUS(status)) {
+            ok = FALSE;
+        }
+    }
+    for (i = 0; ok && i < jobcount; ++i) {
+        if (read_job_header(&jobs[i]) != DW_DLV_OK) {
+            ok = FALSE;
+        } else if (jobs[i].jb_unmerged >= 0) {
+            /*  A dwarfdump bug, not a problem with the
+                object.  The serial pass gives the right
+                results, this says --jobs could not. */
+            fprintf(stderr,"%s: --jobs worker changed glflags"
+                " byte %ld, which is not merged,"
+                " so checking serially\n",
+                glflags.program_name,jobs[i].jb_unmerged);
+            ok = FALSE;
+        } else if (!jobs[i].jb_complete) {
+            ok = FALSE;
+        } else if (jobs[i].jb_cu_seen) {
+            last = i;
+        }
+    }
+    if (ok && !once_state_exact(jobs,jobcount,&once)) {
+        ok = FALSE;
+    }
+    if (!ok) {
+        /*  Nothing of the workers' is used. */
+        close_jobs(jobs,jobcount);
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!jobs[last].jb_cu_seen) {
+        /*  No CUs. The last worker walked the section. */
+        last = jobcount-1;
+    }
+    for (i = 0; i < jobcount; ++i) {
+        if (jobs[i].jb_msg) {
+            copy_job_output(jobs[i].jb_out,dd_json_get_output());
+            copy_job_output(jobs[i].jb_msg,stdout);
+        } else {
+            copy_job_output(jobs[i].jb_out,stdout);
+        }
+    }
+    read_all_cu_headers(dbg);
+    print_die_job_once_set(&once);
+    for (i = 0; i < jobcount; ++i) {
+        int res = merge_job_state(dbg,jobs[i].jb_state,i == last);
+
+        if (res != DW_DLV_OK) {
+            printf("ERROR: Unable to merge the check results of"
+                " --jobs worker %d, the summary is incomplete\n",
+                i);
+            glflags.gf_count_major_errors++;
+        }
+    }
+    close_jobs(jobs,jobcount);
+    return DW_DLV_OK;
+}
+#else /* !DD_HAVE_FORK */
+int
+print_infos_in_jobs(Dwarf_Debug dbg)
+{
+    /*  No fork(), always check serially. */
+    (void)dbg;
+    return DW_DLV_NO_ENTRY;
+}
+#endif /* DD_HAVE_FORK */
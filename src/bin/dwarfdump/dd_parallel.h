@@ -0,0 +1,79 @@
+/*
+  Copyright 2026 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+*/
+
+#ifndef DD_PARALLEL_H
+#define DD_PARALLEL_H
+
+#include <stdio.h> /* FILE */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  --jobs=<n>: checking the .debug_info CUs in n worker
+    processes.  Returns DW_DLV_OK if the workers checked
+    every CU and their results are merged in, else
+    DW_DLV_NO_ENTRY and the caller checks serially. */
+int print_infos_in_jobs(Dwarf_Debug dbg);
+
+/*  In print_die.c.  Checks the CUs of one worker's slice. */
+int print_info_cu_range(Dwarf_Debug dbg,
+    int jobindex,int jobcount,
+    Dwarf_Bool *cu_seen);
+/*  The print_die.c checks done only the first so many
+    times in a run, see print_infos_in_jobs(). */
+#define ATTRLIST_SENSIBLE_LIMIT 1000
+struct dd_job_once_s {
+    int        jo_check_limiter;
+    Dwarf_Bool jo_limiter_wanted;
+    Dwarf_Bool jo_showed_note;
+};
+void print_die_job_once_get(struct dd_job_once_s *once);
+void print_die_job_once_set(struct dd_job_once_s *once);
+void attributes_encoding_job_reset(void);
+int  attributes_encoding_job_save(FILE *f);
+int  attributes_encoding_job_merge(FILE *f);
+
+/*  In print_tag_attributes_usage.c, the -ku tables. */
+void tag_usage_job_reset(void);
+int  tag_usage_job_save(FILE *f);
+int  tag_usage_job_merge(FILE *f);
+
+/*  Worker results are passed to the parent in a
+    temporary file written by the same binary,
+    so records are written as raw bytes.
+    These return DW_DLV_OK or DW_DLV_ERROR. */
+int dd_job_write(FILE *f,const void *p,size_t len);
+int dd_job_read(FILE *f,void *p,size_t len);
+int dd_job_write_string(FILE *f,const char *s);
+/*  Sets *s to a malloc()ed copy the caller frees. */
+int dd_job_read_string(FILE *f,char **s);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* DD_PARALLEL_H */
@@ -83,6 +83,7 @@ Portions Copyright 2012 SN Systems Ltd. All rights reserved.
 #include "dd_naming.h" /* for get_FORM_name() */
 #include "dd_command_options.h"
 #include "dd_compiler_info.h"
+#include "dd_json.h"
 #include "dd_safe_strcpy.h"
 #include "dd_minimal.h"
 #include "dd_mac_cputype.h"
@@ -376,9 +377,10 @@ main(int argc, char *argv[])
     }
 #endif /* HAVE_UTF8 */
     file_name = process_args(argc, argv);
-    /*  print_version_details already done in
-        dd_command_options.c */
-    print_args(argc,argv);
+    if (!glflags.gf_format_json) {
+        print_version_details(glflags.program_fullname);
+        print_args(argc,argv);
+    }
 
     /*  Redirect stdout  to an specific file */
     if (glflags.output_file) {
@@ -389,6 +391,20 @@ main(int argc, char *argv[])
             global_destructors();
             exit(EXIT_FAILURE);
         }
+    }
+    if (glflags.gf_format_json) {
+        /*  Every message and error goes to stderr,
+            only records to the output. */
+        if (dd_json_separate_output() != DW_DLV_OK) {
+            printf("ERROR dwarfdump: Unable to separate "
+                "--format-json records from messages\n");
+            global_destructors();
+            exit(EXIT_FAILURE);
+        }
+        print_version_details(glflags.program_fullname);
+        print_args(argc,argv);
+    }
+    if (glflags.output_file && !glflags.gf_format_json) {
         /* Record version and arguments in the output file */
         print_version_details(argv[0]);
         print_args(argc,argv);
@@ -747,6 +763,9 @@ dbgsetup(Dwarf_Debug dbg,struct dwconf_s *setup_config_file_data)
             (Dwarf_Small)setup_config_file_data->cf_address_size);
     }
     dwarf_set_harmless_error_list_size(dbg,50);
+    if (glflags.gf_load_mmap) {
+        dwarf_set_load_preference(dbg,Dwarf_Alloc_Mmap);
+    }
 }
 
 /*  Callable at any time, Sets section sizes with the sizes
@@ -1052,7 +1071,9 @@ process_one_file(
         DROP_ERROR_INSTANCE(dbg,dres,onef_err);
         return DW_DLV_NO_ENTRY;
     }
-    if (path_source == DW_PATHSOURCE_dsym) {
+    if (glflags.gf_format_json) {
+        /*  Every --format-json line is a record. */
+    } else if (path_source == DW_PATHSOURCE_dsym) {
         struct esb_s homifiedname;
 
         esb_constructor(&homifiedname);
@@ -1656,7 +1677,9 @@ process_one_file(
         DROP_ERROR_INSTANCE(dbg,dres,onef_err);
         dbg = 0;
     }
-    printf("\n");
+    if (!glflags.gf_format_json) {
+        printf("\n");
+    }
     destroy_attr_form_trees();
     destruct_abbrev_array();
     esb_close_null_device();
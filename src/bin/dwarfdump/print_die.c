@@ -58,6 +58,8 @@ Portions Copyright 2007-2021 David Anderson. All rights reserved.
 #include "dd_attr_form.h"
 #include "dd_regex.h"
 #include "dd_safe_strcpy.h"
+#include "dd_parallel.h"
+#include "dd_json.h"
 
 #define VSFBUFSZ 200
 #define DIE_STACK_SIZE 800  /* A hard limit. */
@@ -165,6 +167,31 @@ static int        die_stack_indent_level = 0;
 static Dwarf_Bool local_symbols_already_begun = FALSE;
 static const Dwarf_Sig8 zerosig;
 
+/*  Set while a --jobs worker checks its share of the
+    .debug_info CUs (see dd_parallel.c).  Worker job_index
+    of job_count gets an equal slice of the section:
+    CUs whose DIE offset is below job_cu_low belong
+    to an earlier worker and CUs at or past job_cu_high
+    to a later one. */
+static Dwarf_Bool     job_range_active = FALSE;
+static int            job_index = 0;
+static int            job_count = 0;
+static Dwarf_Bool     job_range_known = FALSE;
+static Dwarf_Unsigned job_cu_low = 0;
+static Dwarf_Unsigned job_cu_high = 0;
+static Dwarf_Bool     job_cu_seen = FALSE;
+static Dwarf_Bool     job_range_failed = FALSE;
+
+/*  Checks and notes done only the first so many
+    times in a run.  A --jobs worker past the first
+    cannot know how many times earlier workers did
+    them, so those workers start with the limit used up
+    and only note that they wanted more.
+    ATTRLIST_SENSIBLE_LIMIT is in dd_parallel.h. */
+static int            check_limiter = 0;
+static Dwarf_Bool     check_limiter_wanted = FALSE;
+static int            showedsizeoddness = 0;
+
 #if 0
 static void
 dump_bytes(const char *msg,Dwarf_Small * start, long len)
@@ -629,10 +656,69 @@ print_infos(Dwarf_Debug dbg,Dwarf_Bool is_info,
     Dwarf_Error *pi_err)
 {
     int nres = 0;
+
+    if (is_info && glflags.gf_jobs > 1) {
+        /*  DW_DLV_OK means worker processes checked
+            every CU, otherwise do it here. */
+        nres = print_infos_in_jobs(dbg);
+        if (nres == DW_DLV_OK) {
+            return DW_DLV_NO_ENTRY;
+        }
+    }
     nres = print_one_die_section(dbg,is_info,pi_err);
     return nres;
 }
 
+/*  For a --jobs worker: check the .debug_info CUs
+    in slice jobindex of jobcount, skipping
+    the others the way -u skips CUs.
+    Returns DW_DLV_OK if the slice was checked to its end,
+    DW_DLV_NO_ENTRY if something stopped the loop early
+    (the serial loop would have stopped too). */
+int
+print_info_cu_range(Dwarf_Debug dbg,
+    int jobindex,int jobcount,
+    Dwarf_Bool *cu_seen)
+{
+    int res = 0;
+    Dwarf_Error err = 0;
+
+    job_range_active = TRUE;
+    job_index = jobindex;
+    job_count = jobcount;
+    job_range_known = FALSE;
+    job_cu_seen = FALSE;
+    job_range_failed = FALSE;
+    if (jobindex) {
+        check_limiter = ATTRLIST_SENSIBLE_LIMIT+1;
+    }
+    check_limiter_wanted = FALSE;
+    showedsizeoddness = 0;
+    res = print_one_die_section(dbg,TRUE,&err);
+    DROP_ERROR_INSTANCE(dbg,res,err);
+    job_range_active = FALSE;
+    *cu_seen = job_cu_seen;
+    if (res != DW_DLV_NO_ENTRY || job_range_failed) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return DW_DLV_OK;
+}
+
+void
+print_die_job_once_get(struct dd_job_once_s *once)
+{
+    once->jo_check_limiter = check_limiter;
+    once->jo_limiter_wanted = check_limiter_wanted;
+    once->jo_showed_note = showedsizeoddness? TRUE:FALSE;
+}
+
+void
+print_die_job_once_set(struct dd_job_once_s *once)
+{
+    check_limiter = once->jo_check_limiter;
+    showedsizeoddness = once->jo_showed_note;
+}
+
 static void
 print_debug_fission_header(struct Dwarf_Debug_Fission_Per_CU_s *fsd)
 {
@@ -1176,6 +1262,27 @@ print_cu_header_data_or_signature(
     }
 }
 
+/*  The section is loaded (and decompressed) by now,
+    so its size is the size CU offsets are in. */
+static void
+set_job_cu_range(Dwarf_Debug dbg)
+{
+    Dwarf_Unsigned size = 0;
+    Dwarf_Unsigned slice = 0;
+
+    dwarf_get_section_max_offsets_d(dbg,&size,
+        0,0,0,0,0,0,0,0,0,
+        0,0,0,0,0,0,0,0,0,0);
+    slice = size/job_count;
+    job_cu_low = slice*job_index;
+    if (job_index+1 == job_count) {
+        job_cu_high = ~(Dwarf_Unsigned)0;
+    } else {
+        job_cu_high = slice*(job_index+1);
+    }
+    job_range_known = TRUE;
+}
+
 /*   */
 static int
 print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
@@ -1218,6 +1325,7 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
         Dwarf_Half cu_type = 0;
         Dwarf_Sig8 signature;
         int        offres = 0;
+        Dwarf_Bool skip_for_job = FALSE;
 
         signature = zerosig;
         /*  glflags.DIE_section_offset: in case
@@ -1225,6 +1333,12 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
             to corrupt dwarf. */
         glflags.DIE_section_offset = dieprint_cu_goffset;
         memset(&fission_data,0,sizeof(fission_data));
+        if (job_range_active && !job_cu_seen) {
+            /*  Harmless errors found reading CU headers
+                before the range belong to an earlier
+                worker. */
+            dwarf_get_harmless_error_list(dbg,0,0,0);
+        }
 #ifdef  ORIGINAL_HEADER_API
         /* a sample. Other places changed with no ifdef */
         nres = dwarf_next_cu_header_d(dbg,
@@ -1247,7 +1361,7 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
             &cu_type, pod_err);
 #endif /* ORIGINAL_HEADER_API */
 
-        if (!loop_count) {
+        if (!loop_count && (!job_range_active || !job_index)) {
             /*  So compress flags show, we waited till
                 section loaded to do this. */
             print_die_secname(dbg,is_info);
@@ -1268,7 +1382,9 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
             if (cu_count == 1) {
                 m="CU";
             }
-            printf("Break at %d %s\n",cu_count,m);
+            if (!glflags.gf_format_json) {
+                printf("Break at %d %s\n",cu_count,m);
+            }
             dwarf_dealloc_die(cu_die);
             cu_die = 0;
             break;
@@ -1282,6 +1398,25 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
         glflags.DIE_CU_overall_offset = glflags.DIE_section_offset;
         glflags.DIE_CU_offset = glflags.DIE_offset;
         dieprint_cu_goffset = glflags.DIE_section_offset;
+        if (job_range_active) {
+            if (!job_range_known) {
+                set_job_cu_range(dbg);
+            }
+            if (offres != DW_DLV_OK) {
+                /*  Cannot tell which worker owns this CU. */
+                job_range_failed = TRUE;
+                dwarf_dealloc_die(cu_die);
+                return DW_DLV_NO_ENTRY;
+            }
+            if (dieprint_cu_goffset >= job_cu_high) {
+                dwarf_dealloc_die(cu_die);
+                return DW_DLV_NO_ENTRY;
+            }
+            skip_for_job = dieprint_cu_goffset < job_cu_low;
+            if (!skip_for_job) {
+                job_cu_seen = TRUE;
+            }
+        }
 
         if (glflags.gf_cu_name_flag) {
             Dwarf_Bool should_skip = FALSE;
@@ -1299,7 +1434,7 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
         /*  Once the compiler table has been updated, see
             if we need to generate the list of CU compiled
             by all the producers contained in the elf file */
-        if (glflags.gf_producer_children_flag) {
+        if (glflags.gf_producer_children_flag && !skip_for_job) {
             int chres = 0;
             chres = fill_in_compiler_target(dbg,cu_die,
                 dieprint_cu_goffset,pod_err);
@@ -1332,6 +1467,15 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
         if (fission_data_result == DW_DLV_OK) {
             suppress_irrelevant_checking();
         }
+        if (skip_for_job) {
+            /*  Checked by an earlier worker. Getting here
+                kept the compiler and dwp state the
+                same as in a serial run. */
+            dwarf_dealloc_die(cu_die);
+            cu_die = 0;
+            ++cu_count;
+            continue;
+        }
         reset_error_reporting_globals();
 
         if ((glflags.gf_info_flag || glflags.gf_types_flag) &&
@@ -2205,6 +2349,249 @@ dealloc_local_atlist(Dwarf_Debug dbg,
     dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
 }
 
+/*  --format-json: the value of one attribute, taken
+    straight from the form.  Writes nothing unless
+    returning DW_DLV_OK, DW_DLV_NO_ENTRY means a form
+    with no JSON value here. */
+static int
+print_attr_value_json(Dwarf_Debug dbg,Dwarf_Attribute attrib,
+    Dwarf_Half theform,Dwarf_Error *err)
+{
+    int res = 0;
+
+    switch (theform) {
+    case DW_FORM_string:
+    case DW_FORM_strp:
+    case DW_FORM_line_strp:
+    case DW_FORM_strp_sup:
+    case DW_FORM_GNU_strp_alt:
+    case DW_FORM_strx:
+    case DW_FORM_strx1:
+    case DW_FORM_strx2:
+    case DW_FORM_strx3:
+    case DW_FORM_strx4:
+    case DW_FORM_GNU_str_index: {
+        char *str = 0;
+
+        res = dwarf_formstring(attrib,&str,err);
+        if (res == DW_DLV_OK) {
+            dd_json_string(str);
+        }
+        return res;
+    }
+    case DW_FORM_flag:
+    case DW_FORM_flag_present: {
+        Dwarf_Bool flag = FALSE;
+
+        res = dwarf_formflag(attrib,&flag,err);
+        if (res == DW_DLV_OK) {
+            dd_json_bool(flag);
+        }
+        return res;
+    }
+    case DW_FORM_addr:
+    case DW_FORM_addrx:
+    case DW_FORM_addrx1:
+    case DW_FORM_addrx2:
+    case DW_FORM_addrx3:
+    case DW_FORM_addrx4:
+    case DW_FORM_GNU_addr_index: {
+        Dwarf_Addr addr = 0;
+
+        res = dwarf_formaddr(attrib,&addr,err);
+        if (res == DW_DLV_OK) {
+            dd_json_unsigned(addr);
+        }
+        return res;
+    }
+    case DW_FORM_data1:
+    case DW_FORM_data2:
+    case DW_FORM_data4:
+    case DW_FORM_data8:
+    case DW_FORM_udata: {
+        Dwarf_Unsigned uval = 0;
+
+        res = dwarf_formudata(attrib,&uval,err);
+        if (res == DW_DLV_OK) {
+            dd_json_unsigned(uval);
+        }
+        return res;
+    }
+    case DW_FORM_sdata:
+    case DW_FORM_implicit_const: {
+        Dwarf_Signed sval = 0;
+
+        res = dwarf_formsdata(attrib,&sval,err);
+        if (res == DW_DLV_OK) {
+            dd_json_signed(sval);
+        }
+        return res;
+    }
+    case DW_FORM_data16: {
+        Dwarf_Form_Data16 data16;
+
+        memset(&data16,0,sizeof(data16));
+        res = dwarf_formdata16(attrib,&data16,err);
+        if (res == DW_DLV_OK) {
+            dd_json_bytes(data16.fd_data,sizeof(data16.fd_data));
+        }
+        return res;
+    }
+    /*  References are section offsets, as are
+        the offsets into other sections. */
+    case DW_FORM_ref1:
+    case DW_FORM_ref2:
+    case DW_FORM_ref4:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_udata:
+    case DW_FORM_ref_addr:
+    case DW_FORM_ref_sup4:
+    case DW_FORM_ref_sup8:
+    case DW_FORM_GNU_ref_alt:
+    case DW_FORM_sec_offset:
+    case DW_FORM_loclistx:
+    case DW_FORM_rnglistx: {
+        Dwarf_Off off = 0;
+        Dwarf_Bool is_info = TRUE;
+
+        res = dwarf_global_formref_b(attrib,&off,&is_info,err);
+        if (res == DW_DLV_OK) {
+            dd_json_unsigned(off);
+        }
+        return res;
+    }
+    case DW_FORM_ref_sig8: {
+        Dwarf_Sig8 sig8;
+
+        memset(&sig8,0,sizeof(sig8));
+        res = dwarf_formsig8(attrib,&sig8,err);
+        if (res == DW_DLV_OK) {
+            dd_json_bytes((unsigned char *)sig8.signature,
+                sizeof(sig8.signature));
+        }
+        return res;
+    }
+    case DW_FORM_block:
+    case DW_FORM_block1:
+    case DW_FORM_block2:
+    case DW_FORM_block4: {
+        Dwarf_Block *block = 0;
+
+        res = dwarf_formblock(attrib,&block,err);
+        if (res == DW_DLV_OK) {
+            dd_json_bytes(block->bl_data,block->bl_len);
+            dwarf_dealloc(dbg,block,DW_DLA_BLOCK);
+        }
+        return res;
+    }
+    case DW_FORM_exprloc: {
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr bytes = 0;
+
+        res = dwarf_formexprloc(attrib,&len,&bytes,err);
+        if (res == DW_DLV_OK) {
+            dd_json_bytes(bytes,len);
+        }
+        return res;
+    }
+    default:
+        break;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+/*  --format-json: one member of the "attrs" array,
+    {"at":name,"form":name,"value":value}.
+    Attribute errors become a null value, the
+    rest of the DIE is still written. */
+static void
+print_attribute_json(Dwarf_Debug dbg,Dwarf_Attribute attrib,
+    Dwarf_Half attrnum)
+{
+    Dwarf_Half theform = 0;
+    const char *name = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    dd_json_begin_object();
+    dd_json_key("at");
+    if (dwarf_get_AT_name(attrnum,&name) != DW_DLV_OK) {
+        name = 0;
+    }
+    dd_json_dwname(name,"AT",attrnum);
+    res = dwarf_whatform(attrib,&theform,&err);
+    if (res != DW_DLV_OK) {
+        DROP_ERROR_INSTANCE(dbg,res,err);
+        dd_json_key("form");
+        dd_json_null();
+        dd_json_key("value");
+        dd_json_null();
+        dd_json_end_object();
+        return;
+    }
+    dd_json_key("form");
+    if (dwarf_get_FORM_name(theform,&name) != DW_DLV_OK) {
+        name = 0;
+    }
+    dd_json_dwname(name,"FORM",theform);
+    dd_json_key("value");
+    res = print_attr_value_json(dbg,attrib,theform,&err);
+    if (res != DW_DLV_OK) {
+        DROP_ERROR_INSTANCE(dbg,res,err);
+        dd_json_null();
+    }
+    dd_json_end_object();
+}
+
+/*  --format-json: the record for one DIE.
+    {"kind":"die","section":...,"cu":...,"offset":...,
+    "depth":...,"tag":...,"abbrev":...,"attrs":[...]}
+    cu and offset are section offsets. */
+static void
+print_die_json(Dwarf_Debug dbg,Dwarf_Die die,Dwarf_Half tag,
+    Dwarf_Off cu_goffset,Dwarf_Off die_goffset,
+    int die_indent_level,Dwarf_Unsigned abbrev_code,
+    Dwarf_Attribute *atlist,Dwarf_Signed atcnt)
+{
+    const char *name = 0;
+    Dwarf_Signed i = 0;
+
+    dd_json_begin_record("die");
+    dd_json_key("section");
+    dd_json_string(dwarf_get_die_infotypes_flag(die)?
+        ".debug_info":".debug_types");
+    dd_json_key("cu");
+    dd_json_unsigned(cu_goffset);
+    dd_json_key("offset");
+    dd_json_unsigned(die_goffset);
+    dd_json_key("depth");
+    dd_json_unsigned((Dwarf_Unsigned)die_indent_level);
+    dd_json_key("tag");
+    if (dwarf_get_TAG_name(tag,&name) != DW_DLV_OK) {
+        name = 0;
+    }
+    dd_json_dwname(name,"TAG",tag);
+    dd_json_key("abbrev");
+    dd_json_unsigned(abbrev_code);
+    dd_json_key("attrs");
+    dd_json_begin_array();
+    for (i = 0; i < atcnt; i++) {
+        Dwarf_Half attrnum = 0;
+        Dwarf_Error err = 0;
+        int ares = 0;
+
+        ares = dwarf_whatattr(atlist[i],&attrnum,&err);
+        if (ares != DW_DLV_OK) {
+            /*  Reported by print_one_die(). */
+            DROP_ERROR_INSTANCE(dbg,ares,err);
+            break;
+        }
+        print_attribute_json(dbg,atlist[i],attrnum);
+    }
+    dd_json_end_array();
+    dd_json_end_record();
+}
+
 /* Print one die on error and verbose or non check mode */
 #define PRINTING_DIES (glflags.gf_do_print_dwarf || \
     (glflags.gf_record_dwarf_error && \
@@ -2288,12 +2675,12 @@ dd_check_attrlist_sensible(Dwarf_Debug dbg,
 {
     Dwarf_Signed i = 0;
     Dwarf_Error error = 0;
-    static int check_limiter;
 
     if (!glflags.gf_check_functions) {
         return;
     }
-    if (check_limiter > 1000) {
+    if (check_limiter > ATTRLIST_SENSIBLE_LIMIT) {
+        check_limiter_wanted = TRUE;
         return;
     }
     ++check_limiter;
@@ -2830,6 +3217,11 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
         return atres;
     }
 
+    if (glflags.gf_format_json) {
+        print_die_json(dbg,die,tag,dieprint_cu_goffset,
+            overall_offset,die_indent_level,abbrev_code,
+            atlist,atcnt);
+    }
     dd_check_die_functions(dbg,die);
     dd_check_attrlist_sensible(dbg,die,atlist,atcnt);
     for (i = 0; i < atcnt; i++) {
@@ -2855,7 +3247,9 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
                 print_indent_prefix(indentprespaces,
                     die_indent_level,2);
             }
-            {
+            /*  With --format-json the attributes were
+                written by print_die_json(). */
+            if (!glflags.gf_format_json) {
                 Dwarf_Bool attr_match_localb = FALSE;
                 int aresb = 0;
 
@@ -4513,7 +4907,6 @@ print_attribute(Dwarf_Debug dbg, Dwarf_Die die,
         will be allocated. */
     res = dwarf_get_die_address_size(die, &address_size_again,0);
     if (res == DW_DLV_OK) {
-        static int showedsizeoddness;
         if ( !showedsizeoddness &&
             address_size_again != address_size_base) {
             printf("NOTE: DIE context address size of %u"
@@ -7380,13 +7773,12 @@ static Dwarf_Bool attributes_encoding_do_init = TRUE;
     DW_FORM_data1, DW_FORM_data2, DW_FORM_data4 and
     DW_FORM_data are checked
 */
-static void
-check_attributes_encoding(Dwarf_Half attr,Dwarf_Half theform,
-    Dwarf_Unsigned value)
+/*  Create the table on first use.
+    Returns FALSE if calloc failed. */
+static Dwarf_Bool
+init_attributes_encoding(void)
 {
-
     if (attributes_encoding_do_init) {
-        /* Create table on first call */
         attributes_encoding_table = (a_attr_encoding *)calloc(
             DW_AT_lo_user,
             sizeof(a_attr_encoding));
@@ -7394,7 +7786,7 @@ check_attributes_encoding(Dwarf_Half attr,Dwarf_Half theform,
             printf("\nERROR: Unable the check attributes "
                 "encoding as calloc failed. Trying to continue\n");
             glflags.gf_count_major_errors++;
-            return;
+            return FALSE;
         }
         /* We use only 5 slots in the table, for quick access */
         /* index 0x0b */
@@ -7407,6 +7799,17 @@ check_attributes_encoding(Dwarf_Half attr,Dwarf_Half theform,
         attributes_encoding_factor[DW_FORM_data16] = 16;
         attributes_encoding_do_init = FALSE;
     }
+    return TRUE;
+}
+
+static void
+check_attributes_encoding(Dwarf_Half attr,Dwarf_Half theform,
+    Dwarf_Unsigned value)
+{
+
+    if (!init_attributes_encoding()) {
+        return;
+    }
 
     /* Regardless of the encoding form, count the checks. */
     DWARF_CHECK_COUNT(attr_encoding_result,1);
@@ -7479,6 +7882,64 @@ check_attributes_encoding(Dwarf_Half attr,Dwarf_Half theform,
     }
 }
 
+/*  For --jobs workers, see dd_parallel.c.
+    A worker starts from zero counts and
+    the parent adds each worker's counts. */
+void
+attributes_encoding_job_reset(void)
+{
+    if (attributes_encoding_table) {
+        memset(attributes_encoding_table,0,
+            DW_AT_lo_user*sizeof(a_attr_encoding));
+    }
+}
+
+int
+attributes_encoding_job_save(FILE *f)
+{
+    Dwarf_Bool present = attributes_encoding_table != 0;
+    int res = 0;
+
+    res = dd_job_write(f,&present,sizeof(present));
+    if (res != DW_DLV_OK || !present) {
+        return res;
+    }
+    return dd_job_write(f,attributes_encoding_table,
+        DW_AT_lo_user*sizeof(a_attr_encoding));
+}
+
+int
+attributes_encoding_job_merge(FILE *f)
+{
+    Dwarf_Bool present = FALSE;
+    a_attr_encoding *in = 0;
+    int res = 0;
+    int index = 0;
+
+    res = dd_job_read(f,&present,sizeof(present));
+    if (res != DW_DLV_OK || !present) {
+        return res;
+    }
+    in = (a_attr_encoding *)calloc(DW_AT_lo_user,
+        sizeof(a_attr_encoding));
+    if (!in) {
+        return DW_DLV_ERROR;
+    }
+    res = dd_job_read(f,in,DW_AT_lo_user*sizeof(a_attr_encoding));
+    if (res == DW_DLV_OK && init_attributes_encoding()) {
+        for (index = 0; index < DW_AT_lo_user; ++index) {
+            attributes_encoding_table[index].entries +=
+                in[index].entries;
+            attributes_encoding_table[index].formx +=
+                in[index].formx;
+            attributes_encoding_table[index].leb128 +=
+                in[index].leb128;
+        }
+    }
+    free(in);
+    return res;
+}
+
 /* Print a detailed encoding usage per attribute -kE */
 int
 print_attributes_encoding(Dwarf_Debug dbg,
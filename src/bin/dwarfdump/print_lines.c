@@ -42,6 +42,7 @@ Portions Copyright 2015-2015 Google, Inc. All Rights Reserved
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
 #include "dd_uri.h"
+#include "dd_json.h"
 
 #include "print_sections.h"
 
@@ -145,9 +146,100 @@ check_last_line_of_table(Dwarf_Addr   pc,
     }
 }
 
+/*  --format-json: the record for one line table row.
+    {"kind":"line","section":...,"cu":...,"row":...,
+    "address":...,"line":...,"column":...,"file":...,
+    and the row flags}.  Rows of a two-level table
+    have a "table" member and only the fields that
+    table has, with "logical" in place of "line" for
+    the actuals. */
+static void
+print_line_row_json(Dwarf_Debug dbg,Dwarf_Line line,
+    const char *sec_name,
+    Dwarf_Off cu_goffset,
+    Dwarf_Signed row,
+    Dwarf_Bool is_logicals_table,
+    Dwarf_Bool is_actuals_table,
+    Dwarf_Addr pc,
+    Dwarf_Unsigned lineno,
+    Dwarf_Unsigned column,
+    const char *filename,
+    Dwarf_Bool newstatement,
+    Dwarf_Bool new_basic_block,
+    Dwarf_Bool lineendsequence)
+{
+    Dwarf_Bool prologue_end = 0;
+    Dwarf_Bool epilogue_begin = 0;
+    Dwarf_Unsigned isa = 0;
+    Dwarf_Unsigned discriminator = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    dd_json_begin_record("line");
+    dd_json_key("section");
+    dd_json_string(sec_name);
+    dd_json_key("cu");
+    dd_json_unsigned(cu_goffset);
+    if (is_logicals_table) {
+        dd_json_key("table");
+        dd_json_string("logicals");
+    } else if (is_actuals_table) {
+        dd_json_key("table");
+        dd_json_string("actuals");
+    }
+    dd_json_key("row");
+    dd_json_unsigned((Dwarf_Unsigned)row);
+    dd_json_key("address");
+    dd_json_unsigned(pc);
+    if (is_actuals_table) {
+        dd_json_key("logical");
+        dd_json_unsigned(lineno);
+    } else {
+        dd_json_key("line");
+        dd_json_unsigned(lineno);
+        dd_json_key("column");
+        dd_json_unsigned(column);
+        dd_json_key("file");
+        if (filename) {
+            dd_json_string(filename);
+        } else {
+            dd_json_null();
+        }
+        dd_json_key("is_stmt");
+        dd_json_bool(newstatement);
+    }
+    if (!is_logicals_table) {
+        dd_json_key("basic_block");
+        dd_json_bool(new_basic_block);
+        dd_json_key("end_sequence");
+        dd_json_bool(lineendsequence);
+    }
+    res = dwarf_prologue_end_etc(line,
+        &prologue_end,&epilogue_begin,
+        &isa,&discriminator,&err);
+    if (res == DW_DLV_OK) {
+        if (!is_actuals_table) {
+            dd_json_key("prologue_end");
+            dd_json_bool(prologue_end);
+            dd_json_key("epilogue_begin");
+            dd_json_bool(epilogue_begin);
+            dd_json_key("discriminator");
+            dd_json_unsigned(discriminator);
+        }
+        if (!is_logicals_table) {
+            dd_json_key("isa");
+            dd_json_unsigned(isa);
+        }
+    } else {
+        DROP_ERROR_INSTANCE(dbg,res,err);
+    }
+    dd_json_end_record();
+}
+
 static int
 process_line_table(Dwarf_Debug dbg,
     const char *sec_name,
+    Dwarf_Off cu_goffset,
     Dwarf_Line *linebuf,
     Dwarf_Signed linecount,
     Dwarf_Bool is_logicals_table,
@@ -226,7 +318,7 @@ process_line_table(Dwarf_Debug dbg,
     }
     for (i = 0; i < linecount; i++) {
         Dwarf_Line line = linebuf[i];
-        char* lsrc_filename = 0;
+        const char *lsrc_filename = 0;
         int nsres = 0;
         Dwarf_Bool found_line_error = FALSE;
         Dwarf_Bool has_is_addr_set = FALSE;
@@ -253,19 +345,17 @@ process_line_table(Dwarf_Debug dbg,
             DWARF_CHECK_COUNT(lines_result,1);
         }
 
-        /*  NO. lsrc_filename is a DW_DLA_STRING, do not assign
-            a static string.
-            lsrc_filename = "<unknown>";
-        */
+        /*  lsrc_filename belongs to the line context,
+            it is not freed here. */
         if (!is_actuals_table) {
             Dwarf_Error aterr = 0;
 
-            sres = dwarf_linesrc(line, &lsrc_filename, &aterr);
+            sres = dwarf_line_srcpath(line, &lsrc_filename, &aterr);
             if (sres == DW_DLV_ERROR) {
                 /* Do not terminate processing  */
                 if (glflags.gf_do_check_dwarf &&
                     checking_this_compiler()) {
-                    where = "dwarf_linesrc()";
+                    where = "dwarf_line_srcpath()";
                     print_common_line_error(where,aterr);
                     found_line_error = TRUE;
                 }
@@ -435,8 +525,6 @@ process_line_table(Dwarf_Debug dbg,
             glflags.gf_record_dwarf_error = FALSE;
             /* Due to a fatal error, skip current record */
             if (found_line_error) {
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 continue;
             }
         }
@@ -475,8 +563,6 @@ process_line_table(Dwarf_Debug dbg,
                 simple_err_return_action(nsres,
                     esb_get_string(&m));
                 esb_destructor(&m);
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 return nsres;
             }
         }
@@ -500,8 +586,6 @@ process_line_table(Dwarf_Debug dbg,
                 simple_err_return_action(nsres,
                     esb_get_string(&m));
                 esb_destructor(&m);
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 return nsres;
             }
             nsres = dwarf_lineendsequence(line,
@@ -523,8 +607,6 @@ process_line_table(Dwarf_Debug dbg,
                 simple_err_return_action(nsres,
                     esb_get_string(&m));
                 esb_destructor(&m);
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 return nsres;
             }
         }
@@ -549,8 +631,6 @@ process_line_table(Dwarf_Debug dbg,
                 simple_err_return_action(nsres,
                     esb_get_string(&m));
                 esb_destructor(&m);
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 return disres;
             }
             if (prologue_end && !is_actuals_table) {
@@ -581,8 +661,6 @@ process_line_table(Dwarf_Debug dbg,
                         simple_err_return_action(nsres,
                         esb_get_string(&m));
                     esb_destructor(&m);
-                    dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                    lsrc_filename = 0;
                     return disres;
                 }
                 if (call_context) {
@@ -622,8 +700,6 @@ process_line_table(Dwarf_Debug dbg,
                     simple_err_return_action(nsres,
                         esb_get_string(&m));
                     esb_destructor(&m);
-                    dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                    lsrc_filename = 0;
                     return disres;
                 }
                 if (subprog_name && strlen(subprog_name)) {
@@ -636,7 +712,14 @@ process_line_table(Dwarf_Debug dbg,
             }
         }
 
-        if (!is_actuals_table) {
+        if (glflags.gf_format_json) {
+            print_line_row_json(dbg,line,sec_name,cu_goffset,i,
+                is_logicals_table,is_actuals_table,pc,
+                is_actuals_table?logicalno:lineno,column,
+                lsrc_filename,newstatement,new_basic_block,
+                lineendsequence);
+        }
+        if (!is_actuals_table && glflags.gf_do_print_dwarf) {
             if (i == 0  ||  glflags.verbose > 2 ||
                 strcmp(lsrc_filename?lsrc_filename:"",
                     esb_get_string(&lastsrc))) {
@@ -664,8 +747,6 @@ process_line_table(Dwarf_Debug dbg,
         if (glflags.gf_do_print_dwarf) {
             printf("\n");
         }
-        dwarf_dealloc(dbg,lsrc_filename, DW_DLA_STRING);
-        lsrc_filename = 0;
     }
     esb_destructor(&lastsrc);
     return DW_DLV_OK;
@@ -931,7 +1012,7 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
         printf("\n%s: line number info for a single cu\n",
             sanitized(esb_get_string(&truename)));
         esb_destructor(&truename);
-    } else {
+    } else if (!glflags.gf_format_json) {
         /* We are checking, not printing. */
         Dwarf_Half tag = 0;
         int tres = dwarf_tag(cu_die, &tag, err);
@@ -956,7 +1037,7 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
         }
     }
 
-    if (glflags.verbose > 1) {
+    if (glflags.verbose > 1 && !glflags.gf_format_json) {
         int errcount = 0;
         Dwarf_Bool attr_dup = FALSE;
         int lresv = 0;
@@ -1097,6 +1178,7 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
                 Dwarf_Bool is_actuals = FALSE;
 
                 ltres = process_line_table(dbg,sec_name,
+                    dieprint_cu_goffset,
                     linebuf, linecount,
                     is_logicals,is_actuals,err);
                 if (ltres == DW_DLV_ERROR) {
@@ -1109,6 +1191,7 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
                 Dwarf_Bool is_actuals = FALSE;
 
                 ltres = process_line_table(dbg,sec_name,
+                    dieprint_cu_goffset,
                     linebuf, linecount,
                     is_logicals, is_actuals,err);
                 if (ltres != DW_DLV_OK) {
@@ -1116,6 +1199,7 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
                     return ltres;
                 }
                 ltres = process_line_table(dbg,sec_name,
+                    dieprint_cu_goffset,
                     linebuf_actuals,
                     linecount_actuals,
                     !is_logicals, !is_actuals,err);
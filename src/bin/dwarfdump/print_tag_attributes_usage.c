@@ -34,6 +34,9 @@ Portions Copyright 2007-2021 David Anderson. All rights reserved.
 
 #include <config.h>
 
+#include <stdio.h>  /* FILE printf() */
+#include <string.h> /* memset() */
+
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "libdwarf_private.h"
@@ -47,6 +50,7 @@ Portions Copyright 2007-2021 David Anderson. All rights reserved.
 #include "dd_helpertree.h"
 #include "dd_tag_common.h"
 #include "dd_attr_form.h"
+#include "dd_parallel.h"
 
 static int pd_dwarf_names_print_on_error = 1;
 
@@ -312,3 +316,102 @@ print_tag_attributes_usage(void)
 #endif /* HAVE_USAGE_TAG_ATTR */
     return DW_DLV_OK;
 }
+
+/*  For --jobs workers (see dd_parallel.c).  The usage
+    tables are static arrays, identical in a worker and
+    the parent, so a worker saves just the counts in
+    table order and the parent adds them in. */
+#ifdef HAVE_USAGE_TAG_ATTR
+#define TAG_USAGE_ROWS(t) (sizeof(t)/sizeof(t[0]))
+
+static int
+tag_usage_job_counts(FILE *f,Dwarf_Bool save)
+{
+    unsigned int count = 0;
+    unsigned int tag = 0;
+    int res = DW_DLV_OK;
+
+    for (tag = 0; res == DW_DLV_OK &&
+        tag < TAG_USAGE_ROWS(tag_usage); ++tag) {
+        if (save) {
+            res = dd_job_write(f,&tag_usage[tag],sizeof(count));
+        } else {
+            res = dd_job_read(f,&count,sizeof(count));
+            tag_usage[tag] += count;
+        }
+    }
+    for (tag = 0; res == DW_DLV_OK &&
+        tag < TAG_USAGE_ROWS(usage_tag_attr); ++tag) {
+        Usage_Tag_Attr *ua = usage_tag_attr[tag];
+
+        for ( ; res == DW_DLV_OK && ua && ua->attr; ++ua) {
+            if (save) {
+                res = dd_job_write(f,&ua->count,sizeof(count));
+            } else {
+                res = dd_job_read(f,&count,sizeof(count));
+                ua->count += count;
+            }
+        }
+    }
+    for (tag = 0; res == DW_DLV_OK &&
+        tag < TAG_USAGE_ROWS(usage_tag_tree); ++tag) {
+        Usage_Tag_Tree *ut = usage_tag_tree[tag];
+
+        for ( ; res == DW_DLV_OK && ut && ut->tag; ++ut) {
+            if (save) {
+                res = dd_job_write(f,&ut->count,sizeof(count));
+            } else {
+                res = dd_job_read(f,&count,sizeof(count));
+                ut->count += count;
+            }
+        }
+    }
+    return res;
+}
+#endif /* HAVE_USAGE_TAG_ATTR */
+
+void
+tag_usage_job_reset(void)
+{
+#ifdef HAVE_USAGE_TAG_ATTR
+    unsigned int tag = 0;
+
+    memset(tag_usage,0,sizeof(tag_usage));
+    for (tag = 0; tag < TAG_USAGE_ROWS(usage_tag_attr); ++tag) {
+        Usage_Tag_Attr *ua = usage_tag_attr[tag];
+
+        for ( ; ua && ua->attr; ++ua) {
+            ua->count = 0;
+        }
+    }
+    for (tag = 0; tag < TAG_USAGE_ROWS(usage_tag_tree); ++tag) {
+        Usage_Tag_Tree *ut = usage_tag_tree[tag];
+
+        for ( ; ut && ut->tag; ++ut) {
+            ut->count = 0;
+        }
+    }
+#endif /* HAVE_USAGE_TAG_ATTR */
+}
+
+int
+tag_usage_job_save(FILE *f)
+{
+#ifdef HAVE_USAGE_TAG_ATTR
+    return tag_usage_job_counts(f,TRUE);
+#else /* !HAVE_USAGE_TAG_ATTR */
+    (void)f;
+    return DW_DLV_OK;
+#endif /* HAVE_USAGE_TAG_ATTR */
+}
+
+int
+tag_usage_job_merge(FILE *f)
+{
+#ifdef HAVE_USAGE_TAG_ATTR
+    return tag_usage_job_counts(f,FALSE);
+#else /* !HAVE_USAGE_TAG_ATTR */
+    (void)f;
+    return DW_DLV_OK;
+#endif /* HAVE_USAGE_TAG_ATTR */
+}
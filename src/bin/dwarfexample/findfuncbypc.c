@@ -14,12 +14,18 @@
     To use, try
         make
         ./findfuncbypc --pc=0x10000 ./findfuncbypc
+
+    With --useindex the search is done with
+    dwarf_addr_index_lookup() instead, and with
+    --indexfile=<path> the index is saved to and
+    reused from <path>.
 */
 
 #include <config.h>
 
-#include <stdio.h>  /* printf() */
-#include <stdlib.h> /* exit() */
+#include <stdio.h>  /* fclose() fopen() fread() fseek() ftell()
+    fwrite() printf() */
+#include <stdlib.h> /* exit() free() malloc() */
 #include <string.h> /* memset() strcmp() strlen() strncmp() */
 
 #include "dwarf.h"
@@ -109,6 +115,11 @@ printusage(void)
     printf(" --allinstances\n");
     printf("   reports but does does not stop processing\n");
     printf("   on finding pc address\n");
+    printf(" --useindex\n");
+    printf("   uses the libdwarf address index\n");
+    printf(" --indexfile=<path>\n");
+    printf("   with --useindex, reads the index from path if\n");
+    printf("   it fits the object, else builds and saves it\n");
     printf(" The argument following valid -- arguments must\n");
     printf("   be a valid object file path\n");
 }
@@ -140,6 +151,125 @@ startswithextractnum(const char *arg,
     return TRUE;
 }
 
+/*  Returns DW_DLV_OK if the saved index in path
+    was installed. */
+static int
+read_index_file(Dwarf_Debug dbg, const char *path)
+{
+    FILE *f = 0;
+    long len = 0;
+    Dwarf_Small *bytes = 0;
+    int res = DW_DLV_NO_ENTRY;
+    Dwarf_Error error = 0;
+
+    f = fopen(path,"rb");
+    if (!f) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!fseek(f,0,SEEK_END)) {
+        len = ftell(f);
+    }
+    if (len > 0 && !fseek(f,0,SEEK_SET)) {
+        bytes = (Dwarf_Small *)malloc((size_t)len);
+    }
+    if (bytes && fread(bytes,1,(size_t)len,f) == (size_t)len) {
+        res = dwarf_addr_index_from_bytes(dbg,bytes,
+            (Dwarf_Unsigned)len,&error);
+        if (res == DW_DLV_ERROR) {
+            printf("Ignoring index file %s: %s\n",path,
+                dwarf_errmsg(error));
+            dwarf_dealloc_error(dbg,error);
+        } else if (res == DW_DLV_NO_ENTRY) {
+            printf("Index file %s is for a different object, "
+                "rebuilding it\n",path);
+        }
+    }
+    free(bytes);
+    fclose(f);
+    return res;
+}
+
+static void
+write_index_file(Dwarf_Debug dbg, const char *path)
+{
+    FILE *f = 0;
+    Dwarf_Small *bytes = 0;
+    Dwarf_Unsigned len = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_addr_index_to_bytes(dbg,&bytes,&len,&error);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    f = fopen(path,"wb");
+    if (!f) {
+        printf("Unable to write index file %s\n",path);
+        dwarf_dealloc(dbg,bytes,DW_DLA_STRING);
+        return;
+    }
+    if (fwrite(bytes,1,(size_t)len,f) != (size_t)len) {
+        printf("Write of index file %s failed\n",path);
+    }
+    fclose(f);
+    dwarf_dealloc(dbg,bytes,DW_DLA_STRING);
+}
+
+static int
+look_up_with_index(Dwarf_Debug dbg, Dwarf_Unsigned pc,
+    const char *indexfile)
+{
+    Dwarf_Off cu_die_offset = 0;
+    Dwarf_Off subprogram_offset = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Die die = 0;
+    char *name = 0;
+    int res = 0;
+
+    if (indexfile && read_index_file(dbg,indexfile) !=
+        DW_DLV_OK) {
+        res = dwarf_addr_index_build(dbg,&error);
+        if (res == DW_DLV_OK) {
+            write_index_file(dbg,indexfile);
+        }
+    }
+    res = dwarf_addr_index_lookup(dbg,pc,&cu_die_offset,
+        &subprogram_offset,&error);
+    if (res == DW_DLV_ERROR) {
+        printf("Index lookup failed: %s\n",dwarf_errmsg(error));
+        dwarf_dealloc_error(dbg,error);
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        printf("pc 0x%" DW_PR_DUx " is in no CU\n",pc);
+        return res;
+    }
+    printf("pc 0x%" DW_PR_DUx " CU DIE offset 0x%" DW_PR_DUx
+        "\n",pc,cu_die_offset);
+    if (!subprogram_offset) {
+        printf("  no function contains the pc\n");
+        return DW_DLV_OK;
+    }
+    res = dwarf_offdie_b(dbg,subprogram_offset,TRUE,&die,&error);
+    if (res == DW_DLV_OK) {
+        if (dwarf_diename(die,&name,&error) == DW_DLV_OK) {
+            printf("  function %s DIE offset 0x%" DW_PR_DUx "\n",
+                name,subprogram_offset);
+        } else {
+            printf("  function DIE offset 0x%" DW_PR_DUx "\n",
+                subprogram_offset);
+        }
+        dwarf_dealloc_die(die);
+    }
+    if (error) {
+        dwarf_dealloc_error(dbg,error);
+    }
+    return DW_DLV_OK;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -154,6 +284,8 @@ main(int argc, char **argv)
     #define PATH_LEN 2000
     char real_path[PATH_LEN];
     struct target_data_s target_data;
+    int use_index = FALSE;
+    const char *indexfile = 0;
 
     real_path[0] = 0;
     memset(&target_data,0, sizeof(target_data));
@@ -166,6 +298,10 @@ main(int argc, char **argv)
             target_data.td_print_details = TRUE;
         } else if (!strcmp(argv[i],"--allinstances")){
             target_data.td_reportallfound = TRUE;
+        } else if (!strcmp(argv[i],"--useindex")){
+            use_index = TRUE;
+        } else if (!strncmp(argv[i],"--indexfile=",12)){
+            indexfile = argv[i]+12;
         } else if (!strcmp(argv[i],"-h")){
             printusage();
             exit(0);
@@ -204,6 +340,11 @@ main(int argc, char **argv)
         printf("Giving up, file %s not found\n",filepath);
         exit(EXIT_FAILURE);
     }
+    if (use_index) {
+        look_up_with_index(dbg,target_pc,indexfile);
+        res = dwarf_finish(dbg);
+        return 0;
+    }
     res = look_for_our_target(dbg,&target_data,&error);
     if (res == FOUND_SUBPROG) {
         /* OK */
@@ -0,0 +1,1130 @@
+/*
+Copyright (c) 2026, David Anderson
+All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/*  New October 2026.
+    An index from code address to the CU and the
+    subprogram containing that address.
+    It is built once per Dwarf_Debug (one walk of
+    every CU) so that each lookup is a binary search.
+    The index can be turned into bytes, to be saved
+    beside the object file, and later loaded back
+    instead of being rebuilt.  */
+
+#include <config.h>
+
+#include <stdlib.h> /* bsearch() calloc() free() malloc()
+    qsort() realloc() */
+#include <string.h> /* memcmp() memcpy() memset() */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+
+struct Dwarf_Addr_Index_Entry_s {
+    Dwarf_Addr ae_low;
+    /* One past the last address. */
+    Dwarf_Addr ae_high;
+    Dwarf_Off  ae_cu_die_offset;
+    Dwarf_Off  ae_die_offset;
+};
+
+/*  The entry ranges cut the address space at every
+    low and high into segments.  Each segment runs
+    from as_start to the next segment's as_start and
+    as_entry is the smallest entry containing it, or
+    at_count for none.  So a lookup is one binary
+    search however the ranges overlap, even when one
+    (bogus) range covers everything. */
+struct Dwarf_Addr_Segment_s {
+    Dwarf_Addr     as_start;
+    Dwarf_Unsigned as_entry;
+};
+
+struct Dwarf_Addr_Table_s {
+    struct Dwarf_Addr_Index_Entry_s *at_entries;
+    Dwarf_Unsigned at_count;
+    Dwarf_Unsigned at_allocated;
+    /* Built by table_finish() */
+    struct Dwarf_Addr_Segment_s *at_segments;
+    Dwarf_Unsigned at_segment_count;
+};
+
+struct Dwarf_Addr_Index_s {
+    /*  From .debug_aranges, or the CU DIE
+        where .debug_aranges has nothing for the CU. */
+    struct Dwarf_Addr_Table_s ax_cus;
+    struct Dwarf_Addr_Table_s ax_subprograms;
+};
+
+/*  Serialized form. Every number is 8 bytes,
+    little-endian.
+    magic, .debug_info size, identity length,
+    identity bytes (padded to a multiple of 8),
+    CU entry count, subprogram entry count,
+    then four numbers (low, high, CU DIE offset,
+    DIE offset) per entry. */
+#define AX_MAGIC     "DWADRIX1"
+#define AX_MAGIC_LEN 8
+#define AX_NUMSIZE   8
+#define AX_ENTRY_NUMS 4
+
+static void
+table_destruct(struct Dwarf_Addr_Table_s *t)
+{
+    free(t->at_entries);
+    t->at_entries = 0;
+    t->at_count = 0;
+    t->at_allocated = 0;
+    free(t->at_segments);
+    t->at_segments = 0;
+    t->at_segment_count = 0;
+}
+
+void
+_dwarf_addr_index_destruct(Dwarf_Debug dbg)
+{
+    struct Dwarf_Addr_Index_s *ax = dbg->de_addr_index;
+
+    if (!ax) {
+        return;
+    }
+    table_destruct(&ax->ax_cus);
+    table_destruct(&ax->ax_subprograms);
+    free(ax);
+    dbg->de_addr_index = 0;
+}
+
+static int
+table_add(struct Dwarf_Addr_Table_s *t,
+    Dwarf_Addr low, Dwarf_Addr high,
+    Dwarf_Off cu_die_offset, Dwarf_Off die_offset)
+{
+    struct Dwarf_Addr_Index_Entry_s *e = 0;
+
+    if (high <= low) {
+        /* Empty or nonsense, nothing to find. */
+        return DW_DLV_OK;
+    }
+    if (t->at_count == t->at_allocated) {
+        Dwarf_Unsigned newcount = t->at_allocated?
+            t->at_allocated*2:64;
+        struct Dwarf_Addr_Index_Entry_s *n = 0;
+
+        n = (struct Dwarf_Addr_Index_Entry_s *)realloc(
+            t->at_entries,newcount*sizeof(*n));
+        if (!n) {
+            return DW_DLV_ERROR;
+        }
+        t->at_entries = n;
+        t->at_allocated = newcount;
+    }
+    e = t->at_entries + t->at_count;
+    e->ae_low = low;
+    e->ae_high = high;
+    e->ae_cu_die_offset = cu_die_offset;
+    e->ae_die_offset = die_offset;
+    t->at_count++;
+    return DW_DLV_OK;
+}
+
+/*  By low address, and for equal low addresses
+    the larger range first, so an enclosing
+    range precedes what it encloses. */
+static int
+entry_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Addr_Index_Entry_s *le = l;
+    const struct Dwarf_Addr_Index_Entry_s *re = r;
+
+    if (le->ae_low < re->ae_low) {
+        return -1;
+    }
+    if (le->ae_low > re->ae_low) {
+        return 1;
+    }
+    if (le->ae_high > re->ae_high) {
+        return -1;
+    }
+    if (le->ae_high < re->ae_high) {
+        return 1;
+    }
+    if (le->ae_die_offset < re->ae_die_offset) {
+        return -1;
+    }
+    if (le->ae_die_offset > re->ae_die_offset) {
+        return 1;
+    }
+    return 0;
+}
+
+static int
+addr_compare(const void *l, const void *r)
+{
+    Dwarf_Addr la = *(const Dwarf_Addr *)l;
+    Dwarf_Addr ra = *(const Dwarf_Addr *)r;
+
+    if (la < ra) {
+        return -1;
+    }
+    if (la > ra) {
+        return 1;
+    }
+    return 0;
+}
+
+struct Dwarf_Addr_Size_s {
+    Dwarf_Addr     az_size;
+    Dwarf_Unsigned az_entry;
+};
+
+/*  Smallest first.  Of equal sizes the later entry
+    first, it is the one a lookup prefers. */
+static int
+size_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Addr_Size_s *lz = l;
+    const struct Dwarf_Addr_Size_s *rz = r;
+
+    if (lz->az_size < rz->az_size) {
+        return -1;
+    }
+    if (lz->az_size > rz->az_size) {
+        return 1;
+    }
+    if (lz->az_entry > rz->az_entry) {
+        return -1;
+    }
+    if (lz->az_entry < rz->az_entry) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  The index of the segment starting at addr,
+    which must be one of the segment starts. */
+static Dwarf_Unsigned
+segment_at(struct Dwarf_Addr_Table_s *t, Dwarf_Addr addr)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = t->at_segment_count;
+
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (t->at_segments[mid].as_start < addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/*  The first segment at or after k not yet given
+    an entry.  next[] links each given segment
+    towards the ones after it. */
+static Dwarf_Unsigned
+next_unowned(Dwarf_Unsigned *next, Dwarf_Unsigned k)
+{
+    while (next[k] != k) {
+        next[k] = next[next[k]];
+        k = next[k];
+    }
+    return k;
+}
+
+/*  Sorts the entries (the saved order need not be
+    trusted) and builds the segments.  Entries are
+    taken smallest first and each gives its entry
+    to the segments it covers that have none yet,
+    so every segment is given once. */
+static int
+table_finish(struct Dwarf_Addr_Table_s *t)
+{
+    struct Dwarf_Addr_Index_Entry_s *ents = t->at_entries;
+    struct Dwarf_Addr_Size_s *sizes = 0;
+    Dwarf_Addr *ends = 0;
+    Dwarf_Unsigned *next = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned segcount = 0;
+    Dwarf_Unsigned i = 0;
+
+    free(t->at_segments);
+    t->at_segments = 0;
+    t->at_segment_count = 0;
+    /*  Loaded entries can be empty. */
+    for (i = 0; i < t->at_count; ++i) {
+        if (ents[i].ae_low < ents[i].ae_high) {
+            ents[count++] = ents[i];
+        }
+    }
+    t->at_count = count;
+    if (!count) {
+        return DW_DLV_OK;
+    }
+    qsort(ents,(size_t)count,
+        sizeof(struct Dwarf_Addr_Index_Entry_s),entry_compare);
+    ends = (Dwarf_Addr *)malloc((size_t)(2*count)*
+        sizeof(Dwarf_Addr));
+    sizes = (struct Dwarf_Addr_Size_s *)malloc(
+        (size_t)count*sizeof(struct Dwarf_Addr_Size_s));
+    next = (Dwarf_Unsigned *)malloc((size_t)(2*count+1)*
+        sizeof(Dwarf_Unsigned));
+    t->at_segments = (struct Dwarf_Addr_Segment_s *)malloc(
+        (size_t)(2*count)*sizeof(struct Dwarf_Addr_Segment_s));
+    if (!ends || !sizes || !next || !t->at_segments) {
+        free(ends);
+        free(sizes);
+        free(next);
+        free(t->at_segments);
+        t->at_segments = 0;
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < count; ++i) {
+        ends[2*i] = ents[i].ae_low;
+        ends[2*i+1] = ents[i].ae_high;
+        sizes[i].az_size = ents[i].ae_high - ents[i].ae_low;
+        sizes[i].az_entry = i;
+    }
+    qsort(ends,(size_t)(2*count),sizeof(Dwarf_Addr),addr_compare);
+    for (i = 0; i < 2*count; ++i) {
+        if (!segcount ||
+            ends[i] != t->at_segments[segcount-1].as_start) {
+            t->at_segments[segcount].as_start = ends[i];
+            t->at_segments[segcount].as_entry = count;
+            ++segcount;
+        }
+    }
+    t->at_segment_count = segcount;
+    free(ends);
+    for (i = 0; i <= segcount; ++i) {
+        next[i] = i;
+    }
+    qsort(sizes,(size_t)count,sizeof(struct Dwarf_Addr_Size_s),
+        size_compare);
+    for (i = 0; i < count; ++i) {
+        Dwarf_Unsigned e = sizes[i].az_entry;
+        Dwarf_Unsigned k = segment_at(t,ents[e].ae_low);
+        Dwarf_Unsigned end = segment_at(t,ents[e].ae_high);
+
+        for (k = next_unowned(next,k); k < end;
+            k = next_unowned(next,k)) {
+            t->at_segments[k].as_entry = e;
+            next[k] = k+1;
+        }
+    }
+    free(sizes);
+    free(next);
+    return DW_DLV_OK;
+}
+
+/*  Finds the smallest range containing pc.  Of
+    equal sizes, the one that sorts last. */
+static struct Dwarf_Addr_Index_Entry_s *
+table_find(struct Dwarf_Addr_Table_s *t, Dwarf_Addr pc)
+{
+    struct Dwarf_Addr_Segment_s *segs = t->at_segments;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = t->at_segment_count;
+
+    /*  Find the count of segments starting at or
+        before pc */
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (segs[mid].as_start <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (!lo || segs[lo-1].as_entry == t->at_count) {
+        return 0;
+    }
+    return t->at_entries + segs[lo-1].as_entry;
+}
+
+static void
+drop_error(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    if (error && *error) {
+        dwarf_dealloc_error(dbg,*error);
+        *error = 0;
+    }
+}
+
+/*  DWARF2,3,4 .debug_ranges. Entries are relative
+    to the CU base address unless a base address
+    selection entry changes the base. */
+static int
+add_debug_ranges(Dwarf_Debug dbg, Dwarf_Die die,
+    Dwarf_Off rangesoffset,
+    struct Dwarf_Addr_Table_s *t,
+    Dwarf_Off cu_die_offset, Dwarf_Off die_offset,
+    Dwarf_Error *error)
+{
+    Dwarf_CU_Context context = die->di_cu_context;
+    Dwarf_Ranges *ranges = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Unsigned bytecount = 0;
+    Dwarf_Off realoffset = 0;
+    Dwarf_Addr base = 0;
+    int res = 0;
+
+    if (context->cc_low_pc_present) {
+        base = context->cc_low_pc;
+    }
+    res = dwarf_get_ranges_b(dbg,rangesoffset,die,
+        &realoffset,&ranges,&count,&bytecount,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Ranges *r = ranges+i;
+
+        if (r->dwr_type == DW_RANGES_END) {
+            break;
+        }
+        if (r->dwr_type == DW_RANGES_ADDRESS_SELECTION) {
+            base = r->dwr_addr2;
+            continue;
+        }
+        res = table_add(t,base + r->dwr_addr1,
+            base + r->dwr_addr2,cu_die_offset,die_offset);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc_ranges(dbg,ranges,count);
+            _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+    }
+    dwarf_dealloc_ranges(dbg,ranges,count);
+    return DW_DLV_OK;
+}
+
+/* DWARF5 .debug_rnglists. */
+static int
+add_rnglists(Dwarf_Debug dbg, Dwarf_Attribute attr,
+    Dwarf_Half form, Dwarf_Unsigned value,
+    struct Dwarf_Addr_Table_s *t,
+    Dwarf_Off cu_die_offset, Dwarf_Off die_offset,
+    Dwarf_Error *error)
+{
+    Dwarf_Rnglists_Head head = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned global_offset = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_rnglists_get_rle_head(attr,form,value,
+        &head,&count,&global_offset,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < count; ++i) {
+        unsigned int entrylen = 0;
+        unsigned int code = 0;
+        Dwarf_Unsigned raw1 = 0;
+        Dwarf_Unsigned raw2 = 0;
+        Dwarf_Bool addr_unavailable = FALSE;
+        Dwarf_Unsigned low = 0;
+        Dwarf_Unsigned high = 0;
+
+        res = dwarf_get_rnglists_entry_fields_a(head,i,
+            &entrylen,&code,&raw1,&raw2,&addr_unavailable,
+            &low,&high,error);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc_rnglists_head(head);
+            return res;
+        }
+        if (code == DW_RLE_end_of_list) {
+            break;
+        }
+        if (code == DW_RLE_base_addressx ||
+            code == DW_RLE_base_address ||
+            addr_unavailable) {
+            continue;
+        }
+        res = table_add(t,low,high,cu_die_offset,die_offset);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc_rnglists_head(head);
+            _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+    }
+    dwarf_dealloc_rnglists_head(head);
+    return DW_DLV_OK;
+}
+
+/*  Adds the code ranges of die, whether from
+    DW_AT_low_pc/DW_AT_high_pc or from DW_AT_ranges.
+    Returns DW_DLV_NO_ENTRY if the DIE has none. */
+static int
+add_die_ranges(Dwarf_Debug dbg, Dwarf_Die die,
+    struct Dwarf_Addr_Table_s *t,
+    Dwarf_Off cu_die_offset, Dwarf_Off die_offset,
+    Dwarf_Error *error)
+{
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    Dwarf_Half form = 0;
+    enum Dwarf_Form_Class formclass = DW_FORM_CLASS_UNKNOWN;
+    Dwarf_Attribute attr = 0;
+    Dwarf_Unsigned value = 0;
+    int res = 0;
+
+    res = dwarf_lowpc(die,&low,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_highpc_b(die,&high,&form,&formclass,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (formclass == DW_FORM_CLASS_CONSTANT) {
+            high += low;
+        }
+        res = table_add(t,low,high,cu_die_offset,die_offset);
+        if (res != DW_DLV_OK) {
+            _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        }
+        return res;
+    }
+    res = dwarf_attr(die,DW_AT_ranges,&attr,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_whatform(attr,&form,error);
+    if (res == DW_DLV_OK) {
+        if (form == DW_FORM_rnglistx) {
+            res = dwarf_formudata(attr,&value,error);
+        } else {
+            Dwarf_Off off = 0;
+
+            res = dwarf_global_formref(attr,&off,error);
+            value = off;
+        }
+    }
+    if (res == DW_DLV_OK) {
+        if (die->di_cu_context->cc_version_stamp >=
+            DW_CU_VERSION5) {
+            res = add_rnglists(dbg,attr,form,value,t,
+                cu_die_offset,die_offset,error);
+        } else {
+            res = add_debug_ranges(dbg,die,value,t,
+                cu_die_offset,die_offset,error);
+        }
+    }
+    dwarf_dealloc_attribute(attr);
+    return res;
+}
+
+/*  Records every DW_TAG_subprogram with code
+    in the tree below die. Subprograms nested in
+    subprograms are recorded too, a lookup picks
+    the innermost. */
+static int
+add_subprograms(Dwarf_Debug dbg, Dwarf_Die die,
+    struct Dwarf_Addr_Index_s *ax,
+    Dwarf_Off cu_die_offset, Dwarf_Error *error)
+{
+    Dwarf_Die cur = 0;
+    int res = 0;
+
+    res = dwarf_child(die,&cur,error);
+    if (res != DW_DLV_OK) {
+        return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+    }
+    for (;;) {
+        Dwarf_Die sib = 0;
+        Dwarf_Half tag = 0;
+
+        res = dwarf_tag(cur,&tag,error);
+        if (res == DW_DLV_OK && tag == DW_TAG_subprogram) {
+            Dwarf_Off offset = 0;
+
+            res = dwarf_dieoffset(cur,&offset,error);
+            if (res == DW_DLV_OK) {
+                res = add_die_ranges(dbg,cur,
+                    &ax->ax_subprograms,
+                    cu_die_offset,offset,error);
+                if (res == DW_DLV_ERROR &&
+                    dwarf_errno(*error) != DW_DLE_ALLOC_FAIL) {
+                    /*  An unreadable address attribute
+                        leaves this DIE out of the index
+                        but the rest is still useful. */
+                    drop_error(dbg,error);
+                    res = DW_DLV_OK;
+                }
+            }
+        }
+        if (res != DW_DLV_ERROR) {
+            res = add_subprograms(dbg,cur,ax,cu_die_offset,
+                error);
+        }
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_die(cur);
+            return res;
+        }
+        res = dwarf_siblingof_c(cur,&sib,error);
+        dwarf_dealloc_die(cur);
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        cur = sib;
+    }
+}
+
+static int
+offset_compare(const void *l, const void *r)
+{
+    const Dwarf_Off *lo = l;
+    const Dwarf_Off *ro = r;
+
+    if (*lo < *ro) {
+        return -1;
+    }
+    if (*lo > *ro) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  Fills ax_cus from .debug_aranges and returns
+    the sorted CU DIE offsets covered there.
+    An unusable .debug_aranges is treated as
+    absent: the CU DIEs are the fallback. */
+static int
+add_aranges(Dwarf_Debug dbg, struct Dwarf_Addr_Index_s *ax,
+    Dwarf_Off **covered_out, Dwarf_Unsigned *covered_count_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Arange *aranges = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Off *covered = 0;
+    Dwarf_Unsigned covered_count = 0;
+    int res = 0;
+
+    res = dwarf_get_aranges(dbg,&aranges,&count,error);
+    if (res == DW_DLV_ERROR) {
+        drop_error(dbg,error);
+        return DW_DLV_NO_ENTRY;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return res;
+    }
+    covered = (Dwarf_Off *)malloc(sizeof(Dwarf_Off)*
+        (count? count:1));
+    if (!covered) {
+        res = DW_DLV_ERROR;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Unsigned segment = 0;
+        Dwarf_Unsigned segment_entry_size = 0;
+        Dwarf_Addr start = 0;
+        Dwarf_Unsigned length = 0;
+        Dwarf_Off cu_die_offset = 0;
+
+        if (res == DW_DLV_OK) {
+            int ares = dwarf_get_arange_info_b(aranges[i],
+                &segment,&segment_entry_size,&start,&length,
+                &cu_die_offset,error);
+            if (ares == DW_DLV_ERROR) {
+                drop_error(dbg,error);
+            } else if (ares == DW_DLV_OK) {
+                covered[covered_count++] = cu_die_offset;
+                res = table_add(&ax->ax_cus,start,start+length,
+                    cu_die_offset,cu_die_offset);
+            }
+        }
+        dwarf_dealloc(dbg,aranges[i],DW_DLA_ARANGE);
+    }
+    dwarf_dealloc(dbg,aranges,DW_DLA_LIST);
+    if (res != DW_DLV_OK) {
+        free(covered);
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    qsort(covered,(size_t)covered_count,sizeof(Dwarf_Off),
+        offset_compare);
+    *covered_out = covered;
+    *covered_count_out = covered_count;
+    return DW_DLV_OK;
+}
+
+static int
+index_one_cu(Dwarf_Debug dbg, struct Dwarf_Addr_Index_s *ax,
+    Dwarf_Off cu_header_offset,
+    Dwarf_Off *covered, Dwarf_Unsigned covered_count,
+    Dwarf_Error *error)
+{
+    Dwarf_Off cu_die_offset = 0;
+    Dwarf_Die cu_die = 0;
+    Dwarf_Half unit_type = 0;
+    int res = 0;
+
+    res = dwarf_get_cu_die_offset_given_cu_header_offset_b(dbg,
+        cu_header_offset,TRUE,&cu_die_offset,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_offdie_b(dbg,cu_die_offset,TRUE,&cu_die,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    unit_type = cu_die->di_cu_context->cc_unit_type;
+    if (unit_type == DW_UT_type || unit_type == DW_UT_split_type) {
+        /* No code in a type unit. */
+        dwarf_dealloc_die(cu_die);
+        return DW_DLV_OK;
+    }
+    if (!covered_count || !bsearch(&cu_die_offset,covered,
+        (size_t)covered_count,sizeof(Dwarf_Off),offset_compare)) {
+        res = add_die_ranges(dbg,cu_die,&ax->ax_cus,
+            cu_die_offset,cu_die_offset,error);
+        if (res == DW_DLV_ERROR &&
+            dwarf_errno(*error) != DW_DLE_ALLOC_FAIL) {
+            drop_error(dbg,error);
+            res = DW_DLV_OK;
+        }
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_die(cu_die);
+            return res;
+        }
+    }
+    res = add_subprograms(dbg,cu_die,ax,cu_die_offset,error);
+    dwarf_dealloc_die(cu_die);
+    return res;
+}
+
+int
+dwarf_addr_index_build(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    struct Dwarf_Addr_Index_s *ax = 0;
+    Dwarf_Off *offsets = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Off *covered = 0;
+    Dwarf_Unsigned covered_count = 0;
+    Dwarf_Error localerr = 0;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_addr_index_build()");
+    if (dbg->de_addr_index) {
+        return DW_DLV_OK;
+    }
+    if (!error) {
+        /*  Unreadable DIE attributes are skipped, which
+            requires seeing the error. */
+        error = &localerr;
+    }
+    ax = (struct Dwarf_Addr_Index_s *)calloc(1,sizeof(*ax));
+    if (!ax) {
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    res = add_aranges(dbg,ax,&covered,&covered_count,error);
+    if (res == DW_DLV_ERROR) {
+        dbg->de_addr_index = ax;
+        _dwarf_addr_index_destruct(dbg);
+        drop_error(dbg,&localerr);
+        return res;
+    }
+    res = dwarf_get_cu_header_offsets(dbg,TRUE,&offsets,
+        &count,error);
+    if (res == DW_DLV_ERROR) {
+        free(covered);
+        dbg->de_addr_index = ax;
+        _dwarf_addr_index_destruct(dbg);
+        drop_error(dbg,&localerr);
+        return res;
+    }
+    for (i = 0; i < count; ++i) {
+        int arena_res = 0;
+
+        /*  Every DIE of a CU is dropped once the CU
+            is done, an arena makes that cheap. */
+        arena_res = dwarf_die_arena_begin(dbg,0);
+        res = index_one_cu(dbg,ax,offsets[i],covered,
+            covered_count,error);
+        if (arena_res == DW_DLV_OK) {
+            dwarf_die_arena_release(dbg);
+        }
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+    }
+    if (count) {
+        dwarf_dealloc(dbg,offsets,DW_DLA_UARRAY);
+    }
+    free(covered);
+    dbg->de_addr_index = ax;
+    if (res == DW_DLV_ERROR) {
+        _dwarf_addr_index_destruct(dbg);
+        drop_error(dbg,&localerr);
+        return res;
+    }
+    if (table_finish(&ax->ax_cus) != DW_DLV_OK ||
+        table_finish(&ax->ax_subprograms) != DW_DLV_OK) {
+        _dwarf_addr_index_destruct(dbg);
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_addr_index_lookup(Dwarf_Debug dbg,
+    Dwarf_Addr pc,
+    Dwarf_Off *cu_die_offset,
+    Dwarf_Off *subprogram_die_offset,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Addr_Index_Entry_s *e = 0;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_addr_index_lookup()");
+    if (!dbg->de_addr_index) {
+        res = dwarf_addr_index_build(dbg,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    e = table_find(&dbg->de_addr_index->ax_subprograms,pc);
+    if (e) {
+        if (cu_die_offset) {
+            *cu_die_offset = e->ae_cu_die_offset;
+        }
+        if (subprogram_die_offset) {
+            *subprogram_die_offset = e->ae_die_offset;
+        }
+        return DW_DLV_OK;
+    }
+    e = table_find(&dbg->de_addr_index->ax_cus,pc);
+    if (!e) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (cu_die_offset) {
+        *cu_die_offset = e->ae_cu_die_offset;
+    }
+    if (subprogram_die_offset) {
+        *subprogram_die_offset = 0;
+    }
+    return DW_DLV_OK;
+}
+
+/*  What ties saved index bytes to this object:
+    the build-id note when there is one, otherwise
+    a crc of .debug_info and .debug_abbrev. */
+static int
+get_identity(Dwarf_Debug dbg, Dwarf_Unsigned *info_size,
+    Dwarf_Small *ident, Dwarf_Unsigned *ident_len,
+    Dwarf_Unsigned ident_max, Dwarf_Error *error)
+{
+    struct Dwarf_Section_s *buildid = &dbg->de_note_gnu_buildid;
+    int res = 0;
+
+    res = _dwarf_load_debug_info(dbg,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *info_size = dbg->de_debug_info.dss_size;
+    if (buildid->dss_size && buildid->dss_size <= ident_max) {
+        res = _dwarf_load_section(dbg,buildid,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            memcpy(ident,buildid->dss_data,
+                (size_t)buildid->dss_size);
+            *ident_len = buildid->dss_size;
+            return DW_DLV_OK;
+        }
+    }
+    {
+        unsigned int crc = 0;
+        unsigned int i = 0;
+
+        crc = dwarf_basic_crc32(dbg->de_debug_info.dss_data,
+            (unsigned long)dbg->de_debug_info.dss_size,0);
+        crc = dwarf_basic_crc32(dbg->de_debug_abbrev.dss_data,
+            (unsigned long)dbg->de_debug_abbrev.dss_size,crc);
+        for (i = 0; i < 4; ++i) {
+            ident[i] = (Dwarf_Small)(crc >> (8*i));
+        }
+        *ident_len = 4;
+    }
+    return DW_DLV_OK;
+}
+
+#define AX_IDENT_MAX 256
+
+static Dwarf_Small *
+put_num(Dwarf_Small *p, Dwarf_Unsigned v)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < AX_NUMSIZE; ++i) {
+        p[i] = (Dwarf_Small)(v >> (8*i));
+    }
+    return p + AX_NUMSIZE;
+}
+
+static const Dwarf_Small *
+get_num(const Dwarf_Small *p, Dwarf_Unsigned *v)
+{
+    unsigned i = 0;
+    Dwarf_Unsigned val = 0;
+
+    for (i = 0; i < AX_NUMSIZE; ++i) {
+        val |= ((Dwarf_Unsigned)p[i]) << (8*i);
+    }
+    *v = val;
+    return p + AX_NUMSIZE;
+}
+
+static Dwarf_Unsigned
+ident_padded(Dwarf_Unsigned len)
+{
+    return (len + AX_NUMSIZE - 1)/AX_NUMSIZE*AX_NUMSIZE;
+}
+
+int
+dwarf_addr_index_to_bytes(Dwarf_Debug dbg,
+    Dwarf_Small **bytes_out,
+    Dwarf_Unsigned *length_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Addr_Index_s *ax = 0;
+    Dwarf_Small ident[AX_IDENT_MAX];
+    Dwarf_Unsigned ident_len = 0;
+    Dwarf_Unsigned info_size = 0;
+    Dwarf_Unsigned length = 0;
+    Dwarf_Small *bytes = 0;
+    Dwarf_Small *p = 0;
+    Dwarf_Unsigned i = 0;
+    int t = 0;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_addr_index_to_bytes()");
+    if (!bytes_out || !length_out) {
+        _dwarf_error(dbg,error,DW_DLE_INVALID_NULL_ARGUMENT);
+        return DW_DLV_ERROR;
+    }
+    res = dwarf_addr_index_build(dbg,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    ax = dbg->de_addr_index;
+    res = get_identity(dbg,&info_size,ident,&ident_len,
+        AX_IDENT_MAX,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    length = AX_MAGIC_LEN + 2*AX_NUMSIZE + ident_padded(ident_len) +
+        2*AX_NUMSIZE +
+        (ax->ax_cus.at_count + ax->ax_subprograms.at_count) *
+        AX_ENTRY_NUMS * AX_NUMSIZE;
+    bytes = (Dwarf_Small *)_dwarf_get_alloc(dbg,DW_DLA_STRING,
+        length);
+    if (!bytes) {
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    p = bytes;
+    memcpy(p,AX_MAGIC,AX_MAGIC_LEN);
+    p += AX_MAGIC_LEN;
+    p = put_num(p,info_size);
+    p = put_num(p,ident_len);
+    memcpy(p,ident,(size_t)ident_len);
+    p += ident_padded(ident_len);
+    p = put_num(p,ax->ax_cus.at_count);
+    p = put_num(p,ax->ax_subprograms.at_count);
+    for (t = 0; t < 2; ++t) {
+        struct Dwarf_Addr_Table_s *tab = t?
+            &ax->ax_subprograms:&ax->ax_cus;
+
+        for (i = 0; i < tab->at_count; ++i) {
+            struct Dwarf_Addr_Index_Entry_s *e =
+                tab->at_entries+i;
+
+            p = put_num(p,e->ae_low);
+            p = put_num(p,e->ae_high);
+            p = put_num(p,e->ae_cu_die_offset);
+            p = put_num(p,e->ae_die_offset);
+        }
+    }
+    *bytes_out = bytes;
+    *length_out = length;
+    return DW_DLV_OK;
+}
+
+static int
+read_table(const Dwarf_Small **pp, Dwarf_Unsigned count,
+    struct Dwarf_Addr_Table_s *t)
+{
+    const Dwarf_Small *p = *pp;
+    Dwarf_Unsigned i = 0;
+
+    if (!count) {
+        return DW_DLV_OK;
+    }
+    t->at_entries = (struct Dwarf_Addr_Index_Entry_s *)
+        malloc((size_t)count*sizeof(*t->at_entries));
+    if (!t->at_entries) {
+        return DW_DLV_ERROR;
+    }
+    t->at_allocated = count;
+    for (i = 0; i < count; ++i) {
+        struct Dwarf_Addr_Index_Entry_s *e = t->at_entries+i;
+
+        p = get_num(p,&e->ae_low);
+        p = get_num(p,&e->ae_high);
+        p = get_num(p,&e->ae_cu_die_offset);
+        p = get_num(p,&e->ae_die_offset);
+    }
+    t->at_count = count;
+    *pp = p;
+    return DW_DLV_OK;
+}
+
+static int
+index_bytes_error(Dwarf_Debug dbg, Dwarf_Error *error,
+    const char *msg)
+{
+    _dwarf_error_string(dbg,error,DW_DLE_ADDR_INDEX_BAD,
+        (char *)msg);
+    return DW_DLV_ERROR;
+}
+
+int
+dwarf_addr_index_from_bytes(Dwarf_Debug dbg,
+    const Dwarf_Small *bytes,
+    Dwarf_Unsigned length,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Addr_Index_s *ax = 0;
+    Dwarf_Small ident[AX_IDENT_MAX];
+    Dwarf_Unsigned ident_len = 0;
+    Dwarf_Unsigned info_size = 0;
+    Dwarf_Unsigned saved_info_size = 0;
+    Dwarf_Unsigned saved_ident_len = 0;
+    Dwarf_Unsigned cu_count = 0;
+    Dwarf_Unsigned sub_count = 0;
+    Dwarf_Unsigned remaining = 0;
+    const Dwarf_Small *p = bytes;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_addr_index_from_bytes()");
+    if (!bytes) {
+        _dwarf_error(dbg,error,DW_DLE_INVALID_NULL_ARGUMENT);
+        return DW_DLV_ERROR;
+    }
+    if (length < AX_MAGIC_LEN + 2*AX_NUMSIZE ||
+        memcmp(p,AX_MAGIC,AX_MAGIC_LEN)) {
+        return index_bytes_error(dbg,error,
+            "DW_DLE_ADDR_INDEX_BAD: not saved index bytes");
+    }
+    p += AX_MAGIC_LEN;
+    p = get_num(p,&saved_info_size);
+    p = get_num(p,&saved_ident_len);
+    remaining = length - AX_MAGIC_LEN - 2*AX_NUMSIZE;
+    if (saved_ident_len > AX_IDENT_MAX ||
+        remaining < ident_padded(saved_ident_len) + 2*AX_NUMSIZE) {
+        return index_bytes_error(dbg,error,
+            "DW_DLE_ADDR_INDEX_BAD: identity length is wrong");
+    }
+    res = get_identity(dbg,&info_size,ident,&ident_len,
+        AX_IDENT_MAX,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (info_size != saved_info_size ||
+        ident_len != saved_ident_len ||
+        memcmp(ident,p,(size_t)ident_len)) {
+        /*  Saved for some other object, or for an
+            earlier build of this one. */
+        return DW_DLV_NO_ENTRY;
+    }
+    p += ident_padded(saved_ident_len);
+    remaining -= ident_padded(saved_ident_len);
+    p = get_num(p,&cu_count);
+    p = get_num(p,&sub_count);
+    remaining -= 2*AX_NUMSIZE;
+    if (cu_count > remaining/(AX_ENTRY_NUMS*AX_NUMSIZE) ||
+        sub_count > remaining/(AX_ENTRY_NUMS*AX_NUMSIZE) ||
+        (cu_count + sub_count) * AX_ENTRY_NUMS*AX_NUMSIZE !=
+        remaining) {
+        return index_bytes_error(dbg,error,
+            "DW_DLE_ADDR_INDEX_BAD: entry counts do not match "
+            "the length");
+    }
+    ax = (struct Dwarf_Addr_Index_s *)calloc(1,sizeof(*ax));
+    if (!ax) {
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    if (read_table(&p,cu_count,&ax->ax_cus) != DW_DLV_OK ||
+        read_table(&p,sub_count,&ax->ax_subprograms) !=
+        DW_DLV_OK) {
+        table_destruct(&ax->ax_cus);
+        free(ax);
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    if (table_finish(&ax->ax_cus) != DW_DLV_OK ||
+        table_finish(&ax->ax_subprograms) != DW_DLV_OK) {
+        table_destruct(&ax->ax_cus);
+        table_destruct(&ax->ax_subprograms);
+        free(ax);
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    _dwarf_addr_index_destruct(dbg);
+    dbg->de_addr_index = ax;
+    return DW_DLV_OK;
+}
@@ -34,7 +34,7 @@
 #include <config.h>
 
 #include <stdio.h>  /* fclose() */
-#include <stdlib.h> /* malloc() free() */
+#include <stdlib.h> /* free() malloc() realloc() */
 #include <string.h> /* memset() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
@@ -45,6 +45,17 @@
 #include <stdint.h> /* uintptr_t */
 #endif /* HAVE_STDINT_H */
 
+#if defined(HAVE_PTHREAD_H)
+#include <pthread.h> /* pthread_mutex_lock()
+    pthread_mutex_unlock() */
+#elif defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif /* WIN32_LEAN_AND_MEAN */
+#include <windows.h> /* AcquireSRWLockExclusive()
+    ReleaseSRWLockExclusive() */
+#endif /* HAVE_PTHREAD_H */
+
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "libdwarf_private.h"
@@ -118,12 +129,15 @@ struct Dwarf_Error_s _dwarf_failsafe_error = {
     is used normally.  If zero then dwarf allocations
     are not tracked by libdwarf and dwarf_finish() cannot
     clean up any per-Dwarf_Debug allocations the
-    caller forgot to dealloc. */
+    caller forgot to dealloc.
+    Copied to de_alloc_tree_on when a Dwarf_Debug
+    is created. */
 static signed char global_de_alloc_tree_on = 1;
 
 /*  Defined March 7 2020. Allows a caller to
     avoid most tracking by the de_alloc_tree hash
     table if called with v of zero.
+    Applies to Dwarf_Debug created after the call.
     Returns the value the flag was before this call. */
 int dwarf_set_de_alloc_flag(int v)
 {
@@ -170,58 +184,133 @@ struct reserve_data_s {
 };
 #define DW_RESERVE sizeof(struct reserve_size_s)
 
+/*  New October 2026. The DIE arena.
+    While de_arena_on is set records are carved
+    from large chunks. Each record still has
+    the reserve prefix, with DW_ARENA_TYPE_FLAG
+    or-d into rd_type so dwarf_dealloc() knows
+    to leave it alone.
+    Only types with no specialconstructor or
+    specialdestructor may be put in the arena. */
+#define DW_ARENA_TYPE_FLAG  0x8000
+#define DW_ARENA_CHUNK_SIZE 65536
+#define DW_ARENA_ALIGN      16
+struct Dwarf_Arena_Chunk_s {
+    struct Dwarf_Arena_Chunk_s *ac_next;
+    Dwarf_Unsigned ac_size;
+    Dwarf_Unsigned ac_used;
+};
+#define DW_ARENA_HEADER ((sizeof(struct Dwarf_Arena_Chunk_s) + \
+    DW_ARENA_ALIGN - 1) / DW_ARENA_ALIGN * DW_ARENA_ALIGN)
+
 /*  In rare cases (bad object files) an error is created
     via malloc with no dbg to attach it to.
     We do not expect this except on corrupt objects.
 
-    In all cases the user is *supposed* to dealloc
-    the returned Dwarf_Error, and if it is in case
-    of a NULL Dwarf_Debug the code were will find it
-    in this special array and free and zero it.
-    Hence no leak.
+    Such an error belongs to the caller that got it,
+    and only dwarf_dealloc_error() (or dwarf_dealloc())
+    frees it.  This list only records which pointers
+    are such errors, so a dealloc with a NULL dbg can
+    check the pointer before freeing it.
+    dwarf_finish() never frees entries here: another
+    thread may still be using them.
 */
 
-#define STATIC_ALLOWED 10 /* arbitrary, must be > 2, see below*/
+#define STATIC_ERRLIST_INITIAL 10
+/*  Slots in use (some possibly zero), allocated,
+    and holding an error. */
 static unsigned static_used = 0;
+static unsigned static_allocated = 0;
+static unsigned static_count = 0;
 /*  entries in this list point to allocations of
     type DW_DLA_ERROR. */
-static Dwarf_Error staticerrlist[STATIC_ALLOWED];
-
-/*  Clean this out if found */
-static void
-dw_empty_errlist_item(Dwarf_Error e_in)
+static Dwarf_Error *staticerrlist = 0;
+
+/*  The list is shared by every thread (failed dwarf_init*()
+    calls and dwarf_dealloc_error() in different
+    threads all touch it) so all access is under this lock.
+    Without pthreads or Windows there is no lock
+    and so no thread safety guarantee. */
+#if defined(HAVE_PTHREAD_H)
+static pthread_mutex_t staticerrlist_mutex =
+    PTHREAD_MUTEX_INITIALIZER;
+#define STATICERRLIST_LOCK() \
+    pthread_mutex_lock(&staticerrlist_mutex)
+#define STATICERRLIST_UNLOCK() \
+    pthread_mutex_unlock(&staticerrlist_mutex)
+#elif defined(_WIN32)
+static SRWLOCK staticerrlist_srwlock = SRWLOCK_INIT;
+#define STATICERRLIST_LOCK() \
+    AcquireSRWLockExclusive(&staticerrlist_srwlock)
+#define STATICERRLIST_UNLOCK() \
+    ReleaseSRWLockExclusive(&staticerrlist_srwlock)
+#else /* !HAVE_PTHREAD_H && !_WIN32 */
+#define STATICERRLIST_LOCK()
+#define STATICERRLIST_UNLOCK()
+#endif /* HAVE_PTHREAD_H */
+
+/*  Removes e_in from the list, returning TRUE if
+    it was there.  Frees the list when it empties
+    so nothing is left at exit.
+    Caller holds the staticerrlist lock. */
+static Dwarf_Bool
+dw_take_errlist_item(void *e_in)
 {
     unsigned i = 0;
-    if (!e_in) {
-        return;
-    }
+
     for ( ; i <static_used; ++i) {
-        Dwarf_Error e = staticerrlist[i];
-        if (e != e_in) {
+        if ((void *)staticerrlist[i] != e_in) {
             continue;
         }
-        if (e->er_static_alloc == DE_MALLOC) {
-            /* e is the returned address, not
-                the base. Free by the base.  */
-            void *mallocaddr = 0;
-
-            if ( (uintptr_t)e > DW_RESERVE) {
-                mallocaddr = (char*)e - DW_RESERVE;
-            } else {
-                /*  Impossible */
-                continue;
-            }
-            _dwarf_error_destructor(e);
-            free(mallocaddr);
-        }
         staticerrlist[i] = 0;
+        --static_count;
+        if (!static_count) {
+            free(staticerrlist);
+            staticerrlist = 0;
+            static_used = 0;
+            static_allocated = 0;
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/*  dwarf_dealloc() with a NULL dbg.  Frees e_in
+    only if it is an error from this list. */
+static void
+dw_empty_errlist_item(void *e_in)
+{
+    Dwarf_Error e = (Dwarf_Error)e_in;
+    Dwarf_Bool found = FALSE;
+    void *mallocaddr = 0;
+
+    if (!e_in) {
+        return;
+    }
+    STATICERRLIST_LOCK();
+    found = dw_take_errlist_item(e_in);
+    STATICERRLIST_UNLOCK();
+    if (!found || e->er_static_alloc != DE_MALLOC) {
+        return;
+    }
+    /* e is the returned address, not
+        the base. Free by the base.  */
+    if ( (uintptr_t)e > DW_RESERVE) {
+        mallocaddr = (char*)e - DW_RESERVE;
+    } else {
+        /*  Impossible */
+        return;
     }
+    _dwarf_error_destructor(e);
+    free(mallocaddr);
 }
 
 /*  If the user calls dwarf_dealloc on an error
     out of a dwarf_init*() call, this will find
     it in the static err list. Here dbg is NULL
-    so not mentioned.  */
+    so not mentioned.
+    If the list cannot grow the error is not recorded,
+    and a dealloc with a NULL dbg leaves it alone. */
 void
 _dwarf_add_to_static_err_list(Dwarf_Error error)
 {
@@ -234,6 +323,7 @@ _dwarf_add_to_static_err_list(Dwarf_Error error)
         " 0x%lx\n",(unsigned long)(uintptr_t)error);
     fflush(stdout);
 #endif /* DEBUG_ALLOC */
+    STATICERRLIST_LOCK();
     for ( ; i <static_used; ++i) {
         Dwarf_Error e = staticerrlist[i];
         if (e) {
@@ -245,12 +335,30 @@ _dwarf_add_to_static_err_list(Dwarf_Error error)
         fflush(stdout);
 #endif /* DEBUG_ALLOC */
         staticerrlist[i] = error;
+        ++static_count;
+        STATICERRLIST_UNLOCK();
         return;
     }
-    if (static_used < STATIC_ALLOWED) {
-        staticerrlist[static_used] = error;
-        ++static_used;
+    if (static_used == static_allocated) {
+        unsigned newcount = static_allocated?
+            static_allocated*2:STATIC_ERRLIST_INITIAL;
+        Dwarf_Error *newlist = 0;
+
+        if (newcount > static_allocated) {
+            newlist = (Dwarf_Error *)realloc(staticerrlist,
+                newcount*sizeof(Dwarf_Error));
+        }
+        if (!newlist) {
+            STATICERRLIST_UNLOCK();
+            return;
+        }
+        staticerrlist = newlist;
+        static_allocated = newcount;
     }
+    staticerrlist[static_used] = error;
+    ++static_used;
+    ++static_count;
+    STATICERRLIST_UNLOCK();
 }
 /*  See libdwarf vulnerability DW202402-002
     for the motivation.
@@ -258,7 +366,6 @@ _dwarf_add_to_static_err_list(Dwarf_Error error)
 static void
 _dwarf_remove_from_staticerrlist(Dwarf_Ptr *space)
 {
-    unsigned i = 0;
     if (!space) {
         return;
     }
@@ -267,37 +374,9 @@ _dwarf_remove_from_staticerrlist(Dwarf_Ptr *space)
         " 0x%lx\n",(unsigned long)(uintptr_t)space);
     fflush(stdout);
 #endif /* DEBUG_ALLOC */
-    for ( ; i <static_used; ++i) {
-        Dwarf_Error e = staticerrlist[i];
-        if (!e) {
-            continue;
-        }
-        if ((void *)e == space) {
-#ifdef DEBUG_ALLOC
-            printf("libdwarfdetector rm from static err list at %u\n",
-            i);
-            fflush(stdout);
-#endif /* DEBUG_ALLOC */
-            staticerrlist[i] = 0;
-            return;
-        }
-    }
-}
-
-/*  This will free everything in the staticerrlist,
-    but that is ok */
-void
-_dwarf_free_static_errlist(void)
-{
-    unsigned i = 0;
-
-    for ( ; i <static_used; ++i) {
-        Dwarf_Error e = staticerrlist[i];
-        if (e) {
-            dw_empty_errlist_item(e);
-            staticerrlist[i] = 0;
-        }
-    }
+    STATICERRLIST_LOCK();
+    (void)dw_take_errlist_item(space);
+    STATICERRLIST_UNLOCK();
 }
 
 static const
@@ -498,7 +577,8 @@ struct ial_s alloc_instance_basics[ALLOC_AREA_INDEX_TABLE_MAX] = {
     /* 0x38 56.  New in July 2014. */
     /* DWARF5 DebugFission dwp file sections
         .debug_cu_index and .debug_tu_index . */
-    {sizeof(struct Dwarf_Xu_Index_Header_s),MULTIPLY_NO,  0, 0},
+    {sizeof(struct Dwarf_Xu_Index_Header_s),MULTIPLY_NO,  0,
+        _dwarf_xu_index_destructor},
 
     /*  These required by new features in DWARF5. Also usable
         for DWARF2,3,4. */
@@ -603,6 +683,110 @@ simple_compare_function(const void *l, const void *r)
     return 0;
 }
 
+/*  size includes DW_RESERVE. A record too large
+    to share a chunk sensibly gets a chunk of its
+    own, linked after the head so the head
+    keeps being filled. */
+static char *
+arena_alloc(Dwarf_Debug dbg, unsigned int type,
+    Dwarf_Unsigned size)
+{
+    struct Dwarf_Arena_Chunk_s *c = dbg->de_arena_chunks;
+    struct reserve_data_s *r = 0;
+    char *mem = 0;
+
+    size = (size + DW_ARENA_ALIGN - 1) /
+        DW_ARENA_ALIGN * DW_ARENA_ALIGN;
+    if (!c || (c->ac_size - c->ac_used) < size) {
+        Dwarf_Unsigned csize = DW_ARENA_CHUNK_SIZE;
+        struct Dwarf_Arena_Chunk_s *n = 0;
+
+        if (size > csize/4) {
+            csize = size;
+        }
+        n = (struct Dwarf_Arena_Chunk_s *)
+            malloc(DW_ARENA_HEADER + csize);
+        if (!n) {
+            return NULL;
+        }
+        n->ac_size = csize;
+        n->ac_used = 0;
+        if (c && csize == size) {
+            n->ac_next = c->ac_next;
+            c->ac_next = n;
+        } else {
+            n->ac_next = c;
+            dbg->de_arena_chunks = n;
+        }
+        c = n;
+    }
+    mem = (char *)c + DW_ARENA_HEADER + c->ac_used;
+    c->ac_used += size;
+    memset(mem, 0, size);
+    r = (struct reserve_data_s *)mem;
+    r->rd_dbg = dbg;
+    r->rd_type = (unsigned short)(type | DW_ARENA_TYPE_FLAG);
+    r->rd_length = (unsigned short)size;
+    return mem + DW_RESERVE;
+}
+
+/*  Frees every chunk except, if keep_one,
+    one ordinary-size chunk which is emptied
+    for reuse by the next arena. */
+static void
+arena_free_chunks(Dwarf_Debug dbg, int keep_one)
+{
+    struct Dwarf_Arena_Chunk_s *c = dbg->de_arena_chunks;
+    struct Dwarf_Arena_Chunk_s *kept = 0;
+
+    while (c) {
+        struct Dwarf_Arena_Chunk_s *next = c->ac_next;
+
+        if (keep_one && !kept &&
+            c->ac_size == DW_ARENA_CHUNK_SIZE) {
+            kept = c;
+            kept->ac_next = 0;
+            kept->ac_used = 0;
+        } else {
+            free(c);
+        }
+        c = next;
+    }
+    dbg->de_arena_chunks = kept;
+}
+
+int
+dwarf_die_arena_begin(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    CHECK_DBG(dbg,error,"dwarf_die_arena_begin()");
+    if (dbg->de_arena_on) {
+        /* No nesting. */
+        return DW_DLV_NO_ENTRY;
+    }
+    dbg->de_arena_on = TRUE;
+    return DW_DLV_OK;
+}
+
+void
+dwarf_die_arena_release(Dwarf_Debug dbg)
+{
+    if (IS_INVALID_DBG(dbg)) {
+        return;
+    }
+    arena_free_chunks(dbg,TRUE);
+    dbg->de_arena_on = FALSE;
+}
+
+char *
+_dwarf_get_attrlist_alloc(Dwarf_Debug dbg, Dwarf_Unsigned count)
+{
+    if (!IS_INVALID_DBG(dbg) && dbg->de_arena_on) {
+        return arena_alloc(dbg,DW_DLA_LIST,
+            count*sizeof(Dwarf_Ptr) + DW_RESERVE);
+    }
+    return _dwarf_get_alloc(dbg,DW_DLA_LIST,count);
+}
+
 /*  This function returns a pointer to a region
     of memory.  For alloc_types that are not
     strings or lists of pointers, only 1 struct
@@ -665,6 +849,10 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
             sizeof(Dwarf_Addr) : sizeof(Dwarf_Off));
     }
     size += DW_RESERVE;
+    if (dbg->de_arena_on &&
+        (type == DW_DLA_DIE || type == DW_DLA_ATTR)) {
+        return arena_alloc(dbg,type,size);
+    }
     alloc_mem = malloc(size);
     if (!alloc_mem) {
         return NULL;
@@ -698,7 +886,7 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
                 return NULL;
             }
         }
-        /*  See global flag.
+        /*  See global flag, copied to de_alloc_tree_on.
             If zero then caller chooses not
             to track allocations, so dwarf_finish()
             is unable to free anything the caller
@@ -707,7 +895,7 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
         /*  As of March 14, 2020 it's
             not necessary to test for alloc type, but instead
             only call tsearch if de_alloc_tree_on. */
-        if (global_de_alloc_tree_on) {
+        if (dbg->de_alloc_tree_on) {
             result = dwarf_tsearch((void *)key,
                 &dbg->de_alloc_tree,simple_compare_function);
             if (!result) {
@@ -920,6 +1108,11 @@ dwarf_dealloc(Dwarf_Debug dbg,
         return;
     }
     r =(struct reserve_data_s *)malloc_addr;
+    if (r->rd_type & DW_ARENA_TYPE_FLAG) {
+        /*  Freed with the rest of its arena by
+            dwarf_die_arena_release(). */
+        return;
+    }
     if (dbg && dbg != r->rd_dbg) {
         /*  Mixed up or originally a no_dbg alloc */
 #ifdef DEBUG_ALLOC
@@ -1052,8 +1245,10 @@ _dwarf_get_debug(Dwarf_Unsigned filesize)
     memset(dbg, 0, sizeof(struct Dwarf_Debug_s));
     /* Set up for a dwarf_tsearch hash table */
     dbg->de_magic = DBG_IS_VALID;
+    dbg->de_alloc_tree_on = (Dwarf_Small)(global_de_alloc_tree_on?
+        TRUE:FALSE);
 
-    if (global_de_alloc_tree_on) {
+    if (dbg->de_alloc_tree_on) {
         /*  The type of the dwarf_initialize_search_hash
             initial-size argument */
         unsigned long size_est = (unsigned long)(filesize/30);
@@ -1089,22 +1284,19 @@ freecontextlist(Dwarf_Debug dbg, Dwarf_Debug_InfoTypes dis)
     Dwarf_CU_Context nextcontext = 0;
     for (context = dis->de_cu_context_list;
         context; context = nextcontext) {
-        Dwarf_Hash_Table hash_table = 0;
-
-        hash_table = context->cc_abbrev_hash_table;
-
-        _dwarf_free_abbrev_hash_table_contents(hash_table,
-            FALSE);
-        hash_table->tb_entries = 0;
+        _dwarf_line_index_destruct(context);
         nextcontext = context->cc_next;
         context->cc_next = 0;
         /*  See also  local_dealloc_cu_context() in
             dwarf_die_deliv.c */
-        free(hash_table);
-        context->cc_abbrev_hash_table = 0;
+        _dwarf_free_cu_abbrev_hash_table(context);
         dwarf_dealloc(dbg, context, DW_DLA_CU_CONTEXT);
     }
     dis->de_cu_context_list = 0;
+    free(dis->de_cu_context_array);
+    dis->de_cu_context_array = 0;
+    dis->de_cu_context_array_count = 0;
+    dis->de_cu_context_array_size = 0;
 }
 
 /*
@@ -1122,7 +1314,6 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
     unsigned g = 0;
 
     if (IS_INVALID_DBG(dbg)) {
-        _dwarf_free_static_errlist();
         return DW_DLV_NO_ENTRY;
     }
     /*  To do complete validation that we have no surprising
@@ -1144,6 +1335,7 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
     }
     freecontextlist(dbg,&dbg->de_info_reading);
     freecontextlist(dbg,&dbg->de_types_reading);
+    _dwarf_free_shared_abbrev_hash_tables(dbg);
     /* Housecleaning done. Now really free all the space. */
     malloc_section_free(&dbg->de_debug_info);
     malloc_section_free(&dbg->de_debug_types);
@@ -1160,6 +1352,7 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
     malloc_section_free(&dbg->de_debug_sup);
     malloc_section_free(&dbg->de_debug_frame);
     malloc_section_free(&dbg->de_debug_frame_eh_gnu);
+    malloc_section_free(&dbg->de_eh_frame_hdr);
     malloc_section_free(&dbg->de_debug_pubtypes);
     malloc_section_free(&dbg->de_debug_funcnames);
     malloc_section_free(&dbg->de_debug_typenames);
@@ -1185,15 +1378,16 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
     }
 
     _dwarf_destroy_group_map(dbg);
+    _dwarf_addr_index_destruct(dbg);
+    arena_free_chunks(dbg,FALSE);
     /*  de_alloc_tree might be NULL if
-        global_de_alloc_tree_on is zero. */
+        de_alloc_tree_on is zero. */
     if (dbg->de_alloc_tree) {
         dbg->de_in_tdestroy = TRUE;
         dwarf_tdestroy(dbg->de_alloc_tree,tdestroy_free_node);
         dbg->de_in_tdestroy = FALSE;
         dbg->de_alloc_tree = 0;
     }
-    _dwarf_free_static_errlist();
     /*  first, walk the search and free()
         contents. */
     /*  Now  do the search tree itself */
@@ -1202,8 +1396,15 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
             _dwarf_tied_destroy_free_node);
         dbg->de_tied_data.td_tied_search = 0;
     }
+    if (dbg->de_type_sig_index) {
+        dwarf_tdestroy(dbg->de_type_sig_index,
+            _dwarf_tied_destroy_free_node);
+        dbg->de_type_sig_index = 0;
+    }
     free((void *)dbg->de_path);
     dbg->de_path = 0;
+    free(dbg->de_decompress_cache_dir);
+    dbg->de_decompress_cache_dir = 0;
     for (g = 0; g < dbg->de_gnu_global_path_count; ++g) {
         free((char *)dbg->de_gnu_global_paths[g]);
         dbg->de_gnu_global_paths[g] = 0;
@@ -1222,8 +1423,9 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
 
     Only applies to DW_DLA_ERROR, and  making up an error record.
 
-    dwarf_error.c calls this and it adds to the staticerrlist
-    all of which is freed by free_static_errlist();
+    dwarf_error.c calls this and it adds to the staticerrlist.
+    The caller owns the error and frees it with
+    dwarf_dealloc_error().
 */
 struct Dwarf_Error_s *
 _dwarf_special_no_dbg_error_malloc(void)
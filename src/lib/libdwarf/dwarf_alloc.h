@@ -36,6 +36,10 @@ extern "C" {
 /* #define DWARF_SIMPLE_MALLOC 1  */
 
 char * _dwarf_get_alloc(Dwarf_Debug, Dwarf_Small, Dwarf_Unsigned);
+/*  Like _dwarf_get_alloc(dbg,DW_DLA_LIST,count) but
+    uses the DIE arena when that is on. Only for
+    lists of Dwarf_Attribute. */
+char * _dwarf_get_attrlist_alloc(Dwarf_Debug, Dwarf_Unsigned);
 Dwarf_Debug _dwarf_get_debug(Dwarf_Unsigned filesize);
 int _dwarf_free_all_of_one_debug(Dwarf_Debug);
 struct Dwarf_Error_s * _dwarf_special_no_dbg_error_malloc(void);
@@ -48,8 +52,6 @@ void _dwarf_error_destructor(void *);
 #define ALLOC_AREA_INDEX_TABLE_MAX 66
 
 void _dwarf_add_to_static_err_list(Dwarf_Error err);
-void _dwarf_flush_static_error_list(void);
-void _dwarf_free_static_errlist(void);
 
 #ifdef __cplusplus
 }
@@ -40,6 +40,14 @@
 #include "dwarf_util.h"
 #include "dwarf_opaque.h"
 #include "dwarf_error.h"
+#include "dwarf_object_read_common.h"
+
+/*  Bytes read() per call when the file cannot be
+    mapped. Was 10000. */
+#define CRC_READ_SIZE  (1024*1024)
+/*  Bytes per mmap() window, a multiple of any
+    page size so every window offset is page aligned. */
+#define CRC_MAP_SIZE   (64*1024*1024)
 
 /*  Returns DW_DLV_OK DW_DLV_NO_ENTRY or DW_DLV_ERROR
     crc32 used for debuglink crc calculation.
@@ -71,14 +79,18 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
     Dwarf_Unsigned   fsize = 0;
     /*  Named with u to remind the reader that this is
         an unsigned value. */
-    Dwarf_Unsigned  readlenu = 10000;
-    Dwarf_Unsigned  size_left = 0;
-    const unsigned char *readbuf = 0;
+    Dwarf_Unsigned  readlenu = 0;
+    Dwarf_Unsigned  loc = 0;
+    unsigned char *readbuf = 0;
     unsigned int   tcrc = 0;
     unsigned int   init = 0;
     int            fd = -1;
     Dwarf_Unsigned   sz = 0;
     int            res = 0;
+    int            errc = 0;
+    /*  Mapping the file avoids copying it through
+        a buffer. If a mapping fails we read() the rest. */
+    Dwarf_Bool     try_mmap = TRUE;
 
     CHECK_DBG(dbg,error,"dwarf_crc32()");
     if (!crcbuf) {
@@ -91,7 +103,6 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
     if (fd < 0) {
         return DW_DLV_NO_ENTRY;
     }
-    fd = dbg->de_fd;
     if (dbg->de_filesize) {
         fsize = (size_t)dbg->de_filesize;
     } else {
@@ -109,41 +120,64 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
             A random length check. */
         return DW_DLV_NO_ENTRY;
     }
-    size_left = fsize;
-    res = _dwarf_seekr(fd,0,SEEK_SET,0);
-    if (res != DW_DLV_OK) {
-        _dwarf_error_string(dbg,error,DW_DLE_SEEK_ERROR,
-            "DW_DLE_SEEK_ERROR: dwarf_crc32 seek "
-            "to start fails");
-        return DW_DLV_ERROR;
-    }
-    readbuf = (unsigned char *)malloc(readlenu);
-    if (!readbuf) {
-        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
-            "DW_DLE_ALLOC_FAIL: dwarf_crc32 read buffer"
-            " alloc fails");
-        return DW_DLV_ERROR;
-    }
-    while (size_left > 0) {
+    while (loc < fsize) {
+        Dwarf_Unsigned size_left = fsize - loc;
+
+        if (try_mmap) {
+            char *map_base = 0;
+            Dwarf_Unsigned map_size = 0;
+            char *data = 0;
+
+            readlenu = CRC_MAP_SIZE;
+            if (size_left < readlenu) {
+                readlenu = size_left;
+            }
+            res = _dwarf_object_mmap_random(fd,loc,readlenu,
+                fsize,&map_base,&map_size,&data,&errc);
+            if (res == DW_DLV_OK) {
+                /*  Call the public API function
+                    so it gets tested too. */
+                tcrc = (unsigned int)dwarf_basic_crc32(
+                    (const unsigned char *)data,
+                    (unsigned long)readlenu,
+                    init);
+                _dwarf_object_munmap(map_base,map_size);
+                init = tcrc;
+                loc += readlenu;
+                continue;
+            }
+            try_mmap = FALSE;
+        }
+        if (!readbuf) {
+            readbuf = (unsigned char *)malloc(CRC_READ_SIZE);
+            if (!readbuf) {
+                _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                    "DW_DLE_ALLOC_FAIL: dwarf_crc32 read buffer"
+                    " alloc fails");
+                return DW_DLV_ERROR;
+            }
+        }
+        readlenu = CRC_READ_SIZE;
         if (size_left < readlenu) {
             readlenu = size_left;
         }
-        res = _dwarf_readr(fd,(char *)readbuf,readlenu,0);
+        res = _dwarf_object_read_random(fd,(char *)readbuf,
+            loc,readlenu,fsize,&errc);
         if (res != DW_DLV_OK) {
             _dwarf_error_string(dbg,error,DW_DLE_READ_ERROR,
                 "DW_DLE_READ_ERROR: dwarf_crc32 read fails ");
-            free((unsigned char*)readbuf);
+            free(readbuf);
             return DW_DLV_ERROR;
         }
         /*  Call the public API function so it gets tested too. */
         tcrc = (unsigned int)dwarf_basic_crc32(readbuf,
             (unsigned long)readlenu,
-            (unsigned long)init);
+            init);
         init = tcrc;
-        size_left -= readlenu;
+        loc += readlenu;
     }
     /*  endianness issues?  */
-    free((unsigned char*)readbuf);
+    free(readbuf);
     memcpy(crcbuf,(void *)&tcrc,4);
     return DW_DLV_OK;
 }
@@ -68,9 +68,7 @@ static char* joinstr  = "/";
 static char joincharw = '\\';
 /*  Large enough it is unlikely dwarfstring will ever
     do a malloc here, Windows paths usually < 256 characters. */
-#if defined (_WIN32)
-static char winbuf[256];
-#endif /* _WIN32 */
+#define WINBUFLEN 256
 
 static int
 is_full_path(char *path)
@@ -110,15 +108,6 @@ is_full_path(char *path)
     return FALSE;
 }
 
-static int
-_dwarf_extract_buildid(Dwarf_Debug dbg,
-    struct Dwarf_Section_s * pbuildid,
-    unsigned        *type_returned,
-    char           **owner_name_returned,
-    unsigned char  **build_id_returned,
-    unsigned        *build_id_length_returned,
-    Dwarf_Error *error);
-
 struct joins_s {
     dwarfstring js_dirname;
     dwarfstring js_basenamesimple;
@@ -242,6 +231,7 @@ _dwarf_pathjoinl(dwarfstring *target,dwarfstring * input)
         running non-Windows this won't happen
         but debuglink won't be useful anyway. */
     dwarfstring winput;
+    char winbuf[WINBUFLEN];
 
     dwarfstring_constructor_static(&winput,winbuf,sizeof(winbuf));
     transform_to_posix_slash(&winput,inputs);
@@ -813,7 +803,7 @@ struct buildid_s {
     char bu_owner[1];
 };
 
-static int
+int
 _dwarf_extract_buildid(Dwarf_Debug dbg,
     struct Dwarf_Section_s * pbuildid,
     unsigned       * type_returned,
@@ -39,6 +39,16 @@ extern "C" {
 
 int _dwarf_pathjoinl(dwarfstring *target,dwarfstring * input);
 
+/*  Returns pointers into the loaded
+    .note.gnu.build-id section. */
+int _dwarf_extract_buildid(Dwarf_Debug dbg,
+    struct Dwarf_Section_s * pbuildid,
+    unsigned        *type_returned,
+    char           **owner_name_returned,
+    unsigned char  **build_id_returned,
+    unsigned        *build_id_length_returned,
+    Dwarf_Error *error);
+
 int _dwarf_construct_linkedto_path(
     char         **global_prefixes_in,
     unsigned       length_global_prefixes_in,
@@ -31,7 +31,7 @@
 
 #include <stdlib.h> /* calloc() free() */
 #include <stdio.h>
-#include <string.h> /* memcpy */
+#include <string.h> /* memcpy() strcmp() */
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
 #endif /* HAVE_STDAFX_H */
@@ -1596,6 +1596,209 @@ dwarf_dnames_name(Dwarf_Dnames_Head dn,
     return DW_DLV_OK;
 }
 
+/*  The DWARF5 .debug_names hash (Section 6.1.1.4.5):
+    the DJB hash of the name with case folding.
+    We fold only ASCII A-Z, other bytes are
+    hashed as they are. */
+static Dwarf_Unsigned
+dnames_djb_hash(const char *name)
+{
+    Dwarf_Unsigned h = 5381;
+    const unsigned char *cp = (const unsigned char *)name;
+
+    for ( ; *cp; ++cp) {
+        unsigned c = *cp;
+
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        h = ((h << 5) + h + c) & 0xffffffff;
+    }
+    return h;
+}
+
+/*  Compare name with the string of name table
+    entry name_index (starting at one) without
+    reading anything else for that entry. */
+static int
+dnames_name_matches(Dwarf_Dnames_Head dn,
+    Dwarf_Unsigned name_index,
+    const char *name,
+    Dwarf_Bool *matches,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = dn->dn_dbg;
+    Dwarf_Unsigned debugstroffset = 0;
+    Dwarf_Small *secdataptr = 0;
+    Dwarf_Small *secend = 0;
+    Dwarf_Small *strpointer = 0;
+    int res = 0;
+
+    {
+        Dwarf_Small *ptr = dn->dn_string_offsets +
+            (name_index-1) * dn->dn_offset_size;
+        Dwarf_Small *endptr = dn->dn_entry_offsets;
+
+        READ_UNALIGNED_CK(dbg, debugstroffset, Dwarf_Unsigned,
+            ptr, dn->dn_offset_size,
+            error,endptr);
+    }
+    secdataptr = (Dwarf_Small *)dbg->de_debug_str.dss_data;
+    secend = secdataptr + dbg->de_debug_str.dss_size;
+    if (debugstroffset >= dbg->de_debug_str.dss_size) {
+        _dwarf_error_string(dbg,error,DW_DLE_DEBUG_NAMES_ERROR,
+            "DW_DLE_DEBUG_NAMES_ERROR: "
+            "a .debug_names string offset is outside "
+            ".debug_str");
+        return DW_DLV_ERROR;
+    }
+    strpointer = secdataptr + debugstroffset;
+    res = _dwarf_check_string_valid(dbg,
+        secdataptr,strpointer,secend,
+        DW_DLE_FORM_STRING_BAD_STRING,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *matches = !strcmp(name,(const char *)strpointer);
+    return DW_DLV_OK;
+}
+
+static int
+dnames_entry_offset(Dwarf_Dnames_Head dn,
+    Dwarf_Unsigned name_index,
+    Dwarf_Unsigned *entrypooloffset_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = dn->dn_dbg;
+    Dwarf_Unsigned entrypooloffset = 0;
+    Dwarf_Small *ptr = dn->dn_entry_offsets +
+        (name_index-1) * dn->dn_offset_size;
+    Dwarf_Small *endptr = dn->dn_abbrevs;
+
+    READ_UNALIGNED_CK(dbg, entrypooloffset, Dwarf_Unsigned,
+        ptr, dn->dn_offset_size,
+        error,endptr);
+    if (entrypooloffset >= dn->dn_entry_pool_size) {
+        _dwarf_error_string(dbg, error,DW_DLE_DEBUG_NAMES_ERROR,
+            "DW_DLE_DEBUG_NAMES_ERROR: "
+            "The entrypool offset read is larger than"
+            "the entrypool size");
+        return DW_DLV_ERROR;
+    }
+    *entrypooloffset_out = entrypooloffset;
+    return DW_DLV_OK;
+}
+
+/*  Find name in this name table using the hash
+    table: only the names in the one bucket
+    with a matching hash have their strings
+    compared.  Without a hash table (bucket count
+    zero is allowed) every name is compared.
+    Names are unique within a name table so
+    there is at most one match. */
+int
+dwarf_dnames_lookup(Dwarf_Dnames_Head dn,
+    const char        * name,
+    Dwarf_Unsigned    * name_index_out,
+    Dwarf_Unsigned    * offset_in_entrypool,
+    Dwarf_Error *       error)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Unsigned hash = 0;
+    Dwarf_Unsigned bucket = 0;
+    Dwarf_Unsigned name_index = 0;
+    Dwarf_Bool matches = FALSE;
+    int res = 0;
+
+    if (!dn || dn->dn_magic != DWARF_DNAMES_MAGIC) {
+        _dwarf_error_string(NULL, error,DW_DLE_DBG_NULL,
+            "DW_DLE_DBG_NULL: bad Head argument to "
+            "dwarf_dnames_lookup");
+        return DW_DLV_ERROR;
+    }
+    dbg = dn->dn_dbg;
+    if (!name) {
+        _dwarf_error_string(dbg, error,DW_DLE_DEBUG_NAMES_ERROR,
+            "DW_DLE_DEBUG_NAMES_ERROR: "
+            "a NULL name passed to dwarf_dnames_lookup");
+        return DW_DLV_ERROR;
+    }
+    if (!dn->dn_name_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!dn->dn_bucket_count) {
+        for (name_index = 1; name_index <= dn->dn_name_count;
+            ++name_index) {
+            res = dnames_name_matches(dn,name_index,name,
+                &matches,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (matches) {
+                break;
+            }
+        }
+        if (!matches) {
+            return DW_DLV_NO_ENTRY;
+        }
+    } else {
+        hash = dnames_djb_hash(name);
+        bucket = hash % dn->dn_bucket_count;
+        {
+            Dwarf_Small *ptr = dn->dn_buckets +
+                bucket*DWARF_32BIT_SIZE;
+            Dwarf_Small *endptr = dn->dn_hash_table;
+
+            READ_UNALIGNED_CK(dbg, name_index, Dwarf_Unsigned,
+                ptr, DWARF_32BIT_SIZE,
+                error,endptr);
+        }
+        if (!name_index) {
+            /* Empty bucket. */
+            return DW_DLV_NO_ENTRY;
+        }
+        /*  The names of a bucket are contiguous,
+            the first hash of another bucket ends it. */
+        for ( ; name_index <= dn->dn_name_count; ++name_index) {
+            Dwarf_Unsigned nhash = 0;
+
+            res = get_hash_value_number(dn,name_index,
+                &nhash,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (nhash % dn->dn_bucket_count != bucket) {
+                break;
+            }
+            if (nhash != hash) {
+                continue;
+            }
+            res = dnames_name_matches(dn,name_index,name,
+                &matches,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (matches) {
+                break;
+            }
+        }
+        if (!matches) {
+            return DW_DLV_NO_ENTRY;
+        }
+    }
+    if (offset_in_entrypool) {
+        res = dnames_entry_offset(dn,name_index,
+            offset_in_entrypool,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (name_index_out) {
+        *name_index_out = name_index;
+    }
+    return DW_DLV_OK;
+}
+
 /*  If abbrev_code returned is zero there is no tag returned
     and we are at the end of the entry pool set for this name
     entry.
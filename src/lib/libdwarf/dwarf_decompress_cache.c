@@ -0,0 +1,267 @@
+/*
+Copyright (c) 2026, David Anderson
+All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Reading and writing the decompressed section
+    cache files.  Other processes (and other users,
+    if the directory is shared) may be using the same
+    directory at the same time, so:
+    A file is written under a unique name created
+    with O_EXCL (mkstemp()) and then renamed, so no
+    reader sees a partly written file and no two
+    writers share a file.
+    A file is only trusted if its header matches
+    and the crc32 of its contents is right, so a
+    truncated or damaged file is just ignored.
+    Symbolic links are not followed when reading.  */
+
+#include <config.h>
+
+#include <stdlib.h> /* free() malloc() mkstemp() */
+#include <stdio.h>  /* remove() rename() */
+#include <string.h> /* memcmp() memcpy() strlen() */
+
+#ifdef _WIN32
+#ifdef HAVE_STDAFX_H
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+#include <io.h> /* _close() _mktemp_s() _open() _read()
+    _write() */
+#include <sys/stat.h> /* _S_IREAD _S_IWRITE */
+#elif defined HAVE_UNISTD_H
+#include <unistd.h> /* close() read() write() */
+#endif /* _WIN32 */
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h> /* open() O_NOFOLLOW O_RDONLY */
+#endif /* HAVE_FCNTL_H */
+
+#if !defined(_WIN32) && defined(HAVE_SYS_STAT_H)
+#include <sys/stat.h> /* fstat() S_ISREG() */
+#endif /* !_WIN32 && HAVE_SYS_STAT_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_decompress_cache.h"
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif /* O_BINARY */
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif /* O_CLOEXEC */
+#ifndef O_NOFOLLOW
+#define O_NOFOLLOW 0
+#endif /* O_NOFOLLOW */
+
+/*  The header: 8 bytes of magic, the section length
+    as 8 little-endian bytes, and the crc32
+    (dwarf_basic_crc32()) of the section bytes as 4
+    little-endian bytes.  Changing the layout means
+    changing the magic. */
+#define CACHE_MAGIC     "dwzcach1"
+#define CACHE_MAGIC_LEN 8
+#define CACHE_HDR_LEN   (CACHE_MAGIC_LEN + 8 + 4)
+
+/*  Limits each read(), write() and crc call. */
+#define CACHE_IO_CHUNK  0x10000000
+
+static unsigned int
+cache_crc(const Dwarf_Small *data, Dwarf_Unsigned len)
+{
+    unsigned int crc = 0;
+
+    while (len) {
+        Dwarf_Unsigned n = len > CACHE_IO_CHUNK?
+            CACHE_IO_CHUNK:len;
+
+        crc = dwarf_basic_crc32(data,(unsigned long)n,crc);
+        data += n;
+        len -= n;
+    }
+    return crc;
+}
+
+static void
+cache_header(Dwarf_Small *hdr, Dwarf_Unsigned len,
+    unsigned int crc)
+{
+    int i = 0;
+
+    memcpy(hdr,CACHE_MAGIC,CACHE_MAGIC_LEN);
+    for (i = 0; i < 8; ++i) {
+        hdr[CACHE_MAGIC_LEN+i] = (Dwarf_Small)(len >> (8*i));
+    }
+    for (i = 0; i < 4; ++i) {
+        hdr[CACHE_MAGIC_LEN+8+i] = (Dwarf_Small)(crc >> (8*i));
+    }
+}
+
+/*  TRUE if exactly len bytes were read. */
+static int
+cache_read(int fd, Dwarf_Small *buf, Dwarf_Unsigned len)
+{
+    while (len) {
+        Dwarf_Unsigned n = len > CACHE_IO_CHUNK?
+            CACHE_IO_CHUNK:len;
+        Dwarf_Signed got = 0;
+
+#ifdef _WIN32
+        got = (Dwarf_Signed)_read(fd,buf,(unsigned int)n);
+#else /* !_WIN32 */
+        got = (Dwarf_Signed)read(fd,buf,(size_t)n);
+#endif /* _WIN32 */
+        if (got <= 0) {
+            return FALSE;
+        }
+        buf += got;
+        len -= (Dwarf_Unsigned)got;
+    }
+    return TRUE;
+}
+
+static int
+cache_write(int fd, const Dwarf_Small *buf, Dwarf_Unsigned len)
+{
+    while (len) {
+        Dwarf_Unsigned n = len > CACHE_IO_CHUNK?
+            CACHE_IO_CHUNK:len;
+        Dwarf_Signed put = 0;
+
+#ifdef _WIN32
+        put = (Dwarf_Signed)_write(fd,buf,(unsigned int)n);
+#else /* !_WIN32 */
+        put = (Dwarf_Signed)write(fd,buf,(size_t)n);
+#endif /* _WIN32 */
+        if (put <= 0) {
+            return FALSE;
+        }
+        buf += put;
+        len -= (Dwarf_Unsigned)put;
+    }
+    return TRUE;
+}
+
+static void
+cache_close(int fd)
+{
+#ifdef _WIN32
+    _close(fd);
+#else /* !_WIN32 */
+    close(fd);
+#endif /* _WIN32 */
+}
+
+Dwarf_Small *
+_dwarf_read_decompress_cache(const char *path, Dwarf_Unsigned len)
+{
+    Dwarf_Small hdr[CACHE_HDR_LEN];
+    Dwarf_Small want[CACHE_HDR_LEN];
+    Dwarf_Small extra = 0;
+    Dwarf_Small *data = 0;
+    int fd = -1;
+    int ok = FALSE;
+
+#ifdef _WIN32
+    fd = _open(path,O_RDONLY|O_BINARY);
+#else /* !_WIN32 */
+    fd = open(path,O_RDONLY|O_BINARY|O_CLOEXEC|O_NOFOLLOW);
+#endif /* _WIN32 */
+    if (fd < 0) {
+        return 0;
+    }
+#if !defined(_WIN32) && defined(HAVE_SYS_STAT_H)
+    {
+        struct stat st;
+
+        if (fstat(fd,&st) || !S_ISREG(st.st_mode) ||
+            (Dwarf_Unsigned)st.st_size != CACHE_HDR_LEN + len) {
+            cache_close(fd);
+            return 0;
+        }
+    }
+#endif /* !_WIN32 && HAVE_SYS_STAT_H */
+    data = (Dwarf_Small *)malloc((size_t)(len?len:1));
+    if (data && cache_read(fd,hdr,CACHE_HDR_LEN) &&
+        cache_read(fd,data,len) &&
+        !cache_read(fd,&extra,1)) {
+        cache_header(want,len,cache_crc(data,len));
+        ok = !memcmp(hdr,want,CACHE_HDR_LEN);
+    }
+    cache_close(fd);
+    if (!ok) {
+        free(data);
+        return 0;
+    }
+    return data;
+}
+
+int
+_dwarf_write_decompress_cache(const char *path,
+    const Dwarf_Small *data, Dwarf_Unsigned len)
+{
+    Dwarf_Small hdr[CACHE_HDR_LEN];
+    size_t pathlen = strlen(path);
+    char *tmp = 0;
+    int fd = -1;
+    int ok = FALSE;
+
+    tmp = (char *)malloc(pathlen + 8);
+    if (!tmp) {
+        return DW_DLV_ERROR;
+    }
+    memcpy(tmp,path,pathlen);
+    memcpy(tmp+pathlen,".XXXXXX",8);
+#ifdef _WIN32
+    if (!_mktemp_s(tmp,pathlen+8)) {
+        fd = _open(tmp,_O_CREAT|_O_EXCL|_O_WRONLY|_O_BINARY,
+            _S_IREAD|_S_IWRITE);
+    }
+#else /* !_WIN32 */
+    fd = mkstemp(tmp);
+#endif /* _WIN32 */
+    if (fd < 0) {
+        free(tmp);
+        return DW_DLV_ERROR;
+    }
+    cache_header(hdr,len,cache_crc(data,len));
+    ok = cache_write(fd,hdr,CACHE_HDR_LEN) &&
+        cache_write(fd,data,len);
+    cache_close(fd);
+    if (!ok || rename(tmp,path)) {
+        remove(tmp);
+        ok = FALSE;
+    }
+    free(tmp);
+    return ok?DW_DLV_OK:DW_DLV_ERROR;
+}
@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2026, David Anderson
+All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DWARF_DECOMPRESS_CACHE_H
+#define DWARF_DECOMPRESS_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  The files of dwarf_set_decompress_cache_dir().
+    A cache file is a header (magic, section length
+    and crc32 of the section bytes, see
+    dwarf_decompress_cache.c) followed by the
+    decompressed section bytes.
+
+    Returns a malloc'd copy of the section bytes
+    if path is a regular file (on POSIX, not reached
+    through a symbolic link) holding a valid cache
+    of exactly len bytes, else NULL. */
+Dwarf_Small * _dwarf_read_decompress_cache(const char *path,
+    Dwarf_Unsigned len);
+
+/*  Writes a new file (created exclusively, so never
+    through a link or over another process's file)
+    and renames it to path.  Returns DW_DLV_OK or,
+    leaving nothing behind, DW_DLV_ERROR. */
+int _dwarf_write_decompress_cache(const char *path,
+    const Dwarf_Small *data, Dwarf_Unsigned len);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* DWARF_DECOMPRESS_CACHE_H */
@@ -31,8 +31,9 @@
 #include <config.h>
 #include <stdio.h> /* debugging */
 
-#include <string.h> /* memcmp() memcpy() memset() strcmp() strlen() */
-#include <stdlib.h> /* calloc() free() */
+#include <string.h> /* memcmp() memcpy() memmove() memset() strcmp()
+    strlen() */
+#include <stdlib.h> /* calloc() free() realloc() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
@@ -104,6 +105,43 @@ dwarf_get_die_infotypes_flag(Dwarf_Die die)
     return die->di_is_info;
 }
 
+/*  The number of contexts in de_cu_context_array
+    with cc_debug_offset not above offset. */
+static Dwarf_Unsigned
+cu_context_array_position(Dwarf_Debug_InfoTypes dis,
+    Dwarf_Off offset)
+{
+    Dwarf_Unsigned low = 0;
+    Dwarf_Unsigned high = dis->de_cu_context_array_count;
+
+    while (low < high) {
+        Dwarf_Unsigned mid = low + (high - low)/2;
+
+        if (dis->de_cu_context_array[mid]->cc_debug_offset <=
+            offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/*  The context in de_cu_context_array with the
+    greatest cc_debug_offset not above offset, or NULL.
+    It need not contain offset. */
+static Dwarf_CU_Context
+last_cu_context_at_or_before(Dwarf_Debug_InfoTypes dis,
+    Dwarf_Off offset)
+{
+    Dwarf_Unsigned pos = cu_context_array_position(dis,offset);
+
+    if (!pos) {
+        return NULL;
+    }
+    return dis->de_cu_context_array[pos-1];
+}
+
 /*
     For a given Dwarf_Debug dbg, this function checks
     if a CU that includes the given offset has been read
@@ -112,7 +150,9 @@ dwarf_get_die_infotypes_flag(Dwarf_Die die)
     internal routine, it is assumed that a valid dbg
     is passed.
 
-    **This is a sequential search.  May be too slow.
+    The de_cu_context hint is checked first
+    (sequential reading mostly hits it), otherwise
+    this is a binary search of de_cu_context_array.
 
     If debug_info and debug_abbrev not loaded, this will
     wind up returning NULL. So no need to load before calling
@@ -135,28 +175,18 @@ _dwarf_find_CU_Context(Dwarf_Debug dbg,
         dis->de_cu_context->cc_next->cc_debug_offset == offset) {
         return dis->de_cu_context->cc_next;
     }
-    if (dis->de_cu_context != NULL &&
-        dis->de_cu_context->cc_debug_offset <= offset) {
-        for (cu_context = dis->de_cu_context;
-            cu_context != NULL;
-            cu_context = cu_context->cc_next) {
-            if (offset >= cu_context->cc_debug_offset &&
-                offset < cu_context->cc_debug_offset +
-                cu_context->cc_length + cu_context->cc_length_size
-                + cu_context->cc_extension_size) {
-                return cu_context;
-            }
-        }
+    cu_context = dis->de_cu_context;
+    if (cu_context != NULL &&
+        offset >= cu_context->cc_debug_offset &&
+        offset < _dwarf_calculate_next_cu_context_offset(
+            cu_context)) {
+        return cu_context;
     }
-    for (cu_context = dis->de_cu_context_list;
-        cu_context != NULL;
-        cu_context = cu_context->cc_next) {
-        if (offset >= cu_context->cc_debug_offset &&
-            offset < cu_context->cc_debug_offset +
-            cu_context->cc_length + cu_context->cc_length_size
-            + cu_context->cc_extension_size) {
-            return cu_context;
-        }
+    cu_context = last_cu_context_at_or_before(dis,offset);
+    if (cu_context &&
+        offset < _dwarf_calculate_next_cu_context_offset(
+        cu_context)) {
+        return cu_context;
     }
     return NULL;
 }
@@ -650,19 +680,11 @@ static void
 local_dealloc_cu_context(Dwarf_Debug dbg,
     Dwarf_CU_Context context)
 {
-    Dwarf_Hash_Table hash_table = 0;
-
     if (!context) {
         return;
     }
-    hash_table = context->cc_abbrev_hash_table;
-    if (hash_table) {
-        _dwarf_free_abbrev_hash_table_contents(hash_table,
-            FALSE);
-        hash_table->tb_entries = 0;
-        free(hash_table);
-        context->cc_abbrev_hash_table = 0;
-    }
+    _dwarf_line_index_destruct(context);
+    _dwarf_free_cu_abbrev_hash_table(context);
     dwarf_dealloc(dbg, context, DW_DLA_CU_CONTEXT);
 }
 
@@ -950,8 +972,12 @@ _dwarf_make_CU_Context(Dwarf_Debug dbg,
     cu_context->cc_debug_offset = offset;
 
     /*  This is recording an overall section value for later
-        sanity checking. */
-    dis->de_last_offset = max_cu_global_offset;
+        sanity checking.  Contexts need not be made in
+        section order (see _dwarf_cu_context_at_header_offset())
+        so never lower it. */
+    if (max_cu_global_offset > dis->de_last_offset) {
+        dis->de_last_offset = max_cu_global_offset;
+    }
     *context_out  = cu_context;
     return DW_DLV_OK;
 }
@@ -1065,6 +1091,128 @@ dwarf_next_cu_header_e(Dwarf_Debug dbg,
     return res;
 }
 
+/*  Reads just the unit_length of the unit at offset
+    and returns the offset of the following unit.
+    Returns DW_DLV_NO_ENTRY for a zero unit_length,
+    which ends the list just as it ends
+    dwarf_next_cu_header_e(). */
+static int
+next_unit_offset(Dwarf_Debug dbg,
+    Dwarf_Unsigned offset,
+    Dwarf_Small   *section_data,
+    Dwarf_Unsigned section_size,
+    Dwarf_Unsigned *next_offset_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Byte_Ptr  ptr = section_data + offset;
+    Dwarf_Byte_Ptr  section_end = section_data + section_size;
+    Dwarf_Unsigned  length = 0;
+    Dwarf_Unsigned  length_size = 0;
+    Dwarf_Unsigned  extension_size = 0;
+    Dwarf_Unsigned  remaining = section_size - offset;
+
+    READ_AREA_LENGTH_CK(dbg, length, Dwarf_Unsigned,
+        ptr, length_size, extension_size,
+        error,section_size,section_end);
+    if (!length) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (length > remaining ||
+        (length + length_size + extension_size) > remaining) {
+        _dwarf_error(dbg, error, DW_DLE_CU_LENGTH_ERROR);
+        return DW_DLV_ERROR;
+    }
+    *next_offset_out = offset + length + length_size +
+        extension_size;
+    return DW_DLV_OK;
+}
+
+/*  New October 2026.
+    Walks only the unit_length fields, so
+    no CU context is created and the sequential
+    dwarf_next_cu_header_e() position is untouched.
+    Meant for splitting the units of a large
+    section among worker threads. */
+int
+dwarf_get_cu_header_offsets(Dwarf_Debug dbg,
+    Dwarf_Bool       is_info,
+    Dwarf_Off     ** offsets_out,
+    Dwarf_Unsigned * offset_count_out,
+    Dwarf_Error    * error)
+{
+    struct Dwarf_Section_s *secdp = 0;
+    Dwarf_Unsigned  header_min = 0;
+    Dwarf_Unsigned  offset = 0;
+    Dwarf_Unsigned  count = 0;
+    Dwarf_Unsigned  i = 0;
+    Dwarf_Off      *offsets = 0;
+    int             res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_get_cu_header_offsets()");
+    if (!offsets_out || !offset_count_out) {
+        _dwarf_error_string(dbg,error,DW_DLE_RET_OP_LIST_NULL,
+            "DW_DLE_RET_OP_LIST_NULL: "
+            "dwarf_get_cu_header_offsets() requires "
+            "non-null return pointers");
+        return DW_DLV_ERROR;
+    }
+    secdp = is_info? &dbg->de_debug_info:&dbg->de_debug_types;
+    if (!secdp->dss_data) {
+        res = _dwarf_load_die_containing_section(dbg,
+            is_info, error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (!secdp->dss_size) {
+        return DW_DLV_NO_ENTRY;
+    }
+    header_min = _dwarf_length_of_cu_header_simple(dbg,is_info);
+    /*  First pass counts, second pass records. */
+    while ((offset + header_min) < secdp->dss_size) {
+        Dwarf_Unsigned next = 0;
+
+        res = next_unit_offset(dbg,offset,secdp->dss_data,
+            secdp->dss_size,&next,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        ++count;
+        offset = next;
+    }
+    if (!count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    offsets = (Dwarf_Off *)_dwarf_get_alloc(dbg,
+        DW_DLA_UARRAY, count);
+    if (!offsets) {
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating the "
+            "array of CU header offsets");
+        return DW_DLV_ERROR;
+    }
+    offset = 0;
+    for (i = 0; i < count; ++i) {
+        Dwarf_Unsigned next = 0;
+
+        offsets[i] = offset;
+        /*  Cannot fail, the first pass read these. */
+        res = next_unit_offset(dbg,offset,secdp->dss_data,
+            secdp->dss_size,&next,error);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc(dbg,offsets,DW_DLA_UARRAY);
+            return res;
+        }
+        offset = next;
+    }
+    *offsets_out = offsets;
+    *offset_count_out = count;
+    return DW_DLV_OK;
+}
+
 static void
 local_attrlist_dealloc(Dwarf_Debug dbg,
     Dwarf_Signed atcount,
@@ -1592,6 +1740,7 @@ finish_up_cu_context_from_cudie(Dwarf_Debug dbg,
         _dwarf_error(dbg, error, DW_DLE_ABBREV_OFFSET_ERROR);
         return DW_DLV_ERROR;
     }
+    _dwarf_share_abbrev_hash_table(cu_context);
     /*  Now we can read the CU die and determine
         the correct DW_UT_ type for DWARF4 and some
         offset base fields for DW4-fission and DW5,
@@ -1623,77 +1772,95 @@ finish_up_cu_context_from_cudie(Dwarf_Debug dbg,
     }
     return DW_DLV_OK;
 }
+/*  Ensure de_cu_context_array has room for one
+    more entry before the list is changed, so
+    the list and array cannot get out of step. */
+static int
+reserve_cu_context_array(Dwarf_Debug_InfoTypes dis)
+{
+    Dwarf_Unsigned newsize = 0;
+    Dwarf_CU_Context *newarray = 0;
+
+    if (dis->de_cu_context_array_count <
+        dis->de_cu_context_array_size) {
+        return DW_DLV_OK;
+    }
+    newsize = dis->de_cu_context_array_size?
+        dis->de_cu_context_array_size*2 : 64;
+    if (newsize > (Dwarf_Unsigned)(((size_t)-1)/
+        sizeof(Dwarf_CU_Context))) {
+        return DW_DLV_ERROR;
+    }
+    newarray = (Dwarf_CU_Context *)realloc(
+        dis->de_cu_context_array,
+        (size_t)(newsize*sizeof(Dwarf_CU_Context)));
+    if (!newarray) {
+        return DW_DLV_ERROR;
+    }
+    dis->de_cu_context_array = newarray;
+    dis->de_cu_context_array_size = newsize;
+    return DW_DLV_OK;
+}
+
 /*
     CU_Contexts do not overlap.
     cu_context we see here is not in the list we
     are updating. See _dwarf_find_CU_Context()
 
     Invariant: cc_debug_offset in strictly
-        ascending order in the list.
+        ascending order in the list, and
+        de_cu_context_array holds the same contexts
+        in the same order.  So the array
+        (a binary search) gives the list
+        predecessor too, even when contexts are
+        created out of order.
 */
 static int
 insert_into_cu_context_list(Dwarf_Debug_InfoTypes dis,
     Dwarf_CU_Context icu_context)
 {
     Dwarf_Unsigned ioffset = icu_context->cc_debug_offset;
-    Dwarf_Unsigned eoffset = 0;
-    Dwarf_Unsigned hoffset = 0;
-    Dwarf_Unsigned coffset = 0;
-    Dwarf_CU_Context next = 0;
-    Dwarf_CU_Context past = 0;
-    Dwarf_CU_Context cur = 0;
+    Dwarf_Unsigned count = dis->de_cu_context_array_count;
+    Dwarf_Unsigned pos = 0;
+    Dwarf_CU_Context *array = 0;
 
     /*  Add the context into the section context list.
         This is the one and only place where it is
         saved for re-use and eventual dealloc. */
-    if (!dis->de_cu_context_list) {
-        /*  First cu encountered. */
-        dis->de_cu_context_list = icu_context;
-        dis->de_cu_context_list_end = icu_context;
-        return DW_DLV_OK;
-    }
-    if (!dis->de_cu_context_list_end) {
+    if (reserve_cu_context_array(dis) != DW_DLV_OK) {
         return DW_DLV_ERROR;
     }
-    eoffset = dis->de_cu_context_list_end->cc_debug_offset;
-    if (eoffset < ioffset) {
+    array = dis->de_cu_context_array;
+    if (count && dis->de_cu_context_list_end &&
+        dis->de_cu_context_list_end->cc_debug_offset < ioffset) {
         /* Normal case, add at end. */
-        dis->de_cu_context_list_end->cc_next = icu_context;
-        dis->de_cu_context_list_end = icu_context;
-        return DW_DLV_OK;
+        pos = count;
+    } else {
+        pos = cu_context_array_position(dis,ioffset);
     }
-    hoffset = dis->de_cu_context_list->cc_debug_offset;
-    if (hoffset > ioffset) {
-        /* insert as new head. Unusual. */
-        next =  dis->de_cu_context_list;
+    if (!pos) {
+        /* insert as new head. Unusual but for the first. */
+        icu_context->cc_next = dis->de_cu_context_list;
         dis->de_cu_context_list = icu_context;
-        dis->de_cu_context_list->cc_next = next;
-        /*  No need to touch de_cu_context_list_end */
-        return DW_DLV_OK;
-    }
-    cur = dis->de_cu_context_list;
-    past = 0;
-    /*  Insert in middle somewhere. Neither at
-        start nor end.
-        ASSERT: cur non-null
-        ASSERT: past non-null */
-    past = cur;
-    cur = cur->cc_next;
-    for ( ; cur ; cur = next) {
-        next = cur->cc_next;
-        coffset = cur->cc_debug_offset;
-        if (coffset  >  ioffset) {
-            /*  Insert before cur, using past.
-                ASSERT: past non-null  */
-            past->cc_next = icu_context;
-            icu_context->cc_next = cur;
-            return DW_DLV_OK;
+        if (!dis->de_cu_context_list_end) {
+            dis->de_cu_context_list_end = icu_context;
+        }
+    } else {
+        Dwarf_CU_Context past = array[pos-1];
+
+        icu_context->cc_next = past->cc_next;
+        past->cc_next = icu_context;
+        if (past == dis->de_cu_context_list_end) {
+            dis->de_cu_context_list_end = icu_context;
         }
-        past = cur;
     }
-    /*  Impossible, for end, coffset (ie, eoffset) > ioffset  */
-    /* NOTREACHED */
-    return DW_DLV_ERROR;
+    if (pos < count) {
+        memmove(array+pos+1,array+pos,
+            (size_t)((count-pos)*sizeof(Dwarf_CU_Context)));
+    }
+    array[pos] = icu_context;
+    dis->de_cu_context_array_count = count+1;
+    return DW_DLV_OK;
 }
 
 Dwarf_Unsigned
@@ -1755,13 +1922,63 @@ _dwarf_create_a_new_cu_context_record_on_list(
         local_dealloc_cu_context(dbg,cu_context);
         _dwarf_error_string(dbg,error,DW_DLE_DIE_NO_CU_CONTEXT,
             "DW_DLE_DIE_NO_CU_CONTEXT"
-            "Impossible error inserting into internal context list");
+            " Out of memory or impossible error inserting"
+            " into internal context list");
         return icres;
     }
+    _dwarf_add_to_type_sig_index(dbg,cu_context);
     *context_out = cu_context;
     return DW_DLV_OK;
 }
 
+/*  For a caller that knows hdr_offset is where a
+    unit header starts (dwarf_get_cu_header_offsets()
+    for example): finds the context of that unit,
+    creating it without reading the headers of any
+    earlier units.  Returns DW_DLV_NO_ENTRY if
+    hdr_offset is inside, not at the start of, a
+    unit already known. */
+int
+_dwarf_cu_context_at_header_offset(Dwarf_Debug dbg,
+    Dwarf_Bool is_info,
+    Dwarf_Unsigned hdr_offset,
+    Dwarf_CU_Context *context_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug_InfoTypes dis = 0;
+    struct Dwarf_Section_s *secdp = 0;
+    Dwarf_CU_Context cu_context = 0;
+    int res = 0;
+
+    if (is_info) {
+        dis = &dbg->de_info_reading;
+        secdp = &dbg->de_debug_info;
+    } else {
+        dis = &dbg->de_types_reading;
+        secdp = &dbg->de_debug_types;
+    }
+    if (!secdp->dss_data) {
+        res = _dwarf_load_die_containing_section(dbg,
+            is_info, error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    cu_context = _dwarf_find_CU_Context(dbg,hdr_offset,is_info);
+    if (cu_context) {
+        if (cu_context->cc_debug_offset != hdr_offset) {
+            return DW_DLV_NO_ENTRY;
+        }
+        *context_out = cu_context;
+        return DW_DLV_OK;
+    }
+    /*  Not setting dis->de_cu_context, leave
+        that unchanged. */
+    return _dwarf_create_a_new_cu_context_record_on_list(
+        dbg,dis,is_info,secdp->dss_size,hdr_offset,
+        context_out,NULL,error);
+}
+
 int
 _dwarf_load_die_containing_section(Dwarf_Debug dbg,
     Dwarf_Bool is_info,
@@ -2130,6 +2347,13 @@ dwarf_die_from_hash_signature(Dwarf_Debug dbg,
         There will be COMDAT sections for the type TUs
             (DW_UT_type).
         A single non-comdat for the DW_UT_compile. */
+    if (is_type_unit) {
+        Dwarf_Bool is_info2 = FALSE;
+
+        /*  The type signature index covers this. */
+        return _dwarf_internal_find_die_given_sig8(dbg,0,
+            hash_sig,returned_die,&is_info2,error);
+    }
     /*  FIXME: DW_DLE_DEBUG_FISSION_INCOMPLETE  */
     _dwarf_error(dbg,error,DW_DLE_DEBUG_FISSION_INCOMPLETE);
     return DW_DLV_ERROR;
@@ -2320,7 +2544,41 @@ _dwarf_next_die_info_ptr(Dwarf_Byte_Ptr die_info_ptr,
         are non-null and if  list->abl_implicit_const_count > 0
         list->abl_implicit_const is non-null. */
 
-    for ( i = 0; i <abbrev_list->abl_abbrev_count; ++i) {
+    if (abbrev_list->abl_attr_offset) {
+        /*  Step over the fixed-size prefix in one go,
+            stopping at a DW_AT_sibling we want to read. */
+        Dwarf_Unsigned skip = 0;
+        Dwarf_Unsigned space_left = 0;
+
+        for ( ; i < abbrev_list->abl_fixed_prefix_count; ++i) {
+            if (want_AT_sibling &&
+                abbrev_list->abl_attr[i] == DW_AT_sibling) {
+                break;
+            }
+        }
+        skip = abbrev_list->abl_attr_offset[i];
+        /*  ptrdiff_t is generated but not named */
+        space_left = (die_info_end >= info_ptr)?
+            (die_info_end - info_ptr):0;
+        if (skip > space_left) {
+            dwarfstring m;
+
+            dwarfstring_constructor(&m);
+            dwarfstring_append_printf_u(&m,
+                "DW_DLE_NEXT_DIE_PAST_END:"
+                " the DIE fixed-size values are %u"
+                " bytes long, and that would extend"
+                " past the end of the section.",
+                skip);
+            _dwarf_error_string(dbg, error,
+                DW_DLE_NEXT_DIE_PAST_END,
+                dwarfstring_string(&m));
+            dwarfstring_destructor(&m);
+            return DW_DLV_ERROR;
+        }
+        info_ptr += skip;
+    }
+    for ( ; i <abbrev_list->abl_abbrev_count; ++i) {
         /* Dwarf_Signed implicit_const = 0; */
         Dwarf_Half   attr = 0;
         Dwarf_Half   attr_form = 0;
@@ -3142,12 +3400,18 @@ dwarf_offdie_b(Dwarf_Debug dbg,
     cu_context = _dwarf_find_CU_Context(dbg, offset,is_info);
     if (cu_context == NULL) {
         Dwarf_Unsigned section_size = 0;
-
-        if (dis->de_cu_context_list_end != NULL) {
+        Dwarf_CU_Context prev_context = 0;
+
+        /*  Read unit headers from the end of the
+            last known unit before offset.  Later units
+            may already be known, see
+            _dwarf_cu_context_at_header_offset(). */
+        prev_context = last_cu_context_at_or_before(dis,offset);
+        if (prev_context != NULL) {
             new_cu_offset = _dwarf_calculate_next_cu_context_offset(
-                dis->de_cu_context_list_end);
-        }/* Else new_cu_offset remains 0, no CUs on list,
-            a fresh section setup. */
+                prev_context);
+        }/* Else new_cu_offset remains 0, no CUs known
+            before offset. */
         section_size = secdp->dss_size;
         do {
             /*  We do not want this to return cu_die as
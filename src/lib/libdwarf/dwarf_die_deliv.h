@@ -75,4 +75,17 @@ struct Dwarf_Abbrev_List_s {
         for an implicit const value. */
     Dwarf_Signed  *abl_implicit_const;
 
+    /*  The decoding plan, built with abl_attr.
+        The first abl_fixed_prefix_count attributes
+        have values whose size does not depend on
+        the DIE (see _dwarf_fixed_size_of_form()).
+        abl_attr_offset[i] is the offset of value i
+        from the end of the abbrev code for
+        i <= abl_fixed_prefix_count, so
+        abl_attr_offset[abl_fixed_prefix_count] is
+        the size of the prefix. When the prefix is
+        all of the attributes every DIE with this
+        abbrev has that fixed size. */
+    Dwarf_Unsigned abl_fixed_prefix_count;
+    Dwarf_Unsigned *abl_attr_offset;
 };
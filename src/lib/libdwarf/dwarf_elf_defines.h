@@ -67,6 +67,10 @@ extern "C" {
 #define SHF_GROUP  (1 << 9)
 #endif /* SHF_GROUP */
 
+#ifndef SHF_COMPRESSED
+#define SHF_COMPRESSED (1 << 11)
+#endif /* SHF_COMPRESSED */
+
 #ifndef STN_UNDEF
 #define STN_UNDEF  0
 #endif /* STN_UNDEF */
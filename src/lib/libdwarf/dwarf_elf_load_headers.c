@@ -66,9 +66,9 @@ calls
 #include "dwarf_reading.h"
 #include "dwarf_elf_defines.h"
 #include "dwarf_elfstructs.h"
+#include "dwarf_object_read_common.h"
 #include "dwarf_elfread.h"
 #include "dwarf_object_detector.h"
-#include "dwarf_object_read_common.h"
 #include "dwarf_util.h"
 #include "dwarf_secname_ck.h"
 
@@ -146,6 +146,9 @@ _dwarf_load_elf_section_is_dwarf(const char *sname,
     if (!strcmp(sname,".eh_frame")) {
         return TRUE;
     }
+    if (!strcmp(sname,".eh_frame_hdr")) {
+        return TRUE;
+    }
     if (!strncmp(sname,".gdb_index",10)) {
         return TRUE;
     }
@@ -189,6 +189,36 @@ static int elf_get_nolibelf_section_info(void *obj,
     return DW_DLV_NO_ENTRY;
 }
 
+/*  A section may be used directly from a read-only
+    mapping of the file only if libdwarf never writes
+    into it: not compressed (the decompressed data
+    goes elsewhere, but keep such sections simple)
+    and not the target of any .rel/.rela section. */
+static int
+elf_section_can_be_mapped(dwarf_elf_object_access_internals_t *elf,
+    Dwarf_Unsigned section_index)
+{
+    struct generic_shdr *sp = elf->f_shdr + section_index;
+    struct generic_shdr *rp = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (sp->gh_flags & SHF_COMPRESSED) {
+        return FALSE;
+    }
+    if (sp->gh_namestring &&
+        !strncmp(sp->gh_namestring,".zdebug_",8)) {
+        return FALSE;
+    }
+    rp = elf->f_shdr + 1;
+    for (i = 1; i < elf->f_loc_shdr.g_count; ++i,++rp) {
+        if ((rp->gh_type == SHT_REL || rp->gh_type == SHT_RELA) &&
+            rp->gh_reloc_target_secnum == section_index) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
 static int
 elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
     Dwarf_Small **return_data, int *error)
@@ -227,6 +257,23 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
             return DW_DLV_ERROR;
         }
 
+        if (elf->f_load_record.lr_preference == Dwarf_Alloc_Mmap &&
+            elf_section_can_be_mapped(elf,section_index)) {
+            res = _dwarf_object_mmap_random(elf->f_fd,
+                sp->gh_offset,sp->gh_size,elf->f_filesize,
+                &sp->gh_mmap_base,&sp->gh_mmap_size,
+                &sp->gh_content,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            if (res == DW_DLV_OK) {
+                elf->f_load_record.lr_mmap_count++;
+                elf->f_load_record.lr_mmap_size += sp->gh_size;
+                *return_data = (Dwarf_Small *)sp->gh_content;
+                return DW_DLV_OK;
+            }
+            /*  DW_DLV_NO_ENTRY: fall back to malloc and read. */
+        }
         sp->gh_content = malloc((size_t)sp->gh_size);
         if (!sp->gh_content) {
             *error = DW_DLE_ALLOC_FAIL;
@@ -255,6 +302,8 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
             read_offset += read_size;
             read_target += read_size;
         }
+        elf->f_load_record.lr_malloc_count++;
+        elf->f_load_record.lr_malloc_size += sp->gh_size;
         *return_data = (Dwarf_Small *)sp->gh_content;
         return DW_DLV_OK;
     }
@@ -544,7 +593,14 @@ _dwarf_destruct_elf_nlaccess(
     for (i = 0; i < shcount; ++i,++shp) {
         free(shp->gh_rels);
         shp->gh_rels = 0;
-        free(shp->gh_content);
+        if (shp->gh_mmap_base) {
+            _dwarf_object_munmap(shp->gh_mmap_base,
+                shp->gh_mmap_size);
+            shp->gh_mmap_base = 0;
+            shp->gh_mmap_size = 0;
+        } else {
+            free(shp->gh_content);
+        }
         shp->gh_content = 0;
         free(shp->gh_sht_group_array);
         shp->gh_sht_group_array = 0;
@@ -611,6 +667,7 @@ _dwarf_elf_nlsetup(int fd,
     intfc->f_path = strdup(true_path);
     (*dbg)->de_obj_machine = intfc->f_machine;
     (*dbg)->de_obj_flags = intfc->f_flags;
+    (*dbg)->de_load_record = &intfc->f_load_record;
     return res;
 }
 
@@ -664,6 +721,7 @@ _dwarf_elf_object_access_internals_init(
     intfc->f_filesize    = filesize;
     intfc->f_ftype       = ftype;
     intfc->f_destruct_close_fd = FALSE;
+    intfc->f_load_record.lr_preference = Dwarf_Alloc_Malloc;
 
 #ifdef WORDS_BIGENDIAN
     if (endian == DW_END_little ) {
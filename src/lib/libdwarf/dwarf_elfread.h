@@ -115,6 +115,12 @@ struct generic_shdr {
         and strings mainly. free() this if not null*/
     char *       gh_content;
 
+    /*  Non-zero if gh_content points into an mmap()
+        of the file rather than malloc space.
+        munmap() these instead of free() of gh_content. */
+    char *       gh_mmap_base;
+    Dwarf_Unsigned gh_mmap_size;
+
     /*  If a .rel or .rela section this will point
         to generic relocation records if such
         have been loaded.
@@ -241,6 +247,9 @@ typedef struct elf_filedata_s {
     Dwarf_Unsigned f_sht_group_type_section_count;
     Dwarf_Unsigned f_shf_group_flag_section_count;
     Dwarf_Unsigned f_dwo_group_section_count;
+
+    /*  Malloc or mmap section data, and counts of each. */
+    struct Dwarf_Obj_Load_Record_s f_load_record;
 } dwarf_elf_object_access_internals_t;
 
 int dwarf_construct_elf_access(int fd,
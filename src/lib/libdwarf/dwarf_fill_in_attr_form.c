@@ -69,6 +69,43 @@ build_alloc_ab_error(Dwarf_Debug dbg,
     dwarfstring_destructor(&m);
 }
 
+/*  Records where each value of the leading
+    fixed-size attributes lies, so walking DIEs
+    need not size those values one at a time. */
+static int
+build_decode_plan(Dwarf_CU_Context context,
+    Dwarf_Abbrev_List abbrev_list,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned offset = 0;
+
+    abbrev_list->abl_attr_offset = (Dwarf_Unsigned *)
+        calloc(abbrev_list->abl_abbrev_count+1,
+            sizeof(Dwarf_Unsigned));
+    if (!abbrev_list->abl_attr_offset) {
+        build_alloc_ab_error(context->cc_dbg,
+            abbrev_list->abl_abbrev_count+1,
+            "abbrev_list->abl_attr_offset",error);
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < abbrev_list->abl_abbrev_count; ++i) {
+        Dwarf_Unsigned size = 0;
+
+        if (!_dwarf_fixed_size_of_form(abbrev_list->abl_form[i],
+            context->cc_version_stamp,
+            context->cc_address_size,
+            context->cc_length_size,&size)) {
+            break;
+        }
+        abbrev_list->abl_attr_offset[i] = offset;
+        offset += size;
+    }
+    abbrev_list->abl_attr_offset[i] = offset;
+    abbrev_list->abl_fixed_prefix_count = i;
+    return DW_DLV_OK;
+}
+
 /*
     This is a pre-scan of the abbrev/form list.
     We will not handle DW_FORM_indirect here as that
@@ -192,5 +229,5 @@ _dwarf_fill_in_attr_form_abtable(Dwarf_CU_Context context,
         }
 #endif
     }
-    return DW_DLV_OK;
+    return build_decode_plan(context,abbrev_list,error);
 }
@@ -28,6 +28,7 @@ Floor, Boston MA 02110-1301, USA.
 
 #include <config.h>
 
+#include <stdlib.h> /* free() */
 #include <string.h> /* memcmp() */
 #include <stdio.h> /* printf() debugging */
 
@@ -35,6 +36,10 @@ Floor, Boston MA 02110-1301, USA.
 #include "stdafx.h"
 #endif /* HAVE_STDAFX_H */
 
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif /* HAVE_STDINT_H */
+
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "libdwarf_private.h"
@@ -44,6 +49,8 @@ Floor, Boston MA 02110-1301, USA.
 #include "dwarf_error.h"
 #include "dwarf_util.h"
 #include "dwarf_string.h"
+#include "dwarf_tsearch.h"
+#include "dwarf_tied_decls.h"
 #if 0 /* dump_bytes */
 static void
 dump_bytes(const char *msg,int line,
@@ -59,6 +66,179 @@ dump_bytes(const char *msg,int line,
 }
 #endif /*0*/
 
+/*  Called for every CU_Context as it is added to
+    a section context list. Records type units
+    in de_type_sig_index.  On out-of-memory the
+    index is abandoned (and the linear search
+    below is used from then on) as the failure
+    need not be fatal. */
+void
+_dwarf_add_to_type_sig_index(Dwarf_Debug dbg,
+    Dwarf_CU_Context context)
+{
+    struct Dwarf_Tied_Entry_s *entry = 0;
+    void *retval = 0;
+
+    if (dbg->de_type_sig_index_failed) {
+        return;
+    }
+    if (context->cc_unit_type != DW_UT_type &&
+        context->cc_unit_type != DW_UT_split_type) {
+        return;
+    }
+    if (!context->cc_signature_present) {
+        return;
+    }
+    if (!dbg->de_type_sig_index) {
+        dwarf_initialize_search_hash(&dbg->de_type_sig_index,
+            _dwarf_tied_data_hashfunc,0);
+        if (!dbg->de_type_sig_index) {
+            dbg->de_type_sig_index_failed = TRUE;
+            return;
+        }
+    }
+    entry = _dwarf_tied_make_entry(&context->cc_signature,
+        context);
+    if (!entry) {
+        dbg->de_type_sig_index_failed = TRUE;
+        return;
+    }
+    retval = dwarf_tsearch(entry,&dbg->de_type_sig_index,
+        _dwarf_tied_compare_function);
+    if (!retval) {
+        free(entry);
+        dbg->de_type_sig_index_failed = TRUE;
+        return;
+    }
+    if (*(struct Dwarf_Tied_Entry_s **)retval != entry) {
+        /*  Duplicate signature (COMDAT copies, say).
+            Keep the first one, as a list scan would. */
+        free(entry);
+    }
+}
+
+/*  Read every unit header of the section not yet
+    on the context list, so every type unit is in
+    de_type_sig_index.  Existing contexts
+    are skipped, gaps (from dwarf_offdie_b() at
+    arbitrary offsets) are filled in. */
+static int
+_dwarf_fill_type_sig_index_section(Dwarf_Debug dbg,
+    Dwarf_Bool is_info,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug_InfoTypes dis = 0;
+    Dwarf_Unsigned section_size = 0;
+    Dwarf_Unsigned offset = 0;
+    Dwarf_CU_Context cur = 0;
+    Dwarf_CU_Context newcontext = 0;
+    int lres = 0;
+
+    lres = _dwarf_load_die_containing_section(dbg,is_info,error);
+    if (lres != DW_DLV_OK) {
+        return lres;
+    }
+    if (is_info) {
+        dis = &dbg->de_info_reading;
+        section_size = dbg->de_debug_info.dss_size;
+    } else {
+        dis = &dbg->de_types_reading;
+        section_size = dbg->de_debug_types.dss_size;
+    }
+    cur = dis->de_cu_context_list;
+    while (offset < section_size) {
+        if (cur && cur->cc_debug_offset <= offset) {
+            if (cur->cc_debug_offset == offset) {
+                offset =
+                    _dwarf_calculate_next_cu_context_offset(cur);
+            }
+            cur = cur->cc_next;
+            continue;
+        }
+        lres = _dwarf_create_a_new_cu_context_record_on_list(
+            dbg,dis,is_info,section_size,offset,
+            &newcontext,NULL,error);
+        if (lres != DW_DLV_OK) {
+            return lres;
+        }
+        offset = _dwarf_calculate_next_cu_context_offset(
+            newcontext);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+_dwarf_lookup_type_sig_index(Dwarf_Debug dbg,
+    Dwarf_Sig8 *sig_in,
+    Dwarf_CU_Context *cu_context_out)
+{
+    struct Dwarf_Tied_Entry_s entry;
+    void *found = 0;
+
+    if (!dbg->de_type_sig_index) {
+        return DW_DLV_NO_ENTRY;
+    }
+    entry.dt_key = *sig_in;
+    entry.dt_context = 0;
+    found = dwarf_tfind(&entry,&dbg->de_type_sig_index,
+        _dwarf_tied_compare_function);
+    if (!found) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *cu_context_out =
+        (*(struct Dwarf_Tied_Entry_s **)found)->dt_context;
+    return DW_DLV_OK;
+}
+
+/*  Sets *answered FALSE if the index cannot
+    answer (it was abandoned) so the
+    caller must search the lists itself. */
+static int
+_dwarf_find_in_type_sig_index(Dwarf_Debug dbg,
+    int context_level,
+    Dwarf_Sig8 *sig_in,
+    Dwarf_CU_Context *cu_context_out,
+    Dwarf_Bool *answered,
+    Dwarf_Error *error)
+{
+    int res = 0;
+
+    *answered = FALSE;
+    if (dbg->de_type_sig_index_failed) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = _dwarf_lookup_type_sig_index(dbg,sig_in,
+        cu_context_out);
+    if (res == DW_DLV_OK) {
+        *answered = TRUE;
+        return res;
+    }
+    /*  With context_level > 0 we must not create
+        contexts, and every existing context
+        is already in the index, which is all the
+        list search would have looked at. */
+    if (!dbg->de_type_sig_index_complete && !context_level) {
+        res = _dwarf_fill_type_sig_index_section(dbg,TRUE,
+            error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        res = _dwarf_fill_type_sig_index_section(dbg,FALSE,
+            error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (dbg->de_type_sig_index_failed) {
+            return DW_DLV_NO_ENTRY;
+        }
+        dbg->de_type_sig_index_complete = TRUE;
+        res = _dwarf_lookup_type_sig_index(dbg,sig_in,
+            cu_context_out);
+    }
+    *answered = TRUE;
+    return res;
+}
+
 static int
 _dwarf_find_CU_Context_given_sig(Dwarf_Debug dbg,
     int context_level,
@@ -69,11 +249,26 @@ _dwarf_find_CU_Context_given_sig(Dwarf_Debug dbg,
 {
     Dwarf_CU_Context cu_context = 0;
     Dwarf_Bool is_info = FALSE;
+    Dwarf_Bool answered = FALSE;
     int loopcount = 0;
     int lres = 0;
     Dwarf_Debug_InfoTypes dis = 0;
     struct Dwarf_Section_s *secdp = 0;
 
+    lres = _dwarf_find_in_type_sig_index(dbg,context_level,
+        sig_in,&cu_context,&answered,error);
+    if (lres == DW_DLV_ERROR) {
+        return lres;
+    }
+    if (lres == DW_DLV_OK) {
+        *cu_context_out = cu_context;
+        *is_info_out = cu_context->cc_is_info;
+        return DW_DLV_OK;
+    }
+    if (answered) {
+        return DW_DLV_NO_ENTRY;
+    }
+    /*  The index is unusable, search the lists. */
     /*  Loop once with is_info, once with !is_info.
         Then stop. */
     for ( ; loopcount < 2; ++loopcount) {
@@ -77,6 +77,10 @@
 
 #define MIN(a,b)  (((a) < (b))? (a):(b))
 
+/*  Rows (and rules) to allocate when a frame row
+    cache is started. */
+#define FRAME_ROW_CACHE_MIN_ROWS 16
+
 #if 0 /* dump_bytes FOR DEBUGGING */
 static void
 dump_bytes(const char *msg,Dwarf_Small * start, long len)
@@ -107,6 +111,14 @@ static void _dwarf_init_reg_rules_dw3(
     Dwarf_Regtable_Entry3_i *base,
     Dwarf_Unsigned, Dwarf_Unsigned last,
     Dwarf_Unsigned  initial_value);
+static int frame_row_cache_add(Dwarf_Debug dbg,
+    struct Dwarf_Frame_Row_Cache_s *cache,
+    Dwarf_Addr loc,
+    Dwarf_Bool has_more_rows,
+    Dwarf_Addr subsequent_pc,
+    struct Dwarf_Reg_Rule_s *regs,
+    struct Dwarf_Reg_Rule_s *cfa_rule,
+    Dwarf_Error *error);
 
 /*  The rules for register settings are described
     in libdwarf.pdf and the html version.
@@ -335,6 +347,7 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
     Dwarf_Addr * subsequent_pc,
     Dwarf_Frame_Instr_Head *ret_frame_instr_head,
     Dwarf_Unsigned * returned_frame_instr_count,
+    struct Dwarf_Frame_Row_Cache_s *row_cache,
     Dwarf_Error *error)
 {
 /*  The following macro depends on macreg and
@@ -509,6 +522,7 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
         Dwarf_Unsigned adv_pc = 0;
         Dwarf_Off fp_instr_offset = 0;
         Dwarf_Small * base_instr_ptr = 0;
+        Dwarf_Addr    row_loc = current_loc;
 
         if (instr_ptr < start_instr_ptr) {
             SERINST("DW_DLE_DF_NEW_LOC_LESS_OLD_LOC: "
@@ -1772,6 +1786,17 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
             return DW_DLV_ERROR;
         }
         }
+        if (row_cache && current_loc != row_loc) {
+            /*  An advance instruction ended the row
+                that started at row_loc. */
+            int rres = frame_row_cache_add(dbg,row_cache,
+                row_loc,true,current_loc,localregtab,
+                &cfa_reg,error);
+            if (rres != DW_DLV_OK) {
+                FREELOCALMALLOC;
+                return rres;
+            }
+        }
         if (make_instr) {
             /* add dfi to end of singly-linked list */
             instr_count++;
@@ -1806,6 +1831,16 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
         }
     }
 
+    if (row_cache) {
+        /*  The last row runs to the end of the FDE. */
+        int rres = frame_row_cache_add(dbg,row_cache,
+            current_loc,false,0,localregtab,&cfa_reg,error);
+        if (rres != DW_DLV_OK) {
+            FREELOCALMALLOC;
+            return rres;
+        }
+    }
+
     /*  Fill in the actual output table, the space the
         caller passed in. */
     if (table) {
@@ -2352,6 +2387,319 @@ dwarf_get_cie_info_b(Dwarf_Cie cie,
     return DW_DLV_OK;
 }
 
+/*  Build the CIE initial table on first use. */
+static int
+get_cie_initial_table(Dwarf_Debug dbg,
+    Dwarf_Cie cie,
+    Dwarf_Unsigned cfa_reg_col_num,
+    Dwarf_Error * error)
+{
+    Dwarf_Small *instrstart = 0;
+    Dwarf_Small *instrend = 0;
+    int res = 0;
+
+    if (cie->ci_initial_table) {
+        return DW_DLV_OK;
+    }
+    instrstart = cie->ci_cie_instr_start;
+    instrend = instrstart +cie->ci_length +
+        cie->ci_length_size +
+        cie->ci_extension_size -
+        (cie->ci_cie_instr_start -
+        cie->ci_cie_start);
+    if (instrend > cie->ci_cie_end) {
+        _dwarf_error(dbg, error,DW_DLE_CIE_INSTR_PTR_ERROR);
+        return DW_DLV_ERROR;
+    }
+    cie->ci_initial_table = (Dwarf_Frame)_dwarf_get_alloc(dbg,
+        DW_DLA_FRAME, 1);
+
+    if (cie->ci_initial_table == NULL) {
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    _dwarf_init_reg_rules_ru(cie->ci_initial_table->fr_reg,
+        0, cie->ci_initial_table->fr_reg_count,
+        dbg->de_frame_rule_initial_value);
+    _dwarf_init_reg_rules_ru(&cie->ci_initial_table->fr_cfa_rule,
+        0,1,dbg->de_frame_rule_initial_value);
+    res = _dwarf_exec_frame_instr( /* make_instr= */ false,
+        /* search_pc */ false,
+        /* search_pc_val */ 0,
+        /* location */ 0,
+        instrstart,
+        instrend,
+        cie->ci_initial_table,
+        cie, dbg,
+        cfa_reg_col_num,
+        /* has_more_rows */ NULL,
+        /* subsequent_pc */ NULL,
+        NULL,NULL,
+        /* row_cache= */ NULL,
+        error);
+    return res;
+}
+
+static Dwarf_Bool
+rule_is_initial(struct Dwarf_Reg_Rule_s *r,
+    Dwarf_Unsigned initial_value)
+{
+    return !r->ru_is_offset &&
+        r->ru_value_type == DW_EXPR_OFFSET &&
+        r->ru_register == initial_value &&
+        !r->ru_offset && !r->ru_args_size &&
+        !r->ru_block.bl_data && !r->ru_block.bl_len;
+}
+
+/*  Called by _dwarf_exec_frame_instr() at the end
+    of each row while filling the cache.
+    A row going backwards (DW_CFA_set_loc in
+    unrelocated objects) cannot be searched, so the
+    cache is marked failed and the FDE is then
+    read the usual way. */
+static int
+frame_row_cache_add(Dwarf_Debug dbg,
+    struct Dwarf_Frame_Row_Cache_s *cache,
+    Dwarf_Addr loc,
+    Dwarf_Bool has_more_rows,
+    Dwarf_Addr subsequent_pc,
+    struct Dwarf_Reg_Rule_s *regs,
+    struct Dwarf_Reg_Rule_s *cfa_rule,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Frame_Row_s *row = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned nrules = 0;
+
+    if (cache->fc_failed) {
+        return DW_DLV_OK;
+    }
+    if (has_more_rows && subsequent_pc < loc) {
+        cache->fc_failed = true;
+        return DW_DLV_OK;
+    }
+    for (i = 0; i < cache->fc_reg_count; ++i) {
+        if (!rule_is_initial(regs+i,cache->fc_initial_value)) {
+            ++nrules;
+        }
+    }
+    if (cache->fc_row_count >= cache->fc_rows_allocated) {
+        Dwarf_Unsigned newcount = cache->fc_rows_allocated?
+            cache->fc_rows_allocated*2:FRAME_ROW_CACHE_MIN_ROWS;
+        struct Dwarf_Frame_Row_s *newrows = 0;
+
+        newrows = (struct Dwarf_Frame_Row_s *)realloc(
+            cache->fc_rows,(size_t)newcount*sizeof(*newrows));
+        if (!newrows) {
+            _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: growing the frame row cache");
+            return DW_DLV_ERROR;
+        }
+        cache->fc_rows = newrows;
+        cache->fc_rows_allocated = newcount;
+    }
+    if (cache->fc_rule_count + nrules > cache->fc_rules_allocated) {
+        Dwarf_Unsigned newcount = cache->fc_rules_allocated?
+            cache->fc_rules_allocated*2:FRAME_ROW_CACHE_MIN_ROWS;
+        struct Dwarf_Frame_Row_Rule_s *newrules = 0;
+
+        while (newcount < cache->fc_rule_count + nrules) {
+            newcount *= 2;
+        }
+        newrules = (struct Dwarf_Frame_Row_Rule_s *)realloc(
+            cache->fc_rules,(size_t)newcount*sizeof(*newrules));
+        if (!newrules) {
+            _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: growing the frame row "
+                "cache rules");
+            return DW_DLV_ERROR;
+        }
+        cache->fc_rules = newrules;
+        cache->fc_rules_allocated = newcount;
+    }
+    row = cache->fc_rows + cache->fc_row_count;
+    row->fw_loc = loc;
+    row->fw_has_more_rows = has_more_rows;
+    row->fw_subsequent_pc = subsequent_pc;
+    row->fw_cfa_rule = *cfa_rule;
+    row->fw_first_rule = cache->fc_rule_count;
+    row->fw_rule_count = nrules;
+    for (i = 0; i < cache->fc_reg_count; ++i) {
+        struct Dwarf_Frame_Row_Rule_s *rr = 0;
+
+        if (rule_is_initial(regs+i,cache->fc_initial_value)) {
+            continue;
+        }
+        rr = cache->fc_rules + cache->fc_rule_count;
+        rr->rr_column = i;
+        rr->rr_rule = regs[i];
+        ++cache->fc_rule_count;
+    }
+    ++cache->fc_row_count;
+    return DW_DLV_OK;
+}
+
+static void
+frame_row_cache_free(struct Dwarf_Fde_s *fde)
+{
+    struct Dwarf_Frame_Row_Cache_s *cache = fde->fd_row_cache;
+
+    if (!cache) {
+        return;
+    }
+    free(cache->fc_rows);
+    free(cache->fc_rules);
+    free(cache);
+    fde->fd_row_cache = 0;
+}
+
+/*  Run the FDE instructions once, keeping every row.
+    Instructions past the pc asked for are read
+    here, so an error in them is not an error for
+    the caller: the cache is marked failed and the
+    FDE is read the usual way. */
+static int
+frame_row_cache_build(Dwarf_Fde fde,
+    Dwarf_Small *instr_end,
+    Dwarf_Unsigned cfa_reg_col_num,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = fde->fd_dbg;
+    struct Dwarf_Frame_Row_Cache_s *cache = 0;
+    Dwarf_Error build_error = 0;
+    int res = 0;
+
+    cache = (struct Dwarf_Frame_Row_Cache_s *)
+        calloc(1,sizeof(struct Dwarf_Frame_Row_Cache_s));
+    if (!cache) {
+        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating a frame row cache");
+        return DW_DLV_ERROR;
+    }
+    cache->fc_reg_count = dbg->de_frame_reg_rules_entry_count;
+    cache->fc_initial_value = dbg->de_frame_rule_initial_value;
+    cache->fc_cfa_col = cfa_reg_col_num;
+    cache->fc_same_value = dbg->de_frame_same_value_number;
+    cache->fc_undefined_value =
+        dbg->de_frame_undefined_value_number;
+    fde->fd_row_cache = cache;
+    res = _dwarf_exec_frame_instr( /* make_instr= */ false,
+        /* search_pc */ false,
+        /* search_pc_val */ 0,
+        fde->fd_initial_location,
+        fde->fd_fde_instr_start,
+        instr_end,
+        /* Dwarf_Frame */ NULL,
+        fde->fd_cie,dbg,
+        cfa_reg_col_num,
+        /* has_more_rows */ NULL,
+        /* subsequent_pc */ NULL,
+        NULL,NULL,
+        cache,
+        &build_error);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,build_error);
+        cache->fc_failed = true;
+    } else if (res == DW_DLV_NO_ENTRY || !cache->fc_row_count) {
+        cache->fc_failed = true;
+    }
+    if (cache->fc_failed) {
+        /*  Keep only the record of the failure. */
+        free(cache->fc_rows);
+        free(cache->fc_rules);
+        cache->fc_rows = 0;
+        cache->fc_rules = 0;
+        cache->fc_row_count = 0;
+        cache->fc_rows_allocated = 0;
+        cache->fc_rule_count = 0;
+        cache->fc_rules_allocated = 0;
+    }
+    return DW_DLV_OK;
+}
+
+/*  Returns DW_DLV_NO_ENTRY if the row cache cannot
+    be used for this FDE, and the caller reads the
+    instructions instead. */
+static int
+frame_row_cache_lookup(Dwarf_Fde fde,
+    Dwarf_Addr pc_requested,
+    Dwarf_Small *instr_end,
+    Dwarf_Frame table,
+    Dwarf_Unsigned cfa_reg_col_num,
+    Dwarf_Bool * has_more_rows,
+    Dwarf_Addr * subsequent_pc,
+    Dwarf_Error * error)
+{
+    Dwarf_Debug dbg = fde->fd_dbg;
+    struct Dwarf_Frame_Row_Cache_s *cache = fde->fd_row_cache;
+    struct Dwarf_Frame_Row_s *row = 0;
+    struct Dwarf_Frame_Row_Rule_s *rr = 0;
+    struct Dwarf_Frame_Row_Rule_s *rrend = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+    Dwarf_Unsigned count = 0;
+
+    if (cache && (cache->fc_reg_count !=
+        dbg->de_frame_reg_rules_entry_count ||
+        cache->fc_initial_value !=
+        dbg->de_frame_rule_initial_value ||
+        cache->fc_cfa_col != cfa_reg_col_num ||
+        cache->fc_same_value !=
+        dbg->de_frame_same_value_number ||
+        cache->fc_undefined_value !=
+        dbg->de_frame_undefined_value_number)) {
+        frame_row_cache_free(fde);
+        cache = 0;
+    }
+    if (!cache) {
+        int res = frame_row_cache_build(fde,instr_end,
+            cfa_reg_col_num,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        cache = fde->fd_row_cache;
+    }
+    if (cache->fc_failed) {
+        return DW_DLV_NO_ENTRY;
+    }
+    /*  The first row is at fd_initial_location and
+        the caller checked pc_requested is not below it,
+        so the search always finds a row. */
+    hi = cache->fc_row_count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (cache->fc_rows[mid].fw_loc <= pc_requested) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (!lo) {
+        return DW_DLV_NO_ENTRY;
+    }
+    row = cache->fc_rows + lo - 1;
+    count = MIN(table->fr_reg_count,cache->fc_reg_count);
+    _dwarf_init_reg_rules_ru(table->fr_reg,0,count,
+        cache->fc_initial_value);
+    rr = cache->fc_rules + row->fw_first_rule;
+    rrend = rr + row->fw_rule_count;
+    for ( ; rr < rrend; ++rr) {
+        if (rr->rr_column < count) {
+            table->fr_reg[rr->rr_column] = rr->rr_rule;
+        }
+    }
+    table->fr_cfa_rule = row->fw_cfa_rule;
+    table->fr_loc = row->fw_loc;
+    if (has_more_rows) {
+        *has_more_rows = row->fw_has_more_rows;
+    }
+    if (subsequent_pc) {
+        *subsequent_pc = row->fw_subsequent_pc;
+    }
+    return DW_DLV_OK;
+}
+
 /* Return the register rules for all registers at a given pc.
 */
 static int
@@ -2386,45 +2734,9 @@ _dwarf_get_fde_info_for_a_pc_row(Dwarf_Fde fde,
     }
 
     cie = fde->fd_cie;
-    if (cie->ci_initial_table == NULL) {
-        Dwarf_Small *instrstart = cie->ci_cie_instr_start;
-        Dwarf_Small *instrend = instrstart +cie->ci_length +
-            cie->ci_length_size +
-            cie->ci_extension_size -
-            (cie->ci_cie_instr_start -
-            cie->ci_cie_start);
-        if (instrend > cie->ci_cie_end) {
-            _dwarf_error(dbg, error,DW_DLE_CIE_INSTR_PTR_ERROR);
-            return DW_DLV_ERROR;
-        }
-        cie->ci_initial_table = (Dwarf_Frame)_dwarf_get_alloc(dbg,
-            DW_DLA_FRAME, 1);
-
-        if (cie->ci_initial_table == NULL) {
-            _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-            return DW_DLV_ERROR;
-        }
-        _dwarf_init_reg_rules_ru(cie->ci_initial_table->fr_reg,
-            0, cie->ci_initial_table->fr_reg_count,
-            dbg->de_frame_rule_initial_value);
-        _dwarf_init_reg_rules_ru(&cie->ci_initial_table->fr_cfa_rule,
-            0,1,dbg->de_frame_rule_initial_value);
-        res = _dwarf_exec_frame_instr( /* make_instr= */ false,
-            /* search_pc */ false,
-            /* search_pc_val */ 0,
-            /* location */ 0,
-            instrstart,
-            instrend,
-            cie->ci_initial_table,
-            cie, dbg,
-            cfa_reg_col_num,
-            has_more_rows,
-            subsequent_pc,
-            NULL,NULL,
-            error);
-        if (res != DW_DLV_OK) {
-            return res;
-        }
+    res = get_cie_initial_table(dbg,cie,cfa_reg_col_num,error);
+    if (res != DW_DLV_OK) {
+        return res;
     }
 
     {
@@ -2435,6 +2747,14 @@ _dwarf_get_fde_info_for_a_pc_row(Dwarf_Fde fde,
             _dwarf_error(dbg, error,DW_DLE_FDE_INSTR_PTR_ERROR);
             return DW_DLV_ERROR;
         }
+        if (dbg->de_frame_row_cache) {
+            res = frame_row_cache_lookup(fde,pc_requested,
+                instr_end,table,cfa_reg_col_num,
+                has_more_rows,subsequent_pc,error);
+            if (res != DW_DLV_NO_ENTRY) {
+                return res;
+            }
+        }
         res = _dwarf_exec_frame_instr( /* make_instr= */ false,
             /* search_pc */ true,
             /* search_pc_val */ pc_requested,
@@ -2447,6 +2767,7 @@ _dwarf_get_fde_info_for_a_pc_row(Dwarf_Fde fde,
             has_more_rows,
             subsequent_pc,
             NULL,NULL,
+            /* row_cache= */ NULL,
             error);
     }
     if (res != DW_DLV_OK) {
@@ -2936,6 +3257,345 @@ dwarf_get_fde_at_pc(Dwarf_Fde * fde_data,
     return DW_DLV_NO_ENTRY;
 }
 
+/*  Read one value from .eh_frame_hdr.
+    Returns DW_DLV_NO_ENTRY for an encoding
+    not used in .eh_frame_hdr by any linker we know of,
+    which makes the caller ignore the header. */
+static int
+read_eh_hdr_value(Dwarf_Debug dbg,
+    struct Dwarf_Section_s *hdr,
+    Dwarf_Small *ptr,
+    unsigned encoding,
+    Dwarf_Unsigned *value_out,
+    Dwarf_Small **ptr_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Small *end = hdr->dss_data + hdr->dss_size;
+    Dwarf_Unsigned value = 0;
+    unsigned size = 0;
+    int is_signed = FALSE;
+
+    switch (encoding & 0x0f) {
+    case DW_EH_PE_absptr:
+        size = dbg->de_pointer_size;
+        break;
+    case DW_EH_PE_udata2:
+        size = 2;
+        break;
+    case DW_EH_PE_udata4:
+        size = 4;
+        break;
+    case DW_EH_PE_udata8:
+        size = 8;
+        break;
+    case DW_EH_PE_sdata2:
+        size = 2;
+        is_signed = TRUE;
+        break;
+    case DW_EH_PE_sdata4:
+        size = 4;
+        is_signed = TRUE;
+        break;
+    case DW_EH_PE_sdata8:
+        size = 8;
+        break;
+    default:
+        return DW_DLV_NO_ENTRY;
+    }
+    if (size > sizeof(Dwarf_Unsigned)) {
+        return DW_DLV_NO_ENTRY;
+    }
+    READ_UNALIGNED_CK(dbg,value,Dwarf_Unsigned,ptr,size,
+        error,end);
+    if (is_signed) {
+        SIGN_EXTEND(value,size);
+    }
+    switch (encoding & 0x70) {
+    case 0:
+        break;
+    case DW_EH_PE_pcrel:
+        value += hdr->dss_addr + (ptr - hdr->dss_data);
+        break;
+    case DW_EH_PE_datarel:
+        value += hdr->dss_addr;
+        break;
+    default:
+        return DW_DLV_NO_ENTRY;
+    }
+    *value_out = value;
+    if (ptr_out) {
+        *ptr_out = ptr + size;
+    }
+    return DW_DLV_OK;
+}
+
+/*  New October 2026.
+    Find the .eh_frame FDE for a pc with the
+    binary search table in .eh_frame_hdr and create
+    just that FDE and its CIE.
+    The header is
+        version (1)
+        eh_frame_ptr encoding, fde_count encoding,
+        table encoding (one byte each)
+        eh_frame_ptr, fde_count
+        fde_count pairs of (initial location, FDE address)
+        sorted by initial location.  */
+int
+dwarf_get_fde_at_pc_eh_hdr(Dwarf_Debug dbg,
+    Dwarf_Addr pc_of_interest,
+    Dwarf_Fde * returned_fde,
+    Dwarf_Addr * lopc,
+    Dwarf_Addr * hipc,
+    Dwarf_Error * error)
+{
+    struct Dwarf_Section_s *hdr = 0;
+    struct Dwarf_Section_s *eh = 0;
+    Dwarf_Small *ptr = 0;
+    Dwarf_Small *table = 0;
+    unsigned ptr_enc = 0;
+    unsigned count_enc = 0;
+    unsigned table_enc = 0;
+    unsigned entry_size = 0;
+    Dwarf_Unsigned eh_frame_addr = 0;
+    Dwarf_Unsigned fde_count = 0;
+    Dwarf_Unsigned fde_addr = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+    Dwarf_Fde fde = 0;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_get_fde_at_pc_eh_hdr()");
+    hdr = &dbg->de_eh_frame_hdr;
+    eh = &dbg->de_debug_frame_eh_gnu;
+    if (!hdr->dss_size || !eh->dss_size) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = _dwarf_load_section(dbg,hdr,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = _dwarf_load_section(dbg,eh,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (hdr->dss_size < 4 || hdr->dss_data[0] != 1) {
+        return DW_DLV_NO_ENTRY;
+    }
+    ptr_enc = hdr->dss_data[1];
+    count_enc = hdr->dss_data[2];
+    table_enc = hdr->dss_data[3];
+    if (ptr_enc == DW_EH_PE_omit || count_enc == DW_EH_PE_omit ||
+        table_enc == DW_EH_PE_omit) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = read_eh_hdr_value(dbg,hdr,hdr->dss_data+4,ptr_enc,
+        &eh_frame_addr,&ptr,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = read_eh_hdr_value(dbg,hdr,ptr,count_enc,
+        &fde_count,&table,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    /*  The table must describe the .eh_frame we have
+        and each entry must be fixed size to be searched. */
+    if (eh_frame_addr != eh->dss_addr) {
+        return DW_DLV_NO_ENTRY;
+    }
+    switch (table_enc & 0x0f) {
+    case DW_EH_PE_udata4:
+    case DW_EH_PE_sdata4:
+        entry_size = 8;
+        break;
+    case DW_EH_PE_udata8:
+    case DW_EH_PE_sdata8:
+        entry_size = 16;
+        break;
+    default:
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!fde_count ||
+        (Dwarf_Unsigned)(hdr->dss_data + hdr->dss_size - table)/
+        entry_size < fde_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    /*  Find the last entry with initial location
+        at or below the pc. */
+    hi = fde_count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+        Dwarf_Unsigned loc = 0;
+
+        res = read_eh_hdr_value(dbg,hdr,table + mid*entry_size,
+            table_enc,&loc,0,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (loc <= pc_of_interest) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (!lo) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = read_eh_hdr_value(dbg,hdr,
+        table + (lo - 1)*entry_size + entry_size/2,
+        table_enc,&fde_addr,0,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (fde_addr < eh->dss_addr ||
+        fde_addr - eh->dss_addr >= eh->dss_size) {
+        _dwarf_error_string(dbg,error,DW_DLE_DEBUG_FRAME_LENGTH_BAD,
+            "DW_DLE_DEBUG_FRAME_LENGTH_BAD: an .eh_frame_hdr "
+            "table entry is outside .eh_frame");
+        return DW_DLV_ERROR;
+    }
+    res = _dwarf_create_single_fde(dbg,
+        /* use_gnu_cie_calc= */ 1,
+        fde_addr - eh->dss_addr,&fde,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (pc_of_interest < fde->fd_initial_location ||
+        pc_of_interest >= fde->fd_initial_location +
+        fde->fd_address_range) {
+        dwarf_dealloc(dbg,fde,DW_DLA_FDE);
+        return DW_DLV_NO_ENTRY;
+    }
+    if (lopc) {
+        *lopc = fde->fd_initial_location;
+    }
+    if (hipc) {
+        *hipc = fde->fd_initial_location +
+            fde->fd_address_range - 1;
+    }
+    *returned_fde = fde;
+    return DW_DLV_OK;
+}
+
+/*  New October 2026.
+    Step over one CIE or FDE of .eh_frame or .debug_frame
+    reading only its length and CIE id, so walking a
+    section allocates nothing.  */
+int
+dwarf_next_frame_entry(Dwarf_Debug dbg,
+    Dwarf_Bool is_eh_frame,
+    Dwarf_Unsigned offset,
+    Dwarf_Bool * is_cie,
+    Dwarf_Unsigned * cie_offset,
+    Dwarf_Unsigned * next_offset,
+    Dwarf_Error * error)
+{
+    struct Dwarf_Section_s *sec = 0;
+    Dwarf_Unsigned cie_id_value = 0;
+    Dwarf_Unsigned entry_size = 0;
+    Dwarf_Unsigned cie_off = 0;
+    struct cie_fde_prefix_s prefix;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_next_frame_entry()");
+    if (is_eh_frame) {
+        sec = &dbg->de_debug_frame_eh_gnu;
+    } else {
+        sec = &dbg->de_debug_frame;
+        cie_id_value = (Dwarf_Unsigned)DW_CIE_ID;
+    }
+    if (!sec->dss_size) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = _dwarf_load_section(dbg,sec,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (offset >= sec->dss_size) {
+        return DW_DLV_NO_ENTRY;
+    }
+    memset(&prefix, 0, sizeof(prefix));
+    res = _dwarf_read_cie_fde_prefix(dbg,
+        sec->dss_data + offset, sec->dss_data,
+        sec->dss_index, sec->dss_size, &prefix, error);
+    if (res != DW_DLV_OK) {
+        /*  DW_DLV_NO_ENTRY is the zero terminator. */
+        return res;
+    }
+    entry_size = prefix.cf_length + prefix.cf_local_length_size +
+        prefix.cf_local_extension_size;
+    if (entry_size > sec->dss_size - offset) {
+        _dwarf_error_string(dbg,error,DW_DLE_DEBUG_FRAME_LENGTH_BAD,
+            "DW_DLE_DEBUG_FRAME_LENGTH_BAD: a cie/fde length "
+            "runs past the end of the frame section");
+        return DW_DLV_ERROR;
+    }
+    if (prefix.cf_cie_id == cie_id_value) {
+        cie_off = offset;
+    } else if (is_eh_frame) {
+        /*  The id is the distance back from the id
+            field to the CIE. */
+        Dwarf_Unsigned id_off = (Dwarf_Unsigned)
+            (prefix.cf_cie_id_addr - sec->dss_data);
+
+        if (prefix.cf_cie_id > id_off) {
+            _dwarf_error_string(dbg,error,
+                DW_DLE_DEBUG_FRAME_LENGTH_BAD,
+                "DW_DLE_DEBUG_FRAME_LENGTH_BAD: an .eh_frame "
+                "fde cie pointer is before the section start");
+            return DW_DLV_ERROR;
+        }
+        cie_off = id_off - prefix.cf_cie_id;
+    } else {
+        if (prefix.cf_cie_id >= sec->dss_size) {
+            _dwarf_error_string(dbg,error,
+                DW_DLE_DEBUG_FRAME_LENGTH_BAD,
+                "DW_DLE_DEBUG_FRAME_LENGTH_BAD: a .debug_frame "
+                "fde cie offset is past the section end");
+            return DW_DLV_ERROR;
+        }
+        cie_off = prefix.cf_cie_id;
+    }
+    if (is_cie) {
+        *is_cie = (prefix.cf_cie_id == cie_id_value);
+    }
+    if (cie_offset) {
+        *cie_offset = cie_off;
+    }
+    if (next_offset) {
+        *next_offset = offset + entry_size;
+    }
+    return DW_DLV_OK;
+}
+
+/*  New October 2026.
+    Create the FDE at fde_offset, typically one found
+    with dwarf_next_frame_entry(), and its CIE.  */
+int
+dwarf_get_fde_at_offset(Dwarf_Debug dbg,
+    Dwarf_Bool is_eh_frame,
+    Dwarf_Unsigned fde_offset,
+    Dwarf_Fde * returned_fde,
+    Dwarf_Error * error)
+{
+    struct Dwarf_Section_s *sec = 0;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_get_fde_at_offset()");
+    sec = is_eh_frame? &dbg->de_debug_frame_eh_gnu:
+        &dbg->de_debug_frame;
+    if (!sec->dss_size) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = _dwarf_load_section(dbg,sec,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return _dwarf_create_single_fde(dbg,
+        is_eh_frame?1:0,
+        fde_offset,returned_fde,error);
+}
+
 /*  Expands a single frame instruction block
     from a specific cie or fde into a
     Dwarf_Frame_Instr_Head.
@@ -2991,6 +3651,7 @@ dwarf_expand_frame_instructions(Dwarf_Cie cie,
         /* subsequent_pc */0,
         returned_instr_head,
         returned_instr_count,
+        /* row_cache= */ NULL,
         error);
     if (res != DW_DLV_OK) {
         return res;
@@ -3350,6 +4011,21 @@ dwarf_set_frame_undefined_value(Dwarf_Debug dbg, Dwarf_Half value)
     return orig;
 }
 
+/*  New October 2026.
+    When non-zero the rows of an FDE are all computed
+    the first time a register rule of the FDE
+    is asked for and later calls find the row with a
+    binary search.
+    Returns the value that was present before
+    we changed it here.  */
+Dwarf_Small
+dwarf_set_frame_row_cache(Dwarf_Debug dbg, Dwarf_Small value)
+{
+    Dwarf_Small orig = dbg->de_frame_row_cache;
+    dbg->de_frame_row_cache = value?1:0;
+    return orig;
+}
+
 /*  Does something only if value passed in is greater than 0 and
     a size than we can handle (in number of bytes).  */
 Dwarf_Small
@@ -3433,7 +4109,13 @@ _dwarf_fde_destructor(void *f)
 
         if (!dbg->de_in_tdestroy) {
             /*  This is just for dwarf_get_fde_for_die() and
+                dwarf_get_fde_at_pc_eh_hdr() and
                 must not be applied in alloc tree destruction. */
+            if (fde->fd_cie->ci_initial_table) {
+                dwarf_dealloc(dbg,fde->fd_cie->ci_initial_table,
+                    DW_DLA_FRAME);
+                fde->fd_cie->ci_initial_table = 0;
+            }
             dwarf_dealloc(fde->fd_dbg,fde->fd_cie,DW_DLA_CIE);
             fde->fd_cie = 0;
         }
@@ -3442,6 +4124,7 @@ _dwarf_fde_destructor(void *f)
         _dwarf_free_fde_table(&fde->fd_fde_table);
         fde->fd_have_fde_tab = false;
     }
+    frame_row_cache_free(fde);
 }
 void
 _dwarf_frame_instr_destructor(void *f)
@@ -381,6 +381,49 @@ struct Dwarf_Fde_s {
     /*  Set by dwarf_get_fde_for_die() */
     Dwarf_Bool     fd_fde_owns_cie;
 
+    /*  Every row of this FDE, built on first use
+        when dwarf_set_frame_row_cache() is on. */
+    struct Dwarf_Frame_Row_Cache_s *fd_row_cache;
+};
+
+/*  One register rule of a cached row.  Only rules
+    differing from the initial rule are kept. */
+struct Dwarf_Frame_Row_Rule_s {
+    Dwarf_Unsigned         rr_column;
+    struct Dwarf_Reg_Rule_s rr_rule;
+};
+
+/*  One row of a cached FDE: the rules apply from
+    fw_loc to the fw_loc of the next row.
+    fw_has_more_rows and fw_subsequent_pc are what
+    the instructions returned for this row. */
+struct Dwarf_Frame_Row_s {
+    Dwarf_Addr     fw_loc;
+    Dwarf_Bool     fw_has_more_rows;
+    Dwarf_Addr     fw_subsequent_pc;
+    struct Dwarf_Reg_Rule_s fw_cfa_rule;
+    Dwarf_Unsigned fw_first_rule;
+    Dwarf_Unsigned fw_rule_count;
+};
+
+/*  The fc_ settings are the Dwarf_Debug frame
+    settings the rows were built with. If any
+    change the rows are rebuilt. */
+struct Dwarf_Frame_Row_Cache_s {
+    Dwarf_Unsigned fc_reg_count;
+    Dwarf_Unsigned fc_initial_value;
+    Dwarf_Unsigned fc_cfa_col;
+    Dwarf_Unsigned fc_same_value;
+    Dwarf_Unsigned fc_undefined_value;
+    /*  Building failed, use the instructions
+        directly for this FDE. */
+    Dwarf_Bool     fc_failed;
+    Dwarf_Unsigned fc_row_count;
+    Dwarf_Unsigned fc_rows_allocated;
+    struct Dwarf_Frame_Row_s *fc_rows;
+    Dwarf_Unsigned fc_rule_count;
+    Dwarf_Unsigned fc_rules_allocated;
+    struct Dwarf_Frame_Row_Rule_s *fc_rules;
 };
 
 int
@@ -471,6 +514,7 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
     Dwarf_Addr * subsequent_pc,
     Dwarf_Frame_Instr_Head *ret_frame_instr_head,
     Dwarf_Unsigned * returned_frame_instr_count,
+    struct Dwarf_Frame_Row_Cache_s *row_cache,
     Dwarf_Error *error);
 
 int _dwarf_read_cie_fde_prefix(Dwarf_Debug dbg,
@@ -503,6 +547,12 @@ int _dwarf_create_cie_from_after_start(Dwarf_Debug dbg,
     Dwarf_Cie *cie_ptr_out,
         Dwarf_Error *error);
 
+int _dwarf_create_single_fde(Dwarf_Debug dbg,
+    int use_gnu_cie_calc,
+    Dwarf_Unsigned fde_offset,
+    Dwarf_Fde *fde_out,
+    Dwarf_Error *error);
+
 int _dwarf_frame_constructor(Dwarf_Debug dbg,void * );
 void _dwarf_frame_destructor (void *);
 void _dwarf_fde_destructor (void *);
@@ -662,6 +662,106 @@ _dwarf_get_fde_list_internal(Dwarf_Debug dbg, Dwarf_Cie ** cie_data,
     return DW_DLV_OK;
 }
 
+/*  New October 2026.
+    Create the one FDE that starts at fde_offset
+    and its CIE, without reading anything else in the
+    section. use_gnu_cie_calc non-zero means .eh_frame,
+    zero means .debug_frame. The section must already
+    be loaded.
+    The FDE owns the CIE, see dwarf_dealloc()
+    of DW_DLA_FDE.
+    Returns DW_DLV_NO_ENTRY if fde_offset is not
+    the start of an FDE. */
+int
+_dwarf_create_single_fde(Dwarf_Debug dbg,
+    int use_gnu_cie_calc,
+    Dwarf_Unsigned fde_offset,
+    Dwarf_Fde *fde_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Section_s *sec = use_gnu_cie_calc?
+        &dbg->de_debug_frame_eh_gnu:&dbg->de_debug_frame;
+    Dwarf_Unsigned cie_id_value = use_gnu_cie_calc?
+        0:(Dwarf_Unsigned)DW_CIE_ID;
+    Dwarf_Small *section_ptr = sec->dss_data;
+    Dwarf_Small *section_ptr_end = section_ptr + sec->dss_size;
+    Dwarf_Small *frame_ptr = 0;
+    Dwarf_Small *cieptr_val = 0;
+    Dwarf_Cie cie = 0;
+    Dwarf_Fde fde = 0;
+    struct cie_fde_prefix_s prefix;
+    int res = 0;
+
+    if (fde_offset >= sec->dss_size) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = _dwarf_validate_register_numbers(dbg,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    memset(&prefix, 0, sizeof(prefix));
+    res = _dwarf_read_cie_fde_prefix(dbg,
+        section_ptr + fde_offset, section_ptr,
+        sec->dss_index, sec->dss_size, &prefix, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (prefix.cf_cie_id == cie_id_value) {
+        /*  A CIE, not an FDE. */
+        return DW_DLV_NO_ENTRY;
+    }
+    frame_ptr = prefix.cf_addr_after_prefix;
+    if (frame_ptr >= section_ptr_end) {
+        _dwarf_error_string(dbg, error,
+            DW_DLE_DEBUG_FRAME_LENGTH_BAD,
+            "DW_DLE_DEBUG_FRAME_LENGTH_BAD: following "
+            "the start of an fde we have run off"
+            " the end of the section.  Corrupt Dwarf");
+        return DW_DLV_ERROR;
+    }
+    res = get_cieptr_given_offset(dbg,
+        prefix.cf_cie_id,
+        use_gnu_cie_calc,
+        section_ptr,
+        sec->dss_size,
+        prefix.cf_cie_id_addr,&cieptr_val,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = _dwarf_create_cie_from_start(dbg,
+        cieptr_val,
+        section_ptr,
+        sec->dss_index,
+        sec->dss_size,
+        section_ptr_end,
+        cie_id_value,
+        /* cie_count= */ 0,
+        use_gnu_cie_calc,
+        &cie,
+        error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = _dwarf_create_fde_from_after_start(dbg,
+        &prefix,
+        section_ptr,
+        sec->dss_size,
+        frame_ptr,
+        section_ptr_end,
+        use_gnu_cie_calc,
+        cie,
+        cie->ci_address_size,
+        &fde,
+        error);
+    if (res != DW_DLV_OK) {
+        dwarf_dealloc(dbg,cie,DW_DLA_CIE);
+        return res;
+    }
+    fde->fd_fde_owns_cie = TRUE;
+    *fde_out = fde;
+    return DW_DLV_OK;
+}
+
 /*  Internal function, not called by consumer code.
     'prefix' has accumulated the info up thru the cie-id
     and now we consume the rest and build a Dwarf_Cie_s structure.
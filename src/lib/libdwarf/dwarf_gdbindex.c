@@ -32,7 +32,7 @@ Index-Section-Format.html#Index-Section-Format
 
 #include <config.h>
 
-#include <string.h>  /* memcpy() */
+#include <string.h>  /* memcpy() strcmp() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
@@ -671,6 +671,236 @@ dwarf_gdbindex_symboltable_entry(
     return DW_DLV_OK;
 }
 
+/*  gdb's mapped_index_string_hash(). For index
+    versions 5 and later the name is lower-cased
+    (ASCII) as it is hashed. */
+static Dwarf_Unsigned
+gdbindex_string_hash(Dwarf_Unsigned version, const char *name)
+{
+    Dwarf_Unsigned r = 0;
+    const unsigned char *cp = (const unsigned char *)name;
+
+    for ( ; *cp; ++cp) {
+        unsigned c = *cp;
+
+        if (version >= 5 && c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        r = (r*67 + c - 113) & 0xffffffff;
+    }
+    return r;
+}
+
+/*  The symbol table is an open-addressing hash table
+    whose size is a power of two. Probe it as gdb
+    does (find_slot_in_mapped_hashtable()): start at
+    hash & (size-1) and step by ((hash*17) & (size-1)) | 1
+    until the name or an empty slot is found. */
+int
+dwarf_gdbindex_symboltable_lookup(Dwarf_Gdbindex gdbindexptr,
+    const char     * name,
+    Dwarf_Unsigned * entryindex_out,
+    Dwarf_Unsigned * cu_vector_offset_out,
+    Dwarf_Error    * error)
+{
+    Dwarf_Unsigned slots = 0;
+    Dwarf_Unsigned mask = 0;
+    Dwarf_Unsigned hash = 0;
+    Dwarf_Unsigned slot = 0;
+    Dwarf_Unsigned step = 0;
+    Dwarf_Unsigned probes = 0;
+
+    if (!gdbindexptr || !gdbindexptr->gi_dbg) {
+        _dwarf_error_string(NULL, error,
+            DW_DLE_GDB_INDEX_INDEX_ERROR,
+            "DW_DLE_GDB_INDEX_INDEX_ERROR:"
+            " passed in NULL indexptr to"
+            " dwarf_gdbindex_symboltable_lookup");
+        return DW_DLV_ERROR;
+    }
+    if (!name) {
+        _dwarf_error_string(gdbindexptr->gi_dbg, error,
+            DW_DLE_GDB_INDEX_INDEX_ERROR,
+            "DW_DLE_GDB_INDEX_INDEX_ERROR:"
+            " passed in NULL name to"
+            " dwarf_gdbindex_symboltable_lookup");
+        return DW_DLV_ERROR;
+    }
+    slots = gdbindexptr->gi_symboltablehdr.dg_count;
+    if (!slots) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (slots & (slots-1)) {
+        emit_one_value_msg(gdbindexptr->gi_dbg,
+            DW_DLE_GDB_INDEX_INDEX_ERROR,
+            "DW_DLE_GDB_INDEX_INDEX_ERROR:"
+            " the symbol table has %u slots,"
+            " not a power of two",
+            slots,error);
+        return DW_DLV_ERROR;
+    }
+    mask = slots - 1;
+    hash = gdbindex_string_hash(gdbindexptr->gi_version,name);
+    slot = hash & mask;
+    step = ((hash*17) & mask) | 1;
+    /*  step is odd, so slots probes visit every slot. */
+    for ( ; probes < slots; ++probes) {
+        Dwarf_Unsigned stroffset = 0;
+        Dwarf_Unsigned cuvecoffset = 0;
+        const char *str = 0;
+        int res = 0;
+
+        res = dwarf_gdbindex_symboltable_entry(gdbindexptr,
+            slot,&stroffset,&cuvecoffset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!stroffset && !cuvecoffset) {
+            /* Empty slot, not present. */
+            return DW_DLV_NO_ENTRY;
+        }
+        res = dwarf_gdbindex_string_by_offset(gdbindexptr,
+            stroffset,&str,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!strcmp(name,str)) {
+            if (entryindex_out) {
+                *entryindex_out = slot;
+            }
+            if (cu_vector_offset_out) {
+                *cu_vector_offset_out = cuvecoffset;
+            }
+            return DW_DLV_OK;
+        }
+        slot = (slot + step) & mask;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+static int
+gdbindex_check_addressarea_order(Dwarf_Gdbindex gdbindexptr,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned count = gdbindexptr->gi_addressareahdr.dg_count;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned prevhigh = 0;
+
+    for (i = 0; i < count; ++i) {
+        Dwarf_Unsigned low = 0;
+        Dwarf_Unsigned high = 0;
+        Dwarf_Unsigned cuindex = 0;
+        int res = 0;
+
+        res = dwarf_gdbindex_addressarea_entry(gdbindexptr,i,
+            &low,&high,&cuindex,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (low > high || (i && low < prevhigh)) {
+            gdbindexptr->gi_addressarea_order =
+                GDBINDEX_ORDER_UNSORTED;
+            return DW_DLV_OK;
+        }
+        prevhigh = high;
+    }
+    gdbindexptr->gi_addressarea_order = GDBINDEX_ORDER_SORTED;
+    return DW_DLV_OK;
+}
+
+/*  Find the address area entry whose
+    [low_address,high_address) holds pc.
+    A binary search when the entries are in order
+    (the usual case), otherwise a linear search. */
+int
+dwarf_gdbindex_addressarea_lookup(Dwarf_Gdbindex gdbindexptr,
+    Dwarf_Unsigned   pc,
+    Dwarf_Unsigned * entryindex_out,
+    Dwarf_Unsigned * cu_index_out,
+    Dwarf_Error    * error)
+{
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+    Dwarf_Unsigned low = 0;
+    Dwarf_Unsigned high = 0;
+    Dwarf_Unsigned cuindex = 0;
+    int res = 0;
+
+    if (!gdbindexptr || !gdbindexptr->gi_dbg) {
+        _dwarf_error_string(NULL, error,
+            DW_DLE_GDB_INDEX_INDEX_ERROR,
+            "DW_DLE_GDB_INDEX_INDEX_ERROR:"
+            " passed in NULL indexptr to"
+            " dwarf_gdbindex_addressarea_lookup");
+        return DW_DLV_ERROR;
+    }
+    count = gdbindexptr->gi_addressareahdr.dg_count;
+    if (!count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (gdbindexptr->gi_addressarea_order ==
+        GDBINDEX_ORDER_UNKNOWN) {
+        res = gdbindex_check_addressarea_order(gdbindexptr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (gdbindexptr->gi_addressarea_order ==
+        GDBINDEX_ORDER_UNSORTED) {
+        for (lo = 0; lo < count; ++lo) {
+            res = dwarf_gdbindex_addressarea_entry(gdbindexptr,
+                lo,&low,&high,&cuindex,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (low <= pc && pc < high) {
+                break;
+            }
+        }
+        if (lo >= count) {
+            return DW_DLV_NO_ENTRY;
+        }
+    } else {
+        /*  Find the first entry with low_address > pc,
+            the one before it is the only candidate. */
+        hi = count;
+        while (lo < hi) {
+            Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+            res = dwarf_gdbindex_addressarea_entry(gdbindexptr,
+                mid,&low,&high,&cuindex,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (low <= pc) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (!lo) {
+            return DW_DLV_NO_ENTRY;
+        }
+        --lo;
+        res = dwarf_gdbindex_addressarea_entry(gdbindexptr,
+            lo,&low,&high,&cuindex,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (pc >= high) {
+            return DW_DLV_NO_ENTRY;
+        }
+    }
+    if (entryindex_out) {
+        *entryindex_out = lo;
+    }
+    if (cu_index_out) {
+        *cu_index_out = cuindex;
+    }
+    return DW_DLV_OK;
+}
+
 int
 dwarf_gdbindex_cuvector_length(Dwarf_Gdbindex gdbindexptr,
     Dwarf_Unsigned   cuvector_offset,
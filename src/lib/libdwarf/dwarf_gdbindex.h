@@ -81,4 +81,14 @@ struct Dwarf_Gdbindex_s {
     struct Dwarf_Gdbindex_array_instance_s  gi_addressareahdr;
     struct Dwarf_Gdbindex_array_instance_s  gi_symboltablehdr;
     struct Dwarf_Gdbindex_array_instance_s  gi_cuvectorhdr;
+
+    /*  Whether the address area entries are in
+        ascending, non-overlapping order (as gdb and gold
+        write them) so dwarf_gdbindex_addressarea_lookup()
+        can use a binary search. Checked on first use. */
+    int gi_addressarea_order;
 };
+
+#define GDBINDEX_ORDER_UNKNOWN 0
+#define GDBINDEX_ORDER_SORTED  1
+#define GDBINDEX_ORDER_UNSORTED 2
@@ -77,6 +77,7 @@ dwarf_init_path_dl(path true_path and globals, dbg1
 #include "dwarf_alloc.h"
 #include "dwarf_error.h"
 #include "dwarf_object_detector.h"
+#include "dwarf_object_read_common.h"
 
 static int
 set_global_paths_init(Dwarf_Debug dbg, Dwarf_Error* error)
@@ -467,13 +468,14 @@ int
 dwarf_finish(Dwarf_Debug dbg)
 {
     if (IS_INVALID_DBG(dbg)) {
-        _dwarf_free_static_errlist();
         return DW_DLV_OK;
     }
+    /*  Points into the reader data freed just below. */
+    dbg->de_load_record = 0;
     if (dbg->de_obj_file) {
         /*  The initial character of a valid
             dbg->de_obj_file->object struct is a letter:
-            E, F, M, or P */
+            E, F, M, P, or S */
         char otype  = *(char *)(dbg->de_obj_file->ai_object);
 
         switch(otype) {
@@ -489,6 +491,10 @@ dwarf_finish(Dwarf_Debug dbg)
         case 'P':
             _dwarf_destruct_pe_access(dbg->de_obj_file);
             break;
+        case 'S':
+            /* dwarf_init_from_debug() */
+            _dwarf_destruct_shared_access(dbg->de_obj_file);
+            break;
         default:
             /*  Do nothing. A serious internal error */
             break;
@@ -541,3 +547,65 @@ dwarf_get_tied_dbg(Dwarf_Debug dbg, Dwarf_Debug *tieddbg_out,
     *tieddbg_out = dbg->de_tied_data.td_tied_object;
     return DW_DLV_OK;
 }
+
+/*  New October 2026.  The preference is kept in the
+    object reader's load record, which is only read
+    as each section is loaded. */
+enum Dwarf_Sec_Alloc_Pref
+dwarf_set_load_preference(Dwarf_Debug dbg,
+    enum Dwarf_Sec_Alloc_Pref pref)
+{
+    struct Dwarf_Obj_Load_Record_s *lr = 0;
+    enum Dwarf_Sec_Alloc_Pref oldpref = Dwarf_Alloc_None;
+
+    if (IS_INVALID_DBG(dbg)) {
+        return Dwarf_Alloc_None;
+    }
+    lr = dbg->de_load_record;
+    if (!lr) {
+        return Dwarf_Alloc_None;
+    }
+    oldpref = lr->lr_preference;
+    switch(pref) {
+    case Dwarf_Alloc_Malloc:
+    case Dwarf_Alloc_Mmap:
+        lr->lr_preference = pref;
+        break;
+    default:
+        /* Dwarf_Alloc_None or nonsense: just a query. */
+        break;
+    }
+    return oldpref;
+}
+
+/*  New October 2026. */
+int
+dwarf_get_mmap_count(Dwarf_Debug dbg,
+    Dwarf_Unsigned *mmap_count,
+    Dwarf_Unsigned *mmap_size,
+    Dwarf_Unsigned *malloc_count,
+    Dwarf_Unsigned *malloc_size)
+{
+    struct Dwarf_Obj_Load_Record_s *lr = 0;
+
+    if (IS_INVALID_DBG(dbg)) {
+        return DW_DLV_NO_ENTRY;
+    }
+    lr = dbg->de_load_record;
+    if (!lr) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (mmap_count) {
+        *mmap_count = lr->lr_mmap_count;
+    }
+    if (mmap_size) {
+        *mmap_size = lr->lr_mmap_size;
+    }
+    if (malloc_count) {
+        *malloc_count = lr->lr_malloc_count;
+    }
+    if (malloc_size) {
+        *malloc_size = lr->lr_malloc_size;
+    }
+    return DW_DLV_OK;
+}
@@ -1610,6 +1610,7 @@ dwarf_get_cu_die_offset_given_cu_header_offset_b(Dwarf_Debug dbg,
     Dwarf_Error * error)
 {
     Dwarf_Off headerlen = 0;
+    struct Dwarf_Section_s *secdp = 0;
     int cres = 0;
 
     if (IS_INVALID_DBG(dbg)) {
@@ -1621,11 +1622,42 @@ dwarf_get_cu_die_offset_given_cu_header_offset_b(Dwarf_Debug dbg,
             "a stale Dwarf_Debug pointer");
         return DW_DLV_ERROR;
     }
+    secdp = is_info? &dbg->de_debug_info: &dbg->de_debug_types;
+    if (!secdp->dss_data) {
+        /*  Nothing has read the section yet, as
+            with a fresh dwarf_init_from_debug()
+            Dwarf_Debug. */
+        cres = _dwarf_load_die_containing_section(dbg,
+            is_info,error);
+        if (cres != DW_DLV_OK) {
+            return cres;
+        }
+    }
+    if (in_cu_header_offset >= secdp->dss_size) {
+        _dwarf_error(dbg, error, DW_DLE_OFFSET_BAD);
+        return DW_DLV_ERROR;
+    }
     cres = _dwarf_length_of_cu_header(dbg,
         in_cu_header_offset,is_info, &headerlen,error);
     if (cres != DW_DLV_OK) {
         return cres;
     }
+    {
+        /*  Make the CU context now, so dwarf_offdie_b()
+            on the CU DIE offset finds it and does not
+            read the headers of all earlier CUs.
+            If that fails the CU is damaged and
+            dwarf_offdie_b() will report it, so the
+            error is dropped here. */
+        Dwarf_CU_Context cu_context = 0;
+        Dwarf_Error cerr = 0;
+
+        cres = _dwarf_cu_context_at_header_offset(dbg,is_info,
+            in_cu_header_offset,&cu_context,&cerr);
+        if (cres == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,cerr);
+        }
+    }
     *out_cu_die_offset = in_cu_header_offset + headerlen;
     return DW_DLV_OK;
 }
@@ -206,29 +206,43 @@ dwarf_sec_group_sizes(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
-static Dwarf_Unsigned map_reccount = 0;
-static struct temp_map_struc_s {
+struct temp_map_struc_s {
     Dwarf_Unsigned section;
     Dwarf_Unsigned group;
     const char *name;
-} *temp_map_data;
+};
+
+/*  Walk state for grp_walk_map(), passed as
+    the dwarf_twalk_r() closure. */
+struct grp_map_walk_s {
+    Dwarf_Unsigned mw_reccount;
+    Dwarf_Unsigned mw_max;
+    struct temp_map_struc_s *mw_data;
+};
 
 static void
 grp_walk_map(const void *nodep,
     const DW_VISIT which,
-    const int depth)
+    const int depth,
+    void *closure)
 {
     struct Dwarf_Group_Map_Entry_s *re = 0;
+    struct grp_map_walk_s *mw = (struct grp_map_walk_s *)closure;
 
     (void)depth;
     re = *(struct Dwarf_Group_Map_Entry_s **)nodep;
     if (which == dwarf_postorder || which == dwarf_endorder) {
         return;
     }
-    temp_map_data[map_reccount].group   = re->gm_group_number;
-    temp_map_data[map_reccount].section = re->gm_key;
-    temp_map_data[map_reccount].name = re->gm_section_name;
-    map_reccount += 1;
+    if (mw->mw_reccount >= mw->mw_max) {
+        /*  Impossible. Caller reports the count mismatch. */
+        mw->mw_reccount += 1;
+        return;
+    }
+    mw->mw_data[mw->mw_reccount].group   = re->gm_group_number;
+    mw->mw_data[mw->mw_reccount].section = re->gm_key;
+    mw->mw_data[mw->mw_reccount].name = re->gm_section_name;
+    mw->mw_reccount += 1;
 }
 
 /* Looks better sorted by group then sec num. */
@@ -271,13 +285,10 @@ dwarf_sec_group_map(Dwarf_Debug dbg,
 {
     Dwarf_Unsigned i = 0;
     struct Dwarf_Group_Data_s *grp = 0;
+    struct temp_map_struc_s *temp_map_data = 0;
+    struct grp_map_walk_s mw;
 
     CHECK_DBG(dbg,error,"dwarf_sec_group_map()");
-    if (temp_map_data) {
-        _dwarf_error(dbg,error,DW_DLE_GROUP_INTERNAL_ERROR);
-        return DW_DLV_ERROR;
-    }
-    map_reccount = 0;
     grp = &dbg->de_groupnumbers;
     if (map_entry_count < grp->gd_map_entry_count) {
         _dwarf_error(dbg,error,DW_DLE_GROUP_COUNT_ERROR);
@@ -289,23 +300,26 @@ dwarf_sec_group_map(Dwarf_Debug dbg,
         _dwarf_error(dbg,error,DW_DLE_GROUP_MAP_ALLOC);
         return DW_DLV_ERROR;
     }
-    dwarf_twalk(grp->gd_map,grp_walk_map);
-    if (map_reccount != grp->gd_map_entry_count) {
+    mw.mw_reccount = 0;
+    mw.mw_max = map_entry_count;
+    mw.mw_data = temp_map_data;
+    dwarf_twalk_r(grp->gd_map,grp_walk_map,&mw);
+    if (mw.mw_reccount != grp->gd_map_entry_count) {
         /*  Impossible. */
+        free(temp_map_data);
         _dwarf_error(dbg,error,DW_DLE_GROUP_INTERNAL_ERROR);
         return DW_DLV_ERROR;
     }
 
-    qsort(temp_map_data,map_reccount,sizeof(struct temp_map_struc_s),
+    qsort(temp_map_data,mw.mw_reccount,
+        sizeof(struct temp_map_struc_s),
         map_sort_compar);
-    for (i =0 ; i < map_reccount; ++i) {
+    for (i =0 ; i < mw.mw_reccount; ++i) {
         sec_numbers_array[i] = temp_map_data[i].section;
         group_numbers_array[i] = temp_map_data[i].group;
         sec_names_array[i] = temp_map_data[i].name;
     }
     free(temp_map_data);
-    map_reccount = 0;
-    temp_map_data = 0;
     return DW_DLV_OK;
 }
 
@@ -345,25 +359,31 @@ _dwarf_dwo_groupnumber_given_name(
     return DW_DLV_NO_ENTRY;
 }
 
-static unsigned target_group = 0;
-static int found_name_in_group = 0;
-const char *lookfor_name = 0;
+/*  Walk state for grp_walk_for_name(), passed as
+    the dwarf_twalk_r() closure. */
+struct grp_name_walk_s {
+    unsigned    nw_target_group;
+    int         nw_found_name_in_group;
+    const char *nw_lookfor_name;
+};
 
 static void
 grp_walk_for_name(const void *nodep,
     const DW_VISIT which,
-    const int depth)
+    const int depth,
+    void *closure)
 {
     struct Dwarf_Group_Map_Entry_s *re = 0;
+    struct grp_name_walk_s *nw = (struct grp_name_walk_s *)closure;
 
     (void)depth;
     re = *(struct Dwarf_Group_Map_Entry_s **)nodep;
     if (which == dwarf_postorder || which == dwarf_endorder) {
         return;
     }
-    if (re->gm_group_number == target_group) {
-        if (!strcmp(lookfor_name,re->gm_section_name)) {
-            found_name_in_group = TRUE;
+    if (re->gm_group_number == nw->nw_target_group) {
+        if (!strcmp(nw->nw_lookfor_name,re->gm_section_name)) {
+            nw->nw_found_name_in_group = TRUE;
         }
     }
 }
@@ -375,13 +395,14 @@ _dwarf_section_in_group_by_name(Dwarf_Debug dbg,
     unsigned groupnum)
 {
     struct Dwarf_Group_Data_s *grp = 0;
+    struct grp_name_walk_s nw;
 
     grp = &dbg->de_groupnumbers;
-    found_name_in_group = FALSE;
-    target_group = groupnum;
-    lookfor_name = scn_name;
-    dwarf_twalk(grp->gd_map,grp_walk_for_name);
-    return found_name_in_group;
+    nw.nw_found_name_in_group = FALSE;
+    nw.nw_target_group = groupnum;
+    nw.nw_lookfor_name = scn_name;
+    dwarf_twalk_r(grp->gd_map,grp_walk_for_name,&nw);
+    return nw.nw_found_name_in_group;
 }
 
 static void
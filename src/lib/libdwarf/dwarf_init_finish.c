@@ -32,13 +32,18 @@
 #include <config.h>
 
 #include <stdlib.h> /* calloc() free() */
-#include <string.h> /* memset() strcmp() strncmp() strlen() */
+#include <string.h> /* memset() strcmp() strdup() strncmp()
+    strlen() */
 #include <stdio.h> /* debugging */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
 #endif /* HAVE_STDAFX_H */
 
+#if defined(HAVE_PTHREAD_H)
+#include <pthread.h> /* pthread_create() pthread_join() */
+#endif /* HAVE_PTHREAD_H */
+
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "libdwarf_private.h"
@@ -52,6 +57,8 @@
 #include "dwarf_string.h"
 #include "dwarf_secname_ck.h"
 #include "dwarf_setup_sections.h"
+#include "dwarf_debuglink.h"
+#include "dwarf_decompress_cache.h"
 
 #ifdef HAVE_ZLIB_H
 #include "zlib.h"
@@ -91,18 +98,20 @@
 #define SHF_COMPRESSED (1 << 11)
 #endif
 
-/* This static is copied to the dbg on dbg init
-   so that the static need not be referenced at
+/* These statics are copied to the dbg on dbg init
+   so that the statics need not be referenced at
    run time, preserving better locality of
-   reference.
+   reference and letting separate Dwarf_Debug
+   be used in separate threads.
+   _dwarf_assume_string_in_bounds:
    Value is 0 means do the string check.
    Value non-zero means do not do the check.
 */
 static Dwarf_Small _dwarf_assume_string_in_bounds;
 static Dwarf_Small _dwarf_apply_relocs = 1;
 
-/*  Call this after calling dwarf_init but before doing anything else.
-    It applies to all objects, not just the current object.  */
+/*  Sets the default for Dwarf_Debug opened later.
+    Call before any other thread is using libdwarf. */
 int
 dwarf_set_reloc_application(int apply)
 {
@@ -120,6 +129,69 @@ dwarf_set_stringcheck(int newval)
     return oldval;
 }
 
+/*  The per-Dwarf_Debug forms of the above.
+    New October 2026. */
+int
+dwarf_set_reloc_application_a(Dwarf_Debug dbg, int apply)
+{
+    int oldval = 0;
+
+    if (IS_INVALID_DBG(dbg)) {
+        return 0;
+    }
+    oldval = dbg->de_apply_relocs;
+    dbg->de_apply_relocs = (Dwarf_Small)apply;
+    return oldval;
+}
+
+int
+dwarf_set_stringcheck_a(Dwarf_Debug dbg, int newval)
+{
+    int oldval = 0;
+
+    if (IS_INVALID_DBG(dbg)) {
+        return 0;
+    }
+    oldval = dbg->de_assume_string_in_bounds;
+    dbg->de_assume_string_in_bounds = (Dwarf_Small)newval;
+    return oldval;
+}
+
+unsigned int
+dwarf_set_decompress_threads(Dwarf_Debug dbg, unsigned int count)
+{
+    unsigned int oldval = 0;
+
+    if (IS_INVALID_DBG(dbg)) {
+        return 0;
+    }
+    oldval = dbg->de_decompress_threads;
+    dbg->de_decompress_threads = count;
+    return oldval;
+}
+
+int
+dwarf_set_decompress_cache_dir(Dwarf_Debug dbg,
+    const char *path,
+    Dwarf_Error *error)
+{
+    char *copy = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_set_decompress_cache_dir()");
+    if (path && path[0]) {
+        copy = strdup(path);
+        if (!copy) {
+            _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: copying the "
+                "decompression cache directory name");
+            return DW_DLV_ERROR;
+        }
+    }
+    free(dbg->de_decompress_cache_dir);
+    dbg->de_decompress_cache_dir = copy;
+    return DW_DLV_OK;
+}
+
 /*  Unifies the basic duplicate/empty testing and section
     data setting to one place. */
 static int
@@ -318,6 +390,9 @@ this_section_dwarf_relevant(const char *scn_name,
             it is harmless to consider it such. */
         return TRUE;
     }
+    if (!strcmp(scn_name, ".eh_frame_hdr")) {
+        return TRUE;
+    }
     if (!strcmp(scn_name, ".gnu_debuglink")) {
         /*  This is not a group or DWARF related file, but
             it is useful for split dwarf. */
@@ -715,6 +790,7 @@ _dwarf_setup(Dwarf_Debug dbg, Dwarf_Error * error)
 
     dbg->de_assume_string_in_bounds =
         _dwarf_assume_string_in_bounds;
+    dbg->de_apply_relocs = _dwarf_apply_relocs;
     /* First make an arbitrary assumption. */
     dbg->de_copy_word = _dwarf_memcpy_noswap_bytes;
     obj = dbg->de_obj_file;
@@ -1000,6 +1076,15 @@ load_debugfission_tables(Dwarf_Debug dbg,Dwarf_Error *error)
     return DW_DLV_OK;
 }
 
+static int object_init_internal(
+    Dwarf_Obj_Access_Interface_a* obj,
+    Dwarf_Handler errhand,
+    Dwarf_Ptr errarg,
+    unsigned groupnumber,
+    Dwarf_Debug section_owner,
+    Dwarf_Debug* ret_dbg,
+    Dwarf_Error* error);
+
 /*
     Use a Dwarf_Obj_Access_Interface to kick things off.
     All other init routines eventually use this one.
@@ -1016,6 +1101,23 @@ dwarf_object_init_b(Dwarf_Obj_Access_Interface_a* obj,
     unsigned groupnumber,
     Dwarf_Debug* ret_dbg,
     Dwarf_Error* error)
+{
+    return object_init_internal(obj,errhand,errarg,
+        groupnumber,0,ret_dbg,error);
+}
+
+/*  section_owner is non-null only for
+    dwarf_init_from_debug(). It must be set
+    before _dwarf_setup() as setup loads some
+    sections. */
+static int
+object_init_internal(Dwarf_Obj_Access_Interface_a* obj,
+    Dwarf_Handler errhand,
+    Dwarf_Ptr errarg,
+    unsigned groupnumber,
+    Dwarf_Debug section_owner,
+    Dwarf_Debug* ret_dbg,
+    Dwarf_Error* error)
 {
     Dwarf_Debug dbg = 0;
     int setup_result = DW_DLV_OK;
@@ -1048,6 +1150,7 @@ dwarf_object_init_b(Dwarf_Obj_Access_Interface_a* obj,
     dbg->de_obj_file = obj;
     dbg->de_filesize = filesize;
     dbg->de_groupnumber = groupnumber;
+    dbg->de_section_owner = section_owner;
     setup_result = _dwarf_setup(dbg, error);
     if (setup_result == DW_DLV_OK) {
         int fission_result = load_debugfission_tables(dbg,error);
@@ -1143,6 +1246,275 @@ dwarf_object_finish(Dwarf_Debug dbg)
     return res;
 }
 
+/*  The object access for a Dwarf_Debug made by
+    dwarf_init_from_debug().  so_ident[0] is 'S'
+    so dwarf_finish() knows what this is.
+    Everything is passed to the owner's object
+    access, but once setup is done nothing is
+    loaded through it: all DWARF section data
+    comes from the owner's loaded sections
+    (see borrow_owner_section()), so the owner's
+    object reader is never modified from
+    another thread. */
+struct Dwarf_Shared_Object_s {
+    char                          so_ident[8];
+    Dwarf_Bool                    so_in_setup;
+    Dwarf_Obj_Access_Interface_a *so_owner_obj;
+    Dwarf_Obj_Access_Interface_a  so_interface;
+};
+
+static int
+shared_get_section_info(void *obj,
+    Dwarf_Unsigned section_index,
+    Dwarf_Obj_Access_Section_a *return_section,
+    int *error)
+{
+    struct Dwarf_Shared_Object_s *so =
+        (struct Dwarf_Shared_Object_s *)obj;
+    Dwarf_Obj_Access_Interface_a *o = so->so_owner_obj;
+
+    return o->ai_methods->om_get_section_info(o->ai_object,
+        section_index,return_section,error);
+}
+static Dwarf_Small
+shared_get_byte_order(void *obj)
+{
+    struct Dwarf_Shared_Object_s *so =
+        (struct Dwarf_Shared_Object_s *)obj;
+    Dwarf_Obj_Access_Interface_a *o = so->so_owner_obj;
+
+    return o->ai_methods->om_get_byte_order(o->ai_object);
+}
+static Dwarf_Small
+shared_get_length_size(void *obj)
+{
+    struct Dwarf_Shared_Object_s *so =
+        (struct Dwarf_Shared_Object_s *)obj;
+    Dwarf_Obj_Access_Interface_a *o = so->so_owner_obj;
+
+    return o->ai_methods->om_get_length_size(o->ai_object);
+}
+static Dwarf_Small
+shared_get_pointer_size(void *obj)
+{
+    struct Dwarf_Shared_Object_s *so =
+        (struct Dwarf_Shared_Object_s *)obj;
+    Dwarf_Obj_Access_Interface_a *o = so->so_owner_obj;
+
+    return o->ai_methods->om_get_pointer_size(o->ai_object);
+}
+static Dwarf_Unsigned
+shared_get_filesize(void *obj)
+{
+    struct Dwarf_Shared_Object_s *so =
+        (struct Dwarf_Shared_Object_s *)obj;
+    Dwarf_Obj_Access_Interface_a *o = so->so_owner_obj;
+
+    return o->ai_methods->om_get_filesize(o->ai_object);
+}
+static Dwarf_Unsigned
+shared_get_section_count(void *obj)
+{
+    struct Dwarf_Shared_Object_s *so =
+        (struct Dwarf_Shared_Object_s *)obj;
+    Dwarf_Obj_Access_Interface_a *o = so->so_owner_obj;
+
+    return o->ai_methods->om_get_section_count(o->ai_object);
+}
+/*  Only the SHT_GROUP sections read by _dwarf_setup()
+    get here, and the owner's reader already has those
+    loaded so it just returns them. */
+static int
+shared_load_section(void *obj,
+    Dwarf_Unsigned section_index,
+    Dwarf_Small **return_data,
+    int *error)
+{
+    struct Dwarf_Shared_Object_s *so =
+        (struct Dwarf_Shared_Object_s *)obj;
+    Dwarf_Obj_Access_Interface_a *o = so->so_owner_obj;
+
+    if (!section_index) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!so->so_in_setup) {
+        *error = DW_DLE_SECTION_ERROR;
+        return DW_DLV_ERROR;
+    }
+    return o->ai_methods->om_load_section(o->ai_object,
+        section_index,return_data,error);
+}
+
+/*  No relocation method: the owner's sections
+    were relocated when it loaded them. */
+static const Dwarf_Obj_Access_Methods_a shared_methods = {
+    shared_get_section_info,
+    shared_get_byte_order,
+    shared_get_length_size,
+    shared_get_pointer_size,
+    shared_get_filesize,
+    shared_get_section_count,
+    shared_load_section,
+    0
+};
+
+void
+_dwarf_destruct_shared_access(
+    struct Dwarf_Obj_Access_Interface_a_s *aip)
+{
+    /*  so_interface is inside the struct, aip
+        points to it. */
+    free(aip->ai_object);
+}
+
+/*  If owner has section_index loaded (and decompressed
+    if it needed that) point section at that data.
+    Returns TRUE if it did. */
+static Dwarf_Bool
+borrow_owner_section(Dwarf_Debug owner,
+    struct Dwarf_Section_s *section)
+{
+    unsigned i = 0;
+
+    for ( ; i < owner->de_debug_sections_total_entries; ++i) {
+        struct Dwarf_Section_s *osec =
+            owner->de_debug_sections[i].ds_secdata;
+
+        if (osec->dss_index != section->dss_index) {
+            continue;
+        }
+        if (!osec->dss_data) {
+            return FALSE;
+        }
+        if ((osec->dss_zdebug_requires_decompress ||
+            osec->dss_shf_compressed ||
+            osec->dss_ZLIB_compressed) &&
+            !osec->dss_did_decompress) {
+            return FALSE;
+        }
+        section->dss_data = osec->dss_data;
+        section->dss_size = osec->dss_size;
+        section->dss_did_decompress = osec->dss_did_decompress;
+        section->dss_uncompressed_length =
+            osec->dss_uncompressed_length;
+        section->dss_compressed_length =
+            osec->dss_compressed_length;
+        /*  The owner frees it, never this Dwarf_Debug. */
+        section->dss_data_was_malloc = FALSE;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/*  Load every DWARF section of dbg so
+    that nothing is loaded (or relocated or
+    decompressed) in dbg once other threads
+    are reading its section data.
+    A section that will not load is left alone,
+    using it later gets the same error in any
+    Dwarf_Debug. */
+static void
+load_all_sections(Dwarf_Debug dbg)
+{
+    unsigned i = 0;
+
+    for ( ; i < dbg->de_debug_sections_total_entries; ++i) {
+        struct Dwarf_Section_s *sec =
+            dbg->de_debug_sections[i].ds_secdata;
+        Dwarf_Error lerr = 0;
+        int res = 0;
+
+        if (!sec->dss_index || !sec->dss_size) {
+            continue;
+        }
+        res = _dwarf_load_section(dbg,sec,&lerr);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,lerr);
+        }
+    }
+}
+
+/*  New October 2026.
+    A new Dwarf_Debug on the object dbg reads,
+    sharing the section data dbg has loaded.
+    The new one has its own CU contexts,
+    allocations, and errors so it can be used
+    in another thread while dbg (or another
+    Dwarf_Debug made from it) is used elsewhere. */
+int
+dwarf_init_from_debug(Dwarf_Debug dbg,
+    Dwarf_Handler errhand,
+    Dwarf_Ptr errarg,
+    Dwarf_Debug *ret_dbg,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Shared_Object_s *so = 0;
+    Dwarf_Debug newdbg = 0;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_init_from_debug()");
+    if (!ret_dbg) {
+        _dwarf_error(dbg,error,DW_DLE_DWARF_INIT_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    *ret_dbg = 0;
+    load_all_sections(dbg);
+    so = (struct Dwarf_Shared_Object_s *)calloc(1,
+        sizeof(struct Dwarf_Shared_Object_s));
+    if (!so) {
+        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating the object "
+            "access record in dwarf_init_from_debug()");
+        return DW_DLV_ERROR;
+    }
+    so->so_ident[0] = 'S';
+    so->so_ident[1] = 1;
+    so->so_in_setup = TRUE;
+    so->so_owner_obj = dbg->de_obj_file;
+    so->so_interface.ai_object = so;
+    so->so_interface.ai_methods = &shared_methods;
+    res = object_init_internal(&so->so_interface,
+        errhand,errarg,dbg->de_groupnumber,dbg,
+        &newdbg,error);
+    if (res != DW_DLV_OK) {
+        free(so);
+        return res;
+    }
+    so->so_in_setup = FALSE;
+    newdbg->de_ftype = dbg->de_ftype;
+    newdbg->de_path_source = dbg->de_path_source;
+    if (dbg->de_path) {
+        newdbg->de_path = strdup(dbg->de_path);
+    }
+    newdbg->de_obj_machine = dbg->de_obj_machine;
+    newdbg->de_obj_ub_offset = dbg->de_obj_ub_offset;
+    newdbg->de_obj_flags = dbg->de_obj_flags;
+    newdbg->de_universalbinary_count =
+        dbg->de_universalbinary_count;
+    newdbg->de_universalbinary_index =
+        dbg->de_universalbinary_index;
+    newdbg->de_assume_string_in_bounds =
+        dbg->de_assume_string_in_bounds;
+    newdbg->de_frame_rule_initial_value =
+        dbg->de_frame_rule_initial_value;
+    newdbg->de_frame_reg_rules_entry_count =
+        dbg->de_frame_reg_rules_entry_count;
+    newdbg->de_frame_cfa_col_number =
+        dbg->de_frame_cfa_col_number;
+    newdbg->de_frame_same_value_number =
+        dbg->de_frame_same_value_number;
+    newdbg->de_frame_undefined_value_number =
+        dbg->de_frame_undefined_value_number;
+    newdbg->de_frame_row_cache = dbg->de_frame_row_cache;
+    newdbg->de_decompress_threads = dbg->de_decompress_threads;
+    if (dbg->de_decompress_cache_dir) {
+        newdbg->de_decompress_cache_dir =
+            strdup(dbg->de_decompress_cache_dir);
+    }
+    *ret_dbg = newdbg;
+    return DW_DLV_OK;
+}
+
 #if defined(HAVE_ZLIB) && defined(HAVE_ZSTD)
 /*  case 1:
     The input stream is assumed to contain
@@ -1166,6 +1538,195 @@ dwarf_object_finish(Dwarf_Debug dbg)
 
     */
 
+/*  A zstd section written by a parallel compressor
+    (lld for example) is several zstd frames each
+    recording its decompressed size, so each frame
+    can be decompressed into its own part of
+    the destination independently of the others. */
+struct zstd_frame_s {
+    Dwarf_Small *zf_src;
+    size_t       zf_srclen;
+    Dwarf_Small *zf_dest;
+    size_t       zf_destlen;
+};
+
+/*  Worker zw_first decompresses frames zw_first,
+    zw_first+zw_step, ...  */
+struct zstd_work_s {
+    struct zstd_frame_s *zw_frames;
+    Dwarf_Unsigned       zw_count;
+    Dwarf_Unsigned       zw_first;
+    Dwarf_Unsigned       zw_step;
+    int                  zw_failed;
+};
+
+static void *
+zstd_frames_worker(void *arg)
+{
+    struct zstd_work_s *w = (struct zstd_work_s *)arg;
+    Dwarf_Unsigned i = 0;
+
+    for (i = w->zw_first; i < w->zw_count; i += w->zw_step) {
+        struct zstd_frame_s *f = w->zw_frames + i;
+        size_t zsize = ZSTD_decompress(f->zf_dest,f->zf_destlen,
+            f->zf_src,f->zf_srclen);
+
+        if (ZSTD_isError(zsize) || zsize != f->zf_destlen) {
+            w->zw_failed = TRUE;
+            break;
+        }
+    }
+    return 0;
+}
+
+#define DECOMPRESS_THREADS_MAX 64
+
+/*  Returns DW_DLV_NO_ENTRY if src is not several
+    frames of known size adding up to destlen
+    (or on running out of memory), so the caller
+    should decompress it in one call.
+    Returns DW_DLV_ERROR if a frame failed to
+    decompress.  */
+static int
+decompress_zstd_frames(unsigned int threads,
+    Dwarf_Small *dest, Dwarf_Unsigned destlen,
+    Dwarf_Small *src, Dwarf_Unsigned srclen)
+{
+    struct zstd_frame_s *frames = 0;
+    struct zstd_work_s work[DECOMPRESS_THREADS_MAX];
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned total = 0;
+    Dwarf_Unsigned off = 0;
+    Dwarf_Unsigned i = 0;
+    unsigned int t = 0;
+    int failed = FALSE;
+
+    /*  First count the frames, then record them. */
+    while (off < srclen) {
+        size_t csize = ZSTD_findFrameCompressedSize(src+off,
+            (size_t)(srclen-off));
+        unsigned long long usize = ZSTD_getFrameContentSize(
+            src+off,(size_t)(srclen-off));
+
+        if (ZSTD_isError(csize) ||
+            usize == ZSTD_CONTENTSIZE_UNKNOWN ||
+            usize == ZSTD_CONTENTSIZE_ERROR ||
+            usize > destlen - total) {
+            return DW_DLV_NO_ENTRY;
+        }
+        total += usize;
+        off += csize;
+        ++count;
+    }
+    if (count < 2 || total != destlen) {
+        return DW_DLV_NO_ENTRY;
+    }
+    frames = (struct zstd_frame_s *)calloc(count,
+        sizeof(struct zstd_frame_s));
+    if (!frames) {
+        return DW_DLV_NO_ENTRY;
+    }
+    for (i = 0, off = 0, total = 0; i < count; ++i) {
+        struct zstd_frame_s *f = frames + i;
+
+        f->zf_src = src + off;
+        f->zf_srclen = ZSTD_findFrameCompressedSize(src+off,
+            (size_t)(srclen-off));
+        f->zf_dest = dest + total;
+        f->zf_destlen = (size_t)ZSTD_getFrameContentSize(src+off,
+            (size_t)(srclen-off));
+        off += f->zf_srclen;
+        total += f->zf_destlen;
+    }
+    if (threads > DECOMPRESS_THREADS_MAX) {
+        threads = DECOMPRESS_THREADS_MAX;
+    }
+    if (threads > count) {
+        threads = (unsigned int)count;
+    }
+    for (t = 0; t < threads; ++t) {
+        work[t].zw_frames = frames;
+        work[t].zw_count = count;
+        work[t].zw_first = t;
+        work[t].zw_step = threads;
+        work[t].zw_failed = FALSE;
+    }
+#if defined(HAVE_PTHREAD_H)
+    {
+        pthread_t tids[DECOMPRESS_THREADS_MAX];
+        int started[DECOMPRESS_THREADS_MAX];
+
+        /*  Worker 0 runs here, as does any worker
+            whose thread cannot be started. */
+        for (t = 1; t < threads; ++t) {
+            started[t] = !pthread_create(&tids[t],0,
+                zstd_frames_worker,&work[t]);
+        }
+        zstd_frames_worker(&work[0]);
+        for (t = 1; t < threads; ++t) {
+            if (started[t]) {
+                pthread_join(tids[t],0);
+            } else {
+                zstd_frames_worker(&work[t]);
+            }
+        }
+    }
+#else /* !HAVE_PTHREAD_H */
+    for (t = 0; t < threads; ++t) {
+        zstd_frames_worker(&work[t]);
+    }
+#endif /* HAVE_PTHREAD_H */
+    for (t = 0; t < threads; ++t) {
+        if (work[t].zw_failed) {
+            failed = TRUE;
+        }
+    }
+    free(frames);
+    return failed?DW_DLV_ERROR:DW_DLV_OK;
+}
+
+/*  The cache file of a section is
+    <cache dir>/<build-id in hex><section name>,
+    for example 5bef...9470.debug_info.
+    Returns FALSE if the object has no usable build-id.  */
+static int
+decompress_cache_path(Dwarf_Debug dbg,
+    struct Dwarf_Section_s *section,
+    dwarfstring *path)
+{
+    struct Dwarf_Section_s *note = &dbg->de_note_gnu_buildid;
+    unsigned type = 0;
+    char *owner = 0;
+    unsigned char *buildid = 0;
+    unsigned buildid_len = 0;
+    unsigned i = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    if (!note->dss_size || !section->dss_name) {
+        return FALSE;
+    }
+    res = _dwarf_load_section(dbg,note,&err);
+    if (res == DW_DLV_OK) {
+        res = _dwarf_extract_buildid(dbg,note,&type,&owner,
+            &buildid,&buildid_len,&err);
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+        return FALSE;
+    }
+    if (res != DW_DLV_OK || !buildid_len) {
+        return FALSE;
+    }
+    dwarfstring_append(path,dbg->de_decompress_cache_dir);
+    dwarfstring_append(path,"/");
+    for (i = 0; i < buildid_len; ++i) {
+        dwarfstring_append_printf_u(path,"%02x",buildid[i]);
+    }
+    dwarfstring_append(path,(char *)section->dss_name);
+    return TRUE;
+}
+
 /*  ALLOWED_ZLIB_INFLATION is a heuristic, not necessarily right.
     The test case klingler2/compresseddebug.amd64 actually
     inflates about 8 times.  */
@@ -1354,6 +1915,23 @@ do_decompress(Dwarf_Debug dbg,
         return DW_DLV_ERROR;
     }
     destlen = uncompressed_len;
+    if (dbg->de_decompress_cache_dir) {
+        dwarfstring cachepath;
+
+        dwarfstring_constructor(&cachepath);
+        if (decompress_cache_path(dbg,section,&cachepath)) {
+            dest = _dwarf_read_decompress_cache(
+                dwarfstring_string(&cachepath),destlen);
+        }
+        dwarfstring_destructor(&cachepath);
+        if (dest) {
+            section->dss_data = dest;
+            section->dss_size = destlen;
+            section->dss_data_was_malloc = TRUE;
+            section->dss_did_decompress = TRUE;
+            return DW_DLV_OK;
+        }
+    }
     dest = malloc(destlen);
     if (!dest) {
         _dwarf_error_string(dbg, error,
@@ -1383,8 +1961,21 @@ do_decompress(Dwarf_Debug dbg,
         }
     }
     if (zstdcompress) {
-        size_t zsize =
-            ZSTD_decompress(dest,destlen,src,srclen);
+        size_t zsize = 0;
+        int fres = DW_DLV_NO_ENTRY;
+
+        if (dbg->de_decompress_threads > 1) {
+            fres = decompress_zstd_frames(
+                dbg->de_decompress_threads,
+                dest,destlen,src,srclen);
+        }
+        if (fres == DW_DLV_OK) {
+            zsize = destlen;
+        } else if (fres == DW_DLV_ERROR) {
+            zsize = 0;
+        } else {
+            zsize = ZSTD_decompress(dest,destlen,src,srclen);
+        }
         if (zsize != destlen) {
             free(dest);
             _dwarf_error_string(dbg, error,
@@ -1394,6 +1985,18 @@ do_decompress(Dwarf_Debug dbg,
             return DW_DLV_ERROR;
         }
     }
+    if (dbg->de_decompress_cache_dir) {
+        dwarfstring cachepath;
+
+        dwarfstring_constructor(&cachepath);
+        if (decompress_cache_path(dbg,section,&cachepath)) {
+            /*  Failure just means the next open
+                decompresses again. */
+            (void)_dwarf_write_decompress_cache(
+                dwarfstring_string(&cachepath),dest,destlen);
+        }
+        dwarfstring_destructor(&cachepath);
+    }
     /* Z_OK */
     section->dss_data = dest;
     section->dss_size = destlen;
@@ -1418,6 +2021,10 @@ _dwarf_load_section(Dwarf_Debug dbg,
     if (section->dss_data !=  NULL) {
         return DW_DLV_OK;
     }
+    if (dbg->de_section_owner &&
+        borrow_owner_section(dbg->de_section_owner,section)) {
+        return DW_DLV_OK;
+    }
     o = dbg->de_obj_file;
     /*  There is an elf convention that section index 0
         is reserved, and that section is always empty.
@@ -1484,7 +2091,7 @@ _dwarf_load_section(Dwarf_Debug dbg,
 #endif /* defined(HAVE_ZLIB) && defined(HAVE_ZSTD) */
         section->dss_did_decompress = TRUE;
     }
-    if (_dwarf_apply_relocs == 0) {
+    if (dbg->de_apply_relocs == 0) {
         return res;
     }
     if (section->dss_reloc_size == 0) {
@@ -368,6 +368,177 @@ dwarf_decode_signed_leb128(char * leb128,
     return DW_DLV_OK;
 }
 
+/*  Bulk decoding of runs of LEB values.
+    Where eight bytes are available the bytes are
+    gathered into one 64 bit word (in little-endian
+    order whatever the host, so this is portable),
+    the terminating byte is found from the high bits
+    of all eight bytes at once, and the 7-bit groups
+    are packed together with three mask-and-shift
+    steps, the SWAR equivalent of the SSE/NEON
+    masked varint decoders.  That covers values of
+    up to 8 bytes (56 bits), which is nearly every
+    LEB in DWARF.  Anything else (longer values,
+    padding, the last few bytes before endptr,
+    errors) goes to the byte-at-a-time decoders
+    above, so results are identical to calling
+    those once per value. */
+#define LEB_HIGH_BITS 0x8080808080808080ULL
+
+/*  Returns the number of bytes (1 to 8) of the LEB
+    at leb, 0 if the fast path does not apply.  */
+static unsigned
+leb_fast_decode(const unsigned char *leb,
+    const unsigned char *endptr,
+    Dwarf_Unsigned *value_out)
+{
+    Dwarf_Unsigned w = 0;
+    Dwarf_Unsigned stop = 0;
+    unsigned nbytes = 0;
+
+    if (sizeof(Dwarf_Unsigned) != 8 || (endptr - leb) < 8) {
+        return 0;
+    }
+    w = (Dwarf_Unsigned)leb[0] |
+        ((Dwarf_Unsigned)leb[1] << 8) |
+        ((Dwarf_Unsigned)leb[2] << 16) |
+        ((Dwarf_Unsigned)leb[3] << 24) |
+        ((Dwarf_Unsigned)leb[4] << 32) |
+        ((Dwarf_Unsigned)leb[5] << 40) |
+        ((Dwarf_Unsigned)leb[6] << 48) |
+        ((Dwarf_Unsigned)leb[7] << 56);
+    stop = ~w & LEB_HIGH_BITS;
+    if (!stop) {
+        return 0;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    nbytes = ((unsigned)__builtin_ctzll(stop) >> 3) + 1;
+#else
+    for (nbytes = 1; !(stop & 0x80); stop >>= 8) {
+        ++nbytes;
+    }
+#endif
+    if (nbytes < 8) {
+        w &= (((Dwarf_Unsigned)1) << (nbytes * 8)) - 1;
+    }
+    w &= 0x7f7f7f7f7f7f7f7fULL;
+    /*  7 bit groups to 14 bits in each 16, then
+        28 in each 32, then 56. */
+    w = ((w & 0x7f007f007f007f00ULL) >> 1) |
+        (w & 0x007f007f007f007fULL);
+    w = ((w & 0x3fff00003fff0000ULL) >> 2) |
+        (w & 0x00003fff00003fffULL);
+    w = ((w & 0x0fffffff00000000ULL) >> 4) |
+        (w & 0x000000000fffffffULL);
+    *value_out = w;
+    return nbytes;
+}
+
+/*  Decode count ULEB values, one after another,
+    from leb into values. *leb128_length is set to
+    the total number of bytes used.
+    On error values up to the bad one are
+    filled in and nothing else is set. */
+int
+dwarf_decode_leb128_bulk(char * leb128,
+    Dwarf_Unsigned count,
+    Dwarf_Unsigned *values,
+    Dwarf_Unsigned *leb128_length,
+    char * endptr)
+{
+    unsigned char *cur = (unsigned char *)leb128;
+    unsigned char *end = (unsigned char *)endptr;
+    Dwarf_Unsigned i = 0;
+
+    if (!values || cur > end) {
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < count; ++i) {
+        unsigned nbytes = 0;
+        Dwarf_Unsigned len = 0;
+        int res = 0;
+
+        /*  One and two byte values are the most common. */
+        if (cur < end && !(*cur & 0x80)) {
+            values[i] = *cur;
+            ++cur;
+            continue;
+        }
+        nbytes = leb_fast_decode(cur,end,&values[i]);
+        if (nbytes) {
+            cur += nbytes;
+            continue;
+        }
+        res = dwarf_decode_leb128((char *)cur,&len,
+            &values[i],endptr);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        cur += len;
+    }
+    if (leb128_length) {
+        *leb128_length = (Dwarf_Unsigned)(cur -
+            (unsigned char *)leb128);
+    }
+    return DW_DLV_OK;
+}
+
+/*  As dwarf_decode_leb128_bulk() but for SLEB values. */
+int
+dwarf_decode_signed_leb128_bulk(char * leb128,
+    Dwarf_Unsigned count,
+    Dwarf_Signed *values,
+    Dwarf_Unsigned *leb128_length,
+    char * endptr)
+{
+    unsigned char *cur = (unsigned char *)leb128;
+    unsigned char *end = (unsigned char *)endptr;
+    Dwarf_Unsigned i = 0;
+
+    if (!values || cur > end) {
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < count; ++i) {
+        unsigned nbytes = 0;
+        Dwarf_Unsigned uval = 0;
+        Dwarf_Unsigned len = 0;
+        int res = 0;
+
+        if (cur < end && !(*cur & 0x80)) {
+            uval = *cur;
+            if (uval & SIGN_BIT) {
+                uval |= ~(Dwarf_Unsigned)DATA_MASK;
+            }
+            values[i] = (Dwarf_Signed)uval;
+            ++cur;
+            continue;
+        }
+        nbytes = leb_fast_decode(cur,end,&uval);
+        if (nbytes) {
+            /*  The last byte carries the sign. A shift
+                of at most 56 is well defined. */
+            if (cur[nbytes-1] & SIGN_BIT) {
+                uval |= ~((((Dwarf_Unsigned)1) <<
+                    (nbytes * DIGIT_WIDTH)) - 1);
+            }
+            values[i] = (Dwarf_Signed)uval;
+            cur += nbytes;
+            continue;
+        }
+        res = dwarf_decode_signed_leb128((char *)cur,&len,
+            &values[i],endptr);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        cur += len;
+    }
+    if (leb128_length) {
+        *leb128_length = (Dwarf_Unsigned)(cur -
+            (unsigned char *)leb128);
+    }
+    return DW_DLV_OK;
+}
+
 /*  Encode val as a uleb128. This encodes it as an unsigned
     number.
     Return DW_DLV_ERROR or DW_DLV_OK.
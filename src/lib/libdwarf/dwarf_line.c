@@ -152,50 +152,24 @@ _dwarf_file_name_is_full_path(Dwarf_Small  *fname)
 }
 #include "dwarf_line_table_reader_common.h"
 
-/*  Used for a short time in the next two functions.
-    Not saved.  If multithreading ever allowed this
-    will have to change to be function local
-    non-static buffers. */
-static char targbuf[300];
-static char nbuf[300];
+/*  Size of the function-local buffers used
+    with dwarfstring_constructor_static() in the
+    next two functions. Large enough that almost
+    never will any malloc be needed by dwarfstring. */
+#define PATHBUFLEN 300
 
-static int
-ret_simple_full_path(Dwarf_Debug dbg,
-    char *file_name,
-    char ** name_ptr_out,
-    Dwarf_Error *error)
+static void
+simple_full_path(char *file_name,
+    dwarfstring *targ)
 {
-    char *tmp = 0;
-    char * mstr = 0;
-    size_t mlen = 0;
-    dwarfstring targ;
     dwarfstring nxt;
+    char nbuf[PATHBUFLEN];
 
-    dwarfstring_constructor_static(&targ,
-        targbuf,sizeof(targbuf));
     dwarfstring_constructor_static(&nxt,
         nbuf,sizeof(nbuf));
-
     dwarfstring_append(&nxt,file_name);
-    _dwarf_pathjoinl(&targ,&nxt);
-    mstr= dwarfstring_string(&targ);
-    mlen = dwarfstring_strlen(&targ) +1;
-    tmp = (char *) _dwarf_get_alloc(dbg, DW_DLA_STRING,
-        (Dwarf_Unsigned)mlen);
-    if (tmp) {
-        _dwarf_safe_strcpy(tmp,mlen, mstr,mlen-1);
-        *name_ptr_out = tmp;
-        dwarfstring_destructor(&targ);
-        dwarfstring_destructor(&nxt);
-        return DW_DLV_OK;
-    }
-    dwarfstring_destructor(&targ);
+    _dwarf_pathjoinl(targ,&nxt);
     dwarfstring_destructor(&nxt);
-    _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
-        "DW_DLE_ALLOC_FAIL: "
-        "Allocation of space for a simple full path "
-        "from line table header data fails." );
-    return DW_DLV_ERROR;
 }
 
 static void
@@ -237,15 +211,7 @@ _dwarf_dirno_string(Dwarf_Line_Context line_context,
 /*  With this routine we ensure the file full path
     is calculated identically for
     dwarf_srcfiles() and _dwarf_filename()
-
-    As of March 14 2020 this *always*
-    does an allocation for the string. dwarf_dealloc
-    is crucial to do no matter what.
-    So we have consistency.
-
-    dwarf_finish() will do the dealloc if nothing else does.
-    Unless the calling application did the call
-    dwarf_set_de_alloc_flag(0).
+    The path is appended to targ.
 
     The treatment of DWARF5 differs from DWARF < 5
     as the line table header in DW5 lists the
@@ -254,18 +220,14 @@ _dwarf_dirno_string(Dwarf_Line_Context line_context,
     _dwarf_pathjoinl() takes care of / and Windows \
 */
 static int
-create_fullest_file_path(Dwarf_Debug dbg,
+build_fullest_file_path(Dwarf_Debug dbg,
     Dwarf_File_Entry fe,
     Dwarf_Line_Context line_context,
-    char ** name_ptr_out,
+    dwarfstring *targ,
     Dwarf_Error *error)
 {
     Dwarf_Unsigned dirno = 0;
-    char *full_name = 0;
     char *file_name = 0;
-    /*  Large enough that almost never will any malloc
-        be needed by dwarfstring.  Arbitrary size. */
-    dwarfstring targ;
     unsigned linetab_version = line_context->lc_version_number;
 
     file_name = (char *) fe->fi_file_name;
@@ -274,25 +236,18 @@ create_fullest_file_path(Dwarf_Debug dbg,
         return DW_DLV_ERROR;
     }
     if (_dwarf_file_name_is_full_path((Dwarf_Small *)file_name)) {
-        int res = 0;
-
-        res = ret_simple_full_path(dbg,
-            file_name,
-            name_ptr_out,
-            error);
-        return res;
+        simple_full_path(file_name,targ);
+        return DW_DLV_OK;
     }
     {
         int need_dir = FALSE;
         unsigned include_dir_offset = 1;
-        static char compdirbuf[300];
-        static char filenamebuf[300];
+        char compdirbuf[PATHBUFLEN];
+        char filenamebuf[PATHBUFLEN];
         dwarfstring compdir;
         dwarfstring incdir;
         dwarfstring filename;
 
-        dwarfstring_constructor_static(&targ,
-            targbuf,sizeof(targbuf));
         dwarfstring_constructor_static(&compdir,
             compdirbuf,sizeof(compdirbuf));
         dwarfstring_constructor_fixed(&incdir,300);
@@ -323,7 +278,6 @@ create_fullest_file_path(Dwarf_Debug dbg,
 
         if (dirno > line_context->lc_include_directories_count) {
             /*  This is quite corrupted. */
-            dwarfstring_destructor(&targ);
             dwarfstring_destructor(&compdir);
             dwarfstring_destructor(&filename);
             dwarfstring_reset(&incdir);
@@ -350,8 +304,8 @@ create_fullest_file_path(Dwarf_Debug dbg,
 
             /* incdir is full path,Ignore DW_AT_comp_dir
                 and (for DWARF5 include_dir[0]) */
-            _dwarf_pathjoinl(&targ,&incdir);
-            _dwarf_pathjoinl(&targ,&filename);
+            _dwarf_pathjoinl(targ,&incdir);
+            _dwarf_pathjoinl(targ,&filename);
         } else {
             /* Join two or all three strings,
                 ignoring empty/irrelevant ones. */
@@ -359,7 +313,7 @@ create_fullest_file_path(Dwarf_Debug dbg,
                 the experimental line table */
             if (linetab_version != DW_LINE_VERSION5) {
                 if (dwarfstring_strlen(&compdir) > 0) {
-                    _dwarf_pathjoinl(&targ,&compdir);
+                    _dwarf_pathjoinl(targ,&compdir);
                 }
             } else if (!include_dir_offset && dirno)  {
                 /*  Don't do this if DW5 and dirno
@@ -369,31 +323,14 @@ create_fullest_file_path(Dwarf_Debug dbg,
                 _dwarf_dirno_string(line_context,0,
                     include_dir_offset,&compdir);
                 if (dwarfstring_strlen(&compdir) > 0) {
-                    _dwarf_pathjoinl(&targ,&compdir);
+                    _dwarf_pathjoinl(targ,&compdir);
                 }
             }
             if (dwarfstring_strlen(&incdir) > 0) {
-                _dwarf_pathjoinl(&targ,&incdir);
+                _dwarf_pathjoinl(targ,&incdir);
             }
-            _dwarf_pathjoinl(&targ,&filename);
-        }
-        {
-            char *mname = dwarfstring_string(&targ);
-            size_t mlen = dwarfstring_strlen(&targ)+1;
-            full_name = (char *) _dwarf_get_alloc(dbg, DW_DLA_STRING,
-                (Dwarf_Unsigned)mlen);
-            if (!full_name) {
-                dwarfstring_destructor(&targ);
-                dwarfstring_destructor(&incdir);
-                dwarfstring_destructor(&compdir);
-                dwarfstring_destructor(&filename);
-                _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                return DW_DLV_ERROR;
-            }
-            _dwarf_safe_strcpy(full_name,mlen,mname,mlen-1);
+            _dwarf_pathjoinl(targ,&filename);
         }
-        *name_ptr_out = full_name;
-        dwarfstring_destructor(&targ);
         dwarfstring_destructor(&incdir);
         dwarfstring_destructor(&compdir);
         dwarfstring_destructor(&filename);
@@ -401,6 +338,174 @@ create_fullest_file_path(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  As of March 14 2020 this *always*
+    does an allocation for the string. dwarf_dealloc
+    is crucial to do no matter what.
+    So we have consistency.
+
+    dwarf_finish() will do the dealloc if nothing else does.
+    Unless the calling application did the call
+    dwarf_set_de_alloc_flag(0).  */
+static int
+copy_to_dla_string(Dwarf_Debug dbg,
+    const char *name,
+    size_t namelen,
+    char **name_ptr_out,
+    Dwarf_Error *error)
+{
+    char *full_name = 0;
+    size_t mlen = namelen+1;
+
+    full_name = (char *) _dwarf_get_alloc(dbg, DW_DLA_STRING,
+        (Dwarf_Unsigned)mlen);
+    if (!full_name) {
+        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: "
+            "Allocation of space for a full path "
+            "from line table header data fails." );
+        return DW_DLV_ERROR;
+    }
+    _dwarf_safe_strcpy(full_name,mlen,name,namelen);
+    *name_ptr_out = full_name;
+    return DW_DLV_OK;
+}
+
+static int
+create_fullest_file_path(Dwarf_Debug dbg,
+    Dwarf_File_Entry fe,
+    Dwarf_Line_Context line_context,
+    char ** name_ptr_out,
+    Dwarf_Error *error)
+{
+    dwarfstring targ;
+    char targbuf[PATHBUFLEN];
+    int res = 0;
+
+    dwarfstring_constructor_static(&targ,
+        targbuf,sizeof(targbuf));
+    res = build_fullest_file_path(dbg,fe,line_context,
+        &targ,error);
+    if (res == DW_DLV_OK) {
+        res = copy_to_dla_string(dbg,dwarfstring_string(&targ),
+            dwarfstring_strlen(&targ),name_ptr_out,error);
+    }
+    dwarfstring_destructor(&targ);
+    return res;
+}
+
+/*  The full path of each file entry is built the first
+    time it is asked for and kept with the line context,
+    so printing or looking up many rows does not join
+    the same directories and names again.
+    Entries from DW_LNE_define_file can be added after
+    the first lookup, so the arrays grow as needed. */
+static int
+line_context_file_path(Dwarf_Line_Context context,
+    Dwarf_Unsigned entryindex,
+    const char **path_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = context->lc_dbg;
+    Dwarf_Unsigned count = context->lc_file_entry_count;
+    dwarfstring targ;
+    char targbuf[PATHBUFLEN];
+    char *path = 0;
+    size_t len = 0;
+    int res = 0;
+
+    if (entryindex >= count) {
+        _dwarf_error(dbg, error, DW_DLE_NO_FILE_NAME);
+        return DW_DLV_ERROR;
+    }
+    if (count > context->lc_file_paths_count) {
+        Dwarf_Unsigned old = context->lc_file_paths_count;
+        Dwarf_File_Entry fe = 0;
+        Dwarf_File_Entry *entries = 0;
+        char **paths = 0;
+        Dwarf_Unsigned i = 0;
+
+        paths = (char **)realloc(context->lc_file_paths,
+            count*sizeof(char *));
+        if (paths) {
+            context->lc_file_paths = paths;
+            entries = (Dwarf_File_Entry *)realloc(
+                context->lc_file_entry_array,
+                count*sizeof(Dwarf_File_Entry));
+        }
+        if (!entries) {
+            _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: "
+                "Allocation of the line table file path "
+                "array fails.");
+            return DW_DLV_ERROR;
+        }
+        context->lc_file_entry_array = entries;
+        fe = context->lc_file_entries;
+        for (i = 0; i < count && fe; ++i, fe = fe->fi_next) {
+            if (i >= old) {
+                paths[i] = 0;
+            }
+            entries[i] = fe;
+        }
+        if (i < count) {
+            /*  The list is shorter than its count. */
+            for ( ; i < count; ++i) {
+                paths[i] = 0;
+                entries[i] = 0;
+            }
+        }
+        context->lc_file_paths_count = count;
+    }
+    if (context->lc_file_paths[entryindex]) {
+        *path_out = context->lc_file_paths[entryindex];
+        return DW_DLV_OK;
+    }
+    if (!context->lc_file_entry_array[entryindex]) {
+        _dwarf_error(dbg, error, DW_DLE_NO_FILE_NAME);
+        return DW_DLV_ERROR;
+    }
+    dwarfstring_constructor_static(&targ,
+        targbuf,sizeof(targbuf));
+    res = build_fullest_file_path(dbg,
+        context->lc_file_entry_array[entryindex],
+        context,&targ,error);
+    if (res != DW_DLV_OK) {
+        dwarfstring_destructor(&targ);
+        return res;
+    }
+    len = dwarfstring_strlen(&targ);
+    path = (char *)malloc(len+1);
+    if (!path) {
+        dwarfstring_destructor(&targ);
+        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: "
+            "Allocation of a line table file path fails.");
+        return DW_DLV_ERROR;
+    }
+    _dwarf_safe_strcpy(path,len+1,dwarfstring_string(&targ),len);
+    dwarfstring_destructor(&targ);
+    context->lc_file_paths[entryindex] = path;
+    *path_out = path;
+    return DW_DLV_OK;
+}
+
+static void
+free_line_context_file_paths(Dwarf_Line_Context context)
+{
+    Dwarf_Unsigned i = 0;
+
+    if (context->lc_file_paths) {
+        for (i = 0; i < context->lc_file_paths_count; ++i) {
+            free(context->lc_file_paths[i]);
+        }
+        free(context->lc_file_paths);
+        context->lc_file_paths = 0;
+    }
+    free(context->lc_file_entry_array);
+    context->lc_file_entry_array = 0;
+    context->lc_file_paths_count = 0;
+}
+
 static void
 report_bogus_stmt_list_form(Dwarf_Debug dbg,
     Dwarf_Half attrform, Dwarf_Error *error)
@@ -757,6 +862,7 @@ _dwarf_internal_srclines(Dwarf_Die die,
     Dwarf_Signed * linecount_actuals,
     Dwarf_Bool doaddrs,
     Dwarf_Bool dolines,
+    struct Dwarf_Line_Index_s *line_index,
     Dwarf_Error * error)
 {
     /*  This pointer is used to scan the portion of the .debug_line
@@ -897,6 +1003,7 @@ _dwarf_internal_srclines(Dwarf_Die die,
     }
     line_context->lc_new_style_access = is_new_interface;
     line_context->lc_compilation_directory = comp_dir;
+    line_context->lc_line_index = line_index;
     /*  We are in dwarf_internal_srclines() */
     {
         Dwarf_Small *newlinep = 0;
@@ -1019,7 +1126,7 @@ _dwarf_internal_srclines(Dwarf_Die die,
         if (linebuf) {
             *linebuf = line_context->lc_linebuf_logicals;
         }
-        if (is_new_interface) {
+        if (is_new_interface && !line_index) {
             /* ASSERT: linebuf_actuals == NULL  */
             is_actuals_table = true;
             /* The call requested an actuals table
@@ -1069,6 +1176,7 @@ _dwarf_internal_srclines(Dwarf_Die die,
         line_context = 0;
         return DW_DLV_OK;
     }
+    line_context->lc_line_index = 0;
     *table_count = line_context->lc_table_count;
     if (version != NULL) {
         *version = line_context->lc_version_number;
@@ -1208,6 +1316,7 @@ dwarf_srclines_b(Dwarf_Die die,
         &linecount_actuals,
         /* addrlist= */ false,
         /* linelist= */ true,
+        /* line_index= */ NULL,
         error);
     if (res == DW_DLV_OK) {
         (*line_context)->lc_new_style_access = true;
@@ -1826,15 +1935,15 @@ dwarf_lineoff_b(Dwarf_Line line,
     return DW_DLV_OK;
 }
 
+/*  Sets *ret_filename to the full path kept
+    with the context, see line_context_file_path(). */
 static int
-_dwarf_filename(Dwarf_Line_Context context,
+borrow_filename(Dwarf_Line_Context context,
     Dwarf_Unsigned fileno_in,
-    char **ret_filename,
+    const char **ret_filename,
     const char *callername,
     Dwarf_Error *error)
 {
-    Dwarf_Signed i = 0;
-    Dwarf_File_Entry file_entry = 0;
     Dwarf_Debug dbg = context->lc_dbg;
     int res = 0;
     Dwarf_Signed baseindex = 0;
@@ -1960,16 +2069,30 @@ _dwarf_filename(Dwarf_Line_Context context,
         }
     }
 
-    file_entry = context->lc_file_entries;
     /*  zero fileno allowed for DWARF5 table. For DWARF4,
         zero fileno handled above. */
-    for (i =  baseindex; i < fileno ; i++) {
-        file_entry = file_entry->fi_next;
-    }
+    return line_context_file_path(context,
+        (Dwarf_Unsigned)(fileno - baseindex),
+        ret_filename,error);
+}
 
-    res = create_fullest_file_path(dbg,
-        file_entry,context, ret_filename,error);
-    return res;
+int
+_dwarf_filename(Dwarf_Line_Context context,
+    Dwarf_Unsigned fileno_in,
+    char **ret_filename,
+    const char *callername,
+    Dwarf_Error *error)
+{
+    const char *path = 0;
+    int res = 0;
+
+    res = borrow_filename(context,fileno_in,&path,
+        callername,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return copy_to_dla_string(context->lc_dbg,path,
+        strlen(path),ret_filename,error);
 }
 
 int
@@ -1989,6 +2112,38 @@ dwarf_linesrc(Dwarf_Line line, char **ret_linesrc,
         "dwarf_linesrc",error);
 }
 
+int
+dwarf_line_srcpath(Dwarf_Line line, const char **ret_path,
+    Dwarf_Error * error)
+{
+    if (line == NULL) {
+        _dwarf_error(NULL, error, DW_DLE_DWARF_LINE_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (line->li_context == NULL) {
+        _dwarf_error(NULL, error, DW_DLE_LINE_CONTEXT_NULL);
+        return DW_DLV_ERROR;
+    }
+    return borrow_filename(line->li_context,
+        line->li_l_data.li_file, ret_path,
+        "dwarf_line_srcpath",error);
+}
+
+int
+dwarf_srclines_file_path(Dwarf_Line_Context line_context,
+    Dwarf_Unsigned fileno,
+    const char **ret_path,
+    Dwarf_Error * error)
+{
+    if (!line_context ||
+        line_context->lc_magic != DW_CONTEXT_MAGIC) {
+        _dwarf_error(NULL, error, DW_DLE_LINE_CONTEXT_NULL);
+        return DW_DLV_ERROR;
+    }
+    return borrow_filename(line_context,fileno,ret_path,
+        "dwarf_srclines_file_path",error);
+}
+
 /*  Every line table entry potentially has the basic-block-start
     flag marked 'on'.   This returns thru *return_bool,
     the basic-block-start flag.
@@ -2137,6 +2292,7 @@ delete_line_context_itself(Dwarf_Line_Context context)
     context->lc_file_entry_count = 0;
     context->lc_file_entry_baseindex = 0;
     context->lc_file_entry_endindex = 0;
+    free_line_context_file_paths(context);
     if (context->lc_subprogs) {
         free(context->lc_subprogs);
         context->lc_subprogs = 0;
@@ -2628,6 +2784,7 @@ _dwarf_line_context_destructor(void *m)
         line_context->lc_include_directories = 0;
         line_context->lc_include_directories_count = 0;
     }
+    free_line_context_file_paths(line_context);
     if (line_context->lc_file_entries) {
         Dwarf_File_Entry fe = line_context->lc_file_entries;
         while(fe) {
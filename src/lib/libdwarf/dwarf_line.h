@@ -264,6 +264,20 @@ struct Dwarf_Line_Context_s {
     /* Non-zero only if two-level table with actuals */
     Dwarf_Line   *lc_linebuf_actuals;
     Dwarf_Unsigned lc_linecount_actuals;
+
+    /*  Non-null only while dwarf_srclines_lookup_pc()
+        is reading the table: rows go here instead of
+        into Dwarf_Line records. */
+    struct Dwarf_Line_Index_s *lc_line_index;
+
+    /*  Full paths of the file entries, each built the
+        first time it is needed and freed with the context.
+        lc_file_paths[i] and lc_file_entry_array[i] are
+        for the file entry i places along lc_file_entries.
+        Both have lc_file_paths_count slots. */
+    char           **lc_file_paths;
+    Dwarf_File_Entry *lc_file_entry_array;
+    Dwarf_Unsigned   lc_file_paths_count;
 };
 
 /*  The line table set of registers.
@@ -293,6 +307,39 @@ void _dwarf_set_line_table_regs_default_values(
     unsigned lineversion,
     Dwarf_Bool is_stmt);
 
+/*  The rows of one line table, in address order,
+    kept as parallel arrays so a pc lookup touches
+    only lx_address until the row is found.
+    Each sequence is ls_row_count rows starting
+    at ls_first_row; the end_sequence row that
+    gives ls_high is not kept.
+    ls_maxhigh is the largest ls_high of this and
+    all earlier sequences so overlapping
+    sequences can be searched in order. */
+struct Dwarf_Line_Sequence_s {
+    Dwarf_Addr     ls_low;
+    Dwarf_Addr     ls_high;
+    Dwarf_Addr     ls_maxhigh;
+    Dwarf_Unsigned ls_first_row;
+    Dwarf_Unsigned ls_row_count;
+};
+struct Dwarf_Line_Index_s {
+    Dwarf_Line_Context lx_context;
+    Dwarf_Unsigned lx_row_count;
+    Dwarf_Unsigned lx_rows_allocated;
+    Dwarf_Addr    *lx_address;
+    unsigned int  *lx_file;
+    unsigned int  *lx_line;
+    unsigned int  *lx_column;
+    Dwarf_Small   *lx_flags;
+    Dwarf_Unsigned lx_sequence_count;
+    struct Dwarf_Line_Sequence_s *lx_sequences;
+};
+int _dwarf_line_index_add_row(Dwarf_Debug dbg,
+    struct Dwarf_Line_Index_s *index,
+    Dwarf_Line_Registers regs,
+    Dwarf_Error *error);
+
 /*
     This structure defines a row of the line table.
     All of the fields
@@ -320,7 +367,7 @@ struct Dwarf_Line_s {
             In actuals table is index into logicals table. 1-N*/
         Dwarf_Unsigned li_line;
 
-        Dwarf_Half li_column; /*source file column number 1-N */
+        unsigned int li_column; /*source file column number 1-N */
         Dwarf_Half li_isa;   /*New as of DWARF4. */
 
         /*  Two-level line tables.
@@ -374,6 +421,7 @@ int _dwarf_internal_srclines(Dwarf_Die die,
     Dwarf_Signed * count_actuals,
     Dwarf_Bool doaddrs,
     Dwarf_Bool dolines,
+    struct Dwarf_Line_Index_s *line_index,
     Dwarf_Error * error);
 
 /*  The LOP, WHAT_IS_OPCODE stuff is here so it can
@@ -484,6 +532,11 @@ void _dwarf_free_chain_entries(Dwarf_Debug dbg,Dwarf_Chain head,
 int _dwarf_line_context_constructor(Dwarf_Debug dbg, void *m);
 void _dwarf_line_context_destructor(void *m);
 
+int _dwarf_filename(Dwarf_Line_Context context,
+    Dwarf_Unsigned fileno_in,
+    char **ret_filename,
+    const char *callername,
+    Dwarf_Error *error);
 void _dwarf_print_line_context_record(Dwarf_Debug dbg,
     Dwarf_Line_Context line_context);
 void _dwarf_context_src_files_destroy(Dwarf_Line_Context context);
@@ -127,6 +127,50 @@ read_uword_de(Dwarf_Small **lp,
     return DW_DLV_OK;
 }
 
+/*  Reads the (content type, form) ULEB pairs of a
+    DWARF5 directory or file name entry format,
+    a run of ULEBs, with dwarf_decode_leb128_bulk(). */
+#define FORMAT_PAIR_CHUNK 32
+static int
+read_format_pairs_de(Dwarf_Small **lp,
+    struct Dwarf_Unsigned_Pair_s *pairs,
+    Dwarf_Unsigned count,
+    Dwarf_Debug dbg,
+    Dwarf_Error *err,
+    Dwarf_Small *lpend)
+{
+    Dwarf_Unsigned vals[2*FORMAT_PAIR_CHUNK];
+    Dwarf_Unsigned done = 0;
+
+    while (done < count) {
+        Dwarf_Unsigned n = count - done;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Unsigned k = 0;
+        int res = 0;
+
+        if (n > FORMAT_PAIR_CHUNK) {
+            n = FORMAT_PAIR_CHUNK;
+        }
+        res = dwarf_decode_leb128_bulk((char *)*lp,2*n,vals,
+            &len,(char *)lpend);
+        if (res != DW_DLV_OK) {
+            _dwarf_error_string(dbg, err,
+                DW_DLE_LEB_IMPROPER,
+                "DW_DLE_LEB_IMPROPER: decode uleb"
+                " runs past allowed area reading"
+                " line table entry formats");
+            return DW_DLV_ERROR;
+        }
+        for (k = 0; k < n; ++k) {
+            pairs[done+k].up_first = vals[2*k];
+            pairs[done+k].up_second = vals[2*k+1];
+        }
+        *lp += len;
+        done += n;
+    }
+    return DW_DLV_OK;
+}
+
 /*  A bogus value read from a line table */
 static void
 IssueExpError(Dwarf_Debug dbg,
@@ -709,26 +753,16 @@ _dwarf_read_line_table_header(Dwarf_Debug dbg,
                 _dwarf_error(dbg, err, DW_DLE_ALLOC_FAIL);
                 return DW_DLV_ERROR;
             }
-            for (i = 0; i < directory_format_count; i++) {
-                dres=read_uword_de(&line_ptr,
-                    &format_values[i].up_first,
-                    dbg,err,line_ptr_end);
-                if (dres != DW_DLV_OK) {
-                    free(format_values);
-                    format_values = 0;
-                    return dres;
-                }
-                dres=read_uword_de(&line_ptr,
-                    &format_values[i].up_second,
-                    dbg,err,line_ptr_end);
-                if (dres != DW_DLV_OK) {
-                    free(format_values);
-                    format_values = 0;
-                    return dres;
-                }
-                /*  FIXME: what would be appropriate tests
-                    of this pair of values? */
+            dres = read_format_pairs_de(&line_ptr,
+                format_values,directory_format_count,
+                dbg,err,line_ptr_end);
+            if (dres != DW_DLV_OK) {
+                free(format_values);
+                format_values = 0;
+                return dres;
             }
+            /*  FIXME: what would be appropriate tests
+                of these pairs of values? */
         }
         dres = read_uword_de(&line_ptr,&directories_count,
             dbg,err,line_ptr_end);
@@ -868,24 +902,15 @@ _dwarf_read_line_table_header(Dwarf_Debug dbg,
                 "reading filename format entries");
             return DW_DLV_ERROR;
         }
-        for (i = 0; i < filename_format_count; i++) {
-            dres=read_uword_de(&line_ptr,
-                &filename_entry_pairs[i].up_first,
-                dbg,err,line_ptr_end);
-            if (dres != DW_DLV_OK) {
-                free(filename_entry_pairs);
-                return dres;
-            }
-            dres=read_uword_de(&line_ptr,
-                &filename_entry_pairs[i].
-                up_second, dbg,err,line_ptr_end);
-            if (dres != DW_DLV_OK) {
-                free(filename_entry_pairs);
-                return dres;
-            }
-            /*  FIXME: what would be appropriate tests
-                of this pair of values? */
+        dres = read_format_pairs_de(&line_ptr,
+            filename_entry_pairs,filename_format_count,
+            dbg,err,line_ptr_end);
+        if (dres != DW_DLV_OK) {
+            free(filename_entry_pairs);
+            return dres;
         }
+        /*  FIXME: what would be appropriate tests
+            of these pairs of values? */
         /* DECODE_LEB128_UWORD_CK(line_ptr, files_count,
             dbg,err,line_ptr_end); */
         dres=read_uword_de(&line_ptr,&files_count,
@@ -1573,6 +1598,13 @@ read_line_table_program(Dwarf_Debug dbg,
             }
 #endif /* PRINTING_DETAILS */
 
+            if (line_context->lc_line_index) {
+                int rres = _dwarf_line_index_add_row(dbg,
+                    line_context->lc_line_index,&regs,error);
+                if (rres != DW_DLV_OK) {
+                    return rres;
+                }
+            }
             if (dolines) {
                 curr_line =
                     (Dwarf_Line) _dwarf_get_alloc(dbg,DW_DLA_LINE,1);
@@ -1593,7 +1625,7 @@ read_line_table_program(Dwarf_Debug dbg,
                 curr_line->li_l_data.li_line =
                     (Dwarf_Signed) regs.lr_line;
                 curr_line->li_l_data.li_column =
-                    (Dwarf_Half) regs.lr_column;
+                    (unsigned int) regs.lr_column;
                 curr_line->li_l_data.li_is_stmt =
                     regs.lr_is_stmt;
                 curr_line->li_l_data.li_basic_block =
@@ -1653,6 +1685,13 @@ read_line_table_program(Dwarf_Debug dbg,
                     &regs,is_single_table,
                     is_actuals_table);
 #endif /* PRINTING_DETAILS */
+                if (line_context->lc_line_index) {
+                    int rres = _dwarf_line_index_add_row(dbg,
+                        line_context->lc_line_index,&regs,error);
+                    if (rres != DW_DLV_OK) {
+                        return rres;
+                    }
+                }
                 if (dolines) {
                     curr_line = (Dwarf_Line) _dwarf_get_alloc(dbg,
                         DW_DLA_LINE, 1);
@@ -1674,7 +1713,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     curr_line->li_l_data.li_line =
                         (Dwarf_Signed) regs.lr_line;
                     curr_line->li_l_data.li_column =
-                        (Dwarf_Half) regs.lr_column;
+                        (unsigned int) regs.lr_column;
                     curr_line->li_l_data.li_is_stmt =
                         regs.lr_is_stmt;
                     curr_line->li_l_data.
@@ -2397,6 +2436,13 @@ read_line_table_program(Dwarf_Debug dbg,
 
             case DW_LNE_end_sequence:{
                 regs.lr_end_sequence = true;
+                if (line_context->lc_line_index) {
+                    int rres = _dwarf_line_index_add_row(dbg,
+                        line_context->lc_line_index,&regs,error);
+                    if (rres != DW_DLV_OK) {
+                        return rres;
+                    }
+                }
                 if (dolines) {
                     curr_line = (Dwarf_Line)
                         _dwarf_get_alloc(dbg, DW_DLA_LINE, 1);
@@ -2420,7 +2466,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     curr_line->li_l_data.li_line =
                         (Dwarf_Signed) regs.lr_line;
                     curr_line->li_l_data.li_column =
-                        (Dwarf_Half) regs.lr_column;
+                        (unsigned int) regs.lr_column;
                     curr_line->li_l_data.li_is_stmt =
                         regs.lr_is_stmt;
                     curr_line->li_l_data.
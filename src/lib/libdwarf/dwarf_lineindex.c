@@ -0,0 +1,481 @@
+/*
+Copyright (c) 2026, David Anderson
+All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/*  New October 2026.
+    A per-CU index from pc to line table row.
+    The line table program is run once through the
+    usual reader in dwarf_line_table_reader_common.h
+    but each row is appended to a set of parallel
+    arrays rather than allocated as a Dwarf_Line.
+    The rows are then put in address order by sequence
+    so a lookup is two binary searches.
+    The index hangs off the CU context and is freed
+    with it by dwarf_finish().  */
+
+#include <config.h>
+
+#include <stdlib.h> /* free() malloc() qsort() realloc() */
+#include <string.h> /* memcpy() memset() */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_line.h"
+
+#define LINE_INDEX_MIN_ROWS 64
+
+static void
+free_row_arrays(struct Dwarf_Line_Index_s *index)
+{
+    free(index->lx_address);
+    free(index->lx_file);
+    free(index->lx_line);
+    free(index->lx_column);
+    free(index->lx_flags);
+    index->lx_address = 0;
+    index->lx_file = 0;
+    index->lx_line = 0;
+    index->lx_column = 0;
+    index->lx_flags = 0;
+    index->lx_row_count = 0;
+    index->lx_rows_allocated = 0;
+}
+
+static int
+alloc_row_arrays(struct Dwarf_Line_Index_s *index,
+    Dwarf_Unsigned count)
+{
+    size_t n = (size_t)count;
+
+    index->lx_address = (Dwarf_Addr *)
+        malloc(n*sizeof(Dwarf_Addr));
+    index->lx_file = (unsigned int *)
+        malloc(n*sizeof(unsigned int));
+    index->lx_line = (unsigned int *)
+        malloc(n*sizeof(unsigned int));
+    index->lx_column = (unsigned int *)
+        malloc(n*sizeof(unsigned int));
+    index->lx_flags = (Dwarf_Small *)malloc(n);
+    if (!index->lx_address || !index->lx_file ||
+        !index->lx_line || !index->lx_column ||
+        !index->lx_flags) {
+        free_row_arrays(index);
+        return DW_DLV_ERROR;
+    }
+    index->lx_rows_allocated = count;
+    return DW_DLV_OK;
+}
+
+static void
+line_index_destruct(struct Dwarf_Line_Index_s *index)
+{
+    if (!index) {
+        return;
+    }
+    free_row_arrays(index);
+    free(index->lx_sequences);
+    index->lx_sequences = 0;
+    index->lx_sequence_count = 0;
+    if (index->lx_context) {
+        dwarf_srclines_dealloc_b(index->lx_context);
+        index->lx_context = 0;
+    }
+    free(index);
+}
+
+void
+_dwarf_line_index_destruct(Dwarf_CU_Context context)
+{
+    line_index_destruct(context->cc_line_index);
+    context->cc_line_index = 0;
+}
+
+/*  Called by the line table reader for each row
+    (special opcode, DW_LNS_copy, DW_LNE_end_sequence).
+    Values too large for the compact fields are
+    clamped; no real line table has them. */
+int
+_dwarf_line_index_add_row(Dwarf_Debug dbg,
+    struct Dwarf_Line_Index_s *index,
+    Dwarf_Line_Registers regs,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned n = index->lx_row_count;
+    Dwarf_Small flags = 0;
+
+    if (n >= index->lx_rows_allocated) {
+        Dwarf_Unsigned newcount = index->lx_rows_allocated?
+            index->lx_rows_allocated*2:LINE_INDEX_MIN_ROWS;
+        struct Dwarf_Line_Index_s grown;
+
+        memset(&grown,0,sizeof(grown));
+        if (alloc_row_arrays(&grown,newcount) != DW_DLV_OK) {
+            _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: growing the line index rows");
+            return DW_DLV_ERROR;
+        }
+        if (n) {
+            memcpy(grown.lx_address,index->lx_address,
+                (size_t)n*sizeof(Dwarf_Addr));
+            memcpy(grown.lx_file,index->lx_file,
+                (size_t)n*sizeof(unsigned int));
+            memcpy(grown.lx_line,index->lx_line,
+                (size_t)n*sizeof(unsigned int));
+            memcpy(grown.lx_column,index->lx_column,
+                (size_t)n*sizeof(unsigned int));
+            memcpy(grown.lx_flags,index->lx_flags,(size_t)n);
+        }
+        free_row_arrays(index);
+        index->lx_address = grown.lx_address;
+        index->lx_file = grown.lx_file;
+        index->lx_line = grown.lx_line;
+        index->lx_column = grown.lx_column;
+        index->lx_flags = grown.lx_flags;
+        index->lx_rows_allocated = newcount;
+    }
+    if (regs->lr_is_stmt) {
+        flags |= DW_LINE_ROW_IS_STMT;
+    }
+    if (regs->lr_basic_block) {
+        flags |= DW_LINE_ROW_BASIC_BLOCK;
+    }
+    if (regs->lr_end_sequence) {
+        flags |= DW_LINE_ROW_END_SEQUENCE;
+    }
+    if (regs->lr_prologue_end) {
+        flags |= DW_LINE_ROW_PROLOGUE_END;
+    }
+    if (regs->lr_epilogue_begin) {
+        flags |= DW_LINE_ROW_EPILOGUE_BEGIN;
+    }
+    index->lx_address[n] = regs->lr_address;
+    index->lx_file[n] = (regs->lr_file > 0xffffffff)?
+        0xffffffff:(unsigned int)regs->lr_file;
+    index->lx_line[n] = (regs->lr_line > 0xffffffff)?
+        0xffffffff:(unsigned int)regs->lr_line;
+    /*  Same conversion as li_column in a Dwarf_Line so
+        dwarf_lineoff_b() and the index agree. */
+    index->lx_column[n] = (unsigned int)regs->lr_column;
+    index->lx_flags[n] = flags;
+    index->lx_row_count = n + 1;
+    return DW_DLV_OK;
+}
+
+static int
+sequence_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Line_Sequence_s *ls = l;
+    const struct Dwarf_Line_Sequence_s *rs = r;
+
+    if (ls->ls_low != rs->ls_low) {
+        return (ls->ls_low < rs->ls_low)?-1:1;
+    }
+    /*  Keep table order for sequences at the same
+        address (relocatable objects) so the
+        result does not depend on qsort. */
+    if (ls->ls_first_row != rs->ls_first_row) {
+        return (ls->ls_first_row < rs->ls_first_row)?-1:1;
+    }
+    return 0;
+}
+
+/*  Rows are in table order. Find the sequences,
+    drop empty or unterminated ones, sort them by
+    address and copy their rows into new arrays in
+    that order. */
+static int
+order_rows(Dwarf_Debug dbg,
+    struct Dwarf_Line_Index_s *index,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Line_Index_s sorted;
+    struct Dwarf_Line_Sequence_s *seqs = 0;
+    Dwarf_Unsigned seqcount = 0;
+    Dwarf_Unsigned rows = 0;
+    Dwarf_Unsigned start = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Addr maxhigh = 0;
+
+    for (i = 0; i < index->lx_row_count; ++i) {
+        if (index->lx_flags[i] & DW_LINE_ROW_END_SEQUENCE) {
+            ++seqcount;
+        }
+    }
+    if (!seqcount) {
+        free_row_arrays(index);
+        return DW_DLV_OK;
+    }
+    seqs = (struct Dwarf_Line_Sequence_s *)
+        malloc((size_t)seqcount*sizeof(*seqs));
+    if (!seqs) {
+        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating line index "
+            "sequences");
+        return DW_DLV_ERROR;
+    }
+    seqcount = 0;
+    for (i = 0; i < index->lx_row_count; ++i) {
+        struct Dwarf_Line_Sequence_s *s = 0;
+
+        if (!(index->lx_flags[i] & DW_LINE_ROW_END_SEQUENCE)) {
+            continue;
+        }
+        if (i > start &&
+            index->lx_address[i] > index->lx_address[start]) {
+            s = seqs + seqcount;
+            s->ls_low = index->lx_address[start];
+            s->ls_high = index->lx_address[i];
+            s->ls_maxhigh = 0;
+            s->ls_first_row = start;
+            s->ls_row_count = i - start;
+            rows += s->ls_row_count;
+            ++seqcount;
+        }
+        start = i + 1;
+    }
+    if (!seqcount) {
+        free(seqs);
+        free_row_arrays(index);
+        return DW_DLV_OK;
+    }
+    qsort(seqs,(size_t)seqcount,sizeof(*seqs),sequence_compare);
+    memset(&sorted,0,sizeof(sorted));
+    if (alloc_row_arrays(&sorted,rows) != DW_DLV_OK) {
+        free(seqs);
+        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating sorted line "
+            "index rows");
+        return DW_DLV_ERROR;
+    }
+    rows = 0;
+    for (i = 0; i < seqcount; ++i) {
+        struct Dwarf_Line_Sequence_s *s = seqs + i;
+        size_t from = (size_t)s->ls_first_row;
+        size_t n = (size_t)s->ls_row_count;
+
+        memcpy(sorted.lx_address+rows,index->lx_address+from,
+            n*sizeof(Dwarf_Addr));
+        memcpy(sorted.lx_file+rows,index->lx_file+from,
+            n*sizeof(unsigned int));
+        memcpy(sorted.lx_line+rows,index->lx_line+from,
+            n*sizeof(unsigned int));
+        memcpy(sorted.lx_column+rows,index->lx_column+from,
+            n*sizeof(unsigned int));
+        memcpy(sorted.lx_flags+rows,index->lx_flags+from,n);
+        s->ls_first_row = rows;
+        rows += n;
+        if (s->ls_high > maxhigh) {
+            maxhigh = s->ls_high;
+        }
+        s->ls_maxhigh = maxhigh;
+    }
+    free_row_arrays(index);
+    index->lx_address = sorted.lx_address;
+    index->lx_file = sorted.lx_file;
+    index->lx_line = sorted.lx_line;
+    index->lx_column = sorted.lx_column;
+    index->lx_flags = sorted.lx_flags;
+    index->lx_row_count = rows;
+    index->lx_rows_allocated = rows;
+    index->lx_sequences = seqs;
+    index->lx_sequence_count = seqcount;
+    return DW_DLV_OK;
+}
+
+static int
+get_line_index(Dwarf_Die die,
+    struct Dwarf_Line_Index_s **index_out,
+    Dwarf_Error *error)
+{
+    Dwarf_CU_Context context = 0;
+    Dwarf_Debug dbg = 0;
+    struct Dwarf_Line_Index_s *index = 0;
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Line_Context line_context = 0;
+    Dwarf_Signed linecount = 0;
+    int res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    context = die->di_cu_context;
+    dbg = context->cc_dbg;
+    if (context->cc_line_index) {
+        *index_out = context->cc_line_index;
+        return DW_DLV_OK;
+    }
+    index = (struct Dwarf_Line_Index_s *)
+        calloc(1,sizeof(struct Dwarf_Line_Index_s));
+    if (!index) {
+        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating a line index");
+        return DW_DLV_ERROR;
+    }
+    res = _dwarf_internal_srclines(die,
+        /* is_new_interface= */ true,
+        &version,&table_count,&line_context,
+        0,&linecount,0,0,
+        /* addrlist= */ false,
+        /* linelist= */ false,
+        index,error);
+    if (res != DW_DLV_OK) {
+        line_index_destruct(index);
+        return res;
+    }
+    index->lx_context = line_context;
+    res = order_rows(dbg,index,error);
+    if (res != DW_DLV_OK) {
+        line_index_destruct(index);
+        return res;
+    }
+    context->cc_line_index = index;
+    *index_out = index;
+    return DW_DLV_OK;
+}
+
+/*  Returns the sequence containing pc, or NULL.
+    When sequences overlap the one starting
+    nearest below pc wins. */
+static struct Dwarf_Line_Sequence_s *
+find_sequence(struct Dwarf_Line_Index_s *index, Dwarf_Addr pc)
+{
+    struct Dwarf_Line_Sequence_s *seqs = index->lx_sequences;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = index->lx_sequence_count;
+
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (seqs[mid].ls_low <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    while (lo > 0) {
+        struct Dwarf_Line_Sequence_s *s = seqs + lo - 1;
+
+        if (s->ls_maxhigh <= pc) {
+            break;
+        }
+        if (pc < s->ls_high) {
+            return s;
+        }
+        --lo;
+    }
+    return 0;
+}
+
+int
+dwarf_srclines_lookup_pc(Dwarf_Die die,
+    Dwarf_Addr pc,
+    Dwarf_Addr *row_address,
+    Dwarf_Unsigned *fileno,
+    Dwarf_Unsigned *lineno,
+    Dwarf_Unsigned *column,
+    Dwarf_Unsigned *flags,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Line_Index_s *index = 0;
+    struct Dwarf_Line_Sequence_s *s = 0;
+    Dwarf_Addr *addrs = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+    Dwarf_Unsigned row = 0;
+    int res = 0;
+
+    res = get_line_index(die,&index,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    s = find_sequence(index,pc);
+    if (!s) {
+        return DW_DLV_NO_ENTRY;
+    }
+    /*  The first row is at ls_low <= pc so the
+        search always finds a row. */
+    addrs = index->lx_address;
+    lo = s->ls_first_row;
+    hi = s->ls_first_row + s->ls_row_count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (addrs[mid] <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    row = lo - 1;
+    if (row_address) {
+        *row_address = addrs[row];
+    }
+    if (fileno) {
+        *fileno = index->lx_file[row];
+    }
+    if (lineno) {
+        *lineno = index->lx_line[row];
+    }
+    if (column) {
+        *column = index->lx_column[row];
+    }
+    if (flags) {
+        *flags = index->lx_flags[row];
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_srclines_lookup_filename(Dwarf_Die die,
+    Dwarf_Unsigned fileno,
+    char **filename,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Line_Index_s *index = 0;
+    int res = 0;
+
+    res = get_line_index(die,&index,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return _dwarf_filename(index->lx_context,fileno,filename,
+        "dwarf_srclines_lookup_filename",error);
+}
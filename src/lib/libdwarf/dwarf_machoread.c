@@ -220,6 +220,27 @@ macho_load_section (void *obj, Dwarf_Unsigned section_index,
             return DW_DLV_ERROR;
         }
 
+        if (macho->mo_load_record.lr_preference ==
+            Dwarf_Alloc_Mmap && sp->dwarfsectname &&
+            strncmp(sp->dwarfsectname,".zdebug_",8)) {
+            char *data = 0;
+
+            res = _dwarf_object_mmap_random(macho->mo_fd,
+                (inner+sp->offset),sp->size,
+                (inner+macho->mo_filesize),
+                &sp->mmap_base,&sp->mmap_size,&data,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            if (res == DW_DLV_OK) {
+                sp->loaded_data = (Dwarf_Small *)data;
+                macho->mo_load_record.lr_mmap_count++;
+                macho->mo_load_record.lr_mmap_size += sp->size;
+                *return_data = sp->loaded_data;
+                return DW_DLV_OK;
+            }
+            /*  DW_DLV_NO_ENTRY: fall back to malloc and read. */
+        }
         sp->loaded_data = malloc((size_t)sp->size);
         if (!sp->loaded_data) {
             *error = DW_DLE_ALLOC_FAIL;
@@ -234,6 +255,8 @@ macho_load_section (void *obj, Dwarf_Unsigned section_index,
             sp->loaded_data = 0;
             return res;
         }
+        macho->mo_load_record.lr_malloc_count++;
+        macho->mo_load_record.lr_malloc_size += sp->size;
         *return_data = sp->loaded_data;
         return DW_DLV_OK;
     }
@@ -264,10 +287,14 @@ _dwarf_destruct_macho_internals(
 
         sp = mp->mo_dwarf_sections;
         for ( i=0; i < mp->mo_dwarf_sectioncount; ++i,++sp) {
-            if (sp->loaded_data) {
+            if (sp->mmap_base) {
+                _dwarf_object_munmap(sp->mmap_base,sp->mmap_size);
+                sp->mmap_base = 0;
+                sp->mmap_size = 0;
+            } else if (sp->loaded_data) {
                 free(sp->loaded_data);
-                sp->loaded_data = 0;
             }
+            sp->loaded_data = 0;
         }
         free(mp->mo_dwarf_sections);
         mp->mo_dwarf_sections = 0;
@@ -897,6 +924,7 @@ _dwarf_macho_setup(int fd,
     (*dbg)->de_obj_machine = intfc->mo_machine;
     (*dbg)->de_universalbinary_index = universalnumber;
     (*dbg)->de_universalbinary_count = universalbinary_count;
+    (*dbg)->de_load_record = &intfc->mo_load_record;
     return res;
 }
 
@@ -1030,6 +1058,7 @@ _dwarf_macho_object_access_internals_init(
     internals->mo_ftype       = ftypei;
     internals->mo_uninumber   = uninumber;
     internals->mo_universal_count = unibinarycounti;
+    internals->mo_load_record.lr_preference = Dwarf_Alloc_Malloc;
 
 #ifdef WORDS_BIGENDIAN
     if (endian == DW_END_little ) {
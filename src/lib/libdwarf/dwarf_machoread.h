@@ -109,6 +109,10 @@ struct generic_macho_section {
     Dwarf_Unsigned  generic_segment_num;
     Dwarf_Unsigned  offset_of_sec_rec;
     Dwarf_Small*  loaded_data;
+    /*  Non-zero if loaded_data points into an mmap()
+        of the file. munmap() rather than free(). */
+    char *        mmap_base;
+    Dwarf_Unsigned mmap_size;
 };
 
 /*  ident[0] == 'M' means this is a macho header.
@@ -145,6 +149,9 @@ typedef struct dwarf_macho_filedata_s {
 
     Dwarf_Unsigned mo_dwarf_sectioncount;
     struct generic_macho_section *mo_dwarf_sections;
+
+    /*  Malloc or mmap section data, and counts of each. */
+    struct Dwarf_Obj_Load_Record_s mo_load_record;
 } dwarf_macho_object_access_internals_t;
 
 int _dwarf_load_macho_header(
@@ -34,6 +34,13 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stddef.h> /* size_t */
 #include <stdio.h>  /* SEEK_END SEEK_SET */
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h> /* sysconf() */
+#endif /* HAVE_UNISTD_H */
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h> /* mmap() munmap() */
+#endif /* HAVE_SYS_MMAN_H */
+
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "libdwarf_private.h"
@@ -74,15 +81,95 @@ _dwarf_object_read_random(int fd, char *buf, Dwarf_Unsigned loc,
         *errc = DW_DLE_READ_OFF_END;
         return DW_DLV_ERROR;
     }
-    res = _dwarf_seekr(fd,loc,SEEK_SET,0);
+    res = _dwarf_preadr(fd,buf,loc,size);
     if (res != DW_DLV_OK) {
-        *errc = DW_DLE_SEEK_ERROR;
+        *errc = DW_DLE_READ_ERROR;
         return DW_DLV_ERROR;
     }
-    res = _dwarf_readr(fd,buf,size,0);
-    if (res != DW_DLV_OK) {
-        *errc = DW_DLE_READ_ERROR;
+    return DW_DLV_OK;
+}
+
+/*  Map [loc,loc+size) of the file read-only.
+    mmap() requires a page-aligned file offset, so
+    the mapping starts at the page containing loc and
+    *data_out points at loc within the mapping.
+    *map_base_out and *map_size_out are what must later be
+    passed to _dwarf_object_munmap().
+    Returns DW_DLV_NO_ENTRY if mmap() is not available
+    or fails for any reason: callers then fall back
+    to malloc() and _dwarf_object_read_random(). */
+int
+_dwarf_object_mmap_random(int fd,
+    Dwarf_Unsigned loc,
+    Dwarf_Unsigned size,
+    Dwarf_Unsigned filesize,
+    char         **map_base_out,
+    Dwarf_Unsigned *map_size_out,
+    char         **data_out,
+    int           *errc)
+{
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+    Dwarf_Unsigned endpoint = 0;
+    Dwarf_Unsigned pagesize = 0;
+    Dwarf_Unsigned pagestart = 0;
+    Dwarf_Unsigned mapsize = 0;
+    long  sc = 0;
+    void *base = 0;
+
+    if (!size) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (loc >= filesize) {
+        *errc = DW_DLE_SEEK_OFF_END;
+        return DW_DLV_ERROR;
+    }
+    endpoint = loc+size;
+    if (endpoint < loc || endpoint > filesize) {
+        *errc = DW_DLE_READ_OFF_END;
         return DW_DLV_ERROR;
     }
+    sc = sysconf(_SC_PAGESIZE);
+    if (sc <= 0) {
+        return DW_DLV_NO_ENTRY;
+    }
+    pagesize = (Dwarf_Unsigned)sc;
+    pagestart = loc - (loc % pagesize);
+    mapsize = endpoint - pagestart;
+    if ((Dwarf_Unsigned)(size_t)mapsize != mapsize) {
+        /* Cannot map this on a 32bit host. */
+        return DW_DLV_NO_ENTRY;
+    }
+    base = mmap(0,(size_t)mapsize,PROT_READ,MAP_PRIVATE,
+        fd,(off_t)pagestart);
+    if (base == MAP_FAILED) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *map_base_out = (char *)base;
+    *map_size_out = mapsize;
+    *data_out = (char *)base + (loc - pagestart);
     return DW_DLV_OK;
+#else /* !HAVE_SYS_MMAN_H */
+    (void)fd;
+    (void)loc;
+    (void)size;
+    (void)filesize;
+    (void)map_base_out;
+    (void)map_size_out;
+    (void)data_out;
+    (void)errc;
+    return DW_DLV_NO_ENTRY;
+#endif /* HAVE_SYS_MMAN_H */
+}
+
+void
+_dwarf_object_munmap(char *map_base, Dwarf_Unsigned map_size)
+{
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_UNISTD_H)
+    if (map_base && map_size) {
+        munmap((void *)map_base,(size_t)map_size);
+    }
+#else /* !HAVE_SYS_MMAN_H */
+    (void)map_base;
+    (void)map_size;
+#endif /* HAVE_SYS_MMAN_H */
 }
@@ -37,8 +37,25 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif /* __cplusplus */
 
+/*  Records how the section data of one object file
+    was brought into memory.  Each object reader
+    (Elf, Mach-O, PE) keeps one of these and updates
+    it as sections are loaded. */
+struct Dwarf_Obj_Load_Record_s {
+    enum Dwarf_Sec_Alloc_Pref lr_preference;
+    Dwarf_Unsigned lr_mmap_count;
+    Dwarf_Unsigned lr_mmap_size;
+    Dwarf_Unsigned lr_malloc_count;
+    Dwarf_Unsigned lr_malloc_size;
+};
+
 int _dwarf_object_read_random(int fd,char *buf,Dwarf_Unsigned loc,
     Dwarf_Unsigned size,Dwarf_Unsigned filesize,int *errc);
+int _dwarf_object_mmap_random(int fd,Dwarf_Unsigned loc,
+    Dwarf_Unsigned size,Dwarf_Unsigned filesize,
+    char **map_base_out,Dwarf_Unsigned *map_size_out,
+    char **data_out,int *errc);
+void _dwarf_object_munmap(char *map_base,Dwarf_Unsigned map_size);
 
 #ifdef __cplusplus
 }
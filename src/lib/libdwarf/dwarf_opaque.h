@@ -325,12 +325,15 @@ struct Dwarf_CU_Context_s {
         Set when the CU die is accessed by dwarf_siblingof_b(). */
     Dwarf_Unsigned cc_cu_die_global_sec_offset;
 
-    Dwarf_Byte_Ptr   cc_last_abbrev_ptr;
-    Dwarf_Byte_Ptr   cc_last_abbrev_endptr;
+    /*  Possibly shared with other CUs,
+        see _dwarf_share_abbrev_hash_table(). */
     Dwarf_Hash_Table cc_abbrev_hash_table;
-    Dwarf_Unsigned   cc_highest_known_code;
     Dwarf_CU_Context cc_next;
 
+    /*  Built on first use by dwarf_srclines_lookup_pc(),
+        see dwarf_lineindex.c */
+    struct Dwarf_Line_Index_s *cc_line_index;
+
     Dwarf_Bool cc_is_info;    /* TRUE means context is
         in debug_info, FALSE means is in debug_types.
         FALSE only possible for DWARF4 .debug_types
@@ -475,6 +478,13 @@ struct Dwarf_Debug_InfoTypes_s {
     /*  Points to the last CU Context added to the list by
         dwarf_next_cu_header(). */
     Dwarf_CU_Context de_cu_context_list_end;
+    /*  The same contexts as de_cu_context_list, in
+        the same ascending cc_debug_offset order, as
+        an array so an offset can be found with a
+        binary search.  malloc space, grown by doubling. */
+    Dwarf_CU_Context *de_cu_context_array;
+    Dwarf_Unsigned    de_cu_context_array_count;
+    Dwarf_Unsigned    de_cu_context_array_size;
 
     /*  Offset of last byte of last CU read.
         Actually one-past that last byte.  So
@@ -653,6 +663,18 @@ struct Dwarf_Debug_s {
         or the Charactersics field from a PE header. */
     Dwarf_Unsigned de_obj_flags;
 
+    /*  Points into the object reader (Elf, Mach-O, PE)
+        data recording whether sections were mmap()ed
+        or malloc()ed.  NULL for dwarf_object_init_b()
+        users.  Cleared before the reader is destroyed. */
+    struct Dwarf_Obj_Load_Record_s *de_load_record;
+
+    /*  Non-null only in a Dwarf_Debug created by
+        dwarf_init_from_debug().  Sections already
+        loaded in de_section_owner are borrowed from it
+        rather than read again.  Never freed here. */
+    struct Dwarf_Debug_s *de_section_owner;
+
     /*  number of bytes in a pointer of the target in various .debug_
         sections. 4 in 32bit, 8 in MIPS 64, ia64.
         This is taken from object file headers. */
@@ -664,10 +686,30 @@ struct Dwarf_Debug_s {
         non-zero means do not do the check. */
     Dwarf_Small de_assume_string_in_bounds;
 
+    /*  Set at creation of a Dwarf_Debug from the
+        dwarf_set_reloc_application() value.
+        Non-zero means apply .rel/.rela relocations
+        when loading sections. */
+    Dwarf_Small de_apply_relocs;
+
+    /*  Set at creation of a Dwarf_Debug from the
+        dwarf_set_de_alloc_flag() value.
+        Non-zero means record allocations in de_alloc_tree. */
+    Dwarf_Small de_alloc_tree_on;
+
     /*  Keep track of allocations so a dwarf_finish call can clean up.
         Null till a tree is created */
     void * de_alloc_tree;
 
+    /*  New October 2026.
+        Non-zero between dwarf_die_arena_begin() and
+        dwarf_die_arena_release().  While set,
+        Dwarf_Die, Dwarf_Attribute and attribute lists
+        are carved from de_arena_chunks and
+        are not recorded in de_alloc_tree. */
+    Dwarf_Small de_arena_on;
+    struct Dwarf_Arena_Chunk_s *de_arena_chunks;
+
     /*  These fields are used to process debug_frame section.
         Updated
         by dwarf_get_fde_list in dwarf_frame.h */
@@ -709,6 +751,9 @@ struct Dwarf_Debug_s {
 
     /* gnu: the g++ eh_frame section */
     struct Dwarf_Section_s de_debug_frame_eh_gnu;
+    /*  gnu: the sorted table of .eh_frame FDEs
+        for dwarf_get_fde_at_pc_eh_hdr(). */
+    struct Dwarf_Section_s de_eh_frame_hdr; /* New October 2026 */
 
     /* DWARF3 .debug_pubtypes */
     struct Dwarf_Section_s de_debug_pubtypes;
@@ -765,6 +810,12 @@ struct Dwarf_Debug_s {
     Dwarf_Xu_Index_Header  de_cu_hashindex_data;
     Dwarf_Xu_Index_Header  de_tu_hashindex_data;
 
+    /*  New October 2026. The code address to
+        CU and subprogram index, built by
+        dwarf_addr_index_build() or loaded by
+        dwarf_addr_index_from_bytes(). */
+    struct Dwarf_Addr_Index_s *de_addr_index;
+
     void (*de_copy_word) (void *dw_targ, const void *dw_src,
         unsigned long dw_len);
     unsigned char de_elf_must_close; /* If non-zero, then
@@ -780,6 +831,17 @@ struct Dwarf_Debug_s {
     Dwarf_Unsigned de_frame_cfa_col_number;
     Dwarf_Unsigned de_frame_same_value_number;
     Dwarf_Unsigned de_frame_undefined_value_number;
+    /*  Non-zero to keep the rows of each FDE after
+        first use. See dwarf_set_frame_row_cache(). */
+    Dwarf_Small    de_frame_row_cache;
+    /*  Threads to use for a compressed section
+        that is several zstd frames.
+        See dwarf_set_decompress_threads(). */
+    unsigned int   de_decompress_threads;
+    /*  Directory holding decompressed copies of
+        sections, named by build-id, or null.
+        See dwarf_set_decompress_cache_dir(). */
+    char          *de_decompress_cache_dir;
 
     /*  If count > 0 means the DW_FTYPE_APPLEUNIVERSAL
         we initially read has this number of
@@ -826,6 +888,26 @@ struct Dwarf_Debug_s {
         file is sometimes needed
         and referenced.*/
     struct Dwarf_Tied_Data_s de_tied_data;
+
+    /*  A dwarf_tsearch hash from the Dwarf_Sig8 of each
+        type unit (DW_UT_type, DW_UT_split_type) in
+        .debug_info or .debug_types of this dbg to its
+        CU_Context. Records are struct Dwarf_Tied_Entry_s.
+        Every context is added as it is created.
+        de_type_sig_index_complete is set once every
+        unit header in both sections has been read,
+        so a miss means the signature is not present.
+        If an insert ever fails de_type_sig_index_failed
+        is set and the index is no longer used. */
+    void      *de_type_sig_index;
+    Dwarf_Bool de_type_sig_index_complete;
+    Dwarf_Bool de_type_sig_index_failed;
+
+    /*  Abbreviation hash tables shared by CUs with the
+        same .debug_abbrev offset, keyed by that offset
+        and the CU version, address size and offset size.
+        A dwarf_tsearch tree of Dwarf_Hash_Table. */
+    void      *de_abbrev_tables;
 };
 
 /* New style. takes advantage of dwarfstrings capability.
@@ -933,6 +1015,11 @@ int _dwarf_create_a_new_cu_context_record_on_list(
     Dwarf_Error *error);
 Dwarf_Unsigned _dwarf_calculate_next_cu_context_offset(
     Dwarf_CU_Context cu_context);
+int _dwarf_cu_context_at_header_offset(Dwarf_Debug dbg,
+    Dwarf_Bool is_info,
+    Dwarf_Unsigned hdr_offset,
+    Dwarf_CU_Context *context_out,
+    Dwarf_Error *error);
 
 int _dwarf_search_for_signature(Dwarf_Debug dbg,
     Dwarf_Sig8 sig,
@@ -946,6 +1033,8 @@ int _dwarf_merge_all_base_attrs_of_cu_die(Dwarf_Debug dbg,
     Dwarf_Error *error);
 
 void _dwarf_tied_destroy_free_node(void *node);
+void _dwarf_add_to_type_sig_index(Dwarf_Debug dbg,
+    Dwarf_CU_Context context);
 void _dwarf_destroy_group_map(Dwarf_Debug dbg);
 
 int _dwarf_section_get_target_group(Dwarf_Debug dbg,
@@ -1072,6 +1161,10 @@ extern int _dwarf_pe_setup(int fd,
     Dwarf_Debug *dbg,Dwarf_Error *error);
 void _dwarf_destruct_pe_access(
     struct Dwarf_Obj_Access_Interface_a_s *aip);
+void _dwarf_destruct_shared_access(
+    struct Dwarf_Obj_Access_Interface_a_s *aip);
+void _dwarf_addr_index_destruct(Dwarf_Debug dbg);
+void _dwarf_line_index_destruct(Dwarf_CU_Context context);
 
 void _dwarf_create_address_size_dwarf_error(Dwarf_Debug dbg,
     Dwarf_Error *error,
@@ -1102,6 +1195,8 @@ int  _dwarf_readr(int fd, char *buf, Dwarf_Unsigned size,
     Dwarf_Unsigned *sizeread);
 int  _dwarf_seekr(int fd, Dwarf_Unsigned loc, int seektype,
     Dwarf_Unsigned *out_loc);
+int  _dwarf_preadr(int fd, char *buf, Dwarf_Unsigned loc,
+    Dwarf_Unsigned size);
 int  _dwarf_openr(const char *name);
 
 int _dwarf_formblock_internal(Dwarf_Debug dbg,
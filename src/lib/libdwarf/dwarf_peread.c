@@ -36,7 +36,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <config.h>
 #include <stddef.h> /* size_t */
 #include <stdlib.h> /* atoi() calloc() free() malloc() */
-#include <string.h> /* memset() strdup() strlen() */
+#include <string.h> /* memset() strdup() strlen() strncmp() */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -389,6 +389,30 @@ pe_load_section (void *obj, Dwarf_Unsigned section_index,
             *error = DW_DLE_FILE_TOO_SMALL;
             return DW_DLV_ERROR;
         }
+        if (pep->pe_load_record.lr_preference == Dwarf_Alloc_Mmap &&
+            sp->VirtualSize == read_length &&
+            sp->dwarfsectname &&
+            strncmp(sp->dwarfsectname,".zdebug_",8)) {
+            char *data = 0;
+
+            /*  No zero-fill needed, so the file bytes
+                are the whole section. */
+            res = _dwarf_object_mmap_random(pep->pe_fd,
+                sp->PointerToRawData,read_length,
+                pep->pe_filesize,
+                &sp->mmap_base,&sp->mmap_size,&data,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            if (res == DW_DLV_OK) {
+                sp->loaded_data = (Dwarf_Small *)data;
+                pep->pe_load_record.lr_mmap_count++;
+                pep->pe_load_record.lr_mmap_size += read_length;
+                *return_data = sp->loaded_data;
+                return DW_DLV_OK;
+            }
+            /*  DW_DLV_NO_ENTRY: fall back to malloc and read. */
+        }
         /*  VirtualSize > SizeOfRawData  if trailing zeros
             in the section were not written to disc.
             Malloc enough for the whole section, read in
@@ -414,6 +438,8 @@ pe_load_section (void *obj, Dwarf_Unsigned section_index,
             memset(sp->loaded_data + read_length, 0,
                 (size_t)(sp->VirtualSize - read_length));
         }
+        pep->pe_load_record.lr_malloc_count++;
+        pep->pe_load_record.lr_malloc_size += sp->VirtualSize;
         *return_data = sp->loaded_data;
         return DW_DLV_OK;
     }
@@ -442,10 +468,14 @@ _dwarf_destruct_pe_access(
 
         sp = pep->pe_sectionptr;
         for (i=0; i < pep->pe_section_count; ++i,++sp) {
-            if (sp->loaded_data) {
+            if (sp->mmap_base) {
+                _dwarf_object_munmap(sp->mmap_base,sp->mmap_size);
+                sp->mmap_base = 0;
+                sp->mmap_size = 0;
+            } else if (sp->loaded_data) {
                 free(sp->loaded_data);
-                sp->loaded_data = 0;
             }
+            sp->loaded_data = 0;
             free(sp->name);
             sp->name = 0;
             free(sp->dwarfsectname);
@@ -855,6 +885,7 @@ _dwarf_pe_setup(int fd,
     pep = binary_interface->ai_object;
     (*dbg)->de_obj_flags = pep->pe_flags;
     (*dbg)->de_obj_machine = pep->pe_machine;
+    (*dbg)->de_load_record = &pep->pe_load_record;
     pep->pe_path = strdup(true_path);
     return res;
 }
@@ -903,6 +934,7 @@ _dwarf_pe_object_access_internals_init(
     intfc->pe_pointersize = offsetsize;
     intfc->pe_filesize    = filesize;
     intfc->pe_ftype       = ftype;
+    intfc->pe_load_record.lr_preference = Dwarf_Alloc_Malloc;
     /* pe_path set by caller */
 
 #ifdef WORDS_BIGENDIAN
@@ -107,6 +107,10 @@ struct dwarf_pe_generic_image_section_header
     Dwarf_Unsigned NumberOfLinenumbers;
     Dwarf_Unsigned Characteristics;
     Dwarf_Small *  loaded_data; /* must be freed. */
+    /*  Non-zero if loaded_data points into an mmap()
+        of the file. munmap() rather than free(). */
+    char *         mmap_base;
+    Dwarf_Unsigned mmap_size;
     Dwarf_Bool     section_irrelevant_to_dwarf;
 };
 
@@ -148,6 +152,9 @@ typedef struct pe_filedata_s {
 
     Dwarf_Unsigned pe_string_table_size;
     char          *pe_string_table;
+
+    /*  Malloc or mmap section data, and counts of each. */
+    struct Dwarf_Obj_Load_Record_s pe_load_record;
 } dwarf_pe_object_access_internals_t;
 
 #ifdef __cplusplus
@@ -49,13 +49,11 @@
 #include "dwarf_string.h"
 
 #define PRINTING_DETAILS 1
-/*  for dwarfstring_constructor_static, saving lots of malloc
-    and free but beware: make sure each routine using
-    this DOES NOT call another routine using it.
-    And do not use it in Dwarf_Error related calls.
-    would be safer to have a buffer per function, but
-    currently not necessary. */
-static char locallinebuf[200];
+/*  For dwarfstring_constructor_static, saving lots of malloc
+    and free. Each routine has its own stack buffer
+    of this size so nothing here is shared
+    between threads. */
+#define LOCALLINEBUFLEN 200
 
 static void
 print_line_header(Dwarf_Debug dbg,
@@ -117,6 +115,7 @@ print_line_detail(
     Dwarf_Bool is_single_table, Dwarf_Bool is_actuals_table)
 {
     dwarfstring m1;
+    char locallinebuf[LOCALLINEBUFLEN];
 
     dwarfstring_constructor_static(&m1,locallinebuf,
         sizeof(locallinebuf));
@@ -229,6 +228,7 @@ print_include_directory_details(Dwarf_Debug dbg,
 {
     Dwarf_Unsigned u = 0;
     dwarfstring    m4;
+    char locallinebuf[LOCALLINEBUFLEN];
     Dwarf_Unsigned indexbase = 0;
     Dwarf_Unsigned indexlimit = 0;
 
@@ -330,6 +330,7 @@ print_just_file_entry_details(Dwarf_Debug dbg,
     Dwarf_File_Entry fe = line_context->lc_file_entries;
     Dwarf_File_Entry fe2 = fe;
     dwarfstring m3;
+    char locallinebuf[LOCALLINEBUFLEN];
     unsigned increment = 1;
 
     if (line_context->lc_version_number == DW_LINE_VERSION5 ) {
@@ -444,6 +445,7 @@ print_file_entry_details(Dwarf_Debug dbg,
     Dwarf_Line_Context line_context)
 {
     dwarfstring m5;
+    char locallinebuf[LOCALLINEBUFLEN];
 
     dwarfstring_constructor_static(&m5,locallinebuf,
         sizeof(locallinebuf));
@@ -504,6 +506,7 @@ print_experimental_subprograms_list(Dwarf_Debug dbg,
     Dwarf_Unsigned exu = 0;
     Dwarf_Subprog_Entry sub = line_context->lc_subprogs;
     dwarfstring m6;
+    char locallinebuf[LOCALLINEBUFLEN];
 
     dwarfstring_constructor_static(&m6,locallinebuf,
         sizeof(locallinebuf));
@@ -33,6 +33,7 @@
 
 #include <stddef.h> /* NULL size_t */
 #include <stdio.h> /* debugging printf */
+#include <string.h> /* memset() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
@@ -346,19 +347,17 @@ empty_local_attrlist(Dwarf_Debug dbg,
     }
 }
 
-int
-dwarf_attrlist(Dwarf_Die die,
-    Dwarf_Attribute **attrbuf,
-    Dwarf_Signed     *attrcnt, Dwarf_Error *error)
+/*  Finds the abbreviation of die, with its attribute
+    and form lists filled in, and where the first
+    attribute value of die starts.  */
+static int
+die_attr_start(Dwarf_Die die,
+    Dwarf_Abbrev_List *abbrev_out,
+    Dwarf_Byte_Ptr    *info_ptr_out,
+    Dwarf_Byte_Ptr    *die_info_end_out,
+    Dwarf_Error       *error)
 {
-    Dwarf_Unsigned    attr_count = 0;
-    Dwarf_Unsigned    attr = 0;
-    Dwarf_Unsigned    attr_form = 0;
-    Dwarf_Unsigned    i = 0;
     Dwarf_Abbrev_List abbrev_list = 0;
-    Dwarf_Attribute   head_attr = NULL;
-    Dwarf_Attribute   curr_attr = NULL;
-    Dwarf_Attribute  *last_attr = &head_attr;
     Dwarf_Debug       dbg = 0;
     Dwarf_Byte_Ptr    info_ptr = 0;
     Dwarf_Byte_Ptr    die_info_end = 0;
@@ -367,7 +366,6 @@ dwarf_attrlist(Dwarf_Die die,
     Dwarf_CU_Context  context = 0;
     Dwarf_Unsigned    highest_code = 0;
 
-    CHECK_DIE(die, DW_DLV_ERROR);
     context = die->di_cu_context;
     dbg = context->cc_dbg;
     die_info_end =
@@ -439,6 +437,102 @@ dwarf_attrlist(Dwarf_Die die,
         /*  Here we are guaranteed abbrev_list->abl_attr
             is non-null */
     }
+    *abbrev_out = abbrev_list;
+    *info_ptr_out = info_ptr;
+    *die_info_end_out = die_info_end;
+    return DW_DLV_OK;
+}
+
+/*  Reads the form that follows a DW_FORM_indirect
+    in the DIE, advancing *info_ptr past it.  */
+static int
+read_indirect_form(Dwarf_Die die,
+    Dwarf_Unsigned  attr,
+    Dwarf_Byte_Ptr *info_ptr,
+    Dwarf_Byte_Ptr  die_info_end,
+    Dwarf_Unsigned *form_out,
+    Dwarf_Error    *error)
+{
+    Dwarf_Debug    dbg = die->di_cu_context->cc_dbg;
+    Dwarf_Unsigned utmp6 = 0;
+    Dwarf_Unsigned attr_form = 0;
+    int            ires = 0;
+
+    if (_dwarf_reference_outside_section(die,
+        (Dwarf_Small*) *info_ptr,
+        ((Dwarf_Small*) *info_ptr )+1)) {
+        _dwarf_error_string(dbg, error,
+            DW_DLE_ATTR_OUTSIDE_SECTION,
+            "DW_DLE_ATTR_OUTSIDE_SECTION: "
+            " Reading Attriutes: "
+            "For DW_FORM_indirect there is"
+            " no room for the form. Corrupt Dwarf");
+        return DW_DLV_ERROR;
+    }
+    ires = _dwarf_leb128_uword_wrapper(dbg,
+        info_ptr,die_info_end,&utmp6,error);
+    if (ires != DW_DLV_OK) {
+        _dwarf_error_string(dbg, error,
+            DW_DLE_ATTR_OUTSIDE_SECTION,
+            "DW_DLE_ATTR_OUTSIDE_SECTION: "
+            "Reading target of a DW_FORM_indirect "
+            "from an abbreviation failed. Corrupt Dwarf");
+        return DW_DLV_ERROR;
+    }
+    attr_form = (Dwarf_Half) utmp6;
+    if (attr_form == DW_FORM_implicit_const) {
+        _dwarf_error_string(dbg, error,
+            DW_DLE_ATTR_OUTSIDE_SECTION,
+            "DW_DLE_ATTR_OUTSIDE_SECTION: "
+            " Reading Attriutes: an indirect form "
+            "leads to a DW_FORM_implicit_const "
+            "which is not handled. Corrupt Dwarf");
+        return DW_DLV_ERROR;
+    }
+    if (!_dwarf_valid_form_we_know(attr_form,attr)) {
+        dwarfstring m;
+
+        dwarfstring_constructor(&m);
+        dwarfstring_append_printf_u(&m,
+            "DW_DLE_UNKNOWN_FORM "
+            " form indirect leads to form"
+            " of  0x%x which is unknown",
+            attr_form);
+        _dwarf_error_string(dbg, error,
+            DW_DLE_UNKNOWN_FORM,
+            dwarfstring_string(&m));
+        dwarfstring_destructor(&m);
+        return DW_DLV_ERROR;
+    }
+    *form_out = attr_form;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_attrlist(Dwarf_Die die,
+    Dwarf_Attribute **attrbuf,
+    Dwarf_Signed     *attrcnt, Dwarf_Error *error)
+{
+    Dwarf_Unsigned    attr_count = 0;
+    Dwarf_Unsigned    attr = 0;
+    Dwarf_Unsigned    attr_form = 0;
+    Dwarf_Unsigned    i = 0;
+    Dwarf_Abbrev_List abbrev_list = 0;
+    Dwarf_Attribute   head_attr = NULL;
+    Dwarf_Attribute   curr_attr = NULL;
+    Dwarf_Attribute  *last_attr = &head_attr;
+    Dwarf_Debug       dbg = 0;
+    Dwarf_Byte_Ptr    info_ptr = 0;
+    Dwarf_Byte_Ptr    die_info_end = 0;
+    int               lres = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    dbg = die->di_cu_context->cc_dbg;
+    lres = die_attr_start(die,&abbrev_list,&info_ptr,
+        &die_info_end,error);
+    if (lres != DW_DLV_OK) {
+        return lres;
+    }
     /*  ASSERT  list->abl_addr and list->abl_form
         are non-null and if  list->abl_implicit_const_count > 0
         list->abl_implicit_const is non-null. */
@@ -465,57 +559,11 @@ dwarf_attrlist(Dwarf_Die die,
         }
         newattr_form = (Dwarf_Half)attr_form;
         if (attr_form == DW_FORM_indirect) {
-            Dwarf_Unsigned utmp6 = 0;
-
-            if (_dwarf_reference_outside_section(die,
-                (Dwarf_Small*) info_ptr,
-                ((Dwarf_Small*) info_ptr )+1)) {
-                empty_local_attrlist(dbg,head_attr);
-                _dwarf_error_string(dbg, error,
-                    DW_DLE_ATTR_OUTSIDE_SECTION,
-                    "DW_DLE_ATTR_OUTSIDE_SECTION: "
-                    " Reading Attriutes: "
-                    "For DW_FORM_indirect there is"
-                    " no room for the form. Corrupt Dwarf");
-                return DW_DLV_ERROR;
-            }
-            ires = _dwarf_leb128_uword_wrapper(dbg,
-                &info_ptr,die_info_end,&utmp6,error);
+            ires = read_indirect_form(die,attr,&info_ptr,
+                die_info_end,&attr_form,error);
             if (ires != DW_DLV_OK) {
                 empty_local_attrlist(dbg,head_attr);
-                _dwarf_error_string(dbg, error,
-                    DW_DLE_ATTR_OUTSIDE_SECTION,
-                    "DW_DLE_ATTR_OUTSIDE_SECTION: "
-                    "Reading target of a DW_FORM_indirect "
-                    "from an abbreviation failed. Corrupt Dwarf");
-                return DW_DLV_ERROR;
-            }
-            attr_form = (Dwarf_Half) utmp6;
-            if (attr_form == DW_FORM_implicit_const) {
-                empty_local_attrlist(dbg,head_attr);
-                _dwarf_error_string(dbg, error,
-                    DW_DLE_ATTR_OUTSIDE_SECTION,
-                    "DW_DLE_ATTR_OUTSIDE_SECTION: "
-                    " Reading Attriutes: an indirect form "
-                    "leads to a DW_FORM_implicit_const "
-                    "which is not handled. Corrupt Dwarf");
-                return DW_DLV_ERROR;
-            }
-            if (!_dwarf_valid_form_we_know(attr_form,attr)) {
-                dwarfstring m;
-
-                dwarfstring_constructor(&m);
-                dwarfstring_append_printf_u(&m,
-                    "DW_DLE_UNKNOWN_FORM "
-                    " form indirect leads to form"
-                    " of  0x%x which is unknown",
-                    attr_form);
-                _dwarf_error_string(dbg, error,
-                    DW_DLE_UNKNOWN_FORM,
-                    dwarfstring_string(&m));
-                dwarfstring_destructor(&m);
-                empty_local_attrlist(dbg,head_attr);
-                return DW_DLV_ERROR;
+                return ires;
             }
             newattr_form = (Dwarf_Half)attr_form;
         }
@@ -599,7 +647,7 @@ dwarf_attrlist(Dwarf_Die die,
         Dwarf_Attribute *attr_ptr = 0;
 
         attr_ptr = (Dwarf_Attribute *)
-            _dwarf_get_alloc(dbg, DW_DLA_LIST, attr_count);
+            _dwarf_get_attrlist_alloc(dbg, attr_count);
         if (attr_ptr == NULL) {
             empty_local_attrlist(dbg,head_attr);
             _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
@@ -616,6 +664,263 @@ dwarf_attrlist(Dwarf_Die die,
     return DW_DLV_OK;
 }
 
+/*  Fill one Dwarf_Attr_Value from the value bytes
+    at info_ptr, size bytes long.  */
+static int
+decode_attr_value(Dwarf_Die die,
+    Dwarf_Half       attr,
+    Dwarf_Half       form,
+    Dwarf_Signed     implicit_const,
+    Dwarf_Byte_Ptr   info_ptr,
+    Dwarf_Unsigned   size,
+    Dwarf_Byte_Ptr   die_info_end,
+    Dwarf_Attr_Value *out,
+    Dwarf_Error     *error)
+{
+    Dwarf_CU_Context context = die->di_cu_context;
+    Dwarf_Debug      dbg = context->cc_dbg;
+    Dwarf_Unsigned   lebval = 0;
+    Dwarf_Unsigned   leblen = 0;
+    Dwarf_Signed     slebval = 0;
+    int              res = 0;
+
+    memset(out,0,sizeof(*out));
+    out->av_attr = attr;
+    out->av_form = form;
+    out->av_class = dwarf_get_form_class(context->cc_version_stamp,
+        attr,context->cc_length_size,form);
+    switch (form) {
+    case DW_FORM_implicit_const:
+        out->av_value = (Dwarf_Unsigned)implicit_const;
+        break;
+    case DW_FORM_flag_present:
+        out->av_value = 1;
+        break;
+    case DW_FORM_udata:
+    case DW_FORM_ref_udata:
+    case DW_FORM_strx:
+    case DW_FORM_addrx:
+    case DW_FORM_loclistx:
+    case DW_FORM_rnglistx:
+    case DW_FORM_GNU_addr_index:
+    case DW_FORM_GNU_str_index:
+        res = dwarf_decode_leb128((char *)info_ptr,&leblen,
+            &lebval,(char *)die_info_end);
+        if (res != DW_DLV_OK) {
+            _dwarf_error_string(dbg,error,DW_DLE_LEB_IMPROPER,
+                "DW_DLE_LEB_IMPROPER: decoding an attribute "
+                "value runs off the end of the DIE");
+            return DW_DLV_ERROR;
+        }
+        out->av_value = lebval;
+        break;
+    case DW_FORM_sdata:
+        res = dwarf_decode_signed_leb128((char *)info_ptr,
+            &leblen,&slebval,(char *)die_info_end);
+        if (res != DW_DLV_OK) {
+            _dwarf_error_string(dbg,error,DW_DLE_LEB_IMPROPER,
+                "DW_DLE_LEB_IMPROPER: decoding an attribute "
+                "value runs off the end of the DIE");
+            return DW_DLV_ERROR;
+        }
+        out->av_value = (Dwarf_Unsigned)slebval;
+        break;
+    case DW_FORM_block1:
+        out->av_ptr = info_ptr + 1;
+        out->av_len = size - 1;
+        break;
+    case DW_FORM_block2:
+        out->av_ptr = info_ptr + DWARF_HALF_SIZE;
+        out->av_len = size - DWARF_HALF_SIZE;
+        break;
+    case DW_FORM_block4:
+        out->av_ptr = info_ptr + DWARF_32BIT_SIZE;
+        out->av_len = size - DWARF_32BIT_SIZE;
+        break;
+    case DW_FORM_block:
+    case DW_FORM_exprloc:
+        res = dwarf_decode_leb128((char *)info_ptr,&leblen,
+            &lebval,(char *)die_info_end);
+        if (res != DW_DLV_OK) {
+            _dwarf_error_string(dbg,error,DW_DLE_LEB_IMPROPER,
+                "DW_DLE_LEB_IMPROPER: decoding a block "
+                "length runs off the end of the DIE");
+            return DW_DLV_ERROR;
+        }
+        out->av_ptr = info_ptr + leblen;
+        out->av_len = lebval;
+        break;
+    case DW_FORM_data16:
+    case DW_FORM_ref_sig8:
+        out->av_ptr = info_ptr;
+        out->av_len = size;
+        break;
+    case DW_FORM_string:
+        out->av_ptr = info_ptr;
+        break;
+    default:
+        /*  Every other form is a fixed size number. */
+        if (!size || size > sizeof(Dwarf_Unsigned)) {
+            dwarfstring m;
+
+            dwarfstring_constructor(&m);
+            dwarfstring_append_printf_u(&m,
+                "DW_DLE_ATTR_FORM_BAD: form 0x%x has no "
+                "decoding as a number",form);
+            _dwarf_error_string(dbg,error,DW_DLE_ATTR_FORM_BAD,
+                dwarfstring_string(&m));
+            dwarfstring_destructor(&m);
+            return DW_DLV_ERROR;
+        }
+        READ_UNALIGNED_CK(dbg,out->av_value,Dwarf_Unsigned,
+            info_ptr,size,error,die_info_end);
+        break;
+    }
+    switch (form) {
+    case DW_FORM_ref1:
+    case DW_FORM_ref2:
+    case DW_FORM_ref4:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_udata:
+        /*  As dwarf_global_formref() does. */
+        out->av_value += context->cc_debug_offset;
+        break;
+    default:
+        break;
+    }
+    if (out->av_class == DW_FORM_CLASS_STRING &&
+        form != DW_FORM_string) {
+        /*  A stack attribute lets dwarf_formstring()
+            do the section lookups, allocating nothing. */
+        struct Dwarf_Attribute_s sattr;
+        char *str = 0;
+
+        memset(&sattr,0,sizeof(sattr));
+        sattr.ar_attribute = attr;
+        sattr.ar_attribute_form = form;
+        sattr.ar_attribute_form_direct = form;
+        sattr.ar_cu_context = context;
+        sattr.ar_debug_ptr = info_ptr;
+        sattr.ar_dbg = dbg;
+        sattr.ar_die = die;
+        res = dwarf_formstring(&sattr,&str,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            out->av_ptr = (Dwarf_Small *)str;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  New October 2026.
+    Decodes the attributes of a DIE into the
+    caller's array, following the same path
+    through the abbreviation as dwarf_attrlist()
+    but with no allocation.  */
+int
+dwarf_die_attr_values(Dwarf_Die die,
+    Dwarf_Attr_Value *values,
+    Dwarf_Unsigned    values_count,
+    Dwarf_Unsigned   *attr_count_out,
+    Dwarf_Error      *error)
+{
+    Dwarf_Abbrev_List abbrev_list = 0;
+    Dwarf_Debug       dbg = 0;
+    Dwarf_Byte_Ptr    info_ptr = 0;
+    Dwarf_Byte_Ptr    die_info_end = 0;
+    Dwarf_Unsigned    attr_count = 0;
+    Dwarf_Unsigned    i = 0;
+    int               res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    dbg = die->di_cu_context->cc_dbg;
+    if (values_count && !values) {
+        _dwarf_error_string(dbg,error,DW_DLE_ATTR_NULL,
+            "DW_DLE_ATTR_NULL: dwarf_die_attr_values() "
+            "given a count but no array");
+        return DW_DLV_ERROR;
+    }
+    res = die_attr_start(die,&abbrev_list,&info_ptr,
+        &die_info_end,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < abbrev_list->abl_abbrev_count; ++i) {
+        Dwarf_Unsigned attr = abbrev_list->abl_attr[i];
+        Dwarf_Unsigned attr_form = abbrev_list->abl_form[i];
+        Dwarf_Signed   implicit_const = 0;
+        Dwarf_Unsigned sov = 0;
+
+        if (attr > DW_AT_hi_user) {
+            _dwarf_error(dbg, error,DW_DLE_ATTR_CORRUPT);
+            return DW_DLV_ERROR;
+        }
+        if (!attr) {
+            continue;
+        }
+        if (attr_count >= values_count) {
+            /*  Just counting the rest. */
+            ++attr_count;
+            continue;
+        }
+        if (attr_form == DW_FORM_implicit_const) {
+            implicit_const = abbrev_list->abl_implicit_const[i];
+        }
+        if (!_dwarf_valid_form_we_know(attr_form,attr)) {
+            _dwarf_error(dbg, error, DW_DLE_UNKNOWN_FORM);
+            return DW_DLV_ERROR;
+        }
+        if (attr_form == DW_FORM_indirect) {
+            res = read_indirect_form(die,attr,&info_ptr,
+                die_info_end,&attr_form,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+        }
+        if (attr_form != DW_FORM_implicit_const) {
+            if (_dwarf_reference_outside_section(die,
+                (Dwarf_Small*) info_ptr,
+                ((Dwarf_Small*) info_ptr )+1)) {
+                _dwarf_error_string(dbg, error,
+                    DW_DLE_ATTR_OUTSIDE_SECTION,
+                    "DW_DLE_ATTR_OUTSIDE_SECTION: "
+                    " Reading Attributes: "
+                    "We have run off the end of the section. "
+                    "Corrupt Dwarf");
+                return DW_DLV_ERROR;
+            }
+            res = _dwarf_get_size_of_val(dbg,
+                attr_form,
+                die->di_cu_context->cc_version_stamp,
+                die->di_cu_context->cc_address_size,
+                info_ptr,
+                die->di_cu_context->cc_length_size,
+                &sov,
+                die_info_end,
+                error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+        }
+        res = decode_attr_value(die,(Dwarf_Half)attr,
+            (Dwarf_Half)attr_form,implicit_const,
+            info_ptr,sov,die_info_end,
+            values + attr_count,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        info_ptr += sov;
+        ++attr_count;
+    }
+    *attr_count_out = attr_count;
+    if (!attr_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return DW_DLV_OK;
+}
+
 static void
 build_alloc_qu_error(Dwarf_Debug dbg,
     const char *fieldname,
@@ -748,7 +1053,28 @@ _dwarf_get_value_ptr(Dwarf_Die die,
             " in _dwarf_get_value_ptr()", error);
         return DW_DLV_ERROR;
     }
-    for (i = 0; i < abbrev_list->abl_abbrev_count; ++i) {
+    if (abbrev_list->abl_attr_offset) {
+        /*  Values in the fixed-size prefix are at
+            known offsets. */
+        Dwarf_Unsigned skip = 0;
+        Dwarf_Unsigned len  = 0;
+
+        for ( ; i < abbrev_list->abl_fixed_prefix_count; ++i) {
+            if (abbrev_list->abl_attr[i] == attrnum_in) {
+                break;
+            }
+        }
+        skip = abbrev_list->abl_attr_offset[i];
+        /*  ptrdiff_t is generated but not named */
+        len = (die_info_end >= info_ptr)?
+            (die_info_end - info_ptr):0;
+        if (skip > len) {
+            _dwarf_error(dbg,error,DW_DLE_DIE_ABBREV_BAD);
+            return DW_DLV_ERROR;
+        }
+        info_ptr += skip;
+    }
+    for ( ; i < abbrev_list->abl_abbrev_count; ++i) {
         Dwarf_Unsigned curr_attr_form = 0;
         Dwarf_Unsigned curr_attr = 0;
         Dwarf_Unsigned value_size=0;
@@ -139,6 +139,52 @@ _dwarf_readr(int fd,
     return DW_DLV_OK;
 }
 
+/*  Read size bytes at file offset loc.
+    Where pread() exists the file offset is neither
+    used nor changed, so processes sharing the fd
+    (after fork()) cannot disturb each other's reads. */
+int
+_dwarf_preadr(int fd,
+    char *buf,
+    Dwarf_Unsigned loc,
+    Dwarf_Unsigned size)
+{
+#if defined(HAVE_UNISTD_H) && !defined(_WIN32)
+    Dwarf_Unsigned max_single_read = 0x1ffff000;
+    Dwarf_Unsigned remaining_bytes = size;
+
+    if ((Dwarf_Signed)loc < 0) {
+        return DW_DLV_ERROR;
+    }
+    while (remaining_bytes > 0) {
+        Dwarf_Signed rcode = 0;
+
+        if (remaining_bytes > max_single_read) {
+            size = max_single_read;
+        } else {
+            size = remaining_bytes;
+        }
+        rcode = (Dwarf_Signed)pread(fd,buf,(size_t)size,
+            (off_t)loc);
+        if (rcode < 0 || rcode != (Dwarf_Signed)size) {
+            return DW_DLV_ERROR;
+        }
+        remaining_bytes -= size;
+        buf += size;
+        loc += size;
+    }
+    return DW_DLV_OK;
+#else
+    int res = 0;
+
+    res = _dwarf_seekr(fd,loc,SEEK_SET,0);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return _dwarf_readr(fd,buf,size,0);
+#endif
+}
+
 int
 _dwarf_seekr(int fd,
     Dwarf_Unsigned loc,
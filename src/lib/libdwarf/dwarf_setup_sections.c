@@ -301,6 +301,12 @@ _dwarf_enter_section_in_de_debug_sections_array(Dwarf_Debug dbg,
         &dbg->de_debug_frame_eh_gnu,
         DW_DLE_DEBUG_FRAME_DUPLICATE,0,
         TRUE,err);
+    /* gnu: binary search table into .eh_frame */
+    SET_UP_SECTION(dbg,scn_name,".eh_frame_hdr",
+        group_number,
+        &dbg->de_eh_frame_hdr,
+        DW_DLE_DEBUG_FRAME_DUPLICATE,0,
+        FALSE,err);
     SET_UP_SECTION(dbg,scn_name,".debug_loc",
         group_number,
         &dbg->de_debug_loc,
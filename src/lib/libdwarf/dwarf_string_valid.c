@@ -0,0 +1,97 @@
+/*
+  Copyright (C) 2000-2005 Silicon Graphics, Inc.  All Rights Reserved.
+  Portions Copyright (C) 2007-2022 David Anderson. All Rights Reserved.
+  Portions Copyright 2012 SN Systems Ltd. All rights reserved.
+  Portions Copyright 2020 Google All rights reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  _dwarf_check_string_valid() is here, apart from
+    dwarf_util.c, so tests can build it alone. */
+
+#include <config.h>
+
+#include <stddef.h> /* size_t */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+
+/*
+    We check that:
+        areaptr <= strptr.
+        a NUL byte (*p) exists at p < end.
+    and return DW_DLV_ERROR with suggested_error
+    if a check fails.
+
+    String sections (and CUs, whose last DIE ends
+    with a zero byte) normally end in NUL, and then every
+    string starting in the area ends in it, so
+    checking the last byte avoids a scan of the string
+    that the caller would repeat with strlen().
+    Only when that byte is not NUL do we scan.
+
+    de_assume_string_in_bounds
+*/
+int
+_dwarf_check_string_valid(Dwarf_Debug dbg,void *areaptr,
+    void *strptr, void *areaendptr,
+    int suggested_error,
+    Dwarf_Error*error)
+{
+    Dwarf_Small *start = areaptr;
+    Dwarf_Small *p = strptr;
+    Dwarf_Small *end = areaendptr;
+
+    if (p < start) {
+        _dwarf_error(dbg,error,suggested_error);
+        return DW_DLV_ERROR;
+    }
+    if (p >= end) {
+        _dwarf_error(dbg,error,suggested_error);
+        return DW_DLV_ERROR;
+    }
+    if (dbg->de_assume_string_in_bounds) {
+        /* This NOT the default. But folks can choose
+            to live dangerously and just assume strings ok. */
+        return DW_DLV_OK;
+    }
+    if (!end[-1]) {
+        return DW_DLV_OK;
+    }
+    while (p < end) {
+        if (*p == 0) {
+            return DW_DLV_OK;
+        }
+        ++p;
+    }
+    _dwarf_error(dbg,error,suggested_error);
+    return DW_DLV_ERROR;
+}
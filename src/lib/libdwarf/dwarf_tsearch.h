@@ -77,6 +77,7 @@ DW_VISIT;
 #define dwarf_tfind    _dwarf_tfind
 #define dwarf_tdelete  _dwarf_tdelete
 #define dwarf_twalk    _dwarf_twalk
+#define dwarf_twalk_r  _dwarf_twalk_r
 #define dwarf_tdestroy _dwarf_tdestroy
 #define dwarf_tdump    _dwarf_tdump
 #define dwarf_initialize_search_hash _dwarf_initialize_search_hash
@@ -104,6 +105,16 @@ void dwarf_twalk(const void * /*root*/,
     const DW_VISIT  /*which*/,
     const int  /*depth*/));
 
+/*  Like dwarf_twalk() but passes closure through to
+    action so the caller need not keep walk state in
+    static variables (which would not be thread safe). */
+void dwarf_twalk_r(const void * /*root*/,
+    void (* /*action*/)(const void * /*nodep*/,
+    const DW_VISIT  /*which*/,
+    const int  /*depth*/,
+    void * /*closure*/),
+    void * /*closure*/);
+
 /*  dwarf_tdestroy() cannot set the root pointer NULL, you must do
     so on return from dwarf_tdestroy(). */
 void dwarf_tdestroy(void * /*root*/,
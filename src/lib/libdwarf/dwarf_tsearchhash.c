@@ -145,6 +145,33 @@ _tsearch_inner( const void *key, struct hs_base* head,
     int (*compar)(const void *, const void *),
     const enum search_intent_t intent, int*inserted,
     struct ts_entry **parent_ptr);
+void
+dwarf_twalk_r(const void *rootp,
+    void (*action)(const void *nodep, const DW_VISIT which,
+        const int depth, void *closure),
+    void *closure)
+{
+    const struct hs_base *head = (const struct hs_base *)rootp;
+    struct ts_entry *p = 0;
+    unsigned long ix = 0;
+    unsigned long tsize = 0;
+
+    if (!head) {
+        return;
+    }
+    p = head->hashtab_;
+    tsize = head->tablesize_;
+    for ( ; ix < tsize; ix++,p++) {
+        struct ts_entry*n = 0;
+        if (p->keyptr) {
+            action((void *)(&(p->keyptr)),dwarf_leaf,0,closure);
+        }
+        for (n = p->next; n ; n = n->next) {
+            action((void *)(&(n->keyptr)),dwarf_leaf,0,closure);
+        }
+    }
+}
+
 static void
 _dwarf_tdestroy_inner(struct hs_base*h,
     void (*free_node)(void *nodep));
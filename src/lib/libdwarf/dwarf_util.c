@@ -40,6 +40,10 @@
 #include "stdafx.h"
 #endif /* HAVE_STDAFX_H */
 
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif /* HAVE_STDINT_H */
+
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "libdwarf_private.h"
@@ -52,6 +56,7 @@
 #include "dwarf_memcpy_swap.h"
 #include "dwarf_die_deliv.h"
 #include "dwarf_string.h"
+#include "dwarf_tsearch.h"
 
 #define MINBUFLEN 1000
 
@@ -601,6 +606,91 @@ _dwarf_get_size_of_val(Dwarf_Debug dbg,
     return DW_DLV_ERROR;
 }
 
+/*  Returns TRUE and sets *size_out if every value
+    of the form has the same size in this CU, so the
+    size is known without looking at the DIE.
+    Agrees with _dwarf_get_size_of_val().
+    Returns FALSE for forms whose size depends
+    on the bytes of the value (leb, block, string)
+    and for DW_FORM_indirect. */
+Dwarf_Bool
+_dwarf_fixed_size_of_form(Dwarf_Half form,
+    Dwarf_Half cu_version,
+    Dwarf_Half address_size,
+    int v_length_size,
+    Dwarf_Unsigned *size_out)
+{
+    switch (form) {
+    case 0:
+    case DW_FORM_flag_present:
+    case DW_FORM_implicit_const:
+        *size_out = 0;
+        return TRUE;
+    case DW_FORM_data1:
+    case DW_FORM_ref1:
+    case DW_FORM_flag:
+    case DW_FORM_addrx1:
+    case DW_FORM_strx1:
+        *size_out = 1;
+        return TRUE;
+    case DW_FORM_data2:
+    case DW_FORM_ref2:
+    case DW_FORM_addrx2:
+    case DW_FORM_strx2:
+        *size_out = 2;
+        return TRUE;
+    case DW_FORM_addrx3:
+    case DW_FORM_strx3:
+        *size_out = 3;
+        return TRUE;
+    case DW_FORM_data4:
+    case DW_FORM_ref4:
+    case DW_FORM_ref_sup4:
+    case DW_FORM_addrx4:
+    case DW_FORM_strx4:
+        *size_out = 4;
+        return TRUE;
+    case DW_FORM_data8:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_sig8:
+    case DW_FORM_ref_sup8:
+        *size_out = 8;
+        return TRUE;
+    case DW_FORM_data16:
+        *size_out = 16;
+        return TRUE;
+    case DW_FORM_addr:
+        if (!address_size) {
+            /*  _dwarf_get_size_of_val() falls back
+                to de_pointer_size. Leave it to that. */
+            return FALSE;
+        }
+        *size_out = address_size;
+        return TRUE;
+    case DW_FORM_ref_addr:
+        if (cu_version == DW_CU_VERSION2) {
+            if (!address_size) {
+                return FALSE;
+            }
+            *size_out = address_size;
+        } else {
+            *size_out = v_length_size;
+        }
+        return TRUE;
+    case DW_FORM_GNU_ref_alt:
+    case DW_FORM_GNU_strp_alt:
+    case DW_FORM_strp_sup:
+    case DW_FORM_sec_offset:
+    case DW_FORM_line_strp:
+    case DW_FORM_strp:
+        *size_out = v_length_size;
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
 /*  Table size is always a power of two so
     we can use "val2 = val1 & (size-1)"
     instead of a slower 'hash' function.  */
@@ -755,7 +845,7 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
                 sizeof(Dwarf_Abbrev_List));
         if (!hash_table_base->tb_entries) {
             *highest_known_code =
-                context->cc_highest_known_code;
+                hash_table_base->tb_highest_known_code;
             return DW_DLV_NO_ENTRY;
         }
     } else if (hash_table_base->tb_total_abbrev_count >
@@ -791,7 +881,7 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
         if (!newht->tb_entries) {
             free(newht);
             *highest_known_code =
-                context->cc_highest_known_code;
+                hash_table_base->tb_highest_known_code;
             return DW_DLV_NO_ENTRY;
         }
         /*  Copy the existing entries to the new table,
@@ -799,15 +889,21 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
         copy_abbrev_table_to_new_table(hash_table_base, newht);
         _dwarf_free_abbrev_hash_table_contents(hash_table_base,
             TRUE /* keep abbrev content */);
-        /*  Now overwrite the existing table pointer
-            the new, newly valid, pointer. */
-        free(context->cc_abbrev_hash_table);
-        context->cc_abbrev_hash_table = newht;
-        hash_table_base = context->cc_abbrev_hash_table;
+        /*  Now move the new entries into the existing
+            table struct, which other CU contexts
+            may point to. */
+        hash_table_base->tb_table_entry_count =
+            newht->tb_table_entry_count;
+        hash_table_base->tb_total_abbrev_count =
+            newht->tb_total_abbrev_count;
+        hash_table_base->tb_highest_used_entry =
+            newht->tb_highest_used_entry;
+        hash_table_base->tb_entries = newht->tb_entries;
+        free(newht);
     } /* Else is ok as is */
     /*  Now add entry. */
-    if (code > context->cc_highest_known_code) {
-        context->cc_highest_known_code = code;
+    if (code > hash_table_base->tb_highest_known_code) {
+        hash_table_base->tb_highest_known_code = code;
     }
     hashable_val = code;
     hash_num = hashable_val HT_MOD_OP
@@ -827,15 +923,15 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
         /*  This returns a pointer to an abbrev
             list entry, not the list itself. */
         *highest_known_code =
-            context->cc_highest_known_code;
+            hash_table_base->tb_highest_known_code;
         hash_abbrev_entry->abl_reference_count++;
         *list_out = hash_abbrev_entry;
         return DW_DLV_OK;
     }
 
-    if (context->cc_last_abbrev_ptr) {
-        abbrev_ptr = context->cc_last_abbrev_ptr;
-        end_abbrev_ptr = context->cc_last_abbrev_endptr;
+    if (hash_table_base->tb_last_abbrev_ptr) {
+        abbrev_ptr = hash_table_base->tb_last_abbrev_ptr;
+        end_abbrev_ptr = hash_table_base->tb_last_abbrev_endptr;
     } else {
         /*  This is ok because cc_abbrev_offset includes DWP
             offset if appropriate.
@@ -877,7 +973,7 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
         is 0. */
     if (*abbrev_ptr == 0) {
         *highest_known_code =
-            context->cc_highest_known_code;
+            hash_table_base->tb_highest_known_code;
         return DW_DLV_NO_ENTRY;
     }
     do {
@@ -911,8 +1007,8 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
             return DW_DLV_ERROR;
         }
         new_hashable_val = abbrev_code;
-        if (abbrev_code > context->cc_highest_known_code) {
-            context->cc_highest_known_code = abbrev_code;
+        if (abbrev_code > hash_table_base->tb_highest_known_code) {
+            hash_table_base->tb_highest_known_code = abbrev_code;
         }
         hash_num = new_hashable_val HT_MOD_OP
             (hash_table_base->tb_table_entry_count-1);
@@ -940,7 +1036,7 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
             &abbrev_ptr2,error);
         if (res != DW_DLV_OK) {
             *highest_known_code =
-                context->cc_highest_known_code;
+                hash_table_base->tb_highest_known_code;
             return res;
         }
         inner_list_entry->abl_implicit_const_count =
@@ -950,9 +1046,9 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
     } while ((abbrev_ptr < end_abbrev_ptr) &&
         *abbrev_ptr != 0 && abbrev_code != code);
 
-    *highest_known_code = context->cc_highest_known_code;
-    context->cc_last_abbrev_ptr = abbrev_ptr;
-    context->cc_last_abbrev_endptr = end_abbrev_ptr;
+    *highest_known_code = hash_table_base->tb_highest_known_code;
+    hash_table_base->tb_last_abbrev_ptr = abbrev_ptr;
+    hash_table_base->tb_last_abbrev_endptr = end_abbrev_ptr;
     if (abbrev_code == code) {
         *list_out = inner_list_entry;
         inner_list_entry->abl_reference_count++;
@@ -965,47 +1061,6 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
     return DW_DLV_NO_ENTRY;
 }
 
-/*
-    We check that:
-        areaptr <= strptr.
-        a NUL byte (*p) exists at p < end.
-    and return DW_DLV_ERROR if a check fails.
-
-    de_assume_string_in_bounds
-*/
-int
-_dwarf_check_string_valid(Dwarf_Debug dbg,void *areaptr,
-    void *strptr, void *areaendptr,
-    int suggested_error,
-    Dwarf_Error*error)
-{
-    Dwarf_Small *start = areaptr;
-    Dwarf_Small *p = strptr;
-    Dwarf_Small *end = areaendptr;
-
-    if (p < start) {
-        _dwarf_error(dbg,error,suggested_error);
-        return DW_DLV_ERROR;
-    }
-    if (p >= end) {
-        _dwarf_error(dbg,error,suggested_error);
-        return DW_DLV_ERROR;
-    }
-    if (dbg->de_assume_string_in_bounds) {
-        /* This NOT the default. But folks can choose
-            to live dangerously and just assume strings ok. */
-        return DW_DLV_OK;
-    }
-    while (p < end) {
-        if (*p == 0) {
-            return DW_DLV_OK;
-        }
-        ++p;
-    }
-    _dwarf_error(dbg,error,DW_DLE_STRING_NOT_TERMINATED);
-    return DW_DLV_ERROR;
-}
-
 /*  Return non-zero if the start/end are not valid for the
     die's section.
     If pastend matches the dss_data+dss_size then
@@ -1262,6 +1317,8 @@ _dwarf_free_abbrev_hash_table_contents(Dwarf_Hash_Table hash_table,
                 abbrev->abl_form = 0;
                 free(abbrev->abl_implicit_const);
                 abbrev->abl_implicit_const = 0;
+                free(abbrev->abl_attr_offset);
+                abbrev->abl_attr_offset = 0;
                 nextabbrev = abbrev->abl_next;
                 abbrev->abl_next = 0;
                 /*  dealloc single list entry */
@@ -1285,6 +1342,128 @@ printf("debugging: max ref count of any abbrev %lu, \n",
     hash_table->tb_entries = 0;
 }
 
+/*  dwarf_tsearch callbacks for de_abbrev_tables. */
+static DW_TSHASHTYPE
+abbrev_table_hashfunc(const void *keyp)
+{
+    const struct Dwarf_Hash_Table_s *ht = keyp;
+
+    return (DW_TSHASHTYPE)ht->tb_abbrev_offset;
+}
+
+static int
+abbrev_table_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Hash_Table_s *lp = l;
+    const struct Dwarf_Hash_Table_s *rp = r;
+
+    if (lp->tb_abbrev_offset != rp->tb_abbrev_offset) {
+        return (lp->tb_abbrev_offset < rp->tb_abbrev_offset)?
+            -1:1;
+    }
+    if (lp->tb_version != rp->tb_version) {
+        return (lp->tb_version < rp->tb_version)? -1:1;
+    }
+    if (lp->tb_address_size != rp->tb_address_size) {
+        return (lp->tb_address_size < rp->tb_address_size)?
+            -1:1;
+    }
+    if (lp->tb_length_size != rp->tb_length_size) {
+        return (lp->tb_length_size < rp->tb_length_size)?
+            -1:1;
+    }
+    return 0;
+}
+
+static void
+abbrev_table_free(void *nodep)
+{
+    Dwarf_Hash_Table hash_table = nodep;
+
+    _dwarf_free_abbrev_hash_table_contents(hash_table,FALSE);
+    free(hash_table);
+}
+
+/*  Called once the CU context's abbreviation offset
+    is final and before any abbreviation is read.
+    If an earlier CU has a table for the same offset
+    (common after dwz or LTO partitioning) switch to
+    that one, else offer this CU's empty table for
+    sharing. The abbreviation decode plans depend on
+    the CU version, address size and offset size so
+    those are part of the key.
+    DWP package units keep their own table, their
+    abbreviations end at a unit-specific size.
+    Failure to share (out of memory) is not an error,
+    the CU simply keeps its own table. */
+void
+_dwarf_share_abbrev_hash_table(Dwarf_CU_Context context)
+{
+    Dwarf_Debug      dbg = context->cc_dbg;
+    Dwarf_Hash_Table own = context->cc_abbrev_hash_table;
+    Dwarf_Hash_Table found = 0;
+    void            *retval = 0;
+
+    if (!own || own->tb_shared || own->tb_entries) {
+        return;
+    }
+    if (context->cc_dwp_offsets.pcu_type) {
+        return;
+    }
+    if (!dbg->de_abbrev_tables) {
+        dwarf_initialize_search_hash(&dbg->de_abbrev_tables,
+            abbrev_table_hashfunc,0);
+        if (!dbg->de_abbrev_tables) {
+            return;
+        }
+    }
+    own->tb_abbrev_offset = context->cc_abbrev_offset;
+    own->tb_version = context->cc_version_stamp;
+    own->tb_address_size = context->cc_address_size;
+    own->tb_length_size = context->cc_length_size;
+    retval = dwarf_tsearch(own,&dbg->de_abbrev_tables,
+        abbrev_table_compare);
+    if (!retval) {
+        return;
+    }
+    found = *(Dwarf_Hash_Table *)retval;
+    if (found == own) {
+        own->tb_shared = TRUE;
+        return;
+    }
+    free(own);
+    context->cc_abbrev_hash_table = found;
+}
+
+/*  Frees the CU context's abbreviation table
+    unless it is shared, shared tables are freed
+    by _dwarf_free_shared_abbrev_hash_tables(). */
+void
+_dwarf_free_cu_abbrev_hash_table(Dwarf_CU_Context context)
+{
+    Dwarf_Hash_Table hash_table = context->cc_abbrev_hash_table;
+
+    if (!hash_table) {
+        return;
+    }
+    context->cc_abbrev_hash_table = 0;
+    if (hash_table->tb_shared) {
+        return;
+    }
+    _dwarf_free_abbrev_hash_table_contents(hash_table,FALSE);
+    free(hash_table);
+}
+
+void
+_dwarf_free_shared_abbrev_hash_tables(Dwarf_Debug dbg)
+{
+    if (dbg->de_abbrev_tables) {
+        dwarf_tdestroy(dbg->de_abbrev_tables,
+            abbrev_table_free);
+        dbg->de_abbrev_tables = 0;
+    }
+}
+
 /*
     If no die provided the size value returned might be wrong.
     If different compilation units have different address sizes
@@ -1510,6 +1689,9 @@ _dwarf_what_section_are_we(Dwarf_Debug dbg,
     FINDSEC(&dbg->de_debug_frame_eh_gnu,
         our_pointer, section_name_out,
         sec_start_ptr_out, sec_len_out, sec_end_ptr_out);
+    FINDSEC(&dbg->de_eh_frame_hdr,
+        our_pointer, section_name_out,
+        sec_start_ptr_out, sec_len_out, sec_end_ptr_out);
     FINDSEC(&dbg->de_gnu_debuglink,
         our_pointer, section_name_out,
         sec_start_ptr_out, sec_len_out, sec_end_ptr_out);
@@ -392,9 +392,20 @@ _dwarf_get_size_of_val(Dwarf_Debug dbg,
     Dwarf_Small *section_end_ptr,
     Dwarf_Error *error);
 
+Dwarf_Bool
+_dwarf_fixed_size_of_form(Dwarf_Half form,
+    Dwarf_Half cu_version,
+    Dwarf_Half address_size,
+    int v_length_size,
+    Dwarf_Unsigned *size_out);
+
 /*
    Dwarf_Hash_Table_s is the base for the 'hash' table.
-   The table occurs exactly once per CU.
+   The table occurs once per CU, except that CUs
+   whose abbreviations start at the same
+   .debug_abbrev offset (and which agree on version,
+   address size and offset size) share one table.
+   See _dwarf_share_abbrev_hash_table().
 
    The intent is that once the total_abbrev_count across
    one should build a new Dwarf_Hash_Table_Base_s, rehash
@@ -420,8 +431,30 @@ struct Dwarf_Hash_Table_s {
         and in each singly-linked  list starting
         there points to the entries for one abbrev code. */
     Dwarf_Abbrev_List  *tb_entries;
+
+    /*  How far the abbreviations have been read.
+        Kept here, not in the CU context, as the
+        table may be shared. */
+    Dwarf_Byte_Ptr      tb_last_abbrev_ptr;
+    Dwarf_Byte_Ptr      tb_last_abbrev_endptr;
+    Dwarf_Unsigned      tb_highest_known_code;
+
+    /*  If tb_shared the Dwarf_Debug owns the table
+        (in de_abbrev_tables) and the
+        remaining fields are its key. */
+    Dwarf_Bool          tb_shared;
+    Dwarf_Unsigned      tb_abbrev_offset;
+    Dwarf_Half          tb_version;
+    Dwarf_Half          tb_address_size;
+    Dwarf_Half          tb_length_size;
 };
 
+void _dwarf_share_abbrev_hash_table(
+    struct Dwarf_CU_Context_s *context);
+void _dwarf_free_cu_abbrev_hash_table(
+    struct Dwarf_CU_Context_s *context);
+void _dwarf_free_shared_abbrev_hash_tables(Dwarf_Debug dbg);
+
 /* Perhaps not actually useful. */
 struct Dwarf_Abbrev_Common_s {
     /*  From cu_context */
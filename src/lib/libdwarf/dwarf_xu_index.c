@@ -66,6 +66,7 @@
 
 #include <config.h>
 
+#include <stdlib.h> /* free() malloc() qsort() */
 #include <string.h>  /* memcmp() memcpy() strcmp() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
@@ -688,6 +689,9 @@ _dwarf_search_fission_for_key(Dwarf_Debug dbg,
     Dwarf_Sig8 hashentry_key;
     Dwarf_Unsigned percu_index = 0;
     Dwarf_Unsigned h = 0;
+    Dwarf_Unsigned hprime = 0;
+    Dwarf_Unsigned mask = 0;
+    Dwarf_Unsigned probes = 0;
 
     (void)dbg;
     hashentry_key = zerohashkey;
@@ -740,9 +744,43 @@ _dwarf_search_fission_for_key(Dwarf_Debug dbg,
         return DW_DLV_ERROR;
     }
     ASNARL(key,key_in,sizeof(*key_in));
-    /*  If we built a lookup based on hash key
-        this loop would not be necessary. */
-    for (h = 0; h < slots; ++h) {
+    if (slots & (slots-1)) {
+        /*  Not a power of two, so not a table
+            built per the DWARF5 hashing rules.
+            Look at every slot. */
+        for (h = 0; h < slots; ++h) {
+            int res = 0;
+
+            res = dwarf_get_xu_hash_entry(xuhdr,
+                h,&hashentry_key,
+                &percu_index,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (percu_index == 0 &&
+                !memcmp(&hashentry_key,&zerohashkey,
+                sizeof(Dwarf_Sig8))) {
+                continue;
+            }
+            if (!memcmp(key_in,&hashentry_key,sizeof(Dwarf_Sig8))) {
+                /* FOUND */
+                *percu_index_out = percu_index;
+                return  DW_DLV_OK;
+            }
+        }
+        return DW_DLV_NO_ENTRY;
+    }
+    /*  DWARF5 7.3.5.3: with S == 2^k and
+        MASK(k) == S-1 the primary hash is
+        H(K) = K & MASK(k) and the secondary hash is
+        H'(K) = ((K >> 32) & MASK(k)) | 1.
+        Probe from H(K) in steps of H'(K) until the key
+        or an unused slot turns up.
+        H'(K) is odd so S probes visit every slot once. */
+    mask = slots - 1;
+    h = key & mask;
+    hprime = ((key >> 32) & mask) | 1;
+    for (probes = 0; probes < slots; ++probes) {
         int res = 0;
 
         res = dwarf_get_xu_hash_entry(xuhdr,
@@ -753,57 +791,88 @@ _dwarf_search_fission_for_key(Dwarf_Debug dbg,
         }
         if (percu_index == 0 &&
             !memcmp(&hashentry_key,&zerohashkey,sizeof(Dwarf_Sig8))) {
-            continue;
+            /* Unused slot: the key is not present. */
+            return DW_DLV_NO_ENTRY;
         }
         if (!memcmp(key_in,&hashentry_key,sizeof(Dwarf_Sig8))) {
             /* FOUND */
             *percu_index_out = percu_index;
             return  DW_DLV_OK;
         }
+        h = (h + hprime) & mask;
     }
     return DW_DLV_NO_ENTRY;
 }
 
-/*  Slow. Consider tsearch. */
-/*  For type units and for CUs. */
-/*  We're finding an index entry refers
-    to a global offset in some CU
-    and hence is unique in the target. */
+/*  Called by qsort to order the offset index.
+    Ties (which only corrupt data should have)
+    keep hash slot order so the result matches
+    a scan of the hash table. */
 static int
-_dwarf_search_fission_for_offset(Dwarf_Debug dbg,
+xu_offset_compare(const void *elem1, const void *elem2)
+{
+    const struct Dwarf_Xu_Offset_Entry_s *e1 =
+        (const struct Dwarf_Xu_Offset_Entry_s *)elem1;
+    const struct Dwarf_Xu_Offset_Entry_s *e2 =
+        (const struct Dwarf_Xu_Offset_Entry_s *)elem2;
+
+    if (e1->xo_offset < e2->xo_offset) {
+        return -1;
+    }
+    if (e1->xo_offset > e2->xo_offset) {
+        return 1;
+    }
+    if (e1->xo_slot < e2->xo_slot) {
+        return -1;
+    }
+    if (e1->xo_slot > e2->xo_slot) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  Builds xuhdr->gx_offset_index for the section
+    column secnum_index (whose DW_SECT_* is dfp_sect_num).
+    Done once per Dwarf_Xu_Index_Header. */
+static int
+build_fission_offset_index(Dwarf_Debug dbg,
     Dwarf_Xu_Index_Header xuhdr,
-    Dwarf_Unsigned offset,
-    Dwarf_Unsigned dfp_sect_num, /* DW_SECT_INFO or TYPES */
-    Dwarf_Unsigned * percu_index_out,
-    Dwarf_Sig8 * key_out,
+    Dwarf_Unsigned secnum_index,
+    Dwarf_Unsigned dfp_sect_num,
     Dwarf_Error *error)
 {
-    Dwarf_Unsigned i = 0;
     Dwarf_Unsigned m = 0;
-    Dwarf_Unsigned secnum_index = 0;
-    Dwarf_Bool     found_secnum = FALSE;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned slots = xuhdr->gx_slots_in_hash;
+    struct Dwarf_Xu_Offset_Entry_s *index = 0;
     int res = 0;
 
-    for ( i = 0; i< xuhdr->gx_column_count_sections; i++) {
-        /*  We could put the secnums array into xuhdr
-            if looping here is too slow. */
-        const char *name = 0;
-        Dwarf_Unsigned num = 0;
-        res = dwarf_get_xu_section_names(xuhdr,i,&num,&name,error);
-        if (res != DW_DLV_OK) {
-            return res;
-        }
-        if (num == dfp_sect_num) {
-            secnum_index = i;
-            found_secnum = TRUE;
-            break;
-        }
+    if (xuhdr->gx_offset_index) {
+        free(xuhdr->gx_offset_index);
+        xuhdr->gx_offset_index = 0;
+        xuhdr->gx_offset_index_count = 0;
+    }
+    if (!slots) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (slots > xuhdr->gx_section_length) {
+        /*  Corrupt. dwarf_get_xu_index_header()
+            checked the hash table fits in the section,
+            this is just for safety in the malloc. */
+        _dwarf_error_string(dbg, error, DW_DLE_XU_NAME_COL_ERROR,
+            "ERROR: DW_DLE_XU_NAME_COL_ERROR the slots count "
+            "is larger than the section length");
+        return DW_DLV_ERROR;
     }
-    if (FALSE == found_secnum) {
-        _dwarf_error(dbg,error,DW_DLE_FISSION_SECNUM_ERR);
+    index = (struct Dwarf_Xu_Offset_Entry_s *)
+        malloc(slots * sizeof(struct Dwarf_Xu_Offset_Entry_s));
+    if (!index) {
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating the "
+            "fission offset index");
         return DW_DLV_ERROR;
     }
-    for ( m = 0; m < xuhdr->gx_slots_in_hash; ++m) {
+    for ( m = 0; m < slots; ++m) {
         Dwarf_Sig8 hash;
         Dwarf_Unsigned indexn = 0;
         Dwarf_Unsigned sec_offset = 0;
@@ -811,6 +880,7 @@ _dwarf_search_fission_for_offset(Dwarf_Debug dbg,
 
         res = dwarf_get_xu_hash_entry(xuhdr,m,&hash,&indexn,error);
         if (res != DW_DLV_OK) {
+            free(index);
             return res;
         }
         if (indexn == 0 &&
@@ -818,20 +888,98 @@ _dwarf_search_fission_for_offset(Dwarf_Debug dbg,
             /* Empty slot. */
             continue;
         }
-
         res = dwarf_get_xu_section_offset(xuhdr,
             indexn,secnum_index,&sec_offset,&sec_size,error);
         if (res != DW_DLV_OK) {
+            free(index);
             return res;
         }
-        if (sec_offset != offset) {
-            continue;
+        index[count].xo_offset = sec_offset;
+        index[count].xo_slot = m;
+        index[count].xo_percu_index = indexn;
+        index[count].xo_hash = hash;
+        ++count;
+    }
+    if (count > 1) {
+        qsort((void *)index, count,
+            sizeof(struct Dwarf_Xu_Offset_Entry_s),
+            xu_offset_compare);
+    }
+    xuhdr->gx_offset_index = index;
+    xuhdr->gx_offset_index_count = count;
+    xuhdr->gx_offset_index_secnum = dfp_sect_num;
+    return DW_DLV_OK;
+}
+
+/*  For type units and for CUs. */
+/*  We're finding an index entry refers
+    to a global offset in some CU
+    and hence is unique in the target.
+    Uses a binary search of an index
+    sorted by offset, built on the first call. */
+static int
+_dwarf_search_fission_for_offset(Dwarf_Debug dbg,
+    Dwarf_Xu_Index_Header xuhdr,
+    Dwarf_Unsigned offset,
+    Dwarf_Unsigned dfp_sect_num, /* DW_SECT_INFO or TYPES */
+    Dwarf_Unsigned * percu_index_out,
+    Dwarf_Sig8 * key_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned secnum_index = 0;
+    Dwarf_Bool     found_secnum = FALSE;
+    Dwarf_Unsigned low = 0;
+    Dwarf_Unsigned high = 0;
+    struct Dwarf_Xu_Offset_Entry_s *index = 0;
+    int res = 0;
+
+    if (!xuhdr->gx_offset_index ||
+        xuhdr->gx_offset_index_secnum != dfp_sect_num) {
+        for ( i = 0; i< xuhdr->gx_column_count_sections; i++) {
+            const char *name = 0;
+            Dwarf_Unsigned num = 0;
+
+            res = dwarf_get_xu_section_names(xuhdr,i,&num,
+                &name,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (num == dfp_sect_num) {
+                secnum_index = i;
+                found_secnum = TRUE;
+                break;
+            }
+        }
+        if (FALSE == found_secnum) {
+            _dwarf_error(dbg,error,DW_DLE_FISSION_SECNUM_ERR);
+            return DW_DLV_ERROR;
+        }
+        res = build_fission_offset_index(dbg,xuhdr,
+            secnum_index,dfp_sect_num,error);
+        if (res != DW_DLV_OK) {
+            return res;
         }
-        *percu_index_out = indexn;
-        *key_out = hash;
-        return DW_DLV_OK;
     }
-    return DW_DLV_NO_ENTRY;
+    index = xuhdr->gx_offset_index;
+    /*  Find the first entry with xo_offset >= offset. */
+    high = xuhdr->gx_offset_index_count;
+    while (low < high) {
+        Dwarf_Unsigned mid = low + (high - low)/2;
+
+        if (index[mid].xo_offset < offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low >= xuhdr->gx_offset_index_count ||
+        index[low].xo_offset != offset) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *percu_index_out = index[low].xo_percu_index;
+    *key_out = index[low].xo_hash;
+    return DW_DLV_OK;
 }
 
 static int
@@ -983,6 +1131,17 @@ dwarf_get_debugfission_for_key(Dwarf_Debug dbg,
     return sres;
 }
 
+/*  Called by dwarf_dealloc() for DW_DLA_XU_INDEX. */
+void
+_dwarf_xu_index_destructor(void *m)
+{
+    Dwarf_Xu_Index_Header xuhdr = (Dwarf_Xu_Index_Header)m;
+
+    free(xuhdr->gx_offset_index);
+    xuhdr->gx_offset_index = 0;
+    xuhdr->gx_offset_index_count = 0;
+}
+
 void
 dwarf_dealloc_xu_header(Dwarf_Xu_Index_Header indexptr)
 {
@@ -35,6 +35,18 @@
     and the draft DWARF5 standard.
 */
 
+/*  One entry per used hash slot, sorted by the
+    offset (of the column gx_offset_index_secnum) so
+    an offset can be found with a binary search.
+    New October 2026. */
+struct Dwarf_Xu_Offset_Entry_s {
+    Dwarf_Unsigned xo_offset;
+    Dwarf_Unsigned xo_slot;
+    /* One-origin row of the offset and size tables. */
+    Dwarf_Unsigned xo_percu_index;
+    Dwarf_Sig8     xo_hash;
+};
+
 struct Dwarf_Xu_Index_Header_s {
     Dwarf_Debug      gx_dbg;
     Dwarf_Small    * gx_section_data;
@@ -58,6 +70,16 @@ struct Dwarf_Xu_Index_Header_s {
 
     /* Do not free gx_section_name. */
     const char     * gx_section_name;
+
+    /*  Built on first search by offset and then
+        kept till the header is deallocated.
+        gx_offset_index_secnum is the DW_SECT_* the
+        offsets were taken from. free() gx_offset_index. */
+    struct Dwarf_Xu_Offset_Entry_s * gx_offset_index;
+    Dwarf_Unsigned   gx_offset_index_count;
+    Dwarf_Unsigned   gx_offset_index_secnum;
 };
 
+void _dwarf_xu_index_destructor(void *m);
+
 #endif /* DWARF_XU_INDEX_H */
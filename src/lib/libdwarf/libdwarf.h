@@ -278,6 +278,26 @@ enum Dwarf_Form_Class {
     DW_FORM_CLASS_RNGLISTSPTR=18,  /* DWARF5 */
     DW_FORM_CLASS_STROFFSETSPTR=19 /* DWARF5 */
 };
+
+/*! @enum Dwarf_Sec_Alloc_Pref
+    How libdwarf should bring object section data
+    into memory.  Dwarf_Alloc_Malloc (the default)
+    reads each section into space from malloc().
+    Dwarf_Alloc_Mmap maps uncompressed, unrelocated
+    sections read-only directly from the object file
+    (where mmap() is available), falling back
+    to malloc() for everything else.
+    Dwarf_Alloc_None is only used to query
+    the current setting, and is what is returned
+    for a Dwarf_Debug whose object file libdwarf
+    does not read itself.
+    @see dwarf_set_load_preference
+*/
+enum Dwarf_Sec_Alloc_Pref {
+    Dwarf_Alloc_None   = 0,
+    Dwarf_Alloc_Malloc = 1,
+    Dwarf_Alloc_Mmap   = 2
+};
 /*! @}   endgroupenums*/
 
 /*! @defgroup allstructs Defined and Opaque Structs
@@ -324,6 +344,34 @@ typedef struct Dwarf_Block_s {
     Dwarf_Unsigned  bl_section_offset;
 } Dwarf_Block;
 
+/*! @typedef Dwarf_Attr_Value
+
+    One decoded attribute as returned by
+    dwarf_die_attr_values().
+    av_form is the form after any DW_FORM_indirect.
+    Numeric values (including flags, references,
+    and index forms such as DW_FORM_strx, which
+    are left as the raw index) are in av_value.
+    CU-local references (DW_FORM_ref1 etc.) are
+    turned into .debug_info/.debug_types section
+    offsets, as dwarf_global_formref() does.
+    Blocks, DW_FORM_exprloc, DW_FORM_data16 and
+    DW_FORM_ref_sig8 set av_ptr to the bytes
+    in the section and av_len to their length.
+    String class forms set av_ptr to the string.
+    New October 2026.
+
+    @see dwarf_die_attr_values
+*/
+typedef struct Dwarf_Attr_Value_s {
+    Dwarf_Half            av_attr;
+    Dwarf_Half            av_form;
+    enum Dwarf_Form_Class av_class;
+    Dwarf_Unsigned        av_value;
+    Dwarf_Small          *av_ptr;
+    Dwarf_Unsigned        av_len;
+} Dwarf_Attr_Value;
+
 /*! @typedef Dwarf_Locdesc_c
     Provides access to Dwarf_Locdesc_c, a single
     location description
@@ -1459,9 +1507,10 @@ typedef struct Dwarf_Rnglists_Head_s * Dwarf_Rnglists_Head;
 #define DW_DLE_ARITHMETIC_OVERFLOW             501
 #define DW_DLE_UNIVERSAL_BINARY_ERROR          502
 #define DW_DLE_UNIV_BIN_OFFSET_SIZE_ERROR      503
+#define DW_DLE_ADDR_INDEX_BAD                  504
 
 /*! @note DW_DLE_LAST MUST EQUAL LAST ERROR NUMBER */
-#define DW_DLE_LAST        503
+#define DW_DLE_LAST        504
 #define DW_DLE_LO_USER     0x10000
 /*! @} */
 
@@ -1709,6 +1758,11 @@ DW_API int dwarf_init_b(int dw_fd,
     There is nothing the caller can do with the return
     value except report it somehow.  Most callers
     ignore the return value.
+
+    An error returned by a failed dwarf_init*() call
+    has no Dwarf_Debug and is not freed here, not even
+    by dwarf_finish(NULL). Free it with
+    dwarf_dealloc_error().
 */
 DW_API int dwarf_finish(Dwarf_Debug dw_dbg);
 
@@ -1768,6 +1822,56 @@ DW_API int dwarf_object_init_b(Dwarf_Obj_Access_Interface_a* dw_obj,
 */
 DW_API int dwarf_object_finish(Dwarf_Debug dw_dbg);
 
+/*! @brief Open a second Dwarf_Debug sharing section data
+
+    New October 2026.
+
+    Creates a new Dwarf_Debug on the object file
+    dw_dbg is reading. The new one does not read
+    the object again: it uses the section data
+    already loaded (and relocated and decompressed)
+    in dw_dbg. It has its own CU contexts, its own
+    allocations and its own error state, so it can
+    be used in one thread while dw_dbg, or another
+    Dwarf_Debug created from dw_dbg, is used in
+    another thread.
+
+    The call loads every DWARF section of dw_dbg
+    that is not yet loaded. Make all such calls
+    from the thread using dw_dbg, typically before
+    starting the worker threads.
+    Call dwarf_finish() on each new Dwarf_Debug
+    before calling dwarf_finish() on dw_dbg.
+
+    A tied Dwarf_Debug (see dwarf_set_tied_dbg())
+    is not carried over: give each worker its
+    own tied Dwarf_Debug if it needs one.
+
+    Use dwarf_get_cu_header_offsets() to divide the
+    CUs among the workers.
+
+    @param dw_dbg
+    An open Dwarf_Debug.
+    @param dw_errhand
+    Pass in NULL normally.
+    @param dw_errarg
+    Pass in NULL normally.
+    @param dw_ret_dbg
+    On success *dw_ret_dbg is set to the new
+    Dwarf_Debug.
+    @param dw_error
+    In case return is DW_DLV_ERROR
+    dw_error is set to point to
+    the error details.
+    @return
+    The usual value: DW_DLV_OK etc.
+*/
+DW_API int dwarf_init_from_debug(Dwarf_Debug dw_dbg,
+    Dwarf_Handler dw_errhand,
+    Dwarf_Ptr     dw_errarg,
+    Dwarf_Debug  *dw_ret_dbg,
+    Dwarf_Error  *dw_error);
+
 /*! @brief Use with split dwarf.
 
     In libdwarf usage the  object file being reported
@@ -1813,6 +1917,77 @@ DW_API int dwarf_set_tied_dbg(Dwarf_Debug dw_split_dbg,
 DW_API int dwarf_get_tied_dbg(Dwarf_Debug dw_dbg,
     Dwarf_Debug * dw_tieddbg_out,
     Dwarf_Error * dw_error);
+
+/*! @brief Choose how section data is loaded
+
+    New October 2026.
+    Applies to the sections of dw_dbg loaded after
+    this call.  Sections are loaded as they are
+    first needed, so call this right after
+    dwarf_init_path(), dwarf_init_path_dl(),
+    dwarf_init_b() or their variants.
+    The setting belongs to dw_dbg alone:
+    other Dwarf_Debug instances, in this thread
+    or any other, are not affected.
+    The default is Dwarf_Alloc_Malloc.
+
+    With Dwarf_Alloc_Mmap the Elf, Mach-O and PE readers
+    map each uncompressed section that needs no
+    relocation directly from the object file (read-only)
+    instead of copying it into malloc() space.
+    That avoids both the read() and the copy, which
+    matters with very large debug files.
+    Compressed sections, sections to which relocations
+    are applied, and PE sections with zero-fill are
+    always loaded with malloc(), as is everything
+    when mmap() is unavailable or fails.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_load_preference
+    Pass Dwarf_Alloc_Malloc or Dwarf_Alloc_Mmap.
+    Pass Dwarf_Alloc_None to leave the setting unchanged.
+    @return
+    Returns the previous preference.
+    Returns Dwarf_Alloc_None, changing nothing,
+    if dw_dbg is not valid or was created by
+    dwarf_object_init_b() or dwarf_init_from_debug().
+*/
+DW_API enum Dwarf_Sec_Alloc_Pref dwarf_set_load_preference(
+    Dwarf_Debug dw_dbg,
+    enum Dwarf_Sec_Alloc_Pref dw_load_preference);
+
+/*! @brief Report how section data was loaded
+
+    Counts only sections loaded so far, since libdwarf
+    loads sections on first use.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_mmap_count
+    On success returns the number of sections
+    mapped with mmap(). Pass NULL if not of interest.
+    @param dw_mmap_size
+    On success returns the total bytes of
+    section data mapped. Pass NULL if not of interest.
+    @param dw_malloc_count
+    On success returns the number of sections
+    read into malloc() space. Pass NULL if not of interest.
+    @param dw_malloc_size
+    On success returns the total bytes of section
+    data read into malloc() space.
+    Pass NULL if not of interest.
+    @return
+    Returns DW_DLV_NO_ENTRY if dw_dbg was not opened
+    on an object file by libdwarf (for example
+    with dwarf_object_init_b()) or is NULL.
+    Never returns DW_DLV_ERROR.
+*/
+DW_API int dwarf_get_mmap_count(Dwarf_Debug dw_dbg,
+    Dwarf_Unsigned *dw_mmap_count,
+    Dwarf_Unsigned *dw_mmap_size,
+    Dwarf_Unsigned *dw_malloc_count,
+    Dwarf_Unsigned *dw_malloc_size);
 /*! @}
 */
 /*! @defgroup compilationunit Compilation Unit (CU) Access
@@ -1952,6 +2127,53 @@ DW_API int dwarf_next_cu_header_d(Dwarf_Debug dw_dbg,
     Dwarf_Half     *dw_header_cu_type,
     Dwarf_Error    *dw_error);
 
+/*! @brief Return the section offsets of all CU headers
+
+    New October 2026.
+
+    Reads only the unit length of each unit, so it
+    is much cheaper than iterating with
+    dwarf_next_cu_header_e() and it does not
+    change where dwarf_next_cu_header_e() is.
+
+    Intended for dividing the CUs of a large
+    section among threads, each with its own
+    Dwarf_Debug from dwarf_init_from_debug().
+    For each offset call
+    dwarf_get_cu_die_offset_given_cu_header_offset_b()
+    and then dwarf_offdie_b() to get the CU DIE.
+    Only that CU is read: a thread given the last
+    CUs does not read the headers of the earlier
+    ones.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_is_info
+    Pass in TRUE for .debug_info,
+    FALSE for DWARF4 .debug_types.
+    @param dw_offsets
+    On success returns an array of CU header
+    offsets in increasing order.
+    Free it with
+    dwarf_dealloc(dw_dbg,*dw_offsets,DW_DLA_UARRAY);
+    @param dw_offset_count
+    On success returns the number of entries in
+    *dw_offsets.
+    @param dw_error
+    In case return is DW_DLV_ERROR
+    dw_error is set to point to
+    the error details.
+    @return
+    Returns DW_DLV_OK etc.
+    Returns DW_DLV_NO_ENTRY if the section is
+    absent or empty.
+*/
+DW_API int dwarf_get_cu_header_offsets(Dwarf_Debug dw_dbg,
+    Dwarf_Bool       dw_is_info,
+    Dwarf_Off      **dw_offsets,
+    Dwarf_Unsigned  *dw_offset_count,
+    Dwarf_Error     *dw_error);
+
 /*! @brief Return the next sibling DIE.
 
     @param dw_die
@@ -2111,6 +2333,10 @@ DW_API void dwarf_dealloc_die( Dwarf_Die dw_die);
     DW_DLV_OK means dw_returned_CU_die was set.
     DW_DLV_NO_ENTRY means  the signature could
     not be found.
+    Without a .debug_tu_index a "tu" request is
+    answered from the same type unit signature
+    index as dwarf_find_die_given_sig8() and the
+    type DIE is returned. Updated October 2026.
 */
 DW_API int dwarf_die_from_hash_signature(Dwarf_Debug dw_dbg,
     Dwarf_Sig8 *  dw_hash_sig,
@@ -2320,6 +2546,9 @@ DW_API int dwarf_CU_dieoffset_given_die(Dwarf_Die dw_die,
 
     Returns the CU DIE global offset if one knows the
     CU header global offset.
+    As of October 2026 this also reads the CU header
+    so a following dwarf_offdie_b() of the returned
+    offset does not read the headers of earlier CUs.
     @see dwarf_CU_dieoffset_given_die
 
     @param dw_dbg
@@ -2854,6 +3083,45 @@ DW_API int dwarf_attrlist(Dwarf_Die dw_die,
     Dwarf_Signed * dw_attrcount,
     Dwarf_Error*   dw_error);
 
+/*! @brief Decodes all attributes of a DIE at once
+
+    Fills a caller-provided array with one
+    Dwarf_Attr_Value per attribute, in abbreviation
+    order, without allocating anything.
+    Meant for tools that visit every attribute
+    of every DIE, where dwarf_attrlist() and
+    per-attribute dwarf_formudata() etc.
+    spend most of their time on allocation.
+    New October 2026.
+
+    @param dw_die
+    The DIE from which to pull attributes.
+    @param dw_values
+    The array to fill in. May be NULL if
+    dw_values_count is zero.
+    @param dw_values_count
+    The number of entries in dw_values.
+    @param dw_attrcount
+    On success returns the number of attributes
+    the DIE has. If this exceeds dw_values_count
+    only the first dw_values_count entries were
+    filled in: call again with a larger array.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK, or DW_DLV_NO_ENTRY
+    if the DIE has no attributes.
+    Pointers in the array remain valid until
+    the Dwarf_Debug is closed.
+
+    @see Dwarf_Attr_Value
+*/
+DW_API int dwarf_die_attr_values(Dwarf_Die dw_die,
+    Dwarf_Attr_Value *dw_values,
+    Dwarf_Unsigned    dw_values_count,
+    Dwarf_Unsigned   *dw_attrcount,
+    Dwarf_Error      *dw_error);
+
 /*! @brief Sets TRUE if a Dwarf_Attribute has the indicated FORM
     @param dw_attr
     The Dwarf_Attribute of interest.
@@ -3615,6 +3883,96 @@ DW_API int dwarf_srclines_two_level_from_linecontext(
 */
 DW_API void dwarf_srclines_dealloc_b(Dwarf_Line_Context dw_context);
 
+/*! @defgroup lineindexflags Line Index Row Flags
+    Bits in the dw_flags value returned by
+    dwarf_srclines_lookup_pc().
+    New October 2026.
+    @{
+*/
+#define DW_LINE_ROW_IS_STMT         0x01
+#define DW_LINE_ROW_BASIC_BLOCK     0x02
+#define DW_LINE_ROW_END_SEQUENCE    0x04
+#define DW_LINE_ROW_PROLOGUE_END    0x08
+#define DW_LINE_ROW_EPILOGUE_BEGIN  0x10
+/*! @} */
+
+/*! @brief Find the line table row for a pc
+
+    New October 2026.
+    The first call for a CU runs the CU line table
+    program once and keeps the rows (address, file
+    number, line, column, and flags) in compact
+    arrays sorted by address, without creating
+    any Dwarf_Line. Each call is then a binary search.
+    The index is freed by dwarf_finish(), there is
+    nothing for the caller to dealloc.
+
+    The row returned is the last row whose address
+    is at or below dw_pc in the sequence containing
+    dw_pc, which is the row describing dw_pc.
+    For two-level line tables only the logicals
+    table is indexed.
+    Any of the return pointers may be NULL.
+
+    @param dw_cudie
+    The CU DIE (its DW_AT_stmt_list names the line table).
+    @param dw_pc
+    The address of interest.
+    @param dw_row_address
+    On success returns the address of the row found.
+    @param dw_fileno
+    On success returns the file register of the row.
+    Pass it to dwarf_srclines_lookup_filename()
+    for the file name.
+    @param dw_line
+    On success returns the line number.
+    @param dw_column
+    On success returns the column number.
+    @param dw_flags
+    On success returns DW_LINE_ROW_IS_STMT and
+    the other DW_LINE_ROW flags that apply.
+    @param dw_error
+    The usual error pointer.
+    @return
+    Returns DW_DLV_NO_ENTRY if the CU has no line table
+    or no sequence contains dw_pc.
+*/
+DW_API int dwarf_srclines_lookup_pc(Dwarf_Die dw_cudie,
+    Dwarf_Addr       dw_pc,
+    Dwarf_Addr     * dw_row_address,
+    Dwarf_Unsigned * dw_fileno,
+    Dwarf_Unsigned * dw_line,
+    Dwarf_Unsigned * dw_column,
+    Dwarf_Unsigned * dw_flags,
+    Dwarf_Error    * dw_error);
+
+/*! @brief Return a file name for a line index file number
+
+    New October 2026.
+    Uses the line table header kept with the index
+    built by dwarf_srclines_lookup_pc(), so the full
+    path is the same as dwarf_linesrc() would return
+    for a Dwarf_Line with that file number.
+
+    @param dw_cudie
+    The CU DIE passed to dwarf_srclines_lookup_pc().
+    @param dw_fileno
+    A file number returned by dwarf_srclines_lookup_pc().
+    @param dw_filename
+    On success returns the file name.
+    Dealloc with dwarf_dealloc(dbg,name,DW_DLA_STRING)
+    when no longer needed.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK etc. DW_DLV_NO_ENTRY for file number zero
+    in a DWARF2,3,4 line table.
+*/
+DW_API int dwarf_srclines_lookup_filename(Dwarf_Die dw_cudie,
+    Dwarf_Unsigned dw_fileno,
+    char        ** dw_filename,
+    Dwarf_Error  * dw_error);
+
 /*! @brief Return the srclines table offset
 
     The offset is in the relevant .debug_line or .debug_line.dwo
@@ -4017,6 +4375,64 @@ DW_API int dwarf_linesrc(Dwarf_Line dw_line,
     char      ** dw_returned_name,
     Dwarf_Error* dw_error);
 
+/*! @brief Return the file path of the Dwarf_Line without a copy
+
+    New October 2026.
+    Returns the same full path as dwarf_linesrc(), but
+    the path is built once per file entry and kept
+    with the Dwarf_Line_Context, so no string is
+    allocated per call.
+
+    @link dwsec_linetabreg Line Table Registers @endlink
+
+    @param dw_line
+    The Dwarf_Line of interest.
+    @param dw_returned_path
+    On success returns a pointer to the full path
+    of the file named by the file register.
+    The string is valid until the Dwarf_Line_Context
+    is deallocated (dwarf_srclines_dealloc_b()).
+    Do not dealloc or free the string.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK if it succeeds.
+    DW_DLV_NO_ENTRY if the file register is zero
+    in a DWARF2,3,4 line table.
+*/
+DW_API int dwarf_line_srcpath(Dwarf_Line dw_line,
+    const char ** dw_returned_path,
+    Dwarf_Error * dw_error);
+
+/*! @brief Return the full path of a line table file number
+
+    New October 2026.
+    Like dwarf_line_srcpath() but for a file number
+    such as a DW_AT_decl_file value or the file
+    register of a row.
+
+    @param dw_context
+    The Dwarf_Line_Context of interest.
+    @param dw_fileno
+    The file number, with the same meaning as in
+    the file register of this line table.
+    @param dw_returned_path
+    On success returns a pointer to the full path.
+    The string is valid until the Dwarf_Line_Context
+    is deallocated.
+    Do not dealloc or free the string.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK if it succeeds.
+    DW_DLV_NO_ENTRY if dw_fileno is zero
+    in a DWARF2,3,4 line table.
+*/
+DW_API int dwarf_srclines_file_path(Dwarf_Line_Context dw_context,
+    Dwarf_Unsigned dw_fileno,
+    const char  ** dw_returned_path,
+    Dwarf_Error  * dw_error);
+
 /*! @brief Return the basic_block line register.
 
     @link dwsec_linetabreg Line Table Registers @endlink
@@ -5868,6 +6284,125 @@ DW_API int dwarf_get_fde_at_pc(Dwarf_Fde* dw_fde_data,
     Dwarf_Addr * dw_hipc,
     Dwarf_Error* dw_error);
 
+/*! @brief Retrieve an .eh_frame FDE given a pc, using .eh_frame_hdr
+
+    New October 2026.
+    Uses the sorted table in the .eh_frame_hdr section
+    (written by GNU ld, gold, lld and others) to find
+    the FDE for dw_pc_of_interest, then reads just that
+    FDE and its CIE from .eh_frame. Unlike
+    dwarf_get_fde_list_eh() with dwarf_get_fde_at_pc()
+    the rest of .eh_frame is never read.
+
+    The FDE returned owns its CIE.
+    When done with it call
+    dwarf_dealloc(dw_dbg,fde,DW_DLA_FDE), which
+    frees the CIE too. Do not pass it to
+    dwarf_dealloc_fde_cie_list().
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_pc_of_interest
+    The pc value of interest.
+    @param dw_returned_fde
+    On success the FDE containing dw_pc_of_interest
+    is set through the pointer.
+    @param dw_lopc
+    On success the low pc of the FDE is set through
+    the pointer.
+    @param dw_hipc
+    On success the high pc (the last byte address,
+    as for dwarf_get_fde_at_pc()) is set through
+    the pointer.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_NO_ENTRY if there is no .eh_frame_hdr,
+    if its table is in a form this does not read,
+    or if no FDE contains dw_pc_of_interest.
+    In the first two cases dwarf_get_fde_list_eh()
+    and dwarf_get_fde_at_pc() may still find the FDE.
+*/
+DW_API int dwarf_get_fde_at_pc_eh_hdr(Dwarf_Debug dw_dbg,
+    Dwarf_Addr       dw_pc_of_interest,
+    Dwarf_Fde      * dw_returned_fde,
+    Dwarf_Addr     * dw_lopc,
+    Dwarf_Addr     * dw_hipc,
+    Dwarf_Error    * dw_error);
+
+/*! @brief Step to the next CIE or FDE in a frame section
+
+    New October 2026.
+    Reads just the length and CIE id of the entry
+    at dw_offset in .eh_frame (dw_is_eh_frame non-zero)
+    or .debug_frame (dw_is_eh_frame zero) and
+    nothing is allocated, so a whole section can
+    be walked cheaply. Start with dw_offset zero and
+    pass back dw_next_offset to continue.
+    Use dwarf_get_fde_at_offset() to create
+    just the FDEs of interest.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_is_eh_frame
+    Pass non-zero for .eh_frame, zero for .debug_frame.
+    @param dw_offset
+    The section offset of a CIE or FDE.
+    @param dw_is_cie
+    On success set to TRUE if the entry is a CIE,
+    FALSE if it is an FDE.
+    @param dw_cie_offset
+    On success set to the section offset of the
+    entry's CIE (for a CIE, to dw_offset).
+    @param dw_next_offset
+    On success set to the section offset just past
+    this entry.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_NO_ENTRY if the section is absent,
+    if dw_offset is at or past the end of the section
+    or if the entry is a zero length terminator.
+*/
+DW_API int dwarf_next_frame_entry(Dwarf_Debug dw_dbg,
+    Dwarf_Bool       dw_is_eh_frame,
+    Dwarf_Unsigned   dw_offset,
+    Dwarf_Bool     * dw_is_cie,
+    Dwarf_Unsigned * dw_cie_offset,
+    Dwarf_Unsigned * dw_next_offset,
+    Dwarf_Error    * dw_error);
+
+/*! @brief Retrieve the FDE at a frame section offset
+
+    New October 2026.
+    Creates the FDE at dw_fde_offset
+    and its CIE, reading nothing else in the section.
+    As with dwarf_get_fde_at_pc_eh_hdr() the FDE
+    owns its CIE:
+    call dwarf_dealloc(dw_dbg,fde,DW_DLA_FDE)
+    when done with it and do not pass it to
+    dwarf_dealloc_fde_cie_list().
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_is_eh_frame
+    Pass non-zero for .eh_frame, zero for .debug_frame.
+    @param dw_fde_offset
+    The section offset of the FDE.
+    @param dw_returned_fde
+    On success the FDE is set through the pointer.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_NO_ENTRY if the section is absent
+    or if dw_fde_offset is not the start of an FDE.
+*/
+DW_API int dwarf_get_fde_at_offset(Dwarf_Debug dw_dbg,
+    Dwarf_Bool       dw_is_eh_frame,
+    Dwarf_Unsigned   dw_fde_offset,
+    Dwarf_Fde      * dw_returned_fde,
+    Dwarf_Error    * dw_error);
+
 /*! @brief Return .eh_frame CIE augmentation data.
 
     GNU .eh_frame CIE augmentation information.
@@ -6195,6 +6730,37 @@ DW_API Dwarf_Half dwarf_set_frame_same_value(
 DW_API Dwarf_Half dwarf_set_frame_undefined_value(
     Dwarf_Debug dw_dbg,
     Dwarf_Half  dw_value);
+
+/*! @brief Keep the rows of each FDE after first use
+
+    New October 2026.
+    Off by default. When on, the first call
+    asking for a register rule of an FDE
+    (dwarf_get_fde_info_for_all_regs3_b(),
+    dwarf_get_fde_info_for_reg3_c(),
+    dwarf_get_fde_info_for_cfa_reg3_c() and the
+    older forms of these) runs the CIE and FDE
+    instructions once and keeps every row of the
+    FDE. Later calls for any pc in the FDE find the
+    row by binary search instead of running the
+    instructions again. The rows are freed with the
+    FDE.
+
+    Results are the same with the cache on or off.
+    Changing any of the frame register settings above
+    causes the rows to be rebuilt on the next call.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_value
+    Pass in non-zero to turn the cache on, zero
+    to turn it off.
+    @return
+    Returns the previous value.
+*/
+DW_API Dwarf_Small dwarf_set_frame_row_cache(
+    Dwarf_Debug dw_dbg,
+    Dwarf_Small dw_value);
 /*! @} */
 
 /*! @defgroup abbrev Abbreviations Section Details
@@ -6953,6 +7519,45 @@ DW_API int dwarf_dnames_name(Dwarf_Dnames_Head dw_dn,
     Dwarf_Unsigned    * dw_idxattr_count,
     Dwarf_Error *       dw_error);
 
+/*! @brief Find a name in a name table
+
+    Uses the hash table of the name table so only
+    names whose hash matches have their strings
+    compared.  The comparison is exact (case
+    sensitive) though the hash is case folded.
+    New October 2026.
+
+    @param dw_dn
+    The table of interest.
+    @param dw_name
+    The name to look for.
+    @param dw_name_index
+    On success returns the index of the name
+    table entry (as used by dwarf_dnames_name()).
+    May be passed as NULL.
+    @param dw_offset_in_entrypool
+    On success returns the offset in the entrypool
+    of the first entry for the name, to be
+    passed to dwarf_dnames_entrypool().
+    The entries for the name follow one another
+    (use the dw_offset_of_next_entrypool
+    from dwarf_dnames_entrypool_values())
+    until an entry with abbrev code zero.
+    May be passed as NULL.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    The usual value: DW_DLV_OK etc.
+    Returns DW_DLV_NO_ENTRY if the name is not in
+    this table. A .debug_names section may hold
+    several tables (see dwarf_dnames_header()).
+*/
+DW_API int dwarf_dnames_lookup(Dwarf_Dnames_Head dw_dn,
+    const char        * dw_name,
+    Dwarf_Unsigned    * dw_name_index,
+    Dwarf_Unsigned    * dw_offset_in_entrypool,
+    Dwarf_Error *       dw_error);
+
 /*! @brief Return a the set of values from an entrypool entry
 
     Returns the basic data about an entrypool record
@@ -7195,6 +7800,130 @@ DW_API int dwarf_get_arange_info_b(Dwarf_Arange dw_arange,
     Dwarf_Unsigned*  dw_length,
     Dwarf_Off     *  dw_cu_die_offset,
     Dwarf_Error   *  dw_error );
+
+/*! @brief Build the code address index of a Dwarf_Debug
+
+    New October 2026.
+    Reads every CU once and records the
+    code address ranges of each CU (from
+    .debug_aranges when present, otherwise from
+    the CU DIE DW_AT_low_pc/DW_AT_high_pc
+    or DW_AT_ranges) and of each
+    DW_TAG_subprogram DIE.
+    The index belongs to dw_dbg and is freed by
+    dwarf_finish().
+    Calling this is optional,
+    dwarf_addr_index_lookup() builds the index
+    when needed.
+    A DIE whose address attributes cannot be
+    read is left out of the index rather than
+    failing the build.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    DW_DLV_OK if the index exists (possibly empty),
+    DW_DLV_ERROR if it could not be built.
+*/
+DW_API int dwarf_addr_index_build(Dwarf_Debug dw_dbg,
+    Dwarf_Error *dw_error);
+
+/*! @brief Find the CU and function containing a code address
+
+    New October 2026.
+    A binary search in the index built by
+    dwarf_addr_index_build() (which is called
+    here if necessary) or loaded by
+    dwarf_addr_index_from_bytes().
+    Where subprograms nest the innermost one
+    containing dw_pc is returned.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_pc
+    The code address of interest.
+    @param dw_cu_die_offset
+    On success returns the .debug_info offset of
+    the CU DIE. Pass NULL if not of interest.
+    @param dw_subprogram_die_offset
+    On success returns the .debug_info offset of
+    the DW_TAG_subprogram DIE containing dw_pc,
+    or zero if dw_pc is in the CU but in no
+    subprogram. Pass NULL if not of interest.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if no CU
+    contains dw_pc.
+*/
+DW_API int dwarf_addr_index_lookup(Dwarf_Debug dw_dbg,
+    Dwarf_Addr   dw_pc,
+    Dwarf_Off   *dw_cu_die_offset,
+    Dwarf_Off   *dw_subprogram_die_offset,
+    Dwarf_Error *dw_error);
+
+/*! @brief Save the code address index as bytes
+
+    New October 2026.
+    Builds the index if necessary and returns
+    it in a portable byte form suitable for
+    writing to a file beside the object.
+    The bytes record the build-id of the object
+    (or, lacking that, a crc of .debug_info
+    and .debug_abbrev) so that stale bytes
+    are recognized by dwarf_addr_index_from_bytes().
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_bytes_out
+    On success returns a pointer to the bytes.
+    Dealloc with dwarf_dealloc(dbg,bytes,DW_DLA_STRING)
+    when no longer of interest; dwarf_finish() frees
+    them otherwise.
+    @param dw_length_out
+    On success returns the number of bytes.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    DW_DLV_OK etc.
+*/
+DW_API int dwarf_addr_index_to_bytes(Dwarf_Debug dw_dbg,
+    Dwarf_Small   **dw_bytes_out,
+    Dwarf_Unsigned *dw_length_out,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Use a saved code address index
+
+    New October 2026.
+    Installs the index saved by
+    dwarf_addr_index_to_bytes() so that
+    dwarf_addr_index_lookup() need not walk
+    the DIEs. Any existing index of dw_dbg
+    is replaced. The bytes are copied, the caller
+    may free them on return.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_bytes
+    The saved bytes.
+    @param dw_length
+    The number of saved bytes.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    DW_DLV_OK if installed.
+    DW_DLV_NO_ENTRY if the bytes were saved from
+    a different object (or a different build of this one),
+    in which case build a new index.
+    DW_DLV_ERROR (DW_DLE_ADDR_INDEX_BAD) if the bytes
+    are not a saved index or are truncated.
+*/
+DW_API int dwarf_addr_index_from_bytes(Dwarf_Debug dw_dbg,
+    const Dwarf_Small *dw_bytes,
+    Dwarf_Unsigned     dw_length,
+    Dwarf_Error       *dw_error);
 /*! @} */
 
 /*! @defgroup pubnames Fast Access to .debug_pubnames and more.
@@ -7807,6 +8536,40 @@ DW_API int dwarf_gdbindex_addressarea_entry(
     Dwarf_Unsigned * dw_cu_index,
     Dwarf_Error    * dw_error);
 
+/*! @brief Find the address area entry for an address
+
+    The address area is searched for the entry
+    whose range (low address up to but not
+    including high address) holds dw_pc.
+    A binary search is used when the entries are
+    in ascending order, which is how gdb and gold
+    write them.
+    New October 2026.
+
+    @param dw_gdbindexptr
+    Pass in the Dwarf_Gdbindex pointer of interest.
+    @param dw_pc
+    The address of interest.
+    @param dw_entryindex
+    On success returns the index of the entry
+    (see dwarf_gdbindex_addressarea_entry()).
+    May be passed as NULL.
+    @param dw_cu_index
+    On success returns the CU index of the entry.
+    May be passed as NULL.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK etc.
+    Returns DW_DLV_NO_ENTRY if no entry holds dw_pc.
+*/
+DW_API int dwarf_gdbindex_addressarea_lookup(
+    Dwarf_Gdbindex   dw_gdbindexptr,
+    Dwarf_Unsigned   dw_pc,
+    Dwarf_Unsigned * dw_entryindex,
+    Dwarf_Unsigned * dw_cu_index,
+    Dwarf_Error    * dw_error);
+
 /*! @brief Get access to the symboltable array
 
     @param dw_gdbindexptr
@@ -7850,6 +8613,42 @@ DW_API int dwarf_gdbindex_symboltable_entry(
     Dwarf_Unsigned * dw_cu_vector_offset,
     Dwarf_Error    * dw_error);
 
+/*! @brief Find a symbol by name
+
+    Uses the symbol table hash (gdb's
+    mapped_index_string_hash) and probes the
+    table the way gdb does, so only the slots
+    on the probe sequence for the name are read.
+    The string comparison is exact.
+    New October 2026.
+
+    @param dw_gdbindexptr
+    Pass in the Dwarf_Gdbindex pointer of interest.
+    @param dw_name
+    The symbol name to look for.
+    @param dw_entryindex
+    On success returns the symbol table index
+    (see dwarf_gdbindex_symboltable_entry()).
+    May be passed as NULL.
+    @param dw_cu_vector_offset
+    On success returns the offset of the
+    CU vector of the symbol, for
+    dwarf_gdbindex_cuvector_length() and
+    dwarf_gdbindex_cuvector_inner_attributes().
+    May be passed as NULL.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK etc.
+    Returns DW_DLV_NO_ENTRY if the name is not present.
+*/
+DW_API int dwarf_gdbindex_symboltable_lookup(
+    Dwarf_Gdbindex   dw_gdbindexptr,
+    const char     * dw_name,
+    Dwarf_Unsigned * dw_entryindex,
+    Dwarf_Unsigned * dw_cu_vector_offset,
+    Dwarf_Error    * dw_error);
+
 /*! @brief Get access to a cuvector
 
     @see examplex
@@ -9334,6 +10133,50 @@ DW_API int dwarf_decode_signed_leb128(char *dw_leb,
     Dwarf_Unsigned *dw_leblen,
     Dwarf_Signed   *dw_outval,
     char           *dw_endptr);
+
+/*! @brief Decodes a run of ULEB values
+
+    Decodes dw_count ULEB values stored one after
+    another, giving exactly the results of calling
+    dwarf_decode_leb128() dw_count times, but
+    decoding up to eight bytes at a time.
+    Useful for runs such as DW_LNCT format pairs.
+    New October 2026.
+
+    @param dw_leb
+    Points to the first ULEB.
+    @param dw_count
+    The number of values to decode.
+    @param dw_values
+    An array of at least dw_count entries
+    to receive the values.
+    @param dw_leblen
+    If non-null, on success returns the total
+    number of bytes decoded.
+    @param dw_endptr
+    One past the last byte the decoder may read.
+    @return
+    DW_DLV_OK or DW_DLV_ERROR (a value is
+    malformed or runs past dw_endptr).
+*/
+DW_API int dwarf_decode_leb128_bulk(char *dw_leb,
+    Dwarf_Unsigned  dw_count,
+    Dwarf_Unsigned *dw_values,
+    Dwarf_Unsigned *dw_leblen,
+    char           *dw_endptr);
+
+/*! @brief Decodes a run of SLEB values
+
+    As dwarf_decode_leb128_bulk() but for
+    signed values, matching
+    dwarf_decode_signed_leb128().
+    New October 2026.
+*/
+DW_API int dwarf_decode_signed_leb128_bulk(char *dw_leb,
+    Dwarf_Unsigned  dw_count,
+    Dwarf_Signed   *dw_values,
+    Dwarf_Unsigned *dw_leblen,
+    char           *dw_endptr);
 /*! @} */
 
 /*! @defgroup miscellaneous Miscellaneous Functions
@@ -9356,8 +10199,12 @@ DW_API const char * dwarf_package_version(void);
 
     Zero is  the default and means do all
     string length validity checks.
-    It applies to all Dwarf_Debug open and
-    all opened later in this library instance.
+    It applies to all Dwarf_Debug
+    opened later in this library instance
+    (the value is copied into each Dwarf_Debug
+    as it is opened).
+    Call it before other threads are using libdwarf.
+    @see dwarf_set_stringcheck_a
 
     @param dw_stringcheck
     Pass in a small non-zero value to turn off
@@ -9369,14 +10216,37 @@ DW_API const char * dwarf_package_version(void);
 */
 DW_API int dwarf_set_stringcheck(int dw_stringcheck);
 
+/*! @brief Turn off libdwarf checks of strings for one Dwarf_Debug
+
+    New October 2026.
+    Like dwarf_set_stringcheck() but applies only
+    to dw_dbg, so it is safe while other threads use
+    other Dwarf_Debug.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_stringcheck
+    Pass in a small non-zero value to turn off
+    string validity checks on this Dwarf_Debug.
+    @return
+    Returns the previous value of this flag
+    for dw_dbg (zero if dw_dbg is not valid).
+*/
+DW_API int dwarf_set_stringcheck_a(Dwarf_Debug dw_dbg,
+    int dw_stringcheck);
+
 /*! @brief Set libdwarf response to *.rela relocations
 
     dw_apply defaults to 1 and means apply all
     '.rela' relocations on reading in a dwarf object
     section of such relocations.
     Best to just ignore this function
-    It applies to all Dwarf_Debug open and
-    all opened later in this library instance.
+    It applies to all Dwarf_Debug
+    opened later in this library instance
+    (the value is copied into each Dwarf_Debug
+    as it is opened).
+    Call it before other threads are using libdwarf.
+    @see dwarf_set_reloc_application_a
 
     @param dw_apply
     Pass in a zero to turn off reading and applying of
@@ -9392,6 +10262,90 @@ DW_API int dwarf_set_stringcheck(int dw_stringcheck);
 */
 DW_API int dwarf_set_reloc_application(int dw_apply);
 
+/*! @brief Set libdwarf response to *.rela relocations
+    for one Dwarf_Debug
+
+    New October 2026.
+    Like dwarf_set_reloc_application() but applies only
+    to dw_dbg. Relocations are applied as
+    each section is loaded, so call this right after
+    the dwarf_init*() call.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_apply
+    Pass in zero to turn off applying relocations
+    to sections of dw_dbg loaded after this call.
+    @return
+    Returns the previous value of the apply flag
+    for dw_dbg (zero if dw_dbg is not valid).
+*/
+DW_API int dwarf_set_reloc_application_a(Dwarf_Debug dw_dbg,
+    int dw_apply);
+
+/*! @brief Decompress zstd sections with several threads
+
+    New October 2026.
+    A compressed section is decompressed when
+    it is first loaded. A zstd section written as several
+    zstd frames, each recording its decompressed size
+    (as linkers compressing in parallel, such as lld,
+    write them), is split among dw_count threads.
+    Any other compressed section is
+    decompressed in one call as before.
+    Call this right after the dwarf_init*() call.
+    Without pthreads the frames are decompressed
+    one after another.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_count
+    The number of threads to use (at most 64).
+    Zero or one, the default, means no extra threads.
+    @return
+    Returns the previous value
+    for dw_dbg (zero if dw_dbg is not valid).
+*/
+DW_API unsigned int dwarf_set_decompress_threads(
+    Dwarf_Debug dw_dbg,
+    unsigned int dw_count);
+
+/*! @brief Keep decompressed sections in a directory
+
+    New October 2026.
+    When set, each compressed section of an object
+    with a .note.gnu.build-id is looked for in
+    dw_path, in a file named by the build-id
+    in hex followed by the section name
+    (for example 5bef...9470.debug_info).
+    If it is there, is a regular file (not a
+    symbolic link) and its header matches the
+    decompressed length and a crc32 of its contents,
+    it is read instead of decompressing.
+    Otherwise the section is decompressed and the
+    file written: to a new file with a unique name
+    (mkstemp(), so readable only by its owner), then
+    renamed, so processes sharing the directory
+    never see or disturb each other's partial files.
+    Errors writing the file are ignored.
+    Objects without a build-id are not cached.
+    The directory must already exist.
+    Call this right after the dwarf_init*() call.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_path
+    The directory to use. Pass NULL or an empty
+    string to stop using a cache.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK or DW_DLV_ERROR.
+*/
+DW_API int dwarf_set_decompress_cache_dir(Dwarf_Debug dw_dbg,
+    const char  *dw_path,
+    Dwarf_Error *dw_error);
+
 /*! @brief Get a pointer to the applicable swap/noswap function
 
     the function pointer returned enables libdwarf users
@@ -9440,8 +10394,11 @@ DW_API void dwarf_record_cmdline_options(
     Dwarf_Cmdline_Options dw_dd_options);
 
 /*!  @brief Eliminate libdwarf tracking of allocations
-    Independent of any Dwarf_Debug and applicable
-    to all whenever the setting is changed.
+    Independent of any Dwarf_Debug.
+    The setting is copied into each Dwarf_Debug
+    as it is opened and applies to that Dwarf_Debug
+    for its lifetime.
+    Call it before other threads are using libdwarf.
     Defaults to non-zero.
 
     @param dw_v
@@ -9459,6 +10416,49 @@ DW_API void dwarf_record_cmdline_options(
 */
 DW_API int dwarf_set_de_alloc_flag(int dw_v);
 
+/*! @brief Bump-allocate DIEs and attributes until released
+
+    New October 2026.
+    After this call, and until dwarf_die_arena_release(),
+    every Dwarf_Die, every Dwarf_Attribute
+    and every dwarf_attrlist() list created on dw_dbg
+    is carved from large blocks instead of being
+    allocated and tracked one at a time.
+    dwarf_dealloc_die(), dwarf_dealloc_attribute()
+    and dwarf_dealloc() of such records do nothing
+    (calling them is harmless), the records are all
+    freed at once by dwarf_die_arena_release().
+    Typical use is around the walk of one CU's tree.
+
+    Nothing allocated while the arena is on may be
+    used or dealloc'd after dwarf_die_arena_release().
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK, or DW_DLV_NO_ENTRY if an
+    arena is already in use on dw_dbg (arenas
+    do not nest).
+*/
+DW_API int dwarf_die_arena_begin(Dwarf_Debug dw_dbg,
+    Dwarf_Error *dw_error);
+
+/*! @brief Free everything in the DIE arena at once
+
+    New October 2026.
+    Frees all the records created since
+    dwarf_die_arena_begin() and returns dw_dbg
+    to normal allocation. One block may be kept
+    for the next arena; dwarf_finish() frees it.
+    Does nothing if no arena is in use.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+*/
+DW_API void dwarf_die_arena_release(Dwarf_Debug dw_dbg);
+
 /*! @brief Set the address size on a Dwarf_Debug
 
     DWARF information CUs and other
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# Creates debugnamesDW5.testme for test_dnameslookup.c.
+# gcc does not emit .debug_names, so this adds a
+# hand-built one indexing the top level DIEs of the
+# single CU whose DW_AT_name is in .debug_str.
+#   cc -g -gdwarf-5 typeunitsource.c -o dn.base
+#   python3 debugnamesbuild.py dn.base debugnamesDW5.testme
+# Needs readelf and objcopy.  Not run as part of testing.
+
+import os
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+
+# Few buckets so most buckets hold several names.
+BUCKETCOUNT = 3
+TAGS = {"DW_TAG_base_type": 0x24, "DW_TAG_structure_type": 0x13,
+    "DW_TAG_union_type": 0x17, "DW_TAG_variable": 0x34,
+    "DW_TAG_subprogram": 0x2e, "DW_TAG_typedef": 0x16}
+DIEPAT = re.compile(r"^ <1><([0-9a-f]+)>: Abbrev Number: \d+ \((\w+)\)")
+NAMEPAT = re.compile(r"DW_AT_name +: \(indirect string, "
+    r"offset: (0x[0-9a-f]+|0)\): (.*)$")
+
+
+def djbhash(s):
+    # DWARF5 6.1.1.4.5, ASCII case folding.
+    h = 5381
+    for c in s.lower().encode("utf-8"):
+        h = (h * 33 + c) & 0xffffffff
+    return h
+
+
+def uleb(v):
+    out = bytearray()
+    while True:
+        b = v & 0x7f
+        v >>= 7
+        if v:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def read_dies(path):
+    # (name, strp, tag, cu-relative offset) of top level DIEs
+    text = subprocess.check_output(["readelf",
+        "--debug-dump=info", path]).decode("utf-8")
+    dies = []
+    cur = None
+    for line in text.splitlines():
+        m = DIEPAT.match(line)
+        if m:
+            cur = None
+            if m.group(2) in TAGS:
+                cur = (int(m.group(1), 16), TAGS[m.group(2)])
+            continue
+        if line.startswith(" <"):
+            cur = None
+            continue
+        m = NAMEPAT.search(line)
+        if m and cur:
+            dies.append((m.group(2), int(m.group(1), 16),
+                cur[1], cur[0]))
+            cur = None
+    return dies
+
+
+def build(dies):
+    tags = sorted(set(d[2] for d in dies))
+    abbrevs = bytearray()
+    for i, t in enumerate(tags):
+        # DW_IDX_die_offset DW_FORM_ref4
+        abbrevs += uleb(i + 1) + uleb(t) + uleb(3) + uleb(0x13)
+        abbrevs += b"\0\0"
+    abbrevs += b"\0"
+    byname = {}
+    for d in dies:
+        byname.setdefault(d[0], []).append(d)
+    names = sorted(byname,
+        key=lambda n: (djbhash(n) % BUCKETCOUNT, djbhash(n)))
+    pool = bytearray()
+    entryoffs = []
+    for n in names:
+        entryoffs.append(len(pool))
+        for d in byname[n]:
+            pool += uleb(tags.index(d[2]) + 1)
+            pool += struct.pack("<I", d[3])
+        pool += b"\0"
+    buckets = [0] * BUCKETCOUNT
+    for i, n in enumerate(names):
+        b = djbhash(n) % BUCKETCOUNT
+        if not buckets[b]:
+            buckets[b] = i + 1
+    body = struct.pack("<HHIIIIIII", 5, 0, 1, 0, 0,
+        BUCKETCOUNT, len(names), len(abbrevs), 0)
+    body += struct.pack("<I", 0)
+    body += b"".join(struct.pack("<I", b) for b in buckets)
+    body += b"".join(struct.pack("<I", djbhash(n)) for n in names)
+    body += b"".join(struct.pack("<I", byname[n][0][1])
+        for n in names)
+    body += b"".join(struct.pack("<I", o) for o in entryoffs)
+    body += bytes(abbrevs) + bytes(pool)
+    return struct.pack("<I", len(body)) + body
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("Usage: debugnamesbuild.py <in> <out>")
+    src, dst = sys.argv[1], sys.argv[2]
+    with tempfile.TemporaryDirectory() as d:
+        namespath = os.path.join(d, "names")
+        with open(namespath, "wb") as f:
+            f.write(build(read_dies(src)))
+        subprocess.check_call(["objcopy", "--add-section",
+            ".debug_names=" + namespath, src, dst])
+
+
+if __name__ == "__main__":
+    main()
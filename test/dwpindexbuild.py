@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+# Creates dwpindexDW4.dwp for test_dwpindex.c.
+# A DWARF4 split-dwarf .dwp of many small CUs, each
+# with a few type units, so .debug_cu_index and
+# .debug_tu_index have enough entries for collisions
+# in their hash tables.
+#   python3 dwpindexbuild.py dwpindexDW4.dwp
+# Needs gcc and dwp (binutils).
+# Not run as part of testing.
+
+import os
+import subprocess
+import sys
+import tempfile
+
+CUS = 48
+TYPES = 2
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: dwpindexbuild.py out")
+    out = os.path.abspath(sys.argv[1])
+    with tempfile.TemporaryDirectory() as d:
+        objs = []
+        for i in range(CUS):
+            src = os.path.join(d, "cu%d.c" % i)
+            with open(src, "w") as f:
+                for t in range(TYPES):
+                    f.write("struct s%d_%d { int a%d; long b; };\n" %
+                        (i, t, t))
+                f.write("int f%d(void) {\n" % i)
+                for t in range(TYPES):
+                    f.write("  struct s%d_%d v%d = {%d, %d};\n" %
+                        (i, t, t, i, t))
+                f.write("  return v0.a0")
+                for t in range(1, TYPES):
+                    f.write(" + (int)v%d.b" % t)
+                f.write(";\n}\n")
+            obj = os.path.join(d, "cu%d.o" % i)
+            subprocess.check_call(["gcc", "-g", "-gdwarf-4",
+                "-gsplit-dwarf", "-fdebug-types-section",
+                "-c", src, "-o", obj], cwd=d)
+            objs.append(obj)
+        dwos = [o[:-2] + ".dwo" for o in objs]
+        subprocess.check_call(["dwp", "-o", out] + dwos, cwd=d)
+
+
+main()
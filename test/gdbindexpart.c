@@ -0,0 +1,21 @@
+/*  With typeunitsource.c this is the source of
+    gdbindexLE64.testme, two CUs and a .gdb_index
+    (version 7) written by gold, for test_gdbindexlookup.c.
+    cc -g -gdwarf-4 -ggnu-pubnames -fuse-ld=gold \
+        -Wl,--gdb-index typeunitsource.c gdbindexpart.c \
+        -o gdbindexLE64.testme
+*/
+int gi_counter;
+
+static int
+gi_twice(int v)
+{
+    return 2*v;
+}
+
+int
+gi_add(int a, int b)
+{
+    gi_counter += gi_twice(a);
+    return a + b;
+}
@@ -0,0 +1,36 @@
+/*  Source of manydiesDW5.testme, three CUs of over
+    a thousand DIEs each, so that a --jobs worker
+    uses up the checks dwarfdump does only the first
+    so many times (see test_dwarfdumpjobs.sh):
+    for p in 1 2 3; do
+        cc -g -gdwarf-5 -c -DPART=$p manydiessource.c \
+            -o manydies$p.o
+    done
+    cc manydies1.o manydies2.o manydies3.o \
+        -o manydiesDW5.testme
+*/
+#define M1(p)    int p;
+#define M4(p)    M1(p##a) M1(p##b) M1(p##c) M1(p##d)
+#define M16(p)   M4(p##a) M4(p##b) M4(p##c) M4(p##d)
+#define M64(p)   M16(p##a) M16(p##b) M16(p##c) M16(p##d)
+#define M256(p)  M64(p##a) M64(p##b) M64(p##c) M64(p##d)
+#define M1024(p) M256(p##a) M256(p##b) M256(p##c) M256(p##d)
+
+#define CAT2(a,b) a##b
+#define CAT(a,b) CAT2(a,b)
+
+struct CAT(many,PART) {
+    M1024(m)
+    /*  A DW_FORM_data4 DW_AT_decl_line, for -kE. */
+#line 70000
+    char pad[70000];
+};
+struct CAT(many,PART) CAT(manyvar,PART);
+
+#if PART == 1
+int
+main(void)
+{
+    return manyvar1.maaaaa;
+}
+#endif
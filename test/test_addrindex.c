@@ -0,0 +1,577 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Usage:  ./test_addrindex -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    For every DW_TAG_subprogram with DW_AT_low_pc
+    and DW_AT_high_pc in the test objects,
+    dwarf_addr_index_lookup() must find that
+    subprogram and its CU at the first and last
+    address of the function.
+    The index saved with dwarf_addr_index_to_bytes()
+    must give the same answers when loaded into
+    a fresh Dwarf_Debug, and must be refused
+    by a different object.
+    Saved bytes with made-up entries (nested,
+    crossing, empty, duplicated and covering
+    everything) must give, for every address near
+    an entry end, what a linear search gives. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() free() getenv() malloc() */
+#include <string.h> /* memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+#define AXNUMSIZE 8
+#define AXHEADERNUMS 3
+#define AXENTRYNUMS 4
+#define CRAFTED_CUS 40
+#define CRAFTED_SUBPROGRAMS 3000
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobjects[] = {
+"/test/testuriLE64ELf.testme",
+"/test/testobjLE32PE.exe",
+"/test/test-mach-o-32.dSYM",
+"/test/dummyexecutable.debug",
+0};
+#define OBJECT_COUNT 4
+
+static char objpaths[OBJECT_COUNT][PATHLEN];
+
+static int failcount;
+static unsigned long seed = 1;
+
+struct crafted_s {
+    Dwarf_Addr cr_low;
+    Dwarf_Addr cr_high;
+    Dwarf_Off  cr_cu_die_offset;
+    Dwarf_Off  cr_die_offset;
+};
+
+static struct crafted_s crafted_cus[CRAFTED_CUS];
+static struct crafted_s crafted_subs[CRAFTED_SUBPROGRAMS];
+
+/*  Counts the functions checked, to be sure
+    the test checks something. */
+static int
+check_subprogram(Dwarf_Debug dbg, Dwarf_Die die,
+    Dwarf_Off cu_die_offset, const char *path)
+{
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    Dwarf_Half form = 0;
+    enum Dwarf_Form_Class formclass = DW_FORM_CLASS_UNKNOWN;
+    Dwarf_Off die_offset = 0;
+    Dwarf_Addr pcs[2];
+    int i = 0;
+
+    if (dwarf_lowpc(die,&low,0) != DW_DLV_OK ||
+        dwarf_highpc_b(die,&high,&form,&formclass,0) !=
+        DW_DLV_OK) {
+        return 0;
+    }
+    if (formclass == DW_FORM_CLASS_CONSTANT) {
+        high += low;
+    }
+    if (high <= low) {
+        return 0;
+    }
+    dwarf_dieoffset(die,&die_offset,0);
+    pcs[0] = low;
+    pcs[1] = high - 1;
+    for (i = 0; i < 2; ++i) {
+        Dwarf_Off cuoff = 0;
+        Dwarf_Off suboff = 0;
+        int res = 0;
+
+        res = dwarf_addr_index_lookup(dbg,pcs[i],&cuoff,
+            &suboff,0);
+        if (res != DW_DLV_OK || cuoff != cu_die_offset ||
+            suboff != die_offset) {
+            printf("FAIL %s pc 0x%llx expected CU 0x%llx "
+                "subprogram 0x%llx got res %d 0x%llx 0x%llx\n",
+                path,(unsigned long long)pcs[i],
+                (unsigned long long)cu_die_offset,
+                (unsigned long long)die_offset,res,
+                (unsigned long long)cuoff,
+                (unsigned long long)suboff);
+            ++failcount;
+        }
+    }
+    return 1;
+}
+
+static int
+walk_dies(Dwarf_Debug dbg, Dwarf_Die die,
+    Dwarf_Off cu_die_offset, const char *path)
+{
+    Dwarf_Die cur = die;
+    int checked = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+        Dwarf_Half tag = 0;
+        int res = 0;
+
+        if (dwarf_tag(cur,&tag,0) == DW_DLV_OK &&
+            tag == DW_TAG_subprogram) {
+            checked += check_subprogram(dbg,cur,
+                cu_die_offset,path);
+        }
+        if (dwarf_child(cur,&child,0) == DW_DLV_OK) {
+            checked += walk_dies(dbg,child,cu_die_offset,path);
+            dwarf_dealloc_die(child);
+        }
+        res = dwarf_siblingof_c(cur,&sib,0);
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        if (res != DW_DLV_OK) {
+            return checked;
+        }
+        cur = sib;
+    }
+}
+
+static int
+check_all_subprograms(Dwarf_Debug dbg, const char *path)
+{
+    int checked = 0;
+
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Off cu_die_offset = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            0,0,0,0,0,0,0,0,0,0,0);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        dwarf_dieoffset(cu_die,&cu_die_offset,0);
+        checked += walk_dies(dbg,cu_die,cu_die_offset,path);
+        dwarf_dealloc_die(cu_die);
+    }
+    return checked;
+}
+
+static Dwarf_Debug
+open_object(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    return dbg;
+}
+
+static void
+check_object(int o)
+{
+    const char *path = objpaths[o];
+    const char *other = objpaths[(o+1)%OBJECT_COUNT];
+    Dwarf_Debug dbg = 0;
+    Dwarf_Small *saved = 0;
+    Dwarf_Small *bytes = 0;
+    Dwarf_Unsigned length = 0;
+    Dwarf_Error error = 0;
+    int checked = 0;
+    int res = 0;
+
+    dbg = open_object(path);
+    checked = check_all_subprograms(dbg,path);
+    if (!checked) {
+        printf("FAIL %s has no subprograms to check\n",path);
+        ++failcount;
+    }
+    res = dwarf_addr_index_lookup(dbg,~(Dwarf_Addr)0,0,0,0);
+    if (res != DW_DLV_NO_ENTRY) {
+        printf("FAIL %s highest pc found\n",path);
+        ++failcount;
+    }
+    res = dwarf_addr_index_to_bytes(dbg,&saved,&length,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s dwarf_addr_index_to_bytes\n",path);
+        ++failcount;
+        dwarf_finish(dbg);
+        return;
+    }
+    /*  As if written to a file and read back. */
+    bytes = (Dwarf_Small *)malloc((size_t)length);
+    if (!bytes) {
+        printf("FAIL %s out of memory\n",path);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(bytes,saved,(size_t)length);
+    dwarf_dealloc(dbg,saved,DW_DLA_STRING);
+    /*  Left for dwarf_finish() to free. */
+    saved = 0;
+    res = dwarf_addr_index_to_bytes(dbg,&saved,&length,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s second dwarf_addr_index_to_bytes\n",path);
+        ++failcount;
+    }
+    dwarf_finish(dbg);
+
+    /*  The saved index, used instead of building one,
+        must give the same results. */
+    dbg = open_object(path);
+    res = dwarf_addr_index_from_bytes(dbg,bytes,length,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s dwarf_addr_index_from_bytes\n",path);
+        ++failcount;
+    } else if (check_all_subprograms(dbg,path) != checked) {
+        printf("FAIL %s count differs with saved index\n",path);
+        ++failcount;
+    }
+    /*  A truncated copy is an error. */
+    res = dwarf_addr_index_from_bytes(dbg,bytes,length-1,&error);
+    if (res != DW_DLV_ERROR ||
+        dwarf_errno(error) != DW_DLE_ADDR_INDEX_BAD) {
+        printf("FAIL %s truncated index accepted\n",path);
+        ++failcount;
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,error);
+    }
+    dwarf_finish(dbg);
+
+    /*  Another object must refuse it. */
+    dbg = open_object(other);
+    res = dwarf_addr_index_from_bytes(dbg,bytes,length,0);
+    if (res != DW_DLV_NO_ENTRY) {
+        printf("FAIL %s index accepted by %s\n",path,other);
+        ++failcount;
+    }
+    dwarf_finish(dbg);
+    free(bytes);
+}
+
+static Dwarf_Addr
+nextrand(void)
+{
+    seed = seed * 1103515245UL + 12345UL;
+    return (Dwarf_Addr)((seed >> 8) & 0xffffff);
+}
+
+static void
+craft(struct crafted_s *c, int i, Dwarf_Off cuoff)
+{
+    Dwarf_Addr low = nextrand();
+
+    c->cr_cu_die_offset = cuoff;
+    c->cr_die_offset = (Dwarf_Off)(i+1)*16;
+    switch (i % 8) {
+    case 0:
+        /* Empty, or low past high. */
+        c->cr_low = low + (i%16)/8;
+        c->cr_high = low;
+        return;
+    case 1:
+        /* Long, overlapping many. */
+        c->cr_low = low;
+        c->cr_high = low + nextrand()*4;
+        return;
+    case 2:
+        /* The same range as the one before. */
+        if (i) {
+            c->cr_low = c[-1].cr_low;
+            c->cr_high = c[-1].cr_high;
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    c->cr_low = low;
+    c->cr_high = low + 1 + nextrand()%256;
+}
+
+/*  The smallest, of equal sizes the one with
+    the greater low then the greater DIE offset. */
+static struct crafted_s *
+linear_find(struct crafted_s *c, int count, Dwarf_Addr pc)
+{
+    struct crafted_s *best = 0;
+    int i = 0;
+
+    for (i = 0; i < count; ++i) {
+        Dwarf_Addr size = 0;
+        Dwarf_Addr bestsize = 0;
+
+        if (pc < c[i].cr_low || pc >= c[i].cr_high) {
+            continue;
+        }
+        size = c[i].cr_high - c[i].cr_low;
+        if (best) {
+            bestsize = best->cr_high - best->cr_low;
+        }
+        if (!best || size < bestsize ||
+            (size == bestsize &&
+            (c[i].cr_low > best->cr_low ||
+            (c[i].cr_low == best->cr_low &&
+            c[i].cr_die_offset > best->cr_die_offset)))) {
+            best = c+i;
+        }
+    }
+    return best;
+}
+
+static Dwarf_Small *
+put_num(Dwarf_Small *p, Dwarf_Unsigned v)
+{
+    int i = 0;
+
+    for (i = 0; i < AXNUMSIZE; ++i) {
+        p[i] = (Dwarf_Small)(v >> (8*i));
+    }
+    return p + AXNUMSIZE;
+}
+
+static Dwarf_Small *
+put_crafted(Dwarf_Small *p, struct crafted_s *c, int count)
+{
+    int i = 0;
+
+    for (i = 0; i < count; ++i) {
+        p = put_num(p,c[i].cr_low);
+        p = put_num(p,c[i].cr_high);
+        p = put_num(p,c[i].cr_cu_die_offset);
+        p = put_num(p,c[i].cr_die_offset);
+    }
+    return p;
+}
+
+static void
+check_crafted_pc(Dwarf_Debug dbg, Dwarf_Addr pc,
+    const char *path)
+{
+    struct crafted_s *c = 0;
+    Dwarf_Off wantcu = 0;
+    Dwarf_Off wantsub = 0;
+    Dwarf_Off cuoff = 0;
+    Dwarf_Off suboff = 0;
+    int want = DW_DLV_OK;
+    int res = 0;
+
+    c = linear_find(crafted_subs,CRAFTED_SUBPROGRAMS,pc);
+    if (c) {
+        wantcu = c->cr_cu_die_offset;
+        wantsub = c->cr_die_offset;
+    } else {
+        c = linear_find(crafted_cus,CRAFTED_CUS,pc);
+        if (c) {
+            wantcu = c->cr_cu_die_offset;
+        } else {
+            want = DW_DLV_NO_ENTRY;
+        }
+    }
+    res = dwarf_addr_index_lookup(dbg,pc,&cuoff,&suboff,0);
+    if (res != want || (res == DW_DLV_OK &&
+        (cuoff != wantcu || suboff != wantsub))) {
+        printf("FAIL %s crafted pc 0x%llx expected res %d "
+            "0x%llx 0x%llx got res %d 0x%llx 0x%llx\n",
+            path,(unsigned long long)pc,want,
+            (unsigned long long)wantcu,
+            (unsigned long long)wantsub,res,
+            (unsigned long long)cuoff,
+            (unsigned long long)suboff);
+        ++failcount;
+    }
+}
+
+static void
+check_crafted(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Small *saved = 0;
+    Dwarf_Small *bytes = 0;
+    Dwarf_Small *p = 0;
+    Dwarf_Unsigned length = 0;
+    Dwarf_Unsigned identlen = 0;
+    Dwarf_Unsigned headerlen = 0;
+    Dwarf_Unsigned newlength = 0;
+    int i = 0;
+    int res = 0;
+
+    dbg = open_object(path);
+    res = dwarf_addr_index_to_bytes(dbg,&saved,&length,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s dwarf_addr_index_to_bytes\n",path);
+        exit(EXIT_FAILURE);
+    }
+    /*  Keep the magic and the identity, replace
+        the entries. */
+    for (i = 0; i < AXNUMSIZE; ++i) {
+        identlen |= ((Dwarf_Unsigned)saved[2*AXNUMSIZE+i]) <<
+            (8*i);
+    }
+    headerlen = AXHEADERNUMS*AXNUMSIZE +
+        (identlen + AXNUMSIZE - 1)/AXNUMSIZE*AXNUMSIZE;
+    newlength = headerlen + 2*AXNUMSIZE +
+        (CRAFTED_CUS + CRAFTED_SUBPROGRAMS)*
+        AXENTRYNUMS*AXNUMSIZE;
+    bytes = (Dwarf_Small *)malloc((size_t)newlength);
+    if (!bytes) {
+        printf("FAIL %s out of memory\n",path);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(bytes,saved,(size_t)headerlen);
+    dwarf_finish(dbg);
+
+    for (i = 0; i < CRAFTED_CUS; ++i) {
+        craft(crafted_cus+i,i,0);
+        crafted_cus[i].cr_cu_die_offset = (Dwarf_Off)(i+1)*11;
+    }
+    /*  One CU and one subprogram cover everything. */
+    crafted_cus[1].cr_low = 0;
+    crafted_cus[1].cr_high = ~(Dwarf_Addr)0;
+    for (i = 0; i < CRAFTED_SUBPROGRAMS; ++i) {
+        craft(crafted_subs+i,i,(Dwarf_Off)(i%CRAFTED_CUS+1)*11);
+    }
+    crafted_subs[9].cr_low = 0;
+    crafted_subs[9].cr_high = ~(Dwarf_Addr)0;
+    p = put_num(bytes+headerlen,CRAFTED_CUS);
+    p = put_num(p,CRAFTED_SUBPROGRAMS);
+    p = put_crafted(p,crafted_cus,CRAFTED_CUS);
+    put_crafted(p,crafted_subs,CRAFTED_SUBPROGRAMS);
+
+    dbg = open_object(path);
+    res = dwarf_addr_index_from_bytes(dbg,bytes,newlength,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s crafted index refused\n",path);
+        ++failcount;
+    } else {
+        for (i = 0; i < CRAFTED_SUBPROGRAMS; ++i) {
+            struct crafted_s *c = crafted_subs+i;
+
+            check_crafted_pc(dbg,c->cr_low,path);
+            check_crafted_pc(dbg,c->cr_low-1,path);
+            check_crafted_pc(dbg,c->cr_high,path);
+            check_crafted_pc(dbg,c->cr_high-1,path);
+        }
+        for (i = 0; i < 1000; ++i) {
+            check_crafted_pc(dbg,nextrand(),path);
+        }
+        check_crafted_pc(dbg,0,path);
+        check_crafted_pc(dbg,~(Dwarf_Addr)0,path);
+        /*  Without the covering subprogram: found
+            by the covering CU or by nothing. */
+        crafted_subs[9].cr_high = 0;
+        crafted_cus[1].cr_high = 0;
+        p = put_crafted(bytes+headerlen+2*AXNUMSIZE,
+            crafted_cus,CRAFTED_CUS);
+        put_crafted(p,crafted_subs,CRAFTED_SUBPROGRAMS);
+        res = dwarf_addr_index_from_bytes(dbg,bytes,newlength,0);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s second crafted index refused\n",
+                path);
+            ++failcount;
+        }
+        for (i = 0; res == DW_DLV_OK && i < CRAFTED_CUS; ++i) {
+            struct crafted_s *c = crafted_cus+i;
+
+            check_crafted_pc(dbg,c->cr_low,path);
+            check_crafted_pc(dbg,c->cr_low-1,path);
+            check_crafted_pc(dbg,c->cr_high,path);
+            check_crafted_pc(dbg,c->cr_high-1,path);
+        }
+        for (i = 0; res == DW_DLV_OK && i < 1000; ++i) {
+            check_crafted_pc(dbg,nextrand(),path);
+        }
+    }
+    dwarf_finish(dbg);
+    free(bytes);
+}
+
+static void
+build_path(char *out,const char *base, const char *tail)
+{
+    size_t blen = strlen(base);
+    size_t tlen = strlen(tail);
+
+    if ((blen + tlen + 1) > PATHLEN) {
+        printf("FAIL path too long for test_addrindex: %s\n",
+            base);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(out,base,blen);
+    memcpy(out+blen,tail,tlen+1);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        build_path(objpaths[i],base,testobjects[i]);
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        check_object(i);
+    }
+    check_crafted(objpaths[0]);
+    if (failcount) {
+        printf("FAIL test_addrindex %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_addrindex\n");
+    return 0;
+}
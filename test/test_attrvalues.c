@@ -0,0 +1,414 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/*  Usage:  ./test_attrvalues -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    Visits every DIE in the test objects and checks
+    that dwarf_die_attr_values() decodes each attribute
+    the same way dwarf_attrlist() and the dwarf_form*()
+    functions do. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcmp() memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+#define MAXATTRS 64
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobjects[] = {
+"/test/testuriLE64ELf.testme",
+"/test/typeunitsDW4.testme",
+"/test/typeunitsDW5.testme",
+"/test/debugnamesDW5.testme",
+/*  Three copies of the typeunitsource.c CU, all with
+    abbrev offset 0, so they share one abbrev table. */
+"/test/abbrevshareDW4.testme",
+0
+};
+
+static int failcount;
+static long attrs_checked;
+static long dies_checked;
+
+static void
+fail_attr(const char *path, Dwarf_Die die,
+    Dwarf_Attr_Value *v, const char *msg)
+{
+    Dwarf_Off off = 0;
+
+    dwarf_dieoffset(die,&off,0);
+    printf("FAIL %s die 0x%llx attr 0x%x form 0x%x %s\n",
+        path,(unsigned long long)off,v->av_attr,v->av_form,msg);
+    ++failcount;
+}
+
+/*  Compares one bulk record with what the
+    per-attribute functions return. */
+static void
+check_attr(Dwarf_Debug dbg, const char *path, Dwarf_Die die,
+    Dwarf_Attribute attr, Dwarf_Attr_Value *v)
+{
+    Dwarf_Half attrnum = 0;
+    Dwarf_Half form = 0;
+    Dwarf_Half version = 0;
+    Dwarf_Half offset_size = 0;
+    Dwarf_Unsigned uval = 0;
+    Dwarf_Signed sval = 0;
+    Dwarf_Off offset = 0;
+    Dwarf_Bool is_info = TRUE;
+    char *str = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    ++attrs_checked;
+    if (dwarf_whatattr(attr,&attrnum,0) != DW_DLV_OK ||
+        dwarf_whatform(attr,&form,0) != DW_DLV_OK ||
+        attrnum != v->av_attr || form != v->av_form) {
+        fail_attr(path,die,v,"attr or form differs");
+        return;
+    }
+    if (dwarf_get_version_of_die(die,&version,&offset_size) !=
+        DW_DLV_OK || dwarf_get_form_class(version,attrnum,
+        offset_size,form) != v->av_class) {
+        fail_attr(path,die,v,"class differs");
+    }
+    switch (form) {
+    case DW_FORM_data1:
+    case DW_FORM_data2:
+    case DW_FORM_data4:
+    case DW_FORM_data8:
+    case DW_FORM_udata:
+    case DW_FORM_loclistx:
+    case DW_FORM_rnglistx:
+        if (dwarf_formudata(attr,&uval,0) != DW_DLV_OK ||
+            uval != v->av_value) {
+            fail_attr(path,die,v,"udata differs");
+        }
+        break;
+    case DW_FORM_sdata:
+    case DW_FORM_implicit_const:
+        if (dwarf_formsdata(attr,&sval,0) != DW_DLV_OK ||
+            (Dwarf_Unsigned)sval != v->av_value) {
+            fail_attr(path,die,v,"sdata differs");
+        }
+        break;
+    case DW_FORM_flag:
+    case DW_FORM_flag_present: {
+        Dwarf_Bool flag = 0;
+
+        if (dwarf_formflag(attr,&flag,0) != DW_DLV_OK ||
+            (Dwarf_Unsigned)flag != v->av_value) {
+            fail_attr(path,die,v,"flag differs");
+        }
+        break;
+    }
+    case DW_FORM_addr: {
+        Dwarf_Addr addr = 0;
+
+        if (dwarf_formaddr(attr,&addr,0) != DW_DLV_OK ||
+            addr != v->av_value) {
+            fail_attr(path,die,v,"addr differs");
+        }
+        break;
+    }
+    case DW_FORM_addrx:
+    case DW_FORM_addrx1:
+    case DW_FORM_addrx2:
+    case DW_FORM_addrx3:
+    case DW_FORM_addrx4:
+    case DW_FORM_GNU_addr_index:
+        if (dwarf_get_debug_addr_index(attr,&uval,0) !=
+            DW_DLV_OK || uval != v->av_value) {
+            fail_attr(path,die,v,"addr index differs");
+        }
+        break;
+    case DW_FORM_ref1:
+    case DW_FORM_ref2:
+    case DW_FORM_ref4:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_udata:
+    case DW_FORM_ref_addr:
+    case DW_FORM_sec_offset:
+        if (dwarf_global_formref_b(attr,&offset,&is_info,0) !=
+            DW_DLV_OK || offset != v->av_value) {
+            fail_attr(path,die,v,"reference differs");
+        }
+        break;
+    case DW_FORM_ref_sig8:
+    case DW_FORM_data16: {
+        Dwarf_Sig8 sig;
+        Dwarf_Form_Data16 d16;
+
+        if (form == DW_FORM_ref_sig8) {
+            res = dwarf_formsig8(attr,&sig,0);
+            if (res != DW_DLV_OK || v->av_len != sizeof(sig) ||
+                memcmp(v->av_ptr,&sig,sizeof(sig))) {
+                fail_attr(path,die,v,"signature differs");
+            }
+        } else {
+            res = dwarf_formdata16(attr,&d16,0);
+            if (res != DW_DLV_OK || v->av_len != sizeof(d16) ||
+                memcmp(v->av_ptr,&d16,sizeof(d16))) {
+                fail_attr(path,die,v,"data16 differs");
+            }
+        }
+        break;
+    }
+    case DW_FORM_block1:
+    case DW_FORM_block2:
+    case DW_FORM_block4:
+    case DW_FORM_block: {
+        Dwarf_Block *block = 0;
+
+        if (dwarf_formblock(attr,&block,0) != DW_DLV_OK) {
+            fail_attr(path,die,v,"no block");
+            break;
+        }
+        if (block->bl_data != (Dwarf_Ptr)v->av_ptr ||
+            block->bl_len != v->av_len) {
+            fail_attr(path,die,v,"block differs");
+        }
+        dwarf_dealloc(dbg,block,
+            DW_DLA_BLOCK);
+        break;
+    }
+    case DW_FORM_exprloc: {
+        Dwarf_Ptr ptr = 0;
+
+        if (dwarf_formexprloc(attr,&uval,&ptr,0) != DW_DLV_OK ||
+            ptr != (Dwarf_Ptr)v->av_ptr || uval != v->av_len) {
+            fail_attr(path,die,v,"exprloc differs");
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    if (v->av_class == DW_FORM_CLASS_STRING) {
+        res = dwarf_formstring(attr,&str,&err);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,err);
+            err = 0;
+        }
+        if (res != DW_DLV_OK || str != (char *)v->av_ptr) {
+            fail_attr(path,die,v,"string differs");
+        }
+        switch (form) {
+        case DW_FORM_strx:
+        case DW_FORM_strx1:
+        case DW_FORM_strx2:
+        case DW_FORM_strx3:
+        case DW_FORM_strx4:
+        case DW_FORM_GNU_str_index:
+            if (dwarf_get_debug_str_index(attr,&uval,0) !=
+                DW_DLV_OK || uval != v->av_value) {
+                fail_attr(path,die,v,"string index differs");
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static void
+check_die(Dwarf_Debug dbg, const char *path,
+    Dwarf_Die die)
+{
+    Dwarf_Attribute *attrs = 0;
+    Dwarf_Signed attrcount = 0;
+    Dwarf_Attr_Value values[MAXATTRS];
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned small_count = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+    int bres = 0;
+
+    ++dies_checked;
+    res = dwarf_attrlist(die,&attrs,&attrcount,&err);
+    bres = dwarf_die_attr_values(die,values,MAXATTRS,
+        &count,&err);
+    if (res == DW_DLV_ERROR || bres == DW_DLV_ERROR) {
+        printf("FAIL %s attribute error %s\n",path,
+            dwarf_errmsg(err));
+        ++failcount;
+        return;
+    }
+    if (res != bres) {
+        printf("FAIL %s attrlist res %d bulk res %d\n",
+            path,res,bres);
+        ++failcount;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return;
+    }
+    if ((Dwarf_Unsigned)attrcount != count ||
+        count > MAXATTRS) {
+        printf("FAIL %s attrlist count %lld bulk count %llu\n",
+            path,(long long)attrcount,(unsigned long long)count);
+        ++failcount;
+    } else {
+        for (i = 0; i < attrcount; ++i) {
+            check_attr(dbg,path,die,attrs[i],&values[i]);
+        }
+    }
+    /*  A short array still reports the full count. */
+    bres = dwarf_die_attr_values(die,values,1,
+        &small_count,&err);
+    if (bres != DW_DLV_OK || small_count != count) {
+        printf("FAIL %s short array count %llu expected %llu\n",
+            path,(unsigned long long)small_count,
+            (unsigned long long)count);
+        ++failcount;
+    }
+    for (i = 0; i < attrcount; ++i) {
+        dwarf_dealloc_attribute(attrs[i]);
+    }
+    dwarf_dealloc(dbg,attrs,
+        DW_DLA_LIST);
+}
+
+static void
+walk_dies(Dwarf_Debug dbg, const char *path, Dwarf_Die die,
+    Dwarf_Bool is_info)
+{
+    Dwarf_Die cur = die;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        check_die(dbg,path,cur);
+        res = dwarf_child(cur,&child,0);
+        if (res == DW_DLV_OK) {
+            walk_dies(dbg,path,child,is_info);
+            dwarf_dealloc_die(child);
+        }
+        res = dwarf_siblingof_c(cur,&sib,0);
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        cur = sib;
+    }
+}
+
+static void
+check_object(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Bool is_info = TRUE;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    for (is_info = TRUE; ; is_info = FALSE) {
+        for (;;) {
+            Dwarf_Die cu_die = 0;
+
+            res = dwarf_next_cu_header_e(dbg,is_info,&cu_die,
+                0,0,0,0,0,0,0,0,0,0,0);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+            walk_dies(dbg,path,cu_die,is_info);
+            dwarf_dealloc_die(cu_die);
+        }
+        if (!is_info) {
+            break;
+        }
+    }
+    dwarf_finish(dbg);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        size_t blen = strlen(base);
+        size_t tlen = strlen(testobjects[i]);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_attrvalues: %s\n",
+                base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i],tlen+1);
+        check_object(path);
+    }
+    if (!attrs_checked) {
+        printf("FAIL test_attrvalues checked no attributes\n");
+        ++failcount;
+    }
+    if (failcount) {
+        printf("FAIL test_attrvalues %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_attrvalues %ld DIEs %ld attributes\n",
+        dies_checked,attrs_checked);
+    return 0;
+}
@@ -0,0 +1,267 @@
+/*   This test code is hereby placed in the public domain. */
+
+/*  test_checkutil.c
+    testing the address lookups of dd_checkutil.c.
+    FindAddressInBucketGroup() and IsValidInBucketGroup()
+    use an index of sorted, merged intervals, built by
+    the first lookup and updated by later additions.
+    Every lookup here is compared with a linear search
+    of the entries this test added: after additions
+    that overlap, abut, nest or are empty (low > high),
+    after additions once the index exists, after
+    deletions (which force a rebuild) and after a reset.
+*/
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_globals.h"
+#include "dd_glflags.h"
+#include "dd_checkutil.h"
+#include "dd_minimal.h"
+
+struct glflags_s glflags;
+void dd_minimal_count_global_error(void) {}
+
+/*  Up to three buckets of entries. */
+#define MAXENTRIES (BUCKET_SIZE*3)
+
+struct entry_s {
+    Dwarf_Addr key;
+    Dwarf_Addr low;
+    Dwarf_Addr high;
+    int live;
+};
+static struct entry_s entries[MAXENTRIES];
+static int entrycount = 0;
+static int failcount = 0;
+static unsigned long seed = 1;
+
+static Dwarf_Addr
+nextrand(void)
+{
+    seed = seed * 1103515245UL + 12345UL;
+    return (Dwarf_Addr)((seed >> 8) & 0xffffff);
+}
+
+static void
+add(Bucket_Group *g,Dwarf_Addr low,Dwarf_Addr high)
+{
+    if (entrycount >= MAXENTRIES) {
+        printf("FAIL test_checkutil.c too many entries\n");
+        exit(EXIT_FAILURE);
+    }
+    entries[entrycount].key = (Dwarf_Addr)entrycount + 1;
+    entries[entrycount].low = low;
+    entries[entrycount].high = high;
+    entries[entrycount].live = TRUE;
+    AddEntryIntoBucketGroup(g,entries[entrycount].key,0,
+        low,high,"",FALSE);
+    ++entrycount;
+}
+
+static void
+delete_entry(Bucket_Group *g,int i)
+{
+    if (!DeleteKeyInBucketGroup(g,entries[i].key)) {
+        printf("FAIL delete of key 0x%" DW_PR_DUx " failed\n",
+            entries[i].key);
+        ++failcount;
+    }
+    entries[i].live = FALSE;
+}
+
+static Dwarf_Bool
+linear_find(Dwarf_Addr addr)
+{
+    int i = 0;
+
+    for (i = 0; i < entrycount; ++i) {
+        if (entries[i].live && addr >= entries[i].low &&
+            addr <= entries[i].high) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static void
+check_addr(Bucket_Group *g,Dwarf_Addr addr,const char *msg)
+{
+    Dwarf_Bool want = linear_find(addr);
+    Dwarf_Bool got = FindAddressInBucketGroup(g,addr);
+
+    if (got != want) {
+        printf("FAIL %s: address 0x%" DW_PR_DUx
+            " found %d expected %d\n",msg,addr,got,want);
+        ++failcount;
+    }
+    got = IsValidInBucketGroup(g,addr);
+    if (addr < g->lower || addr > g->upper) {
+        want = FALSE;
+    }
+    if (got != want) {
+        printf("FAIL %s: address 0x%" DW_PR_DUx
+            " valid %d expected %d\n",msg,addr,got,want);
+        ++failcount;
+    }
+}
+
+/*  Checks both ends of every entry and the addresses
+    just outside them, plus some others. */
+static void
+check_all(Bucket_Group *g,const char *msg)
+{
+    int i = 0;
+    int count = failcount;
+
+    for (i = 0; i < entrycount; ++i) {
+        check_addr(g,entries[i].low,msg);
+        check_addr(g,entries[i].high,msg);
+        check_addr(g,entries[i].low - 1,msg);
+        check_addr(g,entries[i].high + 1,msg);
+        if (failcount - count > 20) {
+            printf("FAIL %s: giving up\n",msg);
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (i = 0; i < 2000; ++i) {
+        check_addr(g,nextrand(),msg);
+    }
+    check_addr(g,0,msg);
+    check_addr(g,~(Dwarf_Addr)0,msg);
+}
+
+/*  Adds count random entries, mostly short so that
+    some touch and many do not. */
+static void
+add_random(Bucket_Group *g,int count)
+{
+    int i = 0;
+
+    for (i = 0; i < count; ++i) {
+        Dwarf_Addr low = nextrand();
+        Dwarf_Addr len = nextrand() % 64;
+
+        switch (i % 8) {
+        case 0:
+            /* Empty, matches nothing. */
+            add(g,low+len+1,low);
+            break;
+        case 1:
+            /* A single address. */
+            add(g,low,low);
+            break;
+        case 2:
+            /* Long, covering many others. */
+            add(g,low,low + len*4096);
+            break;
+        default:
+            add(g,low,low + len);
+            break;
+        }
+    }
+}
+
+static void
+test_fixed(Bucket_Group *g)
+{
+    /* Overlapping. */
+    add(g,0x1000,0x1fff);
+    add(g,0x1800,0x27ff);
+    /* Abutting, with a one-address gap between. */
+    add(g,0x3000,0x3fff);
+    add(g,0x4000,0x4fff);
+    add(g,0x5001,0x5fff);
+    /* Nested. */
+    add(g,0x8000,0x8fff);
+    add(g,0x8100,0x8200);
+    /* Empty. */
+    add(g,0x9001,0x9000);
+    check_all(g,"fixed");
+
+    /*  Now the index exists, each of these changes it. */
+    add(g,0x5000,0x5000);     /* Joins 0x3000 to 0x5fff. */
+    add(g,0x7000,0x7fff);     /* Abuts 0x8000 below. */
+    add(g,0x0800,0x9000);     /* Covers all of them. */
+    add(g,0xa000,0xa000);     /* Past the end. */
+    add(g,0x10,0x20);         /* Before the start. */
+    add(g,0x9002,0x9001);     /* Empty. */
+    check_all(g,"fixed after index");
+
+    /*  The ends of the address space. */
+    add(g,0,0x5);
+    add(g,~(Dwarf_Addr)0 - 3,~(Dwarf_Addr)0);
+    add(g,~(Dwarf_Addr)0 - 8,~(Dwarf_Addr)0 - 4);
+    check_all(g,"fixed address space ends");
+}
+
+int
+main(void)
+{
+    Bucket_Group *g = 0;
+    int i = 0;
+
+    g = AllocateBucketGroup(KIND_RANGES_INFO);
+    if (!g) {
+        printf("FAIL test_checkutil.c out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    SetLimitsBucketGroup(g,0x100,0xffffff);
+
+    test_fixed(g);
+
+    /*  Index built on the first lookup, then merged
+        into one addition at a time. */
+    ResetBucketGroup(g);
+    entrycount = 0;
+    add_random(g,BUCKET_SIZE + 500);
+    check_all(g,"random");
+    for (i = 0; i < 300; ++i) {
+        add_random(g,1);
+        check_addr(g,entries[entrycount-1].low,"random added");
+        check_addr(g,entries[entrycount-1].high + 1,
+            "random added");
+        check_addr(g,entries[entrycount-1].low - 1,
+            "random added");
+    }
+    check_all(g,"random after index");
+
+    /*  Deleting must not leave addresses of merged
+        intervals behind. */
+    for (i = 2; i < entrycount; i += 97) {
+        delete_entry(g,i);
+    }
+    delete_entry(g,entrycount-1);
+    check_all(g,"after delete");
+    add_random(g,BUCKET_SIZE);
+    check_all(g,"added after delete");
+
+    /*  After a reset nothing is found, until added again. */
+    ResetBucketGroup(g);
+    for (i = 0; i < entrycount; ++i) {
+        entries[i].live = FALSE;
+    }
+    check_all(g,"after reset");
+    entrycount = 0;
+    add_random(g,BUCKET_SIZE + 10);
+    check_all(g,"added after reset");
+
+    ReleaseBucketGroup(g);
+    if (glflags.gf_count_major_errors) {
+        printf("FAIL test_checkutil.c %lu errors reported\n",
+            glflags.gf_count_major_errors);
+        ++failcount;
+    }
+    if (failcount) {
+        printf("FAIL test_checkutil.c %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_checkutil.c\n");
+    return 0;
+}
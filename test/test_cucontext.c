@@ -0,0 +1,399 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Usage:  ./test_cucontext -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    A sequential walk with dwarf_next_cu_header_e()
+    records every unit and the offsets of its DIEs.
+    Then, in a fresh Dwarf_Debug,
+    dwarf_get_cu_die_offset_given_cu_header_offset_b()
+    at the unit header offsets in shuffled order
+    creates the CU contexts out of order, most going
+    into the middle of the list of those already made,
+    and dwarf_offdie_b() on each CU DIE offset must
+    find its unit.  Every DIE offset, also shuffled,
+    must then be in the same unit as in the walk,
+    and a walk of that Dwarf_Debug must give the
+    units in the same order.  Throughout, the
+    Dwarf_Debug list of CU contexts and the array
+    searched for them must hold one context per unit
+    met so far, in the same ascending order.
+    Done for .debug_info and .debug_types. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+
+#define PATHLEN 2000
+#define MAXUNITS 1000
+#define MAXDIES 20000
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobjects[] = {
+"/test/dwpindexDW4.dwp",
+"/test/typeunitsDW4.testme",
+"/test/manydiesDW5.testme",
+"/test/abbrevshareDW4.testme",
+0};
+
+struct unit_s {
+    Dwarf_Off hdr_offset;
+    Dwarf_Off length;
+    Dwarf_Off die_offset;
+};
+
+struct die_s {
+    Dwarf_Off offset;
+    unsigned  unit;
+};
+
+static struct unit_s units[MAXUNITS];
+static unsigned unitcount;
+static struct die_s dies[MAXDIES];
+static unsigned diecount;
+static unsigned long seed = 1;
+static int failcount;
+static unsigned totalunits;
+static unsigned totaldies;
+
+static unsigned
+nextrand(unsigned limit)
+{
+    seed = seed * 1103515245UL + 12345UL;
+    return (unsigned)((seed >> 8) % limit);
+}
+
+static void
+open_object(const char *path, Dwarf_Debug *dbg)
+{
+    Dwarf_Error err = 0;
+    int res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,dbg,&err);
+
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*  Records die, its siblings and all their children. */
+static void
+record_dies(Dwarf_Die in_die, unsigned unit)
+{
+    Dwarf_Die die = in_die;
+    Dwarf_Error err = 0;
+    int res = DW_DLV_OK;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        if (diecount < MAXDIES) {
+            dwarf_dieoffset(die,&dies[diecount].offset,&err);
+            dies[diecount].unit = unit;
+            ++diecount;
+        }
+        res = dwarf_child(die,&child,&err);
+        if (res == DW_DLV_OK) {
+            record_dies(child,unit);
+            dwarf_dealloc_die(child);
+        }
+        res = dwarf_siblingof_c(die,&sib,&err);
+        if (die != in_die) {
+            dwarf_dealloc_die(die);
+        }
+        if (res != DW_DLV_OK) {
+            return;
+        }
+        die = sib;
+    }
+}
+
+/*  The walk of dbg must find exactly the units
+    recorded, in order.  With record set it records
+    them. */
+static void
+walk_units(Dwarf_Debug dbg, Dwarf_Bool is_info, int record,
+    const char *path)
+{
+    Dwarf_Off hdroff = 0;
+    Dwarf_Error err = 0;
+    unsigned n = 0;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Unsigned next = 0;
+        Dwarf_Off dieoff = 0;
+
+        res = dwarf_next_cu_header_e(dbg,is_info,&cudie,
+            0,0,0,0,0,0,0,0,&next,0,&err);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s walk: %s\n",path,dwarf_errmsg(err));
+            ++failcount;
+            dwarf_dealloc_error(dbg,err);
+            break;
+        }
+        dwarf_dieoffset(cudie,&dieoff,&err);
+        if (record) {
+            if (n >= MAXUNITS) {
+                printf("FAIL %s too many units\n",path);
+                exit(EXIT_FAILURE);
+            }
+            units[n].hdr_offset = hdroff;
+            units[n].length = next - hdroff;
+            units[n].die_offset = dieoff;
+            record_dies(cudie,n);
+        } else if (n >= unitcount ||
+            units[n].hdr_offset != hdroff ||
+            units[n].die_offset != dieoff) {
+            printf("FAIL %s unit %u at 0x%lx out of order "
+                "after offdie\n",path,n,(unsigned long)hdroff);
+            ++failcount;
+        }
+        dwarf_dealloc_die(cudie);
+        hdroff = next;
+        ++n;
+    }
+    if (record) {
+        unitcount = n;
+    } else if (n != unitcount) {
+        printf("FAIL %s walk after offdie found %u units not %u\n",
+            path,n,unitcount);
+        ++failcount;
+    }
+}
+
+/*  The context list and array must agree and each
+    context must start a recorded unit, once. */
+static void
+check_contexts(Dwarf_Debug dbg, Dwarf_Bool is_info,
+    const char *path)
+{
+    Dwarf_Debug_InfoTypes dis = is_info? &dbg->de_info_reading:
+        &dbg->de_types_reading;
+    Dwarf_CU_Context cur = dis->de_cu_context_list;
+    Dwarf_CU_Context last = 0;
+    Dwarf_Unsigned i = 0;
+    unsigned u = 0;
+
+    for (i = 0; i < dis->de_cu_context_array_count;
+        ++i, cur = cur->cc_next) {
+        if (!cur || cur != dis->de_cu_context_array[i]) {
+            printf("FAIL %s context list and array differ "
+                "at entry %lu\n",path,(unsigned long)i);
+            ++failcount;
+            return;
+        }
+        while (u < unitcount &&
+            units[u].hdr_offset < cur->cc_debug_offset) {
+            ++u;
+        }
+        if (u == unitcount ||
+            units[u].hdr_offset != cur->cc_debug_offset) {
+            printf("FAIL %s context at 0x%lx is not a unit "
+                "or is out of order\n",path,
+                (unsigned long)cur->cc_debug_offset);
+            ++failcount;
+            return;
+        }
+        ++u;
+        last = cur;
+    }
+    if (cur || dis->de_cu_context_list_end != last) {
+        printf("FAIL %s context list longer than array "
+            "or wrong list end\n",path);
+        ++failcount;
+    }
+}
+
+/*  dwarf_offdie_b(offset) must give a DIE
+    of unit u. */
+static void
+check_offdie(Dwarf_Debug dbg, Dwarf_Bool is_info,
+    Dwarf_Off offset, unsigned u, const char *path)
+{
+    Dwarf_Die die = 0;
+    Dwarf_Off hdroff = 0;
+    Dwarf_Off len = 0;
+    Dwarf_Off cudieoff = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_offdie_b(dbg,offset,is_info,&die,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s offdie 0x%lx: %s\n",path,
+            (unsigned long)offset,
+            res == DW_DLV_ERROR?dwarf_errmsg(err):"no entry");
+        ++failcount;
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,err);
+        }
+        return;
+    }
+    dwarf_die_CU_offset_range(die,&hdroff,&len,&err);
+    dwarf_CU_dieoffset_given_die(die,&cudieoff,&err);
+    if (hdroff != units[u].hdr_offset || len != units[u].length ||
+        cudieoff != units[u].die_offset) {
+        printf("FAIL %s DIE 0x%lx in unit at 0x%lx not 0x%lx\n",
+            path,(unsigned long)offset,(unsigned long)hdroff,
+            (unsigned long)units[u].hdr_offset);
+        ++failcount;
+    }
+    dwarf_dealloc_die(die);
+}
+
+static void
+check_object(const char *path, Dwarf_Bool is_info)
+{
+    Dwarf_Debug dbg = 0;
+    unsigned order[MAXUNITS];
+    unsigned i = 0;
+
+    unitcount = 0;
+    diecount = 0;
+    open_object(path,&dbg);
+    walk_units(dbg,is_info,TRUE,path);
+    dwarf_finish(dbg);
+    if (!unitcount) {
+        if (is_info) {
+            printf("FAIL %s has no CUs\n",path);
+            ++failcount;
+        }
+        return;
+    }
+
+    for (i = 0; i < unitcount; ++i) {
+        order[i] = i;
+    }
+    for (i = unitcount; i > 1; --i) {
+        unsigned j = nextrand(i);
+        unsigned t = order[i-1];
+
+        order[i-1] = order[j];
+        order[j] = t;
+    }
+    for (i = diecount; i > 1; --i) {
+        unsigned j = nextrand(i);
+        struct die_s t = dies[i-1];
+
+        dies[i-1] = dies[j];
+        dies[j] = t;
+    }
+    open_object(path,&dbg);
+    for (i = 0; i < unitcount; ++i) {
+        struct unit_s *u = &units[order[i]];
+        Dwarf_Off dieoff = 0;
+        Dwarf_Error err = 0;
+        int res = 0;
+
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dbg,u->hdr_offset,is_info,&dieoff,&err);
+        if (res != DW_DLV_OK || dieoff != u->die_offset) {
+            printf("FAIL %s unit at 0x%lx gives CU DIE 0x%lx\n",
+                path,(unsigned long)u->hdr_offset,
+                (unsigned long)dieoff);
+            ++failcount;
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,err);
+            }
+        }
+        check_offdie(dbg,is_info,u->die_offset,order[i],path);
+        check_contexts(dbg,is_info,path);
+    }
+    for (i = 0; i < diecount; ++i) {
+        check_offdie(dbg,is_info,dies[i].offset,dies[i].unit,path);
+    }
+    check_contexts(dbg,is_info,path);
+    walk_units(dbg,is_info,FALSE,path);
+    check_contexts(dbg,is_info,path);
+    dwarf_finish(dbg);
+    totalunits += unitcount;
+    totaldies += diecount;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    size_t blen = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    blen = strlen(base);
+    for (i = 0; testobjects[i]; ++i) {
+        size_t tlen = strlen(testobjects[i]);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_cucontext: %s\n",
+                base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i],tlen+1);
+        check_object(path,TRUE);
+        check_object(path,FALSE);
+    }
+    if (failcount) {
+        printf("FAIL test_cucontext %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_cucontext %u units %u DIEs\n",
+        totalunits,totaldies);
+    return 0;
+}
@@ -0,0 +1,609 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/*  Usage:  ./test_decompress -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    zstdframesLE64.testme has zstd compressed sections
+    each written as several zstd frames (see
+    zstdframesbuild.py). Reading every DIE and line
+    table must give the same result decompressing
+    in one call, with dwarf_set_decompress_threads(),
+    and through dwarf_set_decompress_cache_dir().
+    A cache file, once written, must be what is read,
+    but only while its checksum holds: editing the
+    cached .debug_str must not change a name, the
+    file is decompressed again instead.
+    The cache files are written to, and removed from,
+    the current directory.
+    Copies of the object with .debug_info damaged at
+    a frame boundary (a bad frame checksum, the last
+    frame cut short, the uncompressed size one too
+    big or too small) must fail to load with
+    DW_DLE_ZLIB_DATA_ERROR, threaded or not, and
+    must not leave a cache file.
+    Without zlib and zstd in the library this
+    reports SKIP. */
+
+#include <config.h>
+
+#include <stdio.h>  /* fclose() fopen() fread() fwrite() printf()
+    remove() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcmp() memcpy() strcat() strcmp()
+    strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+#define FILEMAX 4096
+#define OBJMAX  100000
+#define DAMAGED "junk.zstdframesdamaged"
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobject = "/test/zstdframesLE64.testme";
+/*  The build-id of the test object, so the names
+    of the cache files. */
+static const char *buildid = "5befbd2d50cf3a39b72e03f7de79357ca7ed9470";
+static const char *cachedsections[] = {
+".debug_info",
+".debug_abbrev",
+".debug_str",
+".debug_line",
+0
+};
+
+struct summary_s {
+    unsigned long dies;
+    unsigned long lines;
+    unsigned long long hash;
+    int saw_edited_name;
+    int skip;
+};
+
+static int failcount;
+
+static void
+add_hash(struct summary_s *s, const void *p, size_t len)
+{
+    const unsigned char *c = (const unsigned char *)p;
+    size_t i = 0;
+
+    for (i = 0; i < len; ++i) {
+        s->hash = (s->hash ^ c[i]) * 1099511628211ULL;
+    }
+}
+
+/*  Walks die, its siblings and all their children.
+    The caller frees die itself. */
+static int
+walk_die(Dwarf_Die in_die, struct summary_s *s, Dwarf_Error *err)
+{
+    Dwarf_Die die = in_die;
+    int res = DW_DLV_OK;
+
+    for (;;) {
+        Dwarf_Off off = 0;
+        Dwarf_Half tag = 0;
+        char *name = 0;
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        ++s->dies;
+        dwarf_dieoffset(die,&off,err);
+        dwarf_tag(die,&tag,err);
+        add_hash(s,&off,sizeof(off));
+        add_hash(s,&tag,sizeof(tag));
+        res = dwarf_diename(die,&name,err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,name,strlen(name));
+            if (!strcmp(name,"pOint")) {
+                s->saw_edited_name = TRUE;
+            }
+        }
+        if (res != DW_DLV_ERROR) {
+            res = dwarf_child(die,&child,err);
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_die(child,s,err);
+            dwarf_dealloc_die(child);
+        }
+        if (res != DW_DLV_ERROR) {
+            res = dwarf_siblingof_c(die,&sib,err);
+        }
+        if (die != in_die) {
+            dwarf_dealloc_die(die);
+        }
+        if (res != DW_DLV_OK) {
+            return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+        }
+        die = sib;
+    }
+}
+
+static int
+walk_lines(Dwarf_Die cudie, struct summary_s *s, Dwarf_Error *err)
+{
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed linecount = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_srclines_b(cudie,&version,&count,&context,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_srclines_from_linecontext(context,&lines,
+        &linecount,err);
+    if (res == DW_DLV_OK) {
+        for (i = 0; i < linecount; ++i) {
+            Dwarf_Addr addr = 0;
+            Dwarf_Unsigned lineno = 0;
+
+            dwarf_lineaddr(lines[i],&addr,err);
+            dwarf_lineno(lines[i],&lineno,err);
+            add_hash(s,&addr,sizeof(addr));
+            add_hash(s,&lineno,sizeof(lineno));
+            ++s->lines;
+        }
+    }
+    dwarf_srclines_dealloc_b(context);
+    return res;
+}
+
+static void
+summarize(const char *path, unsigned int threads,
+    const char *cachedir, struct summary_s *s)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    memset(s,0,sizeof(*s));
+    s->hash = 14695981039346656037ULL;
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    dwarf_set_decompress_threads(dbg,threads);
+    if (dwarf_set_decompress_cache_dir(dbg,cachedir,&err) !=
+        DW_DLV_OK) {
+        printf("FAIL setting the cache directory\n");
+        exit(EXIT_FAILURE);
+    }
+    for (;;) {
+        Dwarf_Die cudie = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cudie,
+            0,0,0,0,0,0,0,0,0,0,&err);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_die(cudie,s,&err);
+            if (res == DW_DLV_OK) {
+                res = walk_lines(cudie,s,&err);
+            }
+            dwarf_dealloc_die(cudie);
+        }
+        if (res == DW_DLV_ERROR) {
+            if (dwarf_errno(err) == DW_DLE_ZDEBUG_REQUIRES_ZLIB) {
+                s->skip = TRUE;
+            } else {
+                printf("FAIL %s threads %u cache %s: %s\n",path,
+                    threads,cachedir?cachedir:"none",
+                    dwarf_errmsg(err));
+                ++failcount;
+            }
+            dwarf_dealloc_error(dbg,err);
+            break;
+        }
+    }
+    dwarf_finish(dbg);
+}
+
+static int
+same(struct summary_s *a, struct summary_s *b)
+{
+    return a->dies == b->dies && a->lines == b->lines &&
+        a->hash == b->hash;
+}
+
+static void
+cache_file_name(char *out, const char *section)
+{
+    out[0] = 0;
+    strcat(out,"./");
+    strcat(out,buildid);
+    strcat(out,section);
+}
+
+static void
+remove_cache_files(void)
+{
+    char name[200];
+    int i = 0;
+
+    for (i = 0; cachedsections[i]; ++i) {
+        cache_file_name(name,cachedsections[i]);
+        remove(name);
+    }
+}
+
+static int
+cache_file_exists(const char *section)
+{
+    char name[200];
+    FILE *f = 0;
+
+    cache_file_name(name,section);
+    f = fopen(name,"rb");
+    if (!f) {
+        return FALSE;
+    }
+    fclose(f);
+    return TRUE;
+}
+
+static Dwarf_Unsigned
+get_le(const unsigned char *p, int len)
+{
+    Dwarf_Unsigned v = 0;
+    int i = 0;
+
+    for (i = len-1; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static void
+put_le(unsigned char *p, int len, Dwarf_Unsigned v)
+{
+    int i = 0;
+
+    for (i = 0; i < len; ++i) {
+        p[i] = (unsigned char)(v >> (8*i));
+    }
+}
+
+/*  Returns the offset of the section header of
+    name in the 64bit little-endian ELF obj, or 0. */
+static Dwarf_Unsigned
+find_shdr(const unsigned char *obj, size_t len, const char *name)
+{
+    Dwarf_Unsigned shoff = get_le(obj+0x28,8);
+    Dwarf_Unsigned shentsize = get_le(obj+0x3a,2);
+    Dwarf_Unsigned shnum = get_le(obj+0x3c,2);
+    Dwarf_Unsigned shstrndx = get_le(obj+0x3e,2);
+    Dwarf_Unsigned strs = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (shoff + shnum*shentsize > len || shstrndx >= shnum) {
+        return 0;
+    }
+    strs = get_le(obj + shoff + shstrndx*shentsize + 24,8);
+    for (i = 0; i < shnum; ++i) {
+        Dwarf_Unsigned hdr = shoff + i*shentsize;
+        Dwarf_Unsigned nameoff = strs + get_le(obj+hdr,4);
+
+        if (nameoff + strlen(name) < len &&
+            !strcmp((const char *)obj + nameoff,name)) {
+            return hdr;
+        }
+    }
+    return 0;
+}
+
+/*  Opens path with the given threads and cache
+    directory and reads the CU headers. TRUE if that
+    fails with DW_DLE_ZLIB_DATA_ERROR. */
+static int
+fails_to_decompress(const char *path, unsigned int threads,
+    const char *cachedir)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+    int failed = FALSE;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            failed = dwarf_errno(err) == DW_DLE_ZLIB_DATA_ERROR;
+            dwarf_dealloc_error(0,err);
+        }
+        return failed;
+    }
+    dwarf_set_decompress_threads(dbg,threads);
+    if (cachedir) {
+        dwarf_set_decompress_cache_dir(dbg,cachedir,&err);
+    }
+    for (;;) {
+        Dwarf_Die cudie = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cudie,
+            0,0,0,0,0,0,0,0,0,0,&err);
+        if (res == DW_DLV_OK) {
+            dwarf_dealloc_die(cudie);
+            continue;
+        }
+        if (res == DW_DLV_ERROR) {
+            failed = dwarf_errno(err) == DW_DLE_ZLIB_DATA_ERROR;
+            dwarf_dealloc_error(dbg,err);
+        }
+        break;
+    }
+    dwarf_finish(dbg);
+    return failed;
+}
+
+/*  Writes obj, with .debug_info damaged as
+    how says, to DAMAGED and checks it cannot be
+    read, threaded or not. */
+static void
+check_damaged(const unsigned char *obj, size_t len,
+    const char *how)
+{
+    static unsigned char copy[OBJMAX];
+    Dwarf_Unsigned hdr = find_shdr(obj,len,".debug_info");
+    Dwarf_Unsigned secoff = 0;
+    Dwarf_Unsigned seclen = 0;
+    Dwarf_Unsigned i = 0;
+    unsigned int magics = 0;
+    int damaged = FALSE;
+    FILE *f = 0;
+
+    if (!hdr) {
+        printf("FAIL no .debug_info section header\n");
+        ++failcount;
+        return;
+    }
+    memcpy(copy,obj,len);
+    secoff = get_le(obj+hdr+24,8);
+    seclen = get_le(obj+hdr+32,8);
+    if (!strcmp(how,"checksum")) {
+        /*  The byte before the third frame is the
+            last of the second frame's checksum. */
+        for (i = secoff + 24; i + 4 <= secoff + seclen; ++i) {
+            if (get_le(obj+i,4) == 0xFD2FB528 && ++magics == 3) {
+                copy[i-1] ^= 0x55;
+                damaged = TRUE;
+                break;
+            }
+        }
+    } else if (!strcmp(how,"short")) {
+        put_le(copy+hdr+32,8,seclen - 1);
+        damaged = TRUE;
+    } else if (!strcmp(how,"big")) {
+        put_le(copy+secoff+8,8,get_le(obj+secoff+8,8) + 1);
+        damaged = TRUE;
+    } else if (!strcmp(how,"small")) {
+        put_le(copy+secoff+8,8,get_le(obj+secoff+8,8) - 1);
+        damaged = TRUE;
+    }
+    if (!damaged) {
+        printf("FAIL .debug_info has fewer than three frames\n");
+        ++failcount;
+        return;
+    }
+    f = fopen(DAMAGED,"wb");
+    if (!f || fwrite(copy,1,len,f) != len) {
+        printf("FAIL cannot write %s\n",DAMAGED);
+        exit(EXIT_FAILURE);
+    }
+    fclose(f);
+    remove_cache_files();
+    if (!fails_to_decompress(DAMAGED,0,0)) {
+        printf("FAIL %s .debug_info read in one call\n",how);
+        ++failcount;
+    }
+    if (!fails_to_decompress(DAMAGED,4,0)) {
+        printf("FAIL %s .debug_info read threaded\n",how);
+        ++failcount;
+    }
+    if (!fails_to_decompress(DAMAGED,4,".")) {
+        printf("FAIL %s .debug_info read with a cache\n",how);
+        ++failcount;
+    }
+    if (cache_file_exists(".debug_info")) {
+        printf("FAIL %s .debug_info was cached\n",how);
+        ++failcount;
+    }
+    remove(DAMAGED);
+}
+
+/*  Rewrite the cached .debug_str with "point"
+    spelled "pOint". */
+static int
+edit_cached_str(void)
+{
+    static unsigned char buf[FILEMAX];
+    char name[200];
+    FILE *f = 0;
+    size_t len = 0;
+    size_t i = 0;
+    int edited = FALSE;
+
+    cache_file_name(name,".debug_str");
+    f = fopen(name,"rb");
+    if (!f) {
+        return FALSE;
+    }
+    len = fread(buf,1,sizeof(buf),f);
+    fclose(f);
+    for (i = 0; i + 6 <= len; ++i) {
+        if (!memcmp(buf+i,"point",6)) {
+            buf[i+1] = 'O';
+            edited = TRUE;
+        }
+    }
+    f = fopen(name,"wb");
+    if (!f) {
+        return FALSE;
+    }
+    if (fwrite(buf,1,len,f) != len) {
+        edited = FALSE;
+    }
+    fclose(f);
+    return edited;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    char name[200];
+    struct summary_s plain;
+    struct summary_s threaded;
+    struct summary_s cached;
+    size_t blen = 0;
+    size_t tlen = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    blen = strlen(base);
+    tlen = strlen(testobject);
+    if ((blen + tlen + 1) > PATHLEN) {
+        printf("FAIL path too long for test_decompress: %s\n",
+            base);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(path,base,blen);
+    memcpy(path+blen,testobject,tlen+1);
+
+    /*  Threaded first, so a frame left undone is not
+        hidden by memory reused from an earlier read. */
+    summarize(path,4,0,&threaded);
+    summarize(path,0,0,&plain);
+    if (plain.skip) {
+        printf("SKIP test_decompress: no zlib and zstd\n");
+        return 0;
+    }
+    if (!plain.dies || !plain.lines) {
+        printf("FAIL %s read no DIEs or lines\n",path);
+        ++failcount;
+    }
+    if (!same(&plain,&threaded)) {
+        printf("FAIL %s threaded decompression differs\n",path);
+        ++failcount;
+    }
+    remove_cache_files();
+    summarize(path,4,".",&cached);
+    if (!same(&plain,&cached)) {
+        printf("FAIL %s decompression writing the cache "
+            "differs\n",path);
+        ++failcount;
+    }
+    for (i = 0; cachedsections[i]; ++i) {
+        FILE *f = 0;
+
+        cache_file_name(name,cachedsections[i]);
+        f = fopen(name,"rb");
+        if (!f) {
+            printf("FAIL no cache file %s\n",name);
+            ++failcount;
+            continue;
+        }
+        fclose(f);
+    }
+    summarize(path,0,".",&cached);
+    if (!same(&plain,&cached)) {
+        printf("FAIL %s reading the cache differs\n",path);
+        ++failcount;
+    }
+    if (!edit_cached_str()) {
+        printf("FAIL cannot edit the cached .debug_str\n");
+        ++failcount;
+    } else {
+        summarize(path,0,".",&cached);
+        if (cached.saw_edited_name || !same(&plain,&cached)) {
+            printf("FAIL %s damaged cached .debug_str used\n",
+                path);
+            ++failcount;
+        }
+        summarize(path,0,".",&cached);
+        if (!same(&plain,&cached)) {
+            printf("FAIL %s rewritten cache differs\n",path);
+            ++failcount;
+        }
+    }
+    remove_cache_files();
+    {
+        static unsigned char obj[OBJMAX];
+        FILE *f = fopen(path,"rb");
+        size_t len = 0;
+
+        if (f) {
+            len = fread(obj,1,sizeof(obj),f);
+            fclose(f);
+        }
+        if (!len || len == sizeof(obj)) {
+            printf("FAIL cannot read %s\n",path);
+            exit(EXIT_FAILURE);
+        }
+        check_damaged(obj,len,"checksum");
+        check_damaged(obj,len,"short");
+        check_damaged(obj,len,"big");
+        check_damaged(obj,len,"small");
+    }
+    remove_cache_files();
+    if (failcount) {
+        printf("FAIL test_decompress %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_decompress %lu DIEs %lu lines\n",
+        plain.dies,plain.lines);
+    return 0;
+}
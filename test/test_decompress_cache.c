@@ -0,0 +1,245 @@
+/*
+Copyright (c) 2026, David Anderson
+All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  test_decompress_cache.c
+    testing dwarf_decompress_cache.c, the files of
+    dwarf_set_decompress_cache_dir().  Unlike
+    test_decompress.c this needs neither zlib nor zstd.
+    A file written must read back exactly, and a
+    file of the right length that is damaged, cut
+    short, of the old headerless form, or reached
+    through a symbolic link must be refused.
+    Writing must replace a symbolic link, not write
+    through it, and must leave a file with the old
+    fixed temporary name alone.
+    The files are written to, and removed from,
+    the current directory. */
+
+#include <config.h>
+
+#include <stdio.h>  /* fclose() fopen() fread() fwrite() printf()
+    remove() */
+#include <stdlib.h> /* exit() free() malloc() */
+#include <string.h> /* memcmp() memset() */
+
+#if !defined(_WIN32) && defined(HAVE_UNISTD_H)
+#include <unistd.h> /* symlink() */
+#endif /* !_WIN32 && HAVE_UNISTD_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_decompress_cache.h"
+
+#define CACHE_NAME  "junk.decompresscache"
+#define OTHER_NAME  "junk.decompresscache.other"
+#define OLDTMP_NAME "junk.decompresscache.tmp"
+#define DATALEN     100000
+/*  Of the header before the section bytes. */
+#define HDR_LEN     20
+
+static int failcount = 0;
+
+static void
+check(int line, int ok, const char *msg)
+{
+    if (!ok) {
+        ++failcount;
+        printf("FAIL line %d %s\n",line,msg);
+    }
+}
+
+/*  Writes len bytes to name, replacing it. */
+static void
+put_file(const char *name, const unsigned char *data,
+    size_t len)
+{
+    FILE *f = fopen(name,"wb");
+
+    if (!f || fwrite(data,1,len,f) != len) {
+        printf("FAIL cannot write %s\n",name);
+        exit(EXIT_FAILURE);
+    }
+    fclose(f);
+}
+
+/*  Reads at most len bytes of name, returning the count. */
+static size_t
+get_file(const char *name, unsigned char *data, size_t len)
+{
+    FILE *f = fopen(name,"rb");
+    size_t got = 0;
+
+    if (!f) {
+        return 0;
+    }
+    got = fread(data,1,len,f);
+    fclose(f);
+    return got;
+}
+
+/*  TRUE if the cache at CACHE_NAME reads back as
+    exactly data. */
+static int
+reads_back(const unsigned char *data, Dwarf_Unsigned len)
+{
+    Dwarf_Small *got = _dwarf_read_decompress_cache(CACHE_NAME,len);
+    int ok = FALSE;
+
+    if (got) {
+        ok = !len || !memcmp(got,data,(size_t)len);
+        free(got);
+    }
+    return ok;
+}
+
+static int
+refused(Dwarf_Unsigned len)
+{
+    Dwarf_Small *got = _dwarf_read_decompress_cache(CACHE_NAME,len);
+
+    free(got);
+    return got == 0;
+}
+
+int
+main(void)
+{
+    unsigned char *data = 0;
+    unsigned char *file = 0;
+    size_t filelen = 0;
+    size_t i = 0;
+    int res = 0;
+
+    data = (unsigned char *)malloc(DATALEN);
+    file = (unsigned char *)malloc(DATALEN + HDR_LEN + 1);
+    if (!data || !file) {
+        printf("FAIL out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < DATALEN; ++i) {
+        data[i] = (unsigned char)(i * 7 + (i >> 8));
+    }
+    remove(CACHE_NAME);
+    remove(OTHER_NAME);
+    remove(OLDTMP_NAME);
+
+    check(__LINE__,refused(DATALEN),"no file must be refused");
+    res = _dwarf_write_decompress_cache(CACHE_NAME,data,DATALEN);
+    check(__LINE__,res == DW_DLV_OK,"write failed");
+    check(__LINE__,reads_back(data,DATALEN),
+        "did not read back what was written");
+    check(__LINE__,refused(DATALEN-1),"shorter length accepted");
+    check(__LINE__,refused(DATALEN+1),"longer length accepted");
+
+    filelen = get_file(CACHE_NAME,file,DATALEN + HDR_LEN + 1);
+    check(__LINE__,filelen == DATALEN + HDR_LEN,
+        "unexpected file length");
+
+    /*  A hole of zeros, as a crashed writer of the
+        old fixed .tmp file could leave, same length. */
+    memset(file + HDR_LEN + 5000,0,4096);
+    put_file(CACHE_NAME,file,filelen);
+    check(__LINE__,refused(DATALEN),"zeroed bytes accepted");
+
+    /*  One changed byte. */
+    res = _dwarf_write_decompress_cache(CACHE_NAME,data,DATALEN);
+    check(__LINE__,res == DW_DLV_OK,"rewrite failed");
+    check(__LINE__,reads_back(data,DATALEN),
+        "rewrite did not replace the bad file");
+    get_file(CACHE_NAME,file,filelen);
+    file[HDR_LEN + DATALEN/2] ^= 1;
+    put_file(CACHE_NAME,file,filelen);
+    check(__LINE__,refused(DATALEN),"changed byte accepted");
+
+    /*  Cut short, and with the header alone. */
+    file[HDR_LEN + DATALEN/2] ^= 1;
+    put_file(CACHE_NAME,file,filelen - 1);
+    check(__LINE__,refused(DATALEN),"short file accepted");
+    check(__LINE__,refused(DATALEN-1),
+        "short file accepted at its length");
+    put_file(CACHE_NAME,file,HDR_LEN);
+    check(__LINE__,refused(0),"header of a longer file accepted");
+
+    /*  The headerless form of earlier releases. */
+    put_file(CACHE_NAME,data,DATALEN);
+    check(__LINE__,refused(DATALEN),"headerless file accepted");
+
+    /*  An empty section. */
+    res = _dwarf_write_decompress_cache(CACHE_NAME,data,0);
+    check(__LINE__,res == DW_DLV_OK,"empty write failed");
+    check(__LINE__,reads_back(data,0),"empty section refused");
+    check(__LINE__,refused(1),"empty section read as one byte");
+
+    /*  The old fixed temporary name is never used. */
+    put_file(OLDTMP_NAME,(const unsigned char *)"keep",4);
+    res = _dwarf_write_decompress_cache(CACHE_NAME,data,DATALEN);
+    check(__LINE__,res == DW_DLV_OK,"write beside .tmp failed");
+    check(__LINE__,get_file(OLDTMP_NAME,file,5) == 4 &&
+        !memcmp(file,"keep",4),".tmp file was touched");
+
+#if !defined(_WIN32) && defined(HAVE_UNISTD_H)
+    /*  A link in place of the cache file: reading must
+        not follow it and writing must replace the link,
+        leaving its target alone. */
+    remove(CACHE_NAME);
+    res = _dwarf_write_decompress_cache(OTHER_NAME,data,DATALEN);
+    check(__LINE__,res == DW_DLV_OK,"write of link target failed");
+    if (symlink(OTHER_NAME,CACHE_NAME)) {
+        printf("FAIL cannot make a symbolic link\n");
+        ++failcount;
+    } else {
+        check(__LINE__,refused(DATALEN),"followed a link");
+        res = _dwarf_write_decompress_cache(CACHE_NAME,data,10);
+        check(__LINE__,res == DW_DLV_OK,"write over link failed");
+        check(__LINE__,reads_back(data,10),
+            "link not replaced by the cache file");
+        check(__LINE__,get_file(OTHER_NAME,file,
+            DATALEN + HDR_LEN + 1) == DATALEN + HDR_LEN,
+            "wrote through the link");
+    }
+#endif /* !_WIN32 && HAVE_UNISTD_H */
+
+    remove(CACHE_NAME);
+    remove(OTHER_NAME);
+    remove(OLDTMP_NAME);
+    free(data);
+    free(file);
+    if (failcount) {
+        printf("FAIL test_decompress_cache.c %d failures\n",
+            failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_decompress_cache.c\n");
+    return 0;
+}
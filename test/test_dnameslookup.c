@@ -0,0 +1,304 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Usage:  ./test_dnameslookup -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    Every name of every .debug_names table must be
+    found by dwarf_dnames_lookup() with the same
+    name index and entrypool offset dwarf_dnames_name()
+    reports.  Names not present, including the same
+    names in upper case (same hash bucket), must give
+    DW_DLV_NO_ENTRY.  The entry for "main" is
+    followed to its DIE. */
+
+#include <config.h>
+
+#include <ctype.h>  /* toupper() */
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+#define NAMELEN 200
+#define MAXPAIRS 10
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobjects[] = {
+"/test/debugnamesDW5.testme",
+0
+};
+
+static int failcount;
+
+static void
+check_not_found(Dwarf_Dnames_Head dn, const char *name,
+    const char *path)
+{
+    Dwarf_Unsigned index = 0;
+    int res = 0;
+
+    res = dwarf_dnames_lookup(dn,name,&index,0,0);
+    if (res != DW_DLV_NO_ENTRY) {
+        printf("FAIL %s found \"%s\" res %d index %lu\n",
+            path,name,res,(unsigned long)index);
+        ++failcount;
+    }
+}
+
+static void
+check_main_die(Dwarf_Debug dbg, Dwarf_Dnames_Head dn,
+    const char *path)
+{
+    Dwarf_Unsigned pooloff = 0;
+    Dwarf_Unsigned abbrev_code = 0;
+    Dwarf_Half tag = 0;
+    Dwarf_Unsigned value_count = 0;
+    Dwarf_Unsigned index_of_abbrev = 0;
+    Dwarf_Unsigned valoff = 0;
+    Dwarf_Half idx[MAXPAIRS];
+    Dwarf_Half form[MAXPAIRS];
+    Dwarf_Unsigned offsets[MAXPAIRS];
+    Dwarf_Sig8 sigs[MAXPAIRS];
+    Dwarf_Bool single_cu = FALSE;
+    Dwarf_Unsigned cuoff = 0;
+    Dwarf_Unsigned next = 0;
+    Dwarf_Die die = 0;
+    char *diename = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_dnames_lookup(dn,"main",0,&pooloff,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s no main res %d\n",path,res);
+        ++failcount;
+        return;
+    }
+    res = dwarf_dnames_entrypool(dn,pooloff,&abbrev_code,&tag,
+        &value_count,&index_of_abbrev,&valoff,0);
+    if (res != DW_DLV_OK || tag != DW_TAG_subprogram ||
+        value_count > MAXPAIRS) {
+        printf("FAIL %s main entrypool res %d tag 0x%x\n",
+            path,res,tag);
+        ++failcount;
+        return;
+    }
+    res = dwarf_dnames_entrypool_values(dn,index_of_abbrev,
+        valoff,MAXPAIRS,idx,form,offsets,sigs,
+        &single_cu,&cuoff,&next,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s main entrypool values res %d\n",
+            path,res);
+        ++failcount;
+        return;
+    }
+    for (i = 0; i < value_count; ++i) {
+        if (idx[i] == DW_IDX_die_offset) {
+            break;
+        }
+    }
+    if (i >= value_count) {
+        printf("FAIL %s main has no DW_IDX_die_offset\n",path);
+        ++failcount;
+        return;
+    }
+    res = dwarf_offdie_b(dbg,cuoff+offsets[i],TRUE,&die,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s main DIE res %d\n",path,res);
+        ++failcount;
+        return;
+    }
+    res = dwarf_diename(die,&diename,0);
+    if (res != DW_DLV_OK || strcmp(diename,"main")) {
+        printf("FAIL %s main DIE has the wrong name\n",path);
+        ++failcount;
+    }
+    dwarf_dealloc_die(die);
+}
+
+static int
+check_table(Dwarf_Dnames_Head dn, const char *path)
+{
+    Dwarf_Unsigned cu_count = 0;
+    Dwarf_Unsigned tu_count = 0;
+    Dwarf_Unsigned ftu_count = 0;
+    Dwarf_Unsigned bucket_count = 0;
+    Dwarf_Unsigned name_count = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_dnames_sizes(dn,&cu_count,&tu_count,&ftu_count,
+        &bucket_count,&name_count,0,0,0,0,0,0,0,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s dwarf_dnames_sizes res %d\n",path,res);
+        ++failcount;
+        return 0;
+    }
+    for (i = 1; i <= name_count; ++i) {
+        Dwarf_Unsigned bucket = 0;
+        Dwarf_Unsigned hash = 0;
+        Dwarf_Unsigned stroff = 0;
+        char *str = 0;
+        Dwarf_Unsigned pooloff = 0;
+        Dwarf_Unsigned found_index = 0;
+        Dwarf_Unsigned found_pooloff = 0;
+        Dwarf_Unsigned code = 0;
+        Dwarf_Half tag = 0;
+        Dwarf_Unsigned attrcount = 0;
+        Dwarf_Half idx[MAXPAIRS];
+        Dwarf_Half form[MAXPAIRS];
+        char upper[NAMELEN];
+        size_t len = 0;
+        size_t k = 0;
+
+        res = dwarf_dnames_name(dn,i,&bucket,&hash,&stroff,
+            &str,&pooloff,&code,&tag,MAXPAIRS,idx,form,
+            &attrcount,0);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s dwarf_dnames_name %lu res %d\n",
+                path,(unsigned long)i,res);
+            ++failcount;
+            continue;
+        }
+        res = dwarf_dnames_lookup(dn,str,&found_index,
+            &found_pooloff,0);
+        if (res != DW_DLV_OK || found_index != i ||
+            found_pooloff != pooloff) {
+            printf("FAIL %s lookup \"%s\" res %d index %lu"
+                " expected %lu\n",path,str,res,
+                (unsigned long)found_index,(unsigned long)i);
+            ++failcount;
+        }
+        len = strlen(str);
+        if (len >= NAMELEN) {
+            continue;
+        }
+        for (k = 0; k <= len; ++k) {
+            upper[k] = (char)toupper((unsigned char)str[k]);
+        }
+        if (strcmp(upper,str)) {
+            check_not_found(dn,upper,path);
+        }
+    }
+    check_not_found(dn,"",path);
+    check_not_found(dn,"no_such_name",path);
+    check_not_found(dn,"mai",path);
+    check_not_found(dn,"mainx",path);
+    return (int)name_count;
+}
+
+static int
+check_object(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Unsigned offset = 0;
+    int checked = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    for (;;) {
+        Dwarf_Dnames_Head dn = 0;
+        Dwarf_Unsigned next = 0;
+
+        res = dwarf_dnames_header(dbg,offset,&dn,&next,0);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        checked += check_table(dn,path);
+        if (!offset) {
+            check_main_die(dbg,dn,path);
+        }
+        dwarf_dealloc_dnames(dn);
+        offset = next;
+    }
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL %s reading .debug_names\n",path);
+        ++failcount;
+    }
+    dwarf_finish(dbg);
+    return checked;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    int checked = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        size_t blen = strlen(base);
+        size_t tlen = strlen(testobjects[i]);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_dnameslookup: %s\n",
+                base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i],tlen+1);
+        checked += check_object(path);
+    }
+    if (!checked) {
+        printf("FAIL test_dnameslookup checked no names\n");
+        ++failcount;
+    }
+    if (failcount) {
+        printf("FAIL test_dnameslookup %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_dnameslookup %d names\n",checked);
+    return 0;
+}
@@ -31,6 +31,8 @@
 
 #include <stddef.h> /* size_t */
 #include <stdio.h>  /* printf() */
+#include <string.h> /* memcpy() strcmp() */
+#include <time.h>   /* clock() */
 
 #include "libdwarf.h"
 #include "libdwarf_private.h"
@@ -927,12 +929,249 @@ testatmaxlimit(void)
     return errcnt;
 }
 
-int main(void)
+#define BULKBUFLEN 4096
+#define BULKMAXVALS 512
+
+/*  Concatenate the encodings of the test values
+    (and some hand-built special ones) and check
+    that the bulk decoders return exactly what the
+    single-value decoders return, value by value. */
+static unsigned
+ubulkfill(unsigned char *buf, unsigned *countout)
+{
+    unsigned ulen = sizeof(utest)/sizeof(Dwarf_Unsigned);
+    unsigned t = 0;
+    unsigned used = 0;
+    unsigned count = 0;
+
+    for (t = 0; t < 300; t += 7) {
+        int encodelen = 0;
+
+        dwarf_encode_leb128(t,&encodelen,(char *)buf+used,
+            BULKBUFLEN-used);
+        used += encodelen;
+        ++count;
+    }
+    for (t = 0; t < ulen; ++t) {
+        int encodelen = 0;
+
+        dwarf_encode_leb128(utest[t],&encodelen,
+            (char *)buf+used, BULKBUFLEN-used);
+        used += encodelen;
+        ++count;
+    }
+    memcpy(buf+used,v62,sizeof(v62));
+    used += sizeof(v62);
+    memcpy(buf+used,v64,sizeof(v64));
+    used += sizeof(v64);
+    /*  Padding is only accepted at the very end. */
+    memcpy(buf+used,v7b,sizeof(v7b));
+    used += sizeof(v7b);
+    count += 3;
+    *countout = count;
+    return used;
+}
+
+static unsigned
+sbulkfill(unsigned char *buf, unsigned *countout)
+{
+    unsigned slen = sizeof(stest)/sizeof(Dwarf_Signed);
+    unsigned t = 0;
+    unsigned used = 0;
+    unsigned count = 0;
+    Dwarf_Signed v = 0;
+
+    for (v = -300; v < 300; v += 7) {
+        int encodelen = 0;
+
+        dwarf_encode_signed_leb128(v,&encodelen,
+            (char *)buf+used, BULKBUFLEN-used);
+        used += encodelen;
+        ++count;
+    }
+    for (t = 0; t < slen; ++t) {
+        int encodelen = 0;
+
+        dwarf_encode_signed_leb128(stest[t],&encodelen,
+            (char *)buf+used, BULKBUFLEN-used);
+        used += encodelen;
+        ++count;
+    }
+    memcpy(buf+used,v63s,sizeof(v63s));
+    used += sizeof(v63s);
+    memcpy(buf+used,v64s,sizeof(v64s));
+    used += sizeof(v64s);
+    memcpy(buf+used,negv7b,sizeof(negv7b));
+    used += sizeof(negv7b);
+    count += 3;
+    *countout = count;
+    return used;
+}
+
+static unsigned
+bulktests(void)
+{
+    unsigned errcnt = 0;
+    unsigned char buf[BULKBUFLEN];
+    Dwarf_Unsigned uvals[BULKMAXVALS];
+    Dwarf_Signed svals[BULKMAXVALS];
+    unsigned used = 0;
+    unsigned count = 0;
+    unsigned t = 0;
+    unsigned off = 0;
+    Dwarf_Unsigned bulklen = 0;
+    int res = 0;
+
+    used = ubulkfill(buf,&count);
+    /*  endptr is exactly the end of the data so the
+        last values take the byte-at-a-time path. */
+    res = dwarf_decode_leb128_bulk((char *)buf,count,uvals,
+        &bulklen,(char *)buf+used);
+    if (res != DW_DLV_OK || bulklen != used) {
+        printf("FAIL unsigned bulk decode res %d len %u "
+            "vs expected %u line:%d\n",
+            res,(unsigned)bulklen,used,__LINE__);
+        ++errcnt;
+    }
+    for (t = 0, off = 0; t < count; ++t) {
+        Dwarf_Unsigned len = 0;
+        Dwarf_Unsigned val = 0;
+
+        res = dwarf_decode_leb128((char *)buf+off,&len,&val,
+            (char *)buf+used);
+        if (res != DW_DLV_OK || val != uvals[t]) {
+            printf("FAIL unsigned bulk decode index %u "
+                "got 0x%llx vs expected 0x%llx line:%d\n",
+                t,uvals[t],val,__LINE__);
+            ++errcnt;
+        }
+        off += (unsigned)len;
+    }
+    /*  Cutting off the last byte leaves the last value
+        unterminated, an error as for dwarf_decode_leb128(). */
+    res = dwarf_decode_leb128_bulk((char *)buf,count,uvals,
+        &bulklen,(char *)buf+used-1);
+    if (res != DW_DLV_ERROR) {
+        printf("FAIL unsigned bulk decode of truncated data "
+            "expected DW_DLV_ERROR line:%d\n",__LINE__);
+        ++errcnt;
+    }
+
+    used = sbulkfill(buf,&count);
+    res = dwarf_decode_signed_leb128_bulk((char *)buf,count,
+        svals, &bulklen,(char *)buf+used);
+    if (res != DW_DLV_OK || bulklen != used) {
+        printf("FAIL signed bulk decode res %d len %u "
+            "vs expected %u line:%d\n",
+            res,(unsigned)bulklen,used,__LINE__);
+        ++errcnt;
+    }
+    for (t = 0, off = 0; t < count; ++t) {
+        Dwarf_Unsigned len = 0;
+        Dwarf_Signed val = 0;
+
+        res = dwarf_decode_signed_leb128((char *)buf+off,&len,
+            &val, (char *)buf+used);
+        if (res != DW_DLV_OK || val != svals[t]) {
+            printf("FAIL signed bulk decode index %u "
+                "got 0x%llx vs expected 0x%llx line:%d\n",
+                t,svals[t],val,__LINE__);
+            ++errcnt;
+        }
+        off += (unsigned)len;
+    }
+    res = dwarf_decode_signed_leb128_bulk((char *)buf,count,
+        svals, &bulklen,(char *)buf+used-1);
+    if (res != DW_DLV_ERROR) {
+        printf("FAIL signed bulk decode of truncated data "
+            "expected DW_DLV_ERROR line:%d\n",__LINE__);
+        ++errcnt;
+    }
+    return errcnt;
+}
+
+/*  With -b, time the single-value decoder against
+    the bulk decoder, first on the encoded test
+    values (mostly long) then on a spread of
+    lengths from 1 to 8 bytes.
+    Not run by make check. */
+#define BENCHREPEAT 200000
+static void
+benchone(const char *name, unsigned char *buf,
+    unsigned used, unsigned count)
+{
+    Dwarf_Unsigned vals[BULKMAXVALS];
+    Dwarf_Unsigned sum = 0;
+    Dwarf_Unsigned bulklen = 0;
+    unsigned r = 0;
+    clock_t start = 0;
+    double scalar = 0.0;
+    double bulk = 0.0;
+
+    start = clock();
+    for (r = 0; r < BENCHREPEAT; ++r) {
+        unsigned t = 0;
+        char *cur = (char *)buf;
+
+        for (t = 0; t < count; ++t) {
+            Dwarf_Unsigned len = 0;
+
+            dwarf_decode_leb128(cur,&len,&vals[t],
+                (char *)buf+used);
+            cur += len;
+        }
+        sum += vals[r%count];
+    }
+    scalar = (double)(clock() - start)/CLOCKS_PER_SEC;
+    start = clock();
+    for (r = 0; r < BENCHREPEAT; ++r) {
+        dwarf_decode_leb128_bulk((char *)buf,count,vals,
+            &bulklen,(char *)buf+used);
+        sum += vals[r%count];
+    }
+    bulk = (double)(clock() - start)/CLOCKS_PER_SEC;
+    printf("%s: %u values, %u bytes, %u repetitions\n",
+        name,count,used,BENCHREPEAT);
+    printf("  dwarf_decode_leb128      %8.3f s\n",scalar);
+    printf("  dwarf_decode_leb128_bulk %8.3f s\n",bulk);
+    printf("  checksum 0x%llx\n",sum);
+}
+
+static void
+benchmark(void)
+{
+    unsigned char buf[BULKBUFLEN];
+    unsigned used = 0;
+    unsigned count = 0;
+    Dwarf_Unsigned v = 1;
+
+    used = ubulkfill(buf,&count);
+    benchone("test values",buf,used,count);
+
+    used = 0;
+    for (count = 0; count < BULKMAXVALS; ++count) {
+        int encodelen = 0;
+
+        /*  1 to 8 byte encodings, in turn. */
+        dwarf_encode_leb128(v & ((((Dwarf_Unsigned)1) <<
+            ((count%8 +1)*7)) -1),
+            &encodelen,(char *)buf+used,BULKBUFLEN-used);
+        used += encodelen;
+        v = v*6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    benchone("1 to 8 byte values",buf,used,count);
+}
+
+int main(int argc, char **argv)
 {
     unsigned slen = sizeof(stest)/sizeof(Dwarf_Signed);
     unsigned ulen = sizeof(utest)/sizeof(Dwarf_Unsigned);
     int errs = 0;
 
+    if (argc > 1 && !strcmp(argv[1],"-b")) {
+        benchmark();
+        return 0;
+    }
     printinteresting();
     errs += signedtest(slen);
 
@@ -942,6 +1181,8 @@ int main(void)
 
     errs += testatmaxlimit();
 
+    errs += bulktests();
+
     if (errs) {
         printf("FAIL. leb encode/decode errors\n");
         return 1;
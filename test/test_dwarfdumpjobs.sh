@@ -0,0 +1,80 @@
+#!/bin/sh
+# Copyright (C) 2026 David Anderson
+# This script is hereby placed in the Public Domain
+# for anyone to use in any way for any purpose.
+#
+# Checks that dwarfdump --jobs=<n> prints exactly what
+# a serial run prints, including the merged compiler,
+# attr/form, tag-usage and macro summaries, and the
+# serial fallback after a worker hits corrupt DWARF.
+#
+# To call this:
+# Either set arg1 to the top source dir
+# or set env var DWTOPSRCDIR to the top source dir.
+# With meson add arg2 ninja.
+if [ $# -gt 0  ]
+then
+  t="$1"
+  y="$2"
+else
+  if [ x$DWTOPSRCDIR = "x" ]
+  then
+    t=`pwd`/..
+  else
+    t=$DWTOPSRCDIR
+  fi
+fi
+. $t/test/test_dwarfdumpsetup.sh $t $y
+# Other tests share the build directory and its
+# dwarfdump.conf, so run in a directory of our own
+# with our own copy of dwarfdump.conf.
+testbin=`mktemp -d` || exit 1
+trap 'rm -rf $testbin' 0
+cp "$top_srcdir/src/bin/dwarfdump/dwarfdump.conf" $testbin || exit 1
+cd $testbin
+serial=$testbin/junk.jobsserial
+jobs=$testbin/junk.jobsjobs
+fails=0
+
+# manydiesDW5.testme has CUs big enough that a worker
+# other than the first does the -ka checks that are
+# limited to the first so many DIEs.
+# dwpindexDW4.dwp has split CUs with no .debug_addr.
+# Every checking option is run on its own too, as
+# a glflags member a worker changes but the parent
+# does not merge shows up here (see job_fields in
+# dd_parallel.c).
+for f in manydiesDW5.testme macrosDW5.testme \
+  abbrevshareDW4.testme typeunitsDW4.testme \
+  gdbindexLE64.testme debugframeDW4.testme \
+  corruptinfoDW4.testme dwpindexDW4.dwp
+do
+  for o in "-ka" "-ka -kd" "-ka -P" "-kE" "-ku" "-kuf" \
+    "-kd -P" "-kw -ki" "-kF -ki" "-kr" \
+    "-kb" "-kM" "-kD" "-kn" "-kc" "-kF" "-kR" "-kx" \
+    "-kxe" "-kf" "-kg" "-kl" "-kw" "-ke" "-km" "-kS" \
+    "-kd" "-ks" "-ki" "-kt" "-ky" "-kG" "-ku" \
+    "-ka --check-functions"
+  do
+    # The program name starts error lines, so the
+    # same $dd is used for both runs.
+    $dd $o $srcdir/$f >$serial 2>&1
+    for n in 2 3
+    do
+      $dd $o --jobs=$n $srcdir/$f >$jobs 2>&1
+      if ! cmp $serial $jobs >/dev/null
+      then
+        echo "FAIL $o --jobs=$n $f differs from serial"
+        diff $serial $jobs | head -n 10
+        fails=`expr $fails + 1`
+      fi
+    done
+  done
+done
+if [ $fails -ne 0 ]
+then
+  echo "FAIL test_dwarfdumpjobs.sh $fails failures"
+  exit 1
+fi
+echo "PASS test_dwarfdumpjobs.sh"
+exit 0
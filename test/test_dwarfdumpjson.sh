@@ -0,0 +1,109 @@
+#!/bin/sh
+# Copyright (C) 2026 David Anderson
+# This script is hereby placed in the Public Domain
+# for anyone to use in any way for any purpose.
+#
+# Checks that dwarfdump --format-json writes only
+# JSON records to stdout, with error messages going
+# to stderr, also with --jobs.
+#
+# To call this:
+# Either set arg1 to the top source dir
+# or set env var DWTOPSRCDIR to the top source dir.
+# With meson add arg2 ninja.
+if [ $# -gt 0  ]
+then
+  t="$1"
+  y="$2"
+else
+  if [ x$DWTOPSRCDIR = "x" ]
+  then
+    t=`pwd`/..
+  else
+    t=$DWTOPSRCDIR
+  fi
+fi
+. $t/test/test_dwarfdumpsetup.sh $t $y
+# Other tests share the build directory and its
+# dwarfdump.conf, so run in a directory of our own
+# with our own copy of dwarfdump.conf.
+testbin=`mktemp -d` || exit 1
+trap 'rm -rf $testbin' 0
+cp "$top_srcdir/src/bin/dwarfdump/dwarfdump.conf" $testbin || exit 1
+cd $testbin
+out=$testbin/junk.jsonout
+err=$testbin/junk.jsonerr
+out2=$testbin/junk.jsonout2
+fails=0
+
+checkjson() {
+  f=$1
+  expecterr=$2
+  shift 2
+  rm -f $out $err
+  $dd --format-json "$@" $f >$out 2>$err
+  if grep -v '^{' $out >/dev/null
+  then
+    echo "FAIL --format-json $* $f: text among the records"
+    grep -v '^{' $out | head -n 5
+    fails=`expr $fails + 1`
+  fi
+  if [ $expecterr = y ]
+  then
+    if ! grep ERROR $err >/dev/null
+    then
+      echo "FAIL --format-json $* $f: no ERROR on stderr"
+      fails=`expr $fails + 1`
+    fi
+  elif [ -s $err ]
+  then
+    echo "FAIL --format-json $* $f: unexpected stderr"
+    head -n 5 $err
+    fails=`expr $fails + 1`
+  fi
+  if python3 -c "" 2>/dev/null
+  then
+    python3 -c "
+import json,sys
+for n,l in enumerate(open(sys.argv[1],'rb')):
+    try:
+        json.loads(l)
+    except ValueError:
+        print('FAIL record',n+1,'of',sys.argv[1],'is not JSON')
+        sys.exit(1)
+" $out
+    if [ $? -ne 0 ]
+    then
+      fails=`expr $fails + 1`
+    fi
+  fi
+  $dd --format-json --jobs=3 "$@" $f >$out2 2>/dev/null
+  if ! cmp $out $out2 >/dev/null
+  then
+    echo "FAIL --format-json --jobs=3 $* $f differs from serial"
+    fails=`expr $fails + 1`
+  fi
+}
+
+checkjson $srcdir/typeunitsDW5.testme n
+checkjson $srcdir/abbrevshareDW4.testme n -i
+checkjson $srcdir/testuriLE64ELf.testme n -l
+# A bad abbreviation code in the third CU.
+checkjson $srcdir/corruptinfoDW4.testme y
+# With -O file= the records go to the file.
+rm -f $out $out2 $err
+$dd --format-json -O file=$out $srcdir/corruptinfoDW4.testme \
+  >$out2 2>$err
+if [ -s $out2 ] || grep -v '^{' $out >/dev/null || \
+  ! grep ERROR $err >/dev/null
+then
+  echo "FAIL --format-json -O file= corruptinfoDW4.testme"
+  fails=`expr $fails + 1`
+fi
+if [ $fails -ne 0 ]
+then
+  echo "FAIL test_dwarfdumpjson.sh $fails failures"
+  exit 1
+fi
+echo "PASS test_dwarfdumpjson.sh"
+exit 0
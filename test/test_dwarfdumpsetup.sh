@@ -54,7 +54,10 @@ fi
 # In addition the zero date for file time in line tables
 # prints differently for different time zones.
 textlim=700
-cp "$top_srcdir/src/bin/dwarfdump/dwarfdump.conf" .
+# Copied under a name of our own and renamed, so a test
+# running at the same time never reads a partial copy.
+cp "$top_srcdir/src/bin/dwarfdump/dwarfdump.conf" ./dwarfdump.conf.$$
+mv -f ./dwarfdump.conf.$$ ./dwarfdump.conf
 # detects Windows msys3 mingw executable
 if [ -f $top_blddir/src/bin/dwarfdump/.libs/dwarfdump.exe ]
 then
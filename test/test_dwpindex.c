@@ -0,0 +1,385 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Usage:  ./test_dwpindex -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    dwpindexDW4.dwp (see dwpindexbuild.py) is a split
+    DWARF4 package of 48 CUs and 96 type units.
+    Every signature in .debug_cu_index and
+    .debug_tu_index, found by scanning every hash slot,
+    must be found by dwarf_get_debugfission_for_key()
+    with the same row, and a signature one bit away
+    from any that is present must not be found.
+    Some entries must not be in their first hash slot,
+    so the probing is tested.
+    DWARF4 CUs have no signature in their header, so
+    reading the CUs finds their index rows by
+    .debug_info offset. Each must be the row the scan
+    found at that offset. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcmp() memcpy() memset() strcmp()
+    strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+#define MAXENTRIES 1000
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobject = "/test/dwpindexDW4.dwp";
+
+/*  One used hash slot, from a scan of the index. */
+struct entry_s {
+    Dwarf_Sig8     sig;
+    Dwarf_Unsigned row;
+    Dwarf_Unsigned slot;
+    /*  Of DW_SECT_INFO or DW_SECT_TYPES in row. */
+    Dwarf_Unsigned offset;
+};
+
+struct table_s {
+    const char    *type;
+    Dwarf_Unsigned slots;
+    Dwarf_Unsigned count;
+    struct entry_s entries[MAXENTRIES];
+};
+
+static struct table_s cutable;
+static struct table_s tutable;
+static int failcount;
+
+/*  The key as the hash sees it, read little-endian
+    like the object. */
+static Dwarf_Unsigned
+sig_key(Dwarf_Sig8 *sig)
+{
+    Dwarf_Unsigned key = 0;
+    int i = 0;
+
+    for (i = 7; i >= 0; --i) {
+        key = (key << 8) | (unsigned char)sig->signature[i];
+    }
+    return key;
+}
+
+static struct entry_s *
+scan_find_sig(struct table_s *t, Dwarf_Sig8 *sig)
+{
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < t->count; ++i) {
+        if (!memcmp(&t->entries[i].sig,sig,sizeof(*sig))) {
+            return &t->entries[i];
+        }
+    }
+    return 0;
+}
+
+static struct entry_s *
+scan_find_offset(struct table_s *t, Dwarf_Unsigned offset)
+{
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < t->count; ++i) {
+        if (t->entries[i].offset == offset) {
+            return &t->entries[i];
+        }
+    }
+    return 0;
+}
+
+/*  Fills in t from every slot of the index. */
+static void
+scan_table(Dwarf_Debug dbg, struct table_s *t, const char *type)
+{
+    Dwarf_Xu_Index_Header xuhdr = 0;
+    Dwarf_Unsigned version = 0;
+    Dwarf_Unsigned columns = 0;
+    Dwarf_Unsigned units = 0;
+    const char *secname = 0;
+    Dwarf_Unsigned col = 0;
+    Dwarf_Unsigned unitcol = 0;
+    int found_col = FALSE;
+    Dwarf_Unsigned s = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    t->type = type;
+    t->count = 0;
+    res = dwarf_get_xu_index_header(dbg,type,&xuhdr,&version,
+        &columns,&units,&t->slots,&secname,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL no %s index\n",type);
+        exit(EXIT_FAILURE);
+    }
+    for (col = 0; col < columns; ++col) {
+        Dwarf_Unsigned num = 0;
+        const char *name = 0;
+
+        res = dwarf_get_xu_section_names(xuhdr,col,&num,&name,&err);
+        if (res == DW_DLV_OK &&
+            (num == DW_SECT_INFO || num == DW_SECT_TYPES)) {
+            unitcol = col;
+            found_col = TRUE;
+        }
+    }
+    if (!found_col) {
+        printf("FAIL %s index has no unit column\n",type);
+        exit(EXIT_FAILURE);
+    }
+    for (s = 0; s < t->slots; ++s) {
+        struct entry_s *e = &t->entries[t->count];
+        Dwarf_Unsigned size = 0;
+
+        res = dwarf_get_xu_hash_entry(xuhdr,s,&e->sig,&e->row,&err);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s hash slot %lu\n",type,(unsigned long)s);
+            exit(EXIT_FAILURE);
+        }
+        if (!e->row) {
+            continue;
+        }
+        res = dwarf_get_xu_section_offset(xuhdr,e->row,unitcol,
+            &e->offset,&size,&err);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s row %lu offset\n",type,
+                (unsigned long)e->row);
+            exit(EXIT_FAILURE);
+        }
+        e->slot = s;
+        if (++t->count >= MAXENTRIES) {
+            printf("FAIL %s index too big for the test\n",type);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (t->count != units) {
+        printf("FAIL %s scan found %lu of %lu units\n",type,
+            (unsigned long)t->count,(unsigned long)units);
+        ++failcount;
+    }
+    dwarf_dealloc_xu_header(xuhdr);
+}
+
+static void
+check_keys(Dwarf_Debug dbg, struct table_s *t)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned displaced = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    for (i = 0; i < t->count; ++i) {
+        struct entry_s *e = &t->entries[i];
+        Dwarf_Debug_Fission_Per_CU percu;
+        int bit = 0;
+
+        if ((sig_key(&e->sig) & (t->slots-1)) != e->slot) {
+            ++displaced;
+        }
+        memset(&percu,0,sizeof(percu));
+        res = dwarf_get_debugfission_for_key(dbg,&e->sig,t->type,
+            &percu,&err);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s key in slot %lu not found\n",t->type,
+                (unsigned long)e->slot);
+            ++failcount;
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,err);
+            }
+            continue;
+        }
+        if (percu.pcu_index != e->row ||
+            memcmp(&percu.pcu_hash,&e->sig,sizeof(e->sig)) ||
+            (percu.pcu_offset[DW_SECT_INFO] != e->offset &&
+            percu.pcu_offset[DW_SECT_TYPES] != e->offset)) {
+            printf("FAIL %s key in slot %lu gave row %lu not %lu\n",
+                t->type,(unsigned long)e->slot,
+                (unsigned long)percu.pcu_index,
+                (unsigned long)e->row);
+            ++failcount;
+        }
+        /*  Near misses, in the low bits (the first
+            slot) and high bits (the probe step). */
+        for (bit = 0; bit < 64; bit += 3) {
+            Dwarf_Sig8 miss = e->sig;
+
+            miss.signature[bit/8] ^= (char)(1 << (bit%8));
+            if (scan_find_sig(t,&miss)) {
+                continue;
+            }
+            res = dwarf_get_debugfission_for_key(dbg,&miss,t->type,
+                &percu,&err);
+            if (res != DW_DLV_NO_ENTRY) {
+                printf("FAIL %s absent key near slot %lu found\n",
+                    t->type,(unsigned long)e->slot);
+                ++failcount;
+                if (res == DW_DLV_ERROR) {
+                    dwarf_dealloc_error(dbg,err);
+                }
+            }
+        }
+    }
+    if (!displaced) {
+        printf("FAIL %s index has no probed entries, "
+            "it tests nothing\n",t->type);
+        ++failcount;
+    }
+}
+
+/*  Reading a unit looks up its index row, by
+    offset for a DWARF4 CU and by signature for
+    a type unit. */
+static void
+check_units(Dwarf_Debug dbg, Dwarf_Bool is_info, struct table_s *t)
+{
+    Dwarf_Unsigned hdroff = 0;
+    Dwarf_Unsigned units = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Unsigned next = 0;
+        Dwarf_Sig8 sig;
+        Dwarf_Debug_Fission_Per_CU percu;
+        struct entry_s *e = 0;
+
+        memset(&sig,0,sizeof(sig));
+        res = dwarf_next_cu_header_e(dbg,is_info,&cudie,
+            0,0,0,0,0,0,&sig,0,&next,0,&err);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s unit at 0x%lx: %s\n",t->type,
+                (unsigned long)hdroff,dwarf_errmsg(err));
+            ++failcount;
+            dwarf_dealloc_error(dbg,err);
+            break;
+        }
+        ++units;
+        e = scan_find_offset(t,hdroff);
+        memset(&percu,0,sizeof(percu));
+        res = dwarf_get_debugfission_for_die(cudie,&percu,&err);
+        if (res != DW_DLV_OK || !e) {
+            printf("FAIL %s unit at 0x%lx has no index row\n",
+                t->type,(unsigned long)hdroff);
+            ++failcount;
+        } else if (percu.pcu_index != e->row ||
+            memcmp(&percu.pcu_hash,&e->sig,sizeof(e->sig))) {
+            printf("FAIL %s unit at 0x%lx row %lu not %lu\n",
+                t->type,(unsigned long)hdroff,
+                (unsigned long)percu.pcu_index,
+                (unsigned long)e->row);
+            ++failcount;
+        } else if (!is_info && memcmp(&sig,&e->sig,sizeof(sig))) {
+            printf("FAIL %s unit at 0x%lx signature differs\n",
+                t->type,(unsigned long)hdroff);
+            ++failcount;
+        }
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,err);
+        }
+        dwarf_dealloc_die(cudie);
+        hdroff = next;
+    }
+    if (units != t->count) {
+        printf("FAIL %s read %lu units, index has %lu\n",t->type,
+            (unsigned long)units,(unsigned long)t->count);
+        ++failcount;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    size_t blen = 0;
+    size_t tlen = 0;
+    int res = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    blen = strlen(base);
+    tlen = strlen(testobject);
+    if ((blen + tlen + 1) > PATHLEN) {
+        printf("FAIL path too long for test_dwpindex: %s\n",
+            base);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(path,base,blen);
+    memcpy(path+blen,testobject,tlen+1);
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    scan_table(dbg,&cutable,"cu");
+    scan_table(dbg,&tutable,"tu");
+    /*  Units first, so their lookups are the first
+        ones made on the index. */
+    check_units(dbg,TRUE,&cutable);
+    check_units(dbg,FALSE,&tutable);
+    check_keys(dbg,&cutable);
+    check_keys(dbg,&tutable);
+    dwarf_finish(dbg);
+    if (failcount) {
+        printf("FAIL test_dwpindex %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_dwpindex %lu CUs %lu TUs\n",
+        (unsigned long)cutable.count,
+        (unsigned long)tutable.count);
+    return 0;
+}
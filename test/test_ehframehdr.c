@@ -0,0 +1,281 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/*  Usage:  ./test_ehframehdr -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    For the first and last address of every .eh_frame
+    FDE, dwarf_get_fde_at_pc_eh_hdr() must find an FDE
+    with the same range, instructions and register
+    rules as dwarf_get_fde_list_eh() with
+    dwarf_get_fde_at_pc().  Addresses outside every
+    FDE, and objects without .eh_frame_hdr,
+    must give DW_DLV_NO_ENTRY. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* calloc() exit() free() getenv() */
+#include <string.h> /* memcmp() memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+#define REGCOUNT 100
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+struct testobject_s {
+    const char *path;
+    int has_eh_frame_hdr;
+};
+
+static struct testobject_s testobjects[] = {
+{"/test/dummyexecutable",TRUE},
+{"/test/testuriLE64ELf.testme",FALSE},
+{0,0}
+};
+
+static int failcount;
+
+static int
+same_rules(Dwarf_Regtable3 *t1, Dwarf_Regtable3 *t2)
+{
+    int i = 0;
+
+    if (memcmp(&t1->rt3_cfa_rule,&t2->rt3_cfa_rule,
+        sizeof(t1->rt3_cfa_rule))) {
+        return FALSE;
+    }
+    for (i = 0; i < REGCOUNT; ++i) {
+        if (memcmp(&t1->rt3_rules[i],&t2->rt3_rules[i],
+            sizeof(t1->rt3_rules[i]))) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void
+check_pc(Dwarf_Debug dbg, Dwarf_Fde *fdes, Dwarf_Addr pc,
+    Dwarf_Regtable3 *t1, Dwarf_Regtable3 *t2, const char *path)
+{
+    Dwarf_Fde fde1 = 0;
+    Dwarf_Fde fde2 = 0;
+    Dwarf_Addr lo1 = 0;
+    Dwarf_Addr hi1 = 0;
+    Dwarf_Addr lo2 = 0;
+    Dwarf_Addr hi2 = 0;
+    Dwarf_Small *instr1 = 0;
+    Dwarf_Small *instr2 = 0;
+    Dwarf_Unsigned len1 = 0;
+    Dwarf_Unsigned len2 = 0;
+    Dwarf_Error err = 0;
+    int res1 = 0;
+    int res2 = 0;
+
+    res1 = dwarf_get_fde_at_pc(fdes,pc,&fde1,&lo1,&hi1,&err);
+    res2 = dwarf_get_fde_at_pc_eh_hdr(dbg,pc,&fde2,&lo2,&hi2,&err);
+    if (res1 != res2) {
+        printf("FAIL %s pc 0x%llx res %d vs %d\n",path,
+            (unsigned long long)pc,res1,res2);
+        ++failcount;
+        if (res2 == DW_DLV_OK) {
+            dwarf_dealloc(dbg,fde2,DW_DLA_FDE);
+        }
+        return;
+    }
+    if (res1 != DW_DLV_OK) {
+        return;
+    }
+    if (lo1 != lo2 || hi1 != hi2) {
+        printf("FAIL %s pc 0x%llx range 0x%llx-0x%llx vs "
+            "0x%llx-0x%llx\n",path,(unsigned long long)pc,
+            (unsigned long long)lo1,(unsigned long long)hi1,
+            (unsigned long long)lo2,(unsigned long long)hi2);
+        ++failcount;
+    }
+    if (dwarf_get_fde_instr_bytes(fde1,&instr1,&len1,&err) !=
+        DW_DLV_OK ||
+        dwarf_get_fde_instr_bytes(fde2,&instr2,&len2,&err) !=
+        DW_DLV_OK || instr1 != instr2 || len1 != len2) {
+        printf("FAIL %s pc 0x%llx instructions differ\n",path,
+            (unsigned long long)pc);
+        ++failcount;
+    }
+    res1 = dwarf_get_fde_info_for_all_regs3_b(fde1,pc,t1,
+        0,0,0,&err);
+    res2 = dwarf_get_fde_info_for_all_regs3_b(fde2,pc,t2,
+        0,0,0,&err);
+    if (res1 != res2 || (res1 == DW_DLV_OK &&
+        !same_rules(t1,t2))) {
+        printf("FAIL %s pc 0x%llx register rules differ\n",path,
+            (unsigned long long)pc);
+        ++failcount;
+    }
+    dwarf_dealloc(dbg,fde2,DW_DLA_FDE);
+}
+
+static int
+check_object(const char *path, int has_eh_frame_hdr)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Cie *cies = 0;
+    Dwarf_Fde *fdes = 0;
+    Dwarf_Signed ciecount = 0;
+    Dwarf_Signed fdecount = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Regtable3 t1;
+    Dwarf_Regtable3 t2;
+    Dwarf_Fde fde = 0;
+    Dwarf_Addr maxpc = 0;
+    int checked = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    res = dwarf_get_fde_at_pc_eh_hdr(dbg,0,&fde,0,0,0);
+    if (res == DW_DLV_OK) {
+        printf("FAIL %s found an FDE at pc 0\n",path);
+        ++failcount;
+        dwarf_dealloc(dbg,fde,DW_DLA_FDE);
+    }
+    res = dwarf_get_fde_list_eh(dbg,&cies,&ciecount,
+        &fdes,&fdecount,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s has no .eh_frame\n",path);
+        ++failcount;
+        dwarf_finish(dbg);
+        return 0;
+    }
+    if (!has_eh_frame_hdr) {
+        Dwarf_Addr lo = 0;
+        Dwarf_Unsigned len = 0;
+
+        dwarf_get_fde_range(fdes[0],&lo,&len,0,0,0,0,0,0);
+        res = dwarf_get_fde_at_pc_eh_hdr(dbg,lo,&fde,0,0,0);
+        if (res != DW_DLV_NO_ENTRY) {
+            printf("FAIL %s no .eh_frame_hdr but res %d\n",
+                path,res);
+            ++failcount;
+        }
+        dwarf_dealloc_fde_cie_list(dbg,cies,ciecount,
+            fdes,fdecount);
+        dwarf_finish(dbg);
+        return 0;
+    }
+    memset(&t1,0,sizeof(t1));
+    memset(&t2,0,sizeof(t2));
+    t1.rt3_reg_table_size = REGCOUNT;
+    t2.rt3_reg_table_size = REGCOUNT;
+    t1.rt3_rules = calloc(REGCOUNT,sizeof(Dwarf_Regtable_Entry3));
+    t2.rt3_rules = calloc(REGCOUNT,sizeof(Dwarf_Regtable_Entry3));
+    if (!t1.rt3_rules || !t2.rt3_rules) {
+        printf("FAIL out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < fdecount; ++i) {
+        Dwarf_Addr lo = 0;
+        Dwarf_Unsigned len = 0;
+
+        res = dwarf_get_fde_range(fdes[i],&lo,&len,0,0,0,0,0,0);
+        if (res != DW_DLV_OK || !len) {
+            continue;
+        }
+        check_pc(dbg,fdes,lo,&t1,&t2,path);
+        check_pc(dbg,fdes,lo+len-1,&t1,&t2,path);
+        check_pc(dbg,fdes,lo+len,&t1,&t2,path);
+        if (lo+len > maxpc) {
+            maxpc = lo+len;
+        }
+        ++checked;
+    }
+    check_pc(dbg,fdes,maxpc+0x1000,&t1,&t2,path);
+    free(t1.rt3_rules);
+    free(t2.rt3_rules);
+    dwarf_dealloc_fde_cie_list(dbg,cies,ciecount,fdes,fdecount);
+    dwarf_finish(dbg);
+    return checked;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    int checked = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i].path; ++i) {
+        size_t blen = strlen(base);
+        size_t tlen = strlen(testobjects[i].path);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_ehframehdr: %s\n",
+                base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i].path,tlen+1);
+        checked += check_object(path,
+            testobjects[i].has_eh_frame_hdr);
+    }
+    if (!checked) {
+        printf("FAIL test_ehframehdr checked no FDEs\n");
+        ++failcount;
+    }
+    if (failcount) {
+        printf("FAIL test_ehframehdr %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_ehframehdr %d FDEs\n",checked);
+    return 0;
+}
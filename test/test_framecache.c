@@ -0,0 +1,358 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/*  Usage:  ./test_framecache -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    Each test object is opened twice, once with
+    dwarf_set_frame_row_cache() on.  For the start of
+    every row of every FDE (in .eh_frame and
+    .debug_frame), for the address after it and for
+    the last address of the FDE, the register rules,
+    row pc and next row pc must be the same from both. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* calloc() exit() free() getenv() */
+#include <string.h> /* memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+#define REGCOUNT 100
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobjects[] = {
+"/test/testuriLE64ELf.testme",
+"/test/testobjLE32PE.exe",
+"/test/test-mach-o-32.dSYM",
+"/test/dummyexecutable",
+"/test/dummyexecutable.debug",
+0};
+
+static int failcount;
+
+static int
+same_entry(Dwarf_Regtable_Entry3 *a, Dwarf_Regtable_Entry3 *b)
+{
+    return a->dw_offset_relevant == b->dw_offset_relevant &&
+        a->dw_value_type == b->dw_value_type &&
+        a->dw_regnum == b->dw_regnum &&
+        a->dw_offset == b->dw_offset &&
+        a->dw_args_size == b->dw_args_size &&
+        a->dw_block.bl_len == b->dw_block.bl_len &&
+        (!a->dw_block.bl_len || !memcmp(a->dw_block.bl_data,
+        b->dw_block.bl_data,(size_t)a->dw_block.bl_len));
+}
+
+/*  Returns the result of the plain lookup so the
+    caller can walk the rows. */
+static int
+check_pc(Dwarf_Fde plain, Dwarf_Fde cached, Dwarf_Addr pc,
+    Dwarf_Regtable3 *t1, Dwarf_Regtable3 *t2,
+    Dwarf_Bool *has_more, Dwarf_Addr *next_pc,
+    const char *path)
+{
+    Dwarf_Addr row1 = 0;
+    Dwarf_Addr row2 = 0;
+    Dwarf_Bool more2 = FALSE;
+    Dwarf_Addr next2 = 0;
+    Dwarf_Error err = 0;
+    int res1 = 0;
+    int res2 = 0;
+    int i = 0;
+
+    res1 = dwarf_get_fde_info_for_all_regs3_b(plain,pc,t1,
+        &row1,has_more,next_pc,&err);
+    res2 = dwarf_get_fde_info_for_all_regs3_b(cached,pc,t2,
+        &row2,&more2,&next2,&err);
+    if (res1 != res2) {
+        printf("FAIL %s pc 0x%llx res %d vs %d\n",path,
+            (unsigned long long)pc,res1,res2);
+        ++failcount;
+        return DW_DLV_ERROR;
+    }
+    if (res1 != DW_DLV_OK) {
+        return res1;
+    }
+    if (row1 != row2 || *has_more != more2 ||
+        *next_pc != next2) {
+        printf("FAIL %s pc 0x%llx row 0x%llx vs 0x%llx "
+            "next 0x%llx vs 0x%llx\n",path,
+            (unsigned long long)pc,(unsigned long long)row1,
+            (unsigned long long)row2,(unsigned long long)*next_pc,
+            (unsigned long long)next2);
+        ++failcount;
+    }
+    if (!same_entry(&t1->rt3_cfa_rule,&t2->rt3_cfa_rule)) {
+        printf("FAIL %s pc 0x%llx cfa rule differs\n",path,
+            (unsigned long long)pc);
+        ++failcount;
+    }
+    for (i = 0; i < REGCOUNT; ++i) {
+        if (!same_entry(&t1->rt3_rules[i],&t2->rt3_rules[i])) {
+            printf("FAIL %s pc 0x%llx reg %d rule differs\n",
+                path,(unsigned long long)pc,i);
+            ++failcount;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  Single register and CFA lookups go through
+    the same rows. */
+static void
+check_reg(Dwarf_Fde plain, Dwarf_Fde cached, Dwarf_Addr pc,
+    Dwarf_Half col, const char *path)
+{
+    Dwarf_Small vt1 = 0;
+    Dwarf_Small vt2 = 0;
+    Dwarf_Unsigned or1 = 0;
+    Dwarf_Unsigned or2 = 0;
+    Dwarf_Unsigned reg1 = 0;
+    Dwarf_Unsigned reg2 = 0;
+    Dwarf_Signed off1 = 0;
+    Dwarf_Signed off2 = 0;
+    Dwarf_Addr row1 = 0;
+    Dwarf_Addr row2 = 0;
+    Dwarf_Error err = 0;
+    int res1 = 0;
+    int res2 = 0;
+
+    res1 = dwarf_get_fde_info_for_reg3_c(plain,col,pc,&vt1,&or1,
+        &reg1,&off1,0,&row1,0,0,&err);
+    res2 = dwarf_get_fde_info_for_reg3_c(cached,col,pc,&vt2,&or2,
+        &reg2,&off2,0,&row2,0,0,&err);
+    if (res1 != res2 || (res1 == DW_DLV_OK &&
+        (vt1 != vt2 || or1 != or2 || reg1 != reg2 ||
+        off1 != off2 || row1 != row2))) {
+        printf("FAIL %s pc 0x%llx reg %u differs\n",path,
+            (unsigned long long)pc,col);
+        ++failcount;
+    }
+    res1 = dwarf_get_fde_info_for_cfa_reg3_c(plain,pc,&vt1,&or1,
+        &reg1,&off1,0,&row1,0,0,&err);
+    res2 = dwarf_get_fde_info_for_cfa_reg3_c(cached,pc,&vt2,&or2,
+        &reg2,&off2,0,&row2,0,0,&err);
+    if (res1 != res2 || (res1 == DW_DLV_OK &&
+        (vt1 != vt2 || or1 != or2 || reg1 != reg2 ||
+        off1 != off2 || row1 != row2))) {
+        printf("FAIL %s pc 0x%llx cfa differs\n",path,
+            (unsigned long long)pc);
+        ++failcount;
+    }
+}
+
+/*  Returns the number of rows checked. */
+static int
+check_fde(Dwarf_Fde plain, Dwarf_Fde cached,
+    Dwarf_Regtable3 *t1, Dwarf_Regtable3 *t2, const char *path)
+{
+    Dwarf_Addr low = 0;
+    Dwarf_Unsigned len = 0;
+    Dwarf_Addr pc = 0;
+    Dwarf_Bool has_more = FALSE;
+    Dwarf_Addr next_pc = 0;
+    int rows = 0;
+    int res = 0;
+
+    res = dwarf_get_fde_range(plain,&low,&len,0,0,0,0,0,0);
+    if (res != DW_DLV_OK || !len) {
+        return 0;
+    }
+    pc = low;
+    for (;;) {
+        res = check_pc(plain,cached,pc,t1,t2,&has_more,
+            &next_pc,path);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        ++rows;
+        check_reg(plain,cached,pc,(Dwarf_Half)(rows%REGCOUNT),
+            path);
+        if (pc+1 < low+len) {
+            check_pc(plain,cached,pc+1,t1,t2,&has_more,
+                &next_pc,path);
+        }
+        if (!has_more || next_pc <= pc || next_pc >= low+len) {
+            break;
+        }
+        pc = next_pc;
+    }
+    check_pc(plain,cached,low+len-1,t1,t2,&has_more,&next_pc,
+        path);
+    return rows;
+}
+
+static int
+check_fde_list(Dwarf_Debug dbg1, Dwarf_Debug dbg2,
+    Dwarf_Bool is_eh, Dwarf_Regtable3 *t1, Dwarf_Regtable3 *t2,
+    const char *path)
+{
+    Dwarf_Cie *cies1 = 0;
+    Dwarf_Cie *cies2 = 0;
+    Dwarf_Fde *fdes1 = 0;
+    Dwarf_Fde *fdes2 = 0;
+    Dwarf_Signed ciecount1 = 0;
+    Dwarf_Signed ciecount2 = 0;
+    Dwarf_Signed fdecount1 = 0;
+    Dwarf_Signed fdecount2 = 0;
+    Dwarf_Signed i = 0;
+    int rows = 0;
+    int res1 = 0;
+    int res2 = 0;
+
+    if (is_eh) {
+        res1 = dwarf_get_fde_list_eh(dbg1,&cies1,&ciecount1,
+            &fdes1,&fdecount1,0);
+        res2 = dwarf_get_fde_list_eh(dbg2,&cies2,&ciecount2,
+            &fdes2,&fdecount2,0);
+    } else {
+        res1 = dwarf_get_fde_list(dbg1,&cies1,&ciecount1,
+            &fdes1,&fdecount1,0);
+        res2 = dwarf_get_fde_list(dbg2,&cies2,&ciecount2,
+            &fdes2,&fdecount2,0);
+    }
+    if (res1 != res2 || (res1 == DW_DLV_OK &&
+        fdecount1 != fdecount2)) {
+        printf("FAIL %s fde lists differ\n",path);
+        ++failcount;
+    } else if (res1 == DW_DLV_OK) {
+        for (i = 0; i < fdecount1; ++i) {
+            rows += check_fde(fdes1[i],fdes2[i],t1,t2,path);
+            /*  Asking again must come from the rows kept. */
+            check_fde(fdes1[i],fdes2[i],t1,t2,path);
+        }
+    }
+    if (res1 == DW_DLV_OK) {
+        dwarf_dealloc_fde_cie_list(dbg1,cies1,ciecount1,
+            fdes1,fdecount1);
+    }
+    if (res2 == DW_DLV_OK) {
+        dwarf_dealloc_fde_cie_list(dbg2,cies2,ciecount2,
+            fdes2,fdecount2);
+    }
+    return rows;
+}
+
+static int
+check_object(const char *path)
+{
+    Dwarf_Debug dbg1 = 0;
+    Dwarf_Debug dbg2 = 0;
+    Dwarf_Regtable3 t1;
+    Dwarf_Regtable3 t2;
+    int rows = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg1,0);
+    if (res == DW_DLV_OK) {
+        res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+            0,0,&dbg2,0);
+    }
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    if (dwarf_set_frame_row_cache(dbg2,TRUE) != 0) {
+        printf("FAIL %s frame row cache on by default\n",path);
+        ++failcount;
+    }
+    memset(&t1,0,sizeof(t1));
+    memset(&t2,0,sizeof(t2));
+    t1.rt3_reg_table_size = REGCOUNT;
+    t2.rt3_reg_table_size = REGCOUNT;
+    t1.rt3_rules = calloc(REGCOUNT,sizeof(Dwarf_Regtable_Entry3));
+    t2.rt3_rules = calloc(REGCOUNT,sizeof(Dwarf_Regtable_Entry3));
+    if (!t1.rt3_rules || !t2.rt3_rules) {
+        printf("FAIL out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    rows += check_fde_list(dbg1,dbg2,TRUE,&t1,&t2,path);
+    rows += check_fde_list(dbg1,dbg2,FALSE,&t1,&t2,path);
+    free(t1.rt3_rules);
+    free(t2.rt3_rules);
+    dwarf_finish(dbg1);
+    dwarf_finish(dbg2);
+    return rows;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    int rows = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        size_t blen = strlen(base);
+        size_t tlen = strlen(testobjects[i]);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_framecache: %s\n",
+                base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i],tlen+1);
+        rows += check_object(path);
+    }
+    if (!rows) {
+        printf("FAIL test_framecache found no frame rows\n");
+        ++failcount;
+    }
+    if (failcount) {
+        printf("FAIL test_framecache %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_framecache %d rows\n",rows);
+    return 0;
+}
@@ -0,0 +1,313 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/*  Usage:  ./test_frameiter -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    Walks .eh_frame and .debug_frame with
+    dwarf_next_frame_entry() and checks that it
+    visits the same CIEs and FDEs as
+    dwarf_get_fde_list_eh() and dwarf_get_fde_list(),
+    and that dwarf_get_fde_at_offset() creates each FDE
+    with the same range, CIE and instructions. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+struct testobject_s {
+    const char *path;
+    int has_debug_frame;
+};
+
+static struct testobject_s testobjects[] = {
+{"/test/dummyexecutable",FALSE},
+{"/test/testuriLE64ELf.testme",FALSE},
+{"/test/debugframeDW4.testme",TRUE},
+{0,0}
+};
+
+static int failcount;
+
+static Dwarf_Fde
+find_listed_fde(Dwarf_Debug dbg, Dwarf_Fde *fdes,
+    Dwarf_Signed fdecount, Dwarf_Unsigned offset)
+{
+    Dwarf_Signed i = 0;
+
+    for (i = 0; i < fdecount; ++i) {
+        Dwarf_Off fde_off = 0;
+        Dwarf_Off cie_off = 0;
+
+        if (dwarf_fde_section_offset(dbg,fdes[i],&fde_off,
+            &cie_off,0) == DW_DLV_OK && fde_off == offset) {
+            return fdes[i];
+        }
+    }
+    return 0;
+}
+
+static void
+compare_fde(Dwarf_Debug dbg, Dwarf_Fde listed, Dwarf_Fde fde,
+    Dwarf_Unsigned cie_offset, const char *path,
+    const char *secname, Dwarf_Unsigned offset)
+{
+    Dwarf_Addr lo1 = 0;
+    Dwarf_Addr lo2 = 0;
+    Dwarf_Unsigned len1 = 0;
+    Dwarf_Unsigned len2 = 0;
+    Dwarf_Small *instr1 = 0;
+    Dwarf_Small *instr2 = 0;
+    Dwarf_Unsigned ilen1 = 0;
+    Dwarf_Unsigned ilen2 = 0;
+    Dwarf_Off fde_off = 0;
+    Dwarf_Off cie_off = 0;
+    Dwarf_Cie cie = 0;
+
+    if (dwarf_get_fde_range(listed,&lo1,&len1,0,0,0,0,0,0) !=
+        DW_DLV_OK ||
+        dwarf_get_fde_range(fde,&lo2,&len2,0,0,0,0,0,0) !=
+        DW_DLV_OK || lo1 != lo2 || len1 != len2) {
+        printf("FAIL %s %s fde 0x%llx range differs\n",path,
+            secname,(unsigned long long)offset);
+        ++failcount;
+    }
+    if (dwarf_get_fde_instr_bytes(listed,&instr1,&ilen1,0) !=
+        DW_DLV_OK ||
+        dwarf_get_fde_instr_bytes(fde,&instr2,&ilen2,0) !=
+        DW_DLV_OK || instr1 != instr2 || ilen1 != ilen2) {
+        printf("FAIL %s %s fde 0x%llx instructions differ\n",
+            path,secname,(unsigned long long)offset);
+        ++failcount;
+    }
+    if (dwarf_fde_section_offset(dbg,fde,&fde_off,&cie_off,0) !=
+        DW_DLV_OK ||
+        dwarf_get_cie_of_fde(fde,&cie,0) != DW_DLV_OK ||
+        dwarf_cie_section_offset(dbg,cie,&cie_off,0) !=
+        DW_DLV_OK || fde_off != offset || cie_off != cie_offset) {
+        printf("FAIL %s %s fde 0x%llx offsets 0x%llx cie 0x%llx "
+            "expected cie 0x%llx\n",path,secname,
+            (unsigned long long)offset,
+            (unsigned long long)fde_off,
+            (unsigned long long)cie_off,
+            (unsigned long long)cie_offset);
+        ++failcount;
+    }
+}
+
+/*  Returns the number of FDEs checked. */
+static int
+check_section(Dwarf_Debug dbg, const char *path,
+    Dwarf_Bool is_eh_frame, int expect_section)
+{
+    const char *secname = is_eh_frame?".eh_frame":".debug_frame";
+    Dwarf_Cie *cies = 0;
+    Dwarf_Fde *fdes = 0;
+    Dwarf_Signed ciecount = 0;
+    Dwarf_Signed fdecount = 0;
+    Dwarf_Unsigned offset = 0;
+    Dwarf_Signed seen_cies = 0;
+    Dwarf_Signed seen_fdes = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    if (is_eh_frame) {
+        res = dwarf_get_fde_list_eh(dbg,&cies,&ciecount,
+            &fdes,&fdecount,&err);
+    } else {
+        res = dwarf_get_fde_list(dbg,&cies,&ciecount,
+            &fdes,&fdecount,&err);
+    }
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL %s %s list error %s\n",path,secname,
+            dwarf_errmsg(err));
+        ++failcount;
+        return 0;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        if (expect_section) {
+            printf("FAIL %s has no %s\n",path,secname);
+            ++failcount;
+        }
+        res = dwarf_next_frame_entry(dbg,is_eh_frame,0,
+            0,0,0,&err);
+        if (res != DW_DLV_NO_ENTRY) {
+            printf("FAIL %s no %s but res %d\n",path,secname,res);
+            ++failcount;
+        }
+        return 0;
+    }
+    for (;;) {
+        Dwarf_Bool is_cie = FALSE;
+        Dwarf_Unsigned cie_offset = 0;
+        Dwarf_Unsigned next_offset = 0;
+        Dwarf_Fde fde = 0;
+        Dwarf_Fde listed = 0;
+
+        res = dwarf_next_frame_entry(dbg,is_eh_frame,offset,
+            &is_cie,&cie_offset,&next_offset,&err);
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s %s 0x%llx error %s\n",path,secname,
+                (unsigned long long)offset,dwarf_errmsg(err));
+            ++failcount;
+            break;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (next_offset <= offset) {
+            printf("FAIL %s %s 0x%llx does not advance\n",
+                path,secname,(unsigned long long)offset);
+            ++failcount;
+            break;
+        }
+        res = dwarf_get_fde_at_offset(dbg,is_eh_frame,offset,
+            &fde,&err);
+        if (is_cie) {
+            ++seen_cies;
+            if (cie_offset != offset || res != DW_DLV_NO_ENTRY) {
+                printf("FAIL %s %s cie 0x%llx res %d\n",path,
+                    secname,(unsigned long long)offset,res);
+                ++failcount;
+            }
+            if (res == DW_DLV_OK) {
+                dwarf_dealloc(dbg,fde,DW_DLA_FDE);
+            }
+            offset = next_offset;
+            continue;
+        }
+        ++seen_fdes;
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s %s fde 0x%llx res %d\n",path,secname,
+                (unsigned long long)offset,res);
+            ++failcount;
+            offset = next_offset;
+            continue;
+        }
+        listed = find_listed_fde(dbg,fdes,fdecount,offset);
+        if (!listed) {
+            printf("FAIL %s %s fde 0x%llx not in the list\n",
+                path,secname,(unsigned long long)offset);
+            ++failcount;
+        } else {
+            compare_fde(dbg,listed,fde,cie_offset,path,secname,
+                offset);
+        }
+        dwarf_dealloc(dbg,fde,DW_DLA_FDE);
+        offset = next_offset;
+    }
+    if (seen_cies != ciecount || seen_fdes != fdecount) {
+        printf("FAIL %s %s saw %lld cies %lld fdes, "
+            "list has %lld %lld\n",path,secname,
+            (long long)seen_cies,(long long)seen_fdes,
+            (long long)ciecount,(long long)fdecount);
+        ++failcount;
+    }
+    dwarf_dealloc_fde_cie_list(dbg,cies,ciecount,fdes,fdecount);
+    return (int)seen_fdes;
+}
+
+static int
+check_object(const char *path, int has_debug_frame)
+{
+    Dwarf_Debug dbg = 0;
+    int checked = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    checked += check_section(dbg,path,TRUE,TRUE);
+    checked += check_section(dbg,path,FALSE,has_debug_frame);
+    dwarf_finish(dbg);
+    return checked;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    int checked = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i].path; ++i) {
+        size_t blen = strlen(base);
+        size_t tlen = strlen(testobjects[i].path);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_frameiter: %s\n",
+                base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i].path,tlen+1);
+        checked += check_object(path,
+            testobjects[i].has_debug_frame);
+    }
+    if (!checked) {
+        printf("FAIL test_frameiter checked no FDEs\n");
+        ++failcount;
+    }
+    if (failcount) {
+        printf("FAIL test_frameiter %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_frameiter %d FDEs\n",checked);
+    return 0;
+}
@@ -0,0 +1,335 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Usage:  ./test_gdbindexlookup -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    Every symbol in the .gdb_index symbol table must be
+    found by dwarf_gdbindex_symboltable_lookup() in its
+    own slot, and absent names (including upper case
+    versions, which hash the same) must give
+    DW_DLV_NO_ENTRY.  Both ends of every address area
+    entry must be found by
+    dwarf_gdbindex_addressarea_lookup(), and addresses
+    outside all entries must not. */
+
+#include <config.h>
+
+#include <ctype.h>  /* toupper() */
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+#define NAMELEN 200
+
+static const char *testobjects[] = {
+"/test/gdbindexLE64.testme",
+0
+};
+
+static int failcount;
+
+static void
+check_not_found(Dwarf_Gdbindex gi, const char *name,
+    const char *path)
+{
+    Dwarf_Unsigned slot = 0;
+    int res = 0;
+
+    res = dwarf_gdbindex_symboltable_lookup(gi,name,&slot,0,0);
+    if (res != DW_DLV_NO_ENTRY) {
+        printf("FAIL %s found \"%s\" res %d slot %lu\n",
+            path,name,res,(unsigned long)slot);
+        ++failcount;
+    }
+}
+
+static int
+check_symbols(Dwarf_Gdbindex gi, const char *path)
+{
+    Dwarf_Unsigned slots = 0;
+    Dwarf_Unsigned i = 0;
+    int checked = 0;
+    int res = 0;
+
+    res = dwarf_gdbindex_symboltable_array(gi,&slots,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s symboltable_array res %d\n",path,res);
+        ++failcount;
+        return 0;
+    }
+    for (i = 0; i < slots; ++i) {
+        Dwarf_Unsigned stroff = 0;
+        Dwarf_Unsigned cuvec = 0;
+        Dwarf_Unsigned found_slot = 0;
+        Dwarf_Unsigned found_cuvec = 0;
+        const char *name = 0;
+        char upper[NAMELEN];
+        size_t len = 0;
+        size_t k = 0;
+
+        res = dwarf_gdbindex_symboltable_entry(gi,i,&stroff,
+            &cuvec,0);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s symbol slot %lu res %d\n",
+                path,(unsigned long)i,res);
+            ++failcount;
+            continue;
+        }
+        if (!stroff && !cuvec) {
+            continue;
+        }
+        res = dwarf_gdbindex_string_by_offset(gi,stroff,&name,0);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s symbol slot %lu no string\n",
+                path,(unsigned long)i);
+            ++failcount;
+            continue;
+        }
+        res = dwarf_gdbindex_symboltable_lookup(gi,name,
+            &found_slot,&found_cuvec,0);
+        if (res != DW_DLV_OK || found_slot != i ||
+            found_cuvec != cuvec) {
+            printf("FAIL %s lookup \"%s\" res %d slot %lu"
+                " expected %lu\n",path,name,res,
+                (unsigned long)found_slot,(unsigned long)i);
+            ++failcount;
+        }
+        ++checked;
+        len = strlen(name);
+        if (len >= NAMELEN) {
+            continue;
+        }
+        for (k = 0; k <= len; ++k) {
+            upper[k] = (char)toupper((unsigned char)name[k]);
+        }
+        if (strcmp(upper,name)) {
+            check_not_found(gi,upper,path);
+        }
+    }
+    check_not_found(gi,"",path);
+    check_not_found(gi,"no_such_symbol",path);
+    check_not_found(gi,"gi_ad",path);
+    return checked;
+}
+
+static void
+check_pc(Dwarf_Gdbindex gi, Dwarf_Unsigned pc,
+    int expect_found, Dwarf_Unsigned expect_index,
+    Dwarf_Unsigned expect_cu, const char *path)
+{
+    Dwarf_Unsigned index = 0;
+    Dwarf_Unsigned cu = 0;
+    int res = 0;
+
+    res = dwarf_gdbindex_addressarea_lookup(gi,pc,&index,&cu,0);
+    if (!expect_found) {
+        if (res != DW_DLV_NO_ENTRY) {
+            printf("FAIL %s pc 0x%lx found entry %lu\n",
+                path,(unsigned long)pc,(unsigned long)index);
+            ++failcount;
+        }
+        return;
+    }
+    if (res != DW_DLV_OK || index != expect_index ||
+        cu != expect_cu) {
+        printf("FAIL %s pc 0x%lx res %d entry %lu expected"
+            " %lu\n",path,(unsigned long)pc,res,
+            (unsigned long)index,(unsigned long)expect_index);
+        ++failcount;
+    }
+}
+
+static int
+check_addresses(Dwarf_Gdbindex gi, const char *path)
+{
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned minlow = 0;
+    Dwarf_Unsigned maxhigh = 0;
+    int res = 0;
+
+    res = dwarf_gdbindex_addressarea(gi,&count,0);
+    if (res != DW_DLV_OK || !count) {
+        printf("FAIL %s no address area\n",path);
+        ++failcount;
+        return 0;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Unsigned low = 0;
+        Dwarf_Unsigned high = 0;
+        Dwarf_Unsigned cu = 0;
+
+        res = dwarf_gdbindex_addressarea_entry(gi,i,&low,&high,
+            &cu,0);
+        if (res != DW_DLV_OK || low >= high) {
+            printf("FAIL %s address entry %lu\n",
+                path,(unsigned long)i);
+            ++failcount;
+            continue;
+        }
+        check_pc(gi,low,1,i,cu,path);
+        check_pc(gi,high-1,1,i,cu,path);
+        check_pc(gi,low+(high-low)/2,1,i,cu,path);
+        if (!i || low < minlow) {
+            minlow = low;
+        }
+        if (high > maxhigh) {
+            maxhigh = high;
+        }
+    }
+    if (minlow) {
+        check_pc(gi,minlow-1,0,0,0,path);
+    }
+    check_pc(gi,maxhigh,0,0,0,path);
+    return (int)count;
+}
+
+/*  gi_add is the only function of the second CU. */
+static void
+check_symbol_cu(Dwarf_Gdbindex gi, const char *path)
+{
+    Dwarf_Unsigned cuvec = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned attr = 0;
+    Dwarf_Unsigned cu = 0;
+    Dwarf_Unsigned kind = 0;
+    Dwarf_Unsigned is_static = 0;
+    int res = 0;
+
+    res = dwarf_gdbindex_symboltable_lookup(gi,"gi_add",0,
+        &cuvec,0);
+    if (res == DW_DLV_OK) {
+        res = dwarf_gdbindex_cuvector_length(gi,cuvec,&count,0);
+    }
+    if (res == DW_DLV_OK && count == 1) {
+        res = dwarf_gdbindex_cuvector_inner_attributes(gi,cuvec,
+            0,&attr,0);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_gdbindex_cuvector_instance_expand_value(gi,
+            attr,&cu,&kind,&is_static,0);
+    }
+    if (res != DW_DLV_OK || count != 1 || cu != 1) {
+        printf("FAIL %s gi_add cu vector res %d count %lu"
+            " cu %lu\n",path,res,(unsigned long)count,
+            (unsigned long)cu);
+        ++failcount;
+    }
+}
+
+static int
+check_object(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Gdbindex gi = 0;
+    Dwarf_Unsigned version = 0;
+    Dwarf_Unsigned culistoff = 0;
+    Dwarf_Unsigned tuculistoff = 0;
+    Dwarf_Unsigned addroff = 0;
+    Dwarf_Unsigned symoff = 0;
+    Dwarf_Unsigned pooloff = 0;
+    Dwarf_Unsigned size = 0;
+    const char *secname = 0;
+    int checked = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    res = dwarf_gdbindex_header(dbg,&gi,&version,&culistoff,
+        &tuculistoff,&addroff,&symoff,&pooloff,&size,
+        &secname,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s no .gdb_index res %d\n",path,res);
+        ++failcount;
+        dwarf_finish(dbg);
+        return 0;
+    }
+    checked += check_symbols(gi,path);
+    checked += check_addresses(gi,path);
+    check_symbol_cu(gi,path);
+    dwarf_dealloc_gdbindex(gi);
+    dwarf_finish(dbg);
+    return checked;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    int checked = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        size_t blen = strlen(base);
+        size_t tlen = strlen(testobjects[i]);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_gdbindexlookup:"
+                " %s\n",base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i],tlen+1);
+        checked += check_object(path);
+    }
+    if (!checked) {
+        printf("FAIL test_gdbindexlookup checked nothing\n");
+        ++failcount;
+    }
+    if (failcount) {
+        printf("FAIL test_gdbindexlookup %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_gdbindexlookup %d symbols and ranges\n",
+        checked);
+    return 0;
+}
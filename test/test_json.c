@@ -0,0 +1,183 @@
+/*
+Copyright (c) 2026, David Anderson
+All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+SUCH DAMAGE.
+*/
+
+/*  test_json.c
+    testing dd_json.c, the --format-json writer.
+    The records go to stdout, so stdout is pointed
+    at a file and read back; messages go to stderr.
+*/
+
+#include <config.h>
+
+#include <stdio.h>  /* fclose() fgets() fopen() freopen() remove() */
+#include <stdlib.h> /* exit() free() malloc() */
+#include <string.h> /* memset() strcat() strcmp() strcpy() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_json.h"
+
+#define JSON_TEST_FILE "junk.testjson"
+
+static int failcount = 0;
+
+static void
+check_line(int line,FILE *in,const char *expect)
+{
+    static char buf[20000];
+
+    if (!fgets(buf,sizeof(buf),in)) {
+        ++failcount;
+        fprintf(stderr,"FAIL line %d no record, expected %s",
+            line,expect);
+        return;
+    }
+    if (strcmp(buf,expect)) {
+        ++failcount;
+        fprintf(stderr,"FAIL line %d\n got    %s expected %s",
+            line,buf,expect);
+    }
+}
+
+int main(void)
+{
+    FILE *in = 0;
+    const unsigned char bytes[] = {0x00,0x7f,0xab,0xff};
+    /*  Valid two and four byte UTF-8, then a stray
+        continuation, a truncated sequence, a UTF-16
+        surrogate and 0xff. */
+    const unsigned char odd[] = {'x',0xc3,0xa9,0xf0,0x9f,0x98,
+        0x80,0x80,0xe2,0x82,'y',0xed,0xa0,0x80,0xff,0};
+    char *longstr = 0;
+    char *longexpect = 0;
+    size_t longlen = 10000;
+
+    if (!freopen(JSON_TEST_FILE,"w",stdout)) {
+        fprintf(stderr,"FAIL cannot open %s\n",JSON_TEST_FILE);
+        exit(EXIT_FAILURE);
+    }
+    dd_json_begin_record("t1");
+    dd_json_key("s");
+    dd_json_string("a\"b\\c\n\t\r\x01\x1f" "d");
+    dd_json_key("odd");
+    dd_json_string((const char *)odd);
+    dd_json_key("empty");
+    dd_json_string("");
+    dd_json_end_record();
+
+    dd_json_begin_record("t2");
+    dd_json_key("u0");
+    dd_json_unsigned(0);
+    dd_json_key("umax");
+    dd_json_unsigned(0xffffffffffffffffULL);
+    dd_json_key("sneg");
+    dd_json_signed(-1);
+    dd_json_key("smin");
+    dd_json_signed((Dwarf_Signed)(-0x7fffffffffffffffLL - 1));
+    dd_json_key("spos");
+    dd_json_signed(42);
+    dd_json_end_record();
+
+    dd_json_begin_record("t3");
+    dd_json_key("list");
+    dd_json_begin_array();
+    dd_json_bool(TRUE);
+    dd_json_bool(FALSE);
+    dd_json_null();
+    dd_json_bytes(bytes,sizeof(bytes));
+    dd_json_bytes(bytes,0);
+    dd_json_begin_object();
+    dd_json_key("at");
+    dd_json_dwname("DW_AT_name","AT",DW_AT_name);
+    dd_json_key("form");
+    dd_json_dwname(0,"FORM",0x1f99);
+    dd_json_end_object();
+    dd_json_begin_object();
+    dd_json_end_object();
+    dd_json_begin_array();
+    dd_json_end_array();
+    dd_json_end_array();
+    dd_json_key("after");
+    dd_json_unsigned(1);
+    dd_json_end_record();
+
+    /*  Bigger than the writer's buffer. */
+    longstr = malloc(longlen+1);
+    longexpect = malloc(longlen+40);
+    if (!longstr || !longexpect) {
+        fprintf(stderr,"FAIL out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(longstr,'q',longlen);
+    longstr[longlen] = 0;
+    dd_json_begin_record("t4");
+    dd_json_key("long");
+    dd_json_string(longstr);
+    dd_json_end_record();
+    fflush(stdout);
+
+    in = fopen(JSON_TEST_FILE,"r");
+    if (!in) {
+        fprintf(stderr,"FAIL cannot read %s\n",JSON_TEST_FILE);
+        exit(EXIT_FAILURE);
+    }
+    check_line(__LINE__,in,
+        "{\"kind\":\"t1\",\"s\":\"a\\\"b\\\\c\\n\\t\\r"
+        "\\u0001\\u001fd\",\"odd\":\"x\xc3\xa9\xf0\x9f\x98\x80"
+        "\\u0080\\u00e2\\u0082y\\u00ed\\u00a0\\u0080\\u00ff\","
+        "\"empty\":\"\"}\n");
+    check_line(__LINE__,in,
+        "{\"kind\":\"t2\",\"u0\":0,"
+        "\"umax\":18446744073709551615,\"sneg\":-1,"
+        "\"smin\":-9223372036854775808,\"spos\":42}\n");
+    check_line(__LINE__,in,
+        "{\"kind\":\"t3\",\"list\":[true,false,null,"
+        "\"007fabff\",\"\",{\"at\":\"DW_AT_name\","
+        "\"form\":\"<Unknown FORM value 0x1f99>\"},"
+        "{},[]],\"after\":1}\n");
+    strcpy(longexpect,"{\"kind\":\"t4\",\"long\":\"");
+    strcat(longexpect,longstr);
+    strcat(longexpect,"\"}\n");
+    check_line(__LINE__,in,longexpect);
+    fclose(in);
+    remove(JSON_TEST_FILE);
+    free(longstr);
+    free(longexpect);
+    if (failcount) {
+        fprintf(stderr,"FAIL test_json.c\n");
+        exit(EXIT_FAILURE);
+    }
+    fprintf(stderr,"PASS test_json.c\n");
+    return 0;
+}
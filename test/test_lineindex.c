@@ -0,0 +1,317 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/*  Usage:  ./test_lineindex -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    For every row of every line table in the test
+    objects, and for an address just past each row,
+    dwarf_srclines_lookup_pc() must return the row
+    a scan of dwarf_srclines_b() lines would choose:
+    the last row at or below the address in a
+    sequence containing it.  The file name must
+    match dwarf_linesrc() for that row.
+    dwarf_line_srcpath() and dwarf_srclines_file_path()
+    must return the dwarf_linesrc() path, and the same
+    pointer every time. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobjects[] = {
+"/test/testuriLE64ELf.testme",
+"/test/testobjLE32PE.exe",
+"/test/test-mach-o-32.dSYM",
+"/test/dummyexecutable.debug",
+0};
+
+static int failcount;
+
+/*  Returns the index of the row a lookup of pc in the
+    sequence [first,end) should give, or -1 if the
+    sequence does not contain pc. linebuf[end] is
+    the end_sequence row. */
+static Dwarf_Signed
+expected_row(Dwarf_Line *linebuf, Dwarf_Signed first,
+    Dwarf_Signed end, Dwarf_Addr pc)
+{
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Signed found = -1;
+
+    dwarf_lineaddr(linebuf[first],&low,0);
+    dwarf_lineaddr(linebuf[end],&high,0);
+    if (pc < low || pc >= high) {
+        return -1;
+    }
+    for (i = first; i < end; ++i) {
+        Dwarf_Addr a = 0;
+
+        dwarf_lineaddr(linebuf[i],&a,0);
+        if (a <= pc) {
+            found = i;
+        }
+    }
+    return found;
+}
+
+/*  Sequences may overlap in a relocatable object,
+    so any sequence containing pc gives an
+    acceptable answer. */
+static void
+check_pc(Dwarf_Debug dbg, Dwarf_Die cu_die,
+    Dwarf_Line *linebuf, Dwarf_Signed count,
+    Dwarf_Addr pc, const char *path)
+{
+    Dwarf_Addr rowaddr = 0;
+    Dwarf_Unsigned fileno = 0;
+    Dwarf_Unsigned lineno = 0;
+    Dwarf_Unsigned column = 0;
+    Dwarf_Unsigned flags = 0;
+    Dwarf_Signed first = 0;
+    Dwarf_Signed i = 0;
+    int anyseq = FALSE;
+    int matched = FALSE;
+    int res = 0;
+
+    res = dwarf_srclines_lookup_pc(cu_die,pc,&rowaddr,&fileno,
+        &lineno,&column,&flags,0);
+    for (i = 0; i < count && !matched; ++i) {
+        Dwarf_Bool endseq = FALSE;
+        Dwarf_Signed e = 0;
+        Dwarf_Addr a = 0;
+        Dwarf_Unsigned l = 0;
+        Dwarf_Unsigned f = 0;
+        Dwarf_Unsigned c = 0;
+
+        dwarf_lineendsequence(linebuf[i],&endseq,0);
+        if (!endseq) {
+            continue;
+        }
+        e = expected_row(linebuf,first,i,pc);
+        first = i + 1;
+        if (e < 0) {
+            continue;
+        }
+        anyseq = TRUE;
+        dwarf_lineaddr(linebuf[e],&a,0);
+        dwarf_lineno(linebuf[e],&l,0);
+        dwarf_line_srcfileno(linebuf[e],&f,0);
+        dwarf_lineoff_b(linebuf[e],&c,0);
+        if (res == DW_DLV_OK && a == rowaddr && l == lineno &&
+            f == fileno && c == column) {
+            char *n1 = 0;
+            char *n2 = 0;
+
+            matched = TRUE;
+            if (dwarf_linesrc(linebuf[e],&n1,0) == DW_DLV_OK &&
+                dwarf_srclines_lookup_filename(cu_die,fileno,
+                &n2,0) == DW_DLV_OK && strcmp(n1,n2)) {
+                printf("FAIL %s pc 0x%llx file %s vs %s\n",path,
+                    (unsigned long long)pc,n1,n2);
+                ++failcount;
+            }
+            if (n1) {
+                dwarf_dealloc(dbg,n1,DW_DLA_STRING);
+            }
+            if (n2) {
+                dwarf_dealloc(dbg,n2,DW_DLA_STRING);
+            }
+        }
+    }
+    if (!anyseq && res != DW_DLV_NO_ENTRY) {
+        printf("FAIL %s pc 0x%llx found but in no sequence\n",
+            path,(unsigned long long)pc);
+        ++failcount;
+    } else if (anyseq && !matched) {
+        printf("FAIL %s pc 0x%llx res %d row 0x%llx line %llu "
+            "not an expected row\n",path,(unsigned long long)pc,
+            res,(unsigned long long)rowaddr,
+            (unsigned long long)lineno);
+        ++failcount;
+    }
+}
+
+static void
+check_srcpath(Dwarf_Debug dbg, Dwarf_Line_Context context,
+    Dwarf_Line line, const char *path)
+{
+    char *n1 = 0;
+    const char *p1 = 0;
+    const char *p2 = 0;
+    const char *p3 = 0;
+    Dwarf_Unsigned fileno = 0;
+    int res1 = 0;
+    int res2 = 0;
+
+    res1 = dwarf_linesrc(line,&n1,0);
+    res2 = dwarf_line_srcpath(line,&p1,0);
+    if (res1 != res2) {
+        printf("FAIL %s dwarf_line_srcpath returns %d, "
+            "dwarf_linesrc %d\n",path,res2,res1);
+        ++failcount;
+    } else if (res1 == DW_DLV_OK) {
+        dwarf_line_srcfileno(line,&fileno,0);
+        dwarf_line_srcpath(line,&p2,0);
+        dwarf_srclines_file_path(context,fileno,&p3,0);
+        if (strcmp(n1,p1) || p1 != p2 || p1 != p3) {
+            printf("FAIL %s file %llu path %s vs %s\n",path,
+                (unsigned long long)fileno,n1,p1);
+            ++failcount;
+        }
+    }
+    if (n1) {
+        dwarf_dealloc(dbg,n1,DW_DLA_STRING);
+    }
+}
+
+static int
+check_cu(Dwarf_Debug dbg, Dwarf_Die cu_die, const char *path)
+{
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *linebuf = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_srclines_b(cu_die,&version,&table_count,
+        &context,0);
+    if (res != DW_DLV_OK) {
+        if (dwarf_srclines_lookup_pc(cu_die,0,0,0,0,0,0,0) ==
+            DW_DLV_OK) {
+            printf("FAIL %s lookup without a line table\n",path);
+            ++failcount;
+        }
+        return 0;
+    }
+    res = dwarf_srclines_from_linecontext(context,&linebuf,
+        &count,0);
+    if (res == DW_DLV_OK) {
+        for (i = 0; i < count; ++i) {
+            Dwarf_Addr a = 0;
+
+            dwarf_lineaddr(linebuf[i],&a,0);
+            check_srcpath(dbg,context,linebuf[i],path);
+            check_pc(dbg,cu_die,linebuf,count,a,path);
+            check_pc(dbg,cu_die,linebuf,count,a+1,path);
+        }
+        check_pc(dbg,cu_die,linebuf,count,~(Dwarf_Addr)0,path);
+    }
+    dwarf_srclines_dealloc_b(context);
+    return (int)count;
+}
+
+static void
+check_object(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    int rows = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            0,0,0,0,0,0,0,0,0,0,0);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        rows += check_cu(dbg,cu_die,path);
+        dwarf_dealloc_die(cu_die);
+    }
+    if (!rows) {
+        printf("FAIL %s has no line rows to check\n",path);
+        ++failcount;
+    }
+    dwarf_finish(dbg);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        size_t blen = strlen(base);
+        size_t tlen = strlen(testobjects[i]);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_lineindex: %s\n",
+                base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i],tlen+1);
+        check_object(path);
+    }
+    if (failcount) {
+        printf("FAIL test_lineindex %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_lineindex\n");
+    return 0;
+}
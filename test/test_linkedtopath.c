@@ -96,40 +96,6 @@ dwarf_errno(Dwarf_Error error)
     return (error->er_errval);
 }
 
-/* A literal copy from dwarf_util.c */
-int
-_dwarf_check_string_valid(Dwarf_Debug dbg,void *areaptr,
-    void *strptr, void *areaendptr,
-    int suggested_error,
-    Dwarf_Error*error)
-{
-    Dwarf_Small *start = areaptr;
-    Dwarf_Small *p = strptr;
-    Dwarf_Small *end = areaendptr;
-
-    if (p < start) {
-        _dwarf_error(dbg,error,suggested_error);
-        return DW_DLV_ERROR;
-    }
-    if (p >= end) {
-        _dwarf_error(dbg,error,suggested_error);
-        return DW_DLV_ERROR;
-    }
-    if (dbg->de_assume_string_in_bounds) {
-        /* This NOT the default. But folks can choose
-            to live dangerously and just assume strings ok. */
-        return DW_DLV_OK;
-    }
-    while (p < end) {
-        if (*p == 0) {
-            return DW_DLV_OK;
-        }
-        ++p;
-    }
-    _dwarf_error(dbg,error,DW_DLE_STRING_NOT_TERMINATED);
-    return DW_DLV_ERROR;
-}
-
 static void
 check_svalid(int expret,int gotret,int experr,int goterr,int line,
     char *filename_in)
@@ -189,6 +155,56 @@ test1(Dwarf_Debug dbg)
 
 }
 
+/*  An area ending in NUL is accepted by its last
+    byte alone, one that does not is scanned.
+    Either way a string must start inside the area
+    and end in it. */
+static void
+test_string_valid(Dwarf_Debug dbg)
+{
+    static char nulend[] = {'a','b','c',0,'d','e','f',0};
+    static char notnulend[] = {'a','b','c',0,'d','e','f'};
+    char *end = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+    int i = 0;
+
+    end = nulend + sizeof(nulend);
+    for (i = 0; i < (int)sizeof(nulend); ++i) {
+        res = _dwarf_check_string_valid(dbg,nulend,nulend+i,
+            end,DW_DLE_FORM_STRING_BAD_STRING,&error);
+        check_svalid(DW_DLV_OK,res,0,0,__LINE__,__FILE__);
+    }
+    res = _dwarf_check_string_valid(dbg,nulend,end,
+        end,DW_DLE_FORM_STRING_BAD_STRING,&error);
+    check_svalid(DW_DLV_ERROR,res,
+        DW_DLE_FORM_STRING_BAD_STRING,dwarf_errno(error),
+        __LINE__,__FILE__);
+    res = _dwarf_check_string_valid(dbg,nulend+1,nulend,
+        end,DW_DLE_FORM_STRING_BAD_STRING,&error);
+    check_svalid(DW_DLV_ERROR,res,
+        DW_DLE_FORM_STRING_BAD_STRING,dwarf_errno(error),
+        __LINE__,__FILE__);
+
+    end = notnulend + sizeof(notnulend);
+    for (i = 0; i < (int)sizeof(notnulend); ++i) {
+        int expret = i < 4? DW_DLV_OK:DW_DLV_ERROR;
+        int experr = i < 4? 0:DW_DLE_FORM_STRING_BAD_STRING;
+
+        error = 0;
+        res = _dwarf_check_string_valid(dbg,notnulend,
+            notnulend+i,end,DW_DLE_FORM_STRING_BAD_STRING,
+            &error);
+        check_svalid(expret,res,experr,(int)dwarf_errno(error),
+            __LINE__,__FILE__);
+    }
+    res = _dwarf_check_string_valid(dbg,notnulend,end,
+        end,DW_DLE_FORM_STRING_BAD_STRING,&error);
+    check_svalid(DW_DLV_ERROR,res,
+        DW_DLE_FORM_STRING_BAD_STRING,dwarf_errno(error),
+        __LINE__,__FILE__);
+}
+
 static void
 checkjoin(int expret,int gotret,char*expstr,char*gotstr,
     int line,
@@ -486,6 +502,7 @@ int main(void)
     dbg->de_magic =  DBG_IS_VALID;
 
     test1(dbg);
+    test_string_valid(dbg);
     test2();
     test3(dbg);
 
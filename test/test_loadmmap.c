@@ -0,0 +1,565 @@
+/*
+Copyright (c) 2026, David Anderson
+All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Usage:  ./test_loadmmap -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    Each test object (Elf, PE and Mach-O) is opened
+    twice at once, one Dwarf_Debug set by
+    dwarf_set_load_preference() to Dwarf_Alloc_Mmap
+    and the other left with malloc().  Every DIE
+    with its attribute values, every line, every
+    abbreviation, every .debug_str string and the
+    frame instructions must read the same
+    either way, and each Dwarf_Debug must have
+    loaded its sections the way it was told to. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobjects[] = {
+"/test/abbrevshareDW4.testme",
+"/test/testobjLE32PE.exe",
+"/test/test-mach-o-32.dSYM",
+0};
+
+struct summary_s {
+    unsigned long dies;
+    unsigned long attrs;
+    unsigned long lines;
+    unsigned long abbrevs;
+    unsigned long strings;
+    unsigned long frames;
+    unsigned long long hash;
+};
+
+static int failcount;
+
+static void
+add_hash(struct summary_s *s, const void *p, size_t len)
+{
+    const unsigned char *c = (const unsigned char *)p;
+    size_t i = 0;
+
+    for (i = 0; i < len; ++i) {
+        s->hash = (s->hash ^ c[i]) * 1099511628211ULL;
+    }
+}
+
+/*  Errors here only mean a value is not of the
+    expected kind, the other Dwarf_Debug gets the same. */
+static void
+drop_error(Dwarf_Debug dbg, int res, Dwarf_Error *err)
+{
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,*err);
+        *err = 0;
+    }
+}
+
+static void
+hash_attr(Dwarf_Debug dbg, Dwarf_Attribute attr,
+    Dwarf_Half version, Dwarf_Half offset_size,
+    struct summary_s *s)
+{
+    Dwarf_Error err = 0;
+    Dwarf_Half attrnum = 0;
+    Dwarf_Half form = 0;
+    enum Dwarf_Form_Class cl = DW_FORM_CLASS_UNKNOWN;
+    int res = 0;
+
+    ++s->attrs;
+    res = dwarf_whatattr(attr,&attrnum,&err);
+    drop_error(dbg,res,&err);
+    res = dwarf_whatform(attr,&form,&err);
+    drop_error(dbg,res,&err);
+    add_hash(s,&attrnum,sizeof(attrnum));
+    add_hash(s,&form,sizeof(form));
+    cl = dwarf_get_form_class(version,attrnum,offset_size,form);
+    switch (cl) {
+    case DW_FORM_CLASS_STRING: {
+        char *str = 0;
+
+        res = dwarf_formstring(attr,&str,&err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,str,strlen(str));
+        }
+        break;
+    }
+    case DW_FORM_CLASS_CONSTANT: {
+        Dwarf_Unsigned u = 0;
+
+        res = dwarf_formudata(attr,&u,&err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,&u,sizeof(u));
+        }
+        break;
+    }
+    case DW_FORM_CLASS_ADDRESS: {
+        Dwarf_Addr addr = 0;
+
+        res = dwarf_formaddr(attr,&addr,&err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,&addr,sizeof(addr));
+        }
+        break;
+    }
+    case DW_FORM_CLASS_REFERENCE: {
+        Dwarf_Off ref = 0;
+
+        res = dwarf_global_formref(attr,&ref,&err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,&ref,sizeof(ref));
+        }
+        break;
+    }
+    case DW_FORM_CLASS_FLAG: {
+        Dwarf_Bool flag = 0;
+
+        res = dwarf_formflag(attr,&flag,&err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,&flag,sizeof(flag));
+        }
+        break;
+    }
+    case DW_FORM_CLASS_BLOCK: {
+        Dwarf_Block *block = 0;
+
+        res = dwarf_formblock(attr,&block,&err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,block->bl_data,(size_t)block->bl_len);
+            dwarf_dealloc(dbg,block,DW_DLA_BLOCK);
+        }
+        break;
+    }
+    case DW_FORM_CLASS_EXPRLOC: {
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr ptr = 0;
+
+        res = dwarf_formexprloc(attr,&len,&ptr,&err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,ptr,(size_t)len);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    drop_error(dbg,res,&err);
+}
+
+/*  Walks die, its siblings and all their children.
+    The caller frees die itself. */
+static int
+walk_die(Dwarf_Debug dbg, Dwarf_Die in_die,
+    struct summary_s *s, Dwarf_Error *err)
+{
+    Dwarf_Die die = in_die;
+    int res = DW_DLV_OK;
+
+    for (;;) {
+        Dwarf_Off off = 0;
+        Dwarf_Half tag = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Half offset_size = 0;
+        Dwarf_Attribute *attrs = 0;
+        Dwarf_Signed attrcount = 0;
+        Dwarf_Signed i = 0;
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        ++s->dies;
+        dwarf_dieoffset(die,&off,err);
+        dwarf_tag(die,&tag,err);
+        add_hash(s,&off,sizeof(off));
+        add_hash(s,&tag,sizeof(tag));
+        dwarf_get_version_of_die(die,&version,&offset_size);
+        res = dwarf_attrlist(die,&attrs,&attrcount,err);
+        if (res == DW_DLV_OK) {
+            for (i = 0; i < attrcount; ++i) {
+                hash_attr(dbg,attrs[i],version,offset_size,s);
+                dwarf_dealloc_attribute(attrs[i]);
+            }
+            dwarf_dealloc(dbg,attrs,DW_DLA_LIST);
+        }
+        if (res != DW_DLV_ERROR) {
+            res = dwarf_child(die,&child,err);
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_die(dbg,child,s,err);
+            dwarf_dealloc_die(child);
+        }
+        if (res != DW_DLV_ERROR) {
+            res = dwarf_siblingof_c(die,&sib,err);
+        }
+        if (die != in_die) {
+            dwarf_dealloc_die(die);
+        }
+        if (res != DW_DLV_OK) {
+            return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+        }
+        die = sib;
+    }
+}
+
+static void
+walk_lines(Dwarf_Debug dbg, Dwarf_Die cudie, struct summary_s *s)
+{
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed linecount = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_srclines_b(cudie,&version,&count,&context,&err);
+    if (res != DW_DLV_OK) {
+        drop_error(dbg,res,&err);
+        return;
+    }
+    res = dwarf_srclines_from_linecontext(context,&lines,
+        &linecount,&err);
+    if (res == DW_DLV_OK) {
+        for (i = 0; i < linecount; ++i) {
+            Dwarf_Addr addr = 0;
+            Dwarf_Unsigned lineno = 0;
+
+            dwarf_lineaddr(lines[i],&addr,&err);
+            dwarf_lineno(lines[i],&lineno,&err);
+            add_hash(s,&addr,sizeof(addr));
+            add_hash(s,&lineno,sizeof(lineno));
+            ++s->lines;
+        }
+    }
+    drop_error(dbg,res,&err);
+    dwarf_srclines_dealloc_b(context);
+}
+
+static void
+walk_abbrevs(Dwarf_Debug dbg, struct summary_s *s)
+{
+    Dwarf_Unsigned offset = 0;
+    Dwarf_Error err = 0;
+
+    for (;;) {
+        Dwarf_Abbrev abbrev = 0;
+        Dwarf_Unsigned length = 0;
+        Dwarf_Unsigned attrcount = 0;
+        Dwarf_Unsigned code = 0;
+        Dwarf_Half tag = 0;
+        Dwarf_Unsigned i = 0;
+        int res = 0;
+
+        res = dwarf_get_abbrev(dbg,offset,&abbrev,&length,
+            &attrcount,&err);
+        if (res != DW_DLV_OK) {
+            drop_error(dbg,res,&err);
+            return;
+        }
+        ++s->abbrevs;
+        dwarf_get_abbrev_code(abbrev,&code,&err);
+        dwarf_get_abbrev_tag(abbrev,&tag,&err);
+        add_hash(s,&code,sizeof(code));
+        add_hash(s,&tag,sizeof(tag));
+        for (i = 0; i < attrcount; ++i) {
+            Dwarf_Unsigned attrnum = 0;
+            Dwarf_Unsigned form = 0;
+            Dwarf_Signed implicit = 0;
+            Dwarf_Off off = 0;
+
+            res = dwarf_get_abbrev_entry_b(abbrev,i,FALSE,
+                &attrnum,&form,&implicit,&off,&err);
+            if (res == DW_DLV_OK) {
+                add_hash(s,&attrnum,sizeof(attrnum));
+                add_hash(s,&form,sizeof(form));
+            }
+            drop_error(dbg,res,&err);
+        }
+        dwarf_dealloc(dbg,abbrev,DW_DLA_ABBREV);
+        offset += length;
+    }
+}
+
+static void
+walk_strings(Dwarf_Debug dbg, struct summary_s *s)
+{
+    Dwarf_Off offset = 0;
+    Dwarf_Error err = 0;
+
+    for (;;) {
+        char *str = 0;
+        Dwarf_Signed len = 0;
+        int res = 0;
+
+        res = dwarf_get_str(dbg,offset,&str,&len,&err);
+        if (res != DW_DLV_OK) {
+            drop_error(dbg,res,&err);
+            return;
+        }
+        ++s->strings;
+        add_hash(s,str,(size_t)len);
+        offset += len + 1;
+    }
+}
+
+static void
+walk_frames(Dwarf_Debug dbg, struct summary_s *s)
+{
+    Dwarf_Cie *cies = 0;
+    Dwarf_Signed ciecount = 0;
+    Dwarf_Fde *fdes = 0;
+    Dwarf_Signed fdecount = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_get_fde_list(dbg,&cies,&ciecount,&fdes,
+        &fdecount,&err);
+    if (res != DW_DLV_OK) {
+        drop_error(dbg,res,&err);
+        return;
+    }
+    for (i = 0; i < ciecount; ++i) {
+        Dwarf_Unsigned bytes = 0;
+        Dwarf_Small version = 0;
+        char *augmenter = 0;
+        Dwarf_Unsigned codealign = 0;
+        Dwarf_Signed dataalign = 0;
+        Dwarf_Half rareg = 0;
+        Dwarf_Small *instrs = 0;
+        Dwarf_Unsigned instrlen = 0;
+        Dwarf_Half offset_size = 0;
+
+        res = dwarf_get_cie_info_b(cies[i],&bytes,&version,
+            &augmenter,&codealign,&dataalign,&rareg,
+            &instrs,&instrlen,&offset_size,&err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,instrs,(size_t)instrlen);
+        }
+        drop_error(dbg,res,&err);
+    }
+    for (i = 0; i < fdecount; ++i) {
+        Dwarf_Small *instrs = 0;
+        Dwarf_Unsigned instrlen = 0;
+
+        ++s->frames;
+        res = dwarf_get_fde_instr_bytes(fdes[i],&instrs,
+            &instrlen,&err);
+        if (res == DW_DLV_OK) {
+            add_hash(s,instrs,(size_t)instrlen);
+        }
+        drop_error(dbg,res,&err);
+    }
+    dwarf_dealloc_fde_cie_list(dbg,cies,ciecount,fdes,fdecount);
+}
+
+static void
+summarize(Dwarf_Debug dbg, const char *path,
+    struct summary_s *s)
+{
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    memset(s,0,sizeof(*s));
+    s->hash = 14695981039346656037ULL;
+    for (;;) {
+        Dwarf_Die cudie = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cudie,
+            0,0,0,0,0,0,0,0,0,0,&err);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_die(dbg,cudie,s,&err);
+            walk_lines(dbg,cudie,s);
+            dwarf_dealloc_die(cudie);
+        }
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s: %s\n",path,dwarf_errmsg(err));
+            ++failcount;
+            dwarf_dealloc_error(dbg,err);
+            break;
+        }
+    }
+    walk_abbrevs(dbg,s);
+    walk_strings(dbg,s);
+    walk_frames(dbg,s);
+}
+
+static int
+same(struct summary_s *a, struct summary_s *b)
+{
+    return !memcmp(a,b,sizeof(*a));
+}
+
+static Dwarf_Debug
+open_object(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    return dbg;
+}
+
+static void
+check_object(const char *path)
+{
+    Dwarf_Debug mdbg = 0;
+    Dwarf_Debug mapdbg = 0;
+    struct summary_s viamalloc;
+    struct summary_s viammap;
+    Dwarf_Unsigned mmap_count = 0;
+    Dwarf_Unsigned malloc_count = 0;
+    enum Dwarf_Sec_Alloc_Pref pref = Dwarf_Alloc_None;
+    int res = 0;
+
+    /*  Both open at once: the preference of one
+        must not change the other. */
+    mdbg = open_object(path);
+    mapdbg = open_object(path);
+    pref = dwarf_set_load_preference(mapdbg,Dwarf_Alloc_Mmap);
+    if (pref != Dwarf_Alloc_Malloc) {
+        printf("FAIL %s default preference %d\n",path,
+            (int)pref);
+        ++failcount;
+    }
+    pref = dwarf_set_load_preference(mapdbg,Dwarf_Alloc_None);
+    if (pref != Dwarf_Alloc_Mmap) {
+        printf("FAIL %s preference not kept\n",path);
+        ++failcount;
+    }
+    pref = dwarf_set_load_preference(mdbg,Dwarf_Alloc_None);
+    if (pref != Dwarf_Alloc_Malloc) {
+        printf("FAIL %s preference set on the other "
+            "Dwarf_Debug\n",path);
+        ++failcount;
+    }
+    summarize(mapdbg,path,&viammap);
+    summarize(mdbg,path,&viamalloc);
+    if (!viamalloc.dies || !viamalloc.lines ||
+        !viamalloc.abbrevs) {
+        printf("FAIL %s read too little: %lu DIEs %lu lines "
+            "%lu abbrevs\n",path,viamalloc.dies,
+            viamalloc.lines,viamalloc.abbrevs);
+        ++failcount;
+    }
+    if (!same(&viamalloc,&viammap)) {
+        printf("FAIL %s reads differently with mmap\n",path);
+        ++failcount;
+    }
+    res = dwarf_get_mmap_count(mdbg,&mmap_count,0,
+        &malloc_count,0);
+    if (res != DW_DLV_OK || mmap_count || !malloc_count) {
+        printf("FAIL %s malloc Dwarf_Debug mapped %lu "
+            "sections\n",path,(unsigned long)mmap_count);
+        ++failcount;
+    }
+#ifdef HAVE_SYS_MMAN_H
+    res = dwarf_get_mmap_count(mapdbg,&mmap_count,0,
+        &malloc_count,0);
+    if (res != DW_DLV_OK || !mmap_count) {
+        printf("FAIL %s mmap Dwarf_Debug mapped nothing\n",
+            path);
+        ++failcount;
+    }
+#endif /* HAVE_SYS_MMAN_H */
+    dwarf_finish(mapdbg);
+    dwarf_finish(mdbg);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    size_t blen = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    blen = strlen(base);
+    for (i = 0; testobjects[i]; ++i) {
+        size_t tlen = strlen(testobjects[i]);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_loadmmap: %s\n",
+                base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i],tlen+1);
+        check_object(path);
+    }
+    if (dwarf_set_load_preference(0,Dwarf_Alloc_Mmap) !=
+        Dwarf_Alloc_None) {
+        printf("FAIL preference set with no Dwarf_Debug\n");
+        ++failcount;
+    }
+    if (failcount) {
+        printf("FAIL test_loadmmap %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_loadmmap\n");
+    return 0;
+}
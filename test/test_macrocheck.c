@@ -29,6 +29,22 @@
 #include "dd_minimal.h"
 #include <stdlib.h> /* for exit() */
 void dd_minimal_count_global_error(void) {}
+/*  The --jobs save/merge of dd_macrocheck.c
+    is not tested here. */
+int dd_job_write(FILE *f,const void *p,size_t len)
+{
+    (void)f;
+    (void)p;
+    (void)len;
+    return DW_DLV_ERROR;
+}
+int dd_job_read(FILE *f,void *p,size_t len)
+{
+    (void)f;
+    (void)p;
+    (void)len;
+    return DW_DLV_ERROR;
+}
 
 int
 main(void)
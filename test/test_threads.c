@@ -0,0 +1,808 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Usage:  ./test_threads -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    Several threads each open, walk, and close their own
+    Dwarf_Debug on the test objects in this directory
+    while other threads provoke errors that have no
+    Dwarf_Debug. Then threads share one object's
+    section data through dwarf_init_from_debug(),
+    each walking some of its CUs, and a
+    dwarf_init_from_debug() Dwarf_Debug must
+    read only the CUs it is asked for.
+    Every thread must get the results
+    a single thread gets.
+    Build the library and this test with -fsanitize=thread
+    to have ThreadSanitizer check for data races. */
+
+#include <config.h>
+
+#include <pthread.h> /* pthread_create() pthread_join() */
+#include <stdio.h>  /* fclose() fopen() fread() fseek() ftell()
+    fwrite() printf() remove() */
+#include <stdlib.h> /* calloc() exit() free() getenv() malloc() */
+#include <string.h> /* memcmp() memcpy() memset() strcmp()
+    strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define THREAD_COUNT 8
+#define ITERATIONS   4
+#define PATHLEN      2000
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobjects[] = {
+"/test/testuriLE64ELf.testme",
+"/test/testobjLE32PE.exe",
+"/test/test-mach-o-32.dSYM",
+"/test/dummyexecutable.debug",
+0};
+#define OBJECT_COUNT 4
+
+static char objpaths[OBJECT_COUNT][PATHLEN];
+
+struct walk_counts_s {
+    Dwarf_Unsigned wc_cus;
+    Dwarf_Unsigned wc_dies;
+    Dwarf_Unsigned wc_attrs;
+    Dwarf_Unsigned wc_names;
+    Dwarf_Unsigned wc_srcfiles;
+    Dwarf_Unsigned wc_lines;
+    Dwarf_Unsigned wc_groupmap;
+    int            wc_failed;
+};
+
+/*  The single-thread results, filled in before
+    any thread starts and only read after that. */
+static struct walk_counts_s expected[OBJECT_COUNT];
+
+static int
+walk_die_tree(Dwarf_Debug dbg, Dwarf_Die die,
+    struct walk_counts_s *wc, Dwarf_Error *error)
+{
+    Dwarf_Die cur = die;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+        char *name = 0;
+        Dwarf_Attribute *attrs = 0;
+        Dwarf_Signed attrcount = 0;
+        Dwarf_Signed i = 0;
+
+        wc->wc_dies++;
+        res = dwarf_attrlist(cur,&attrs,&attrcount,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            for (i = 0; i < attrcount; ++i) {
+                Dwarf_Half attrnum = 0;
+
+                if (dwarf_whatattr(attrs[i],&attrnum,0) ==
+                    DW_DLV_OK) {
+                    wc->wc_attrs += attrnum;
+                }
+                dwarf_dealloc_attribute(attrs[i]);
+            }
+            dwarf_dealloc(dbg,attrs,DW_DLA_LIST);
+        }
+        res = dwarf_diename(cur,&name,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            wc->wc_names += strlen(name);
+        }
+        res = dwarf_child(cur,&child,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_die_tree(dbg,child,wc,error);
+            dwarf_dealloc_die(child);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+        }
+        res = dwarf_siblingof_c(cur,&sib,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        cur = sib;
+    }
+}
+
+static void
+count_lines(Dwarf_Debug dbg, Dwarf_Die cu_die,
+    struct walk_counts_s *wc)
+{
+    char **srcfiles = 0;
+    Dwarf_Signed srccount = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *linebuf = 0;
+    Dwarf_Signed linecount = 0;
+    int res = 0;
+
+    res = dwarf_srcfiles(cu_die,&srcfiles,&srccount,0);
+    if (res == DW_DLV_OK) {
+        for (i = 0; i < srccount; ++i) {
+            wc->wc_srcfiles += strlen(srcfiles[i]);
+            dwarf_dealloc(dbg,srcfiles[i],DW_DLA_STRING);
+        }
+        dwarf_dealloc(dbg,srcfiles,DW_DLA_LIST);
+    }
+    res = dwarf_srclines_b(cu_die,&version,&table_count,
+        &context,0);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    res = dwarf_srclines_from_linecontext(context,
+        &linebuf,&linecount,0);
+    if (res == DW_DLV_OK) {
+        for (i = 0; i < linecount; ++i) {
+            char *linesrc = 0;
+
+            res = dwarf_linesrc(linebuf[i],&linesrc,0);
+            if (res == DW_DLV_OK) {
+                wc->wc_lines += strlen(linesrc);
+                dwarf_dealloc(dbg,linesrc,DW_DLA_STRING);
+            }
+        }
+    }
+    dwarf_srclines_dealloc_b(context);
+}
+
+static void
+count_groups(Dwarf_Debug dbg, struct walk_counts_s *wc)
+{
+    Dwarf_Unsigned section_count = 0;
+    Dwarf_Unsigned group_count = 0;
+    Dwarf_Unsigned selected_group = 0;
+    Dwarf_Unsigned map_entry_count = 0;
+    Dwarf_Unsigned *groups = 0;
+    Dwarf_Unsigned *secnums = 0;
+    const char **names = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_sec_group_sizes(dbg,&section_count,
+        &group_count,&selected_group,&map_entry_count,0);
+    if (res != DW_DLV_OK || !map_entry_count) {
+        return;
+    }
+    groups = calloc(map_entry_count,sizeof(Dwarf_Unsigned));
+    secnums = calloc(map_entry_count,sizeof(Dwarf_Unsigned));
+    names = calloc(map_entry_count,sizeof(const char *));
+    if (groups && secnums && names) {
+        res = dwarf_sec_group_map(dbg,map_entry_count,
+            groups,secnums,names,0);
+        if (res == DW_DLV_OK) {
+            for (i = 0; i < map_entry_count; ++i) {
+                wc->wc_groupmap += groups[i]*1000 + secnums[i];
+            }
+        }
+    }
+    free(groups);
+    free(secnums);
+    free((void *)names);
+}
+
+static void
+walk_object(const char *path, int variant,
+    struct walk_counts_s *wc)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    memset(wc,0,sizeof(*wc));
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        wc->wc_failed = TRUE;
+        return;
+    }
+    /*  Per-Dwarf_Debug settings must not affect
+        other threads, and string checking does not
+        change the results on a valid object. */
+    dwarf_set_stringcheck_a(dbg,variant&1);
+    count_groups(dbg,wc);
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Half cu_type = 0;
+
+        /*  Some walks put each CU's DIEs and
+            attributes in an arena. */
+        if (variant&2) {
+            dwarf_die_arena_begin(dbg,0);
+        }
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            0,0,0,0,0,0,0,0,0,&cu_type,&error);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            wc->wc_failed = TRUE;
+            break;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        wc->wc_cus++;
+        count_lines(dbg,cu_die,wc);
+        res = walk_die_tree(dbg,cu_die,wc,&error);
+        dwarf_dealloc_die(cu_die);
+        if (variant&2) {
+            dwarf_die_arena_release(dbg);
+        }
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            wc->wc_failed = TRUE;
+            break;
+        }
+    }
+    dwarf_finish(dbg);
+}
+
+/*  Each worker has its own Dwarf_Debug from
+    dwarf_init_from_debug() and walks a contiguous
+    range of the CUs of the shared object. */
+struct range_arg_s {
+    Dwarf_Debug    ra_dbg;
+    Dwarf_Off     *ra_offsets;
+    Dwarf_Unsigned ra_first;
+    Dwarf_Unsigned ra_count;
+    struct walk_counts_s ra_counts;
+};
+
+static void *
+range_main(void *arg)
+{
+    struct range_arg_s *ra = (struct range_arg_s *)arg;
+    struct walk_counts_s *wc = &ra->ra_counts;
+    Dwarf_Debug dbg = ra->ra_dbg;
+    Dwarf_Unsigned i = 0;
+
+    for (i = ra->ra_first; i < ra->ra_first+ra->ra_count; ++i) {
+        Dwarf_Off dieoff = 0;
+        Dwarf_Die cu_die = 0;
+        Dwarf_Error error = 0;
+        int res = 0;
+
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dbg,ra->ra_offsets[i],TRUE,&dieoff,&error);
+        if (res == DW_DLV_OK) {
+            res = dwarf_offdie_b(dbg,dieoff,TRUE,&cu_die,&error);
+        }
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+            }
+            wc->wc_failed = TRUE;
+            break;
+        }
+        wc->wc_cus++;
+        count_lines(dbg,cu_die,wc);
+        res = walk_die_tree(dbg,cu_die,wc,&error);
+        dwarf_dealloc_die(cu_die);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            wc->wc_failed = TRUE;
+            break;
+        }
+    }
+    return 0;
+}
+
+static int
+shared_object_check(int o)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Off *offsets = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned per_thread = 0;
+    pthread_t threads[THREAD_COUNT];
+    struct range_arg_s args[THREAD_COUNT];
+    struct walk_counts_s total;
+    int started = 0;
+    int failcount = 0;
+    int i = 0;
+    int res = 0;
+
+    res = dwarf_init_path(objpaths[o],0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",objpaths[o]);
+        return 1;
+    }
+    res = dwarf_get_cu_header_offsets(dbg,TRUE,&offsets,
+        &count,&error);
+    if (res != DW_DLV_OK || count != expected[o].wc_cus) {
+        printf("FAIL dwarf_get_cu_header_offsets on %s\n",
+            objpaths[o]);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        dwarf_finish(dbg);
+        return 1;
+    }
+    memset(args,0,sizeof(args));
+    per_thread = (count + THREAD_COUNT -1)/THREAD_COUNT;
+    for (i = 0; i < THREAD_COUNT; ++i) {
+        Dwarf_Unsigned first = i*per_thread;
+
+        args[i].ra_offsets = offsets;
+        args[i].ra_first = first;
+        if (first < count) {
+            args[i].ra_count = count - first;
+            if (args[i].ra_count > per_thread) {
+                args[i].ra_count = per_thread;
+            }
+        }
+        /*  All created here, before any worker starts. */
+        res = dwarf_init_from_debug(dbg,0,0,
+            &args[i].ra_dbg,&error);
+        if (res != DW_DLV_OK) {
+            printf("FAIL dwarf_init_from_debug on %s\n",
+                objpaths[o]);
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+            }
+            ++failcount;
+            break;
+        }
+    }
+    for (started = 0; !failcount && started < THREAD_COUNT;
+        ++started) {
+        if (pthread_create(&threads[started],0,range_main,
+            &args[started])) {
+            printf("FAIL pthread_create\n");
+            ++failcount;
+            break;
+        }
+    }
+    memset(&total,0,sizeof(total));
+    for (i = 0; i < THREAD_COUNT; ++i) {
+        if (i < started) {
+            pthread_join(threads[i],0);
+        }
+        total.wc_cus += args[i].ra_counts.wc_cus;
+        total.wc_dies += args[i].ra_counts.wc_dies;
+        total.wc_names += args[i].ra_counts.wc_names;
+        total.wc_srcfiles += args[i].ra_counts.wc_srcfiles;
+        total.wc_lines += args[i].ra_counts.wc_lines;
+        total.wc_failed |= args[i].ra_counts.wc_failed;
+        if (args[i].ra_dbg) {
+            dwarf_finish(args[i].ra_dbg);
+        }
+    }
+    if (!failcount && (total.wc_failed ||
+        total.wc_cus != expected[o].wc_cus ||
+        total.wc_dies != expected[o].wc_dies ||
+        total.wc_names != expected[o].wc_names ||
+        total.wc_srcfiles != expected[o].wc_srcfiles ||
+        total.wc_lines != expected[o].wc_lines)) {
+        printf("FAIL shared section workers on %s "
+            "differ from the single thread results\n",
+            objpaths[o]);
+        ++failcount;
+    }
+    dwarf_dealloc(dbg,offsets,DW_DLA_UARRAY);
+    dwarf_finish(dbg);
+    return failcount;
+}
+
+static void
+build_path(char *out,const char *base, const char *tail)
+{
+    size_t blen = strlen(base);
+    size_t tlen = strlen(tail);
+
+    if ((blen + tlen + 1) > PATHLEN) {
+        printf("FAIL path too long for test_threads: %s\n",base);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(out,base,blen);
+    memcpy(out+blen,tail,tlen+1);
+}
+
+/*  A worker must read only the CUs it is given.
+    In a copy of DIRECT_OBJECT with the first CU DIE
+    damaged the other CUs must still read, with the
+    results they give in the undamaged object,
+    and in either order. */
+#define DIRECT_OBJECT "/test/abbrevshareDW4.testme"
+#define DIRECT_COPY   "junk.threadsdirect"
+/*  No abbreviation code in DIRECT_OBJECT is this big. */
+#define BAD_ABBREV_CODE 0x7f
+
+static int
+walk_cu_at(Dwarf_Debug dbg, Dwarf_Off hdroff,
+    struct walk_counts_s *wc)
+{
+    Dwarf_Off dieoff = 0;
+    Dwarf_Off cudieoff = 0;
+    Dwarf_Die cu_die = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+        dbg,hdroff,TRUE,&dieoff,&error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_offdie_b(dbg,dieoff,TRUE,&cu_die,&error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_CU_dieoffset_given_die(cu_die,&cudieoff,
+            &error);
+        if (res == DW_DLV_OK && cudieoff != dieoff) {
+            wc->wc_failed = TRUE;
+        }
+    }
+    if (res == DW_DLV_OK) {
+        wc->wc_cus++;
+        count_lines(dbg,cu_die,wc);
+        res = walk_die_tree(dbg,cu_die,wc,&error);
+    }
+    if (cu_die) {
+        dwarf_dealloc_die(cu_die);
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,error);
+    }
+    return res;
+}
+
+/*  Walks CUs 1 through count-1, forwards or backwards,
+    in a new Dwarf_Debug sharing dbg's sections. */
+static void
+walk_later_cus(Dwarf_Debug dbg, Dwarf_Off *offsets,
+    Dwarf_Unsigned count, int backwards,
+    struct walk_counts_s *wc)
+{
+    Dwarf_Debug worker = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    memset(wc,0,sizeof(*wc));
+    res = dwarf_init_from_debug(dbg,0,0,&worker,&error);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        wc->wc_failed = TRUE;
+        return;
+    }
+    for (i = 1; i < count; ++i) {
+        Dwarf_Unsigned k = backwards? count - i: i;
+
+        if (walk_cu_at(worker,offsets[k],wc) != DW_DLV_OK) {
+            wc->wc_failed = TRUE;
+        }
+    }
+    dwarf_finish(worker);
+}
+
+static int
+direct_cu_check(const char *base)
+{
+    char path[PATHLEN];
+    Dwarf_Debug dbg = 0;
+    Dwarf_Debug copydbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Off *offsets = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Off cu0dieoff = 0;
+    Dwarf_Addr secaddr = 0;
+    Dwarf_Unsigned secsize = 0;
+    Dwarf_Unsigned secflags = 0;
+    Dwarf_Unsigned secoffset = 0;
+    struct walk_counts_s forward;
+    struct walk_counts_s backward;
+    struct walk_counts_s damaged;
+    unsigned char *bytes = 0;
+    long filelen = 0;
+    FILE *f = 0;
+    int failcount = 0;
+    int res = 0;
+
+    build_path(path,base,DIRECT_OBJECT);
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        return 1;
+    }
+    res = dwarf_get_cu_header_offsets(dbg,TRUE,&offsets,
+        &count,&error);
+    if (res == DW_DLV_OK && count < 3) {
+        res = DW_DLV_NO_ENTRY;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_get_section_info_by_name_a(dbg,
+            ".debug_info",&secaddr,&secsize,&secflags,
+            &secoffset,&error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dbg,offsets[0],TRUE,&cu0dieoff,&error);
+    }
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot find the CUs of %s\n",path);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        if (offsets) {
+            dwarf_dealloc(dbg,offsets,DW_DLA_UARRAY);
+        }
+        dwarf_finish(dbg);
+        return 1;
+    }
+    walk_later_cus(dbg,offsets,count,FALSE,&forward);
+    walk_later_cus(dbg,offsets,count,TRUE,&backward);
+    if (forward.wc_failed || !forward.wc_dies ||
+        memcmp(&forward,&backward,sizeof(forward))) {
+        printf("FAIL reading the CUs of %s backwards "
+            "differs from reading them forwards\n",path);
+        ++failcount;
+    }
+
+    /*  The copy, with the first CU DIE's abbreviation
+        code replaced. */
+    f = fopen(path,"rb");
+    if (f && !fseek(f,0,SEEK_END)) {
+        filelen = ftell(f);
+    }
+    if (filelen > 0 && (Dwarf_Unsigned)filelen >
+        secoffset + cu0dieoff) {
+        bytes = (unsigned char *)malloc((size_t)filelen);
+    }
+    if (!bytes || fseek(f,0,SEEK_SET) ||
+        fread(bytes,1,(size_t)filelen,f) != (size_t)filelen) {
+        printf("FAIL cannot read %s\n",path);
+        if (f) {
+            fclose(f);
+        }
+        free(bytes);
+        dwarf_dealloc(dbg,offsets,DW_DLA_UARRAY);
+        dwarf_finish(dbg);
+        return failcount+1;
+    }
+    fclose(f);
+    bytes[secoffset + cu0dieoff] = BAD_ABBREV_CODE;
+    f = fopen(DIRECT_COPY,"wb");
+    if (!f || fwrite(bytes,1,(size_t)filelen,f) !=
+        (size_t)filelen) {
+        printf("FAIL cannot write %s\n",DIRECT_COPY);
+        if (f) {
+            fclose(f);
+        }
+        free(bytes);
+        dwarf_dealloc(dbg,offsets,DW_DLA_UARRAY);
+        dwarf_finish(dbg);
+        return failcount+1;
+    }
+    fclose(f);
+    free(bytes);
+    res = dwarf_init_path(DIRECT_COPY,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&copydbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",DIRECT_COPY);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(copydbg,error);
+        }
+        remove(DIRECT_COPY);
+        dwarf_dealloc(dbg,offsets,DW_DLA_UARRAY);
+        dwarf_finish(dbg);
+        return failcount+1;
+    }
+    walk_later_cus(copydbg,offsets,count,FALSE,&damaged);
+    if (memcmp(&forward,&damaged,sizeof(forward))) {
+        printf("FAIL a damaged first CU changes "
+            "reading the later CUs of %s\n",DIRECT_COPY);
+        ++failcount;
+    }
+    memset(&damaged,0,sizeof(damaged));
+    if (walk_cu_at(copydbg,offsets[0],&damaged) !=
+        DW_DLV_ERROR) {
+        printf("FAIL the damaged first CU of %s reads\n",
+            DIRECT_COPY);
+        ++failcount;
+    }
+    dwarf_finish(copydbg);
+    dwarf_dealloc(dbg,offsets,DW_DLA_UARRAY);
+    dwarf_finish(dbg);
+    remove(DIRECT_COPY);
+    return failcount;
+}
+
+/*  An error with no Dwarf_Debug goes on the library's
+    shared list, which dwarf_finish() in any other
+    thread also cleans. */
+/*  The error from a failed dwarf_init*() belongs to
+    this thread alone.  dwarf_finish(0), here or in any
+    other thread, must not free it, so with
+    -fsanitize=address a use after free or double free
+    shows up here.  Each thread holds several at once
+    so the library's list of them must grow. */
+#define HELD_ERRORS 3
+static int
+provoke_static_error(int threadnum)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error errors[HELD_ERRORS];
+    Dwarf_Unsigned errnums[HELD_ERRORS];
+    int failcount = 0;
+    int i = 0;
+
+    for (i = 0; i < HELD_ERRORS; ++i) {
+        int res = 0;
+
+        errors[i] = 0;
+        res = dwarf_init_b(-1,DW_GROUPNUMBER_ANY,0,0,&dbg,
+            &errors[i]);
+        if (res != DW_DLV_ERROR) {
+            printf("FAIL thread %d dwarf_init_b(-1) returned %d, "
+                "not DW_DLV_ERROR\n",threadnum,res);
+            ++failcount;
+            errors[i] = 0;
+            continue;
+        }
+        errnums[i] = dwarf_errno(errors[i]);
+    }
+    dwarf_finish(0);
+    for (i = 0; i < HELD_ERRORS; ++i) {
+        char *msg = 0;
+
+        if (!errors[i]) {
+            continue;
+        }
+        if (dwarf_errno(errors[i]) != errnums[i]) {
+            printf("FAIL thread %d error changed "
+                "by dwarf_finish(0)\n",threadnum);
+            ++failcount;
+        }
+        msg = dwarf_errmsg(errors[i]);
+        if (!msg || !msg[0]) {
+            printf("FAIL thread %d error has no message "
+                "after dwarf_finish(0)\n",threadnum);
+            ++failcount;
+        }
+        dwarf_dealloc_error(dbg,errors[i]);
+    }
+    return failcount;
+}
+
+struct thread_arg_s {
+    int ta_number;
+    int ta_failcount;
+};
+
+static void *
+thread_main(void *arg)
+{
+    struct thread_arg_s *ta = (struct thread_arg_s *)arg;
+    int iter = 0;
+
+    for (iter = 0; iter < ITERATIONS; ++iter) {
+        int k = 0;
+
+        for (k = 0; k < OBJECT_COUNT; ++k) {
+            /*  Each thread starts on a different object. */
+            int o = (k + ta->ta_number) % OBJECT_COUNT;
+            struct walk_counts_s wc;
+
+            walk_object(objpaths[o],ta->ta_number+iter,&wc);
+            if (memcmp(&wc,&expected[o],sizeof(wc))) {
+                printf("FAIL thread %d object %s results "
+                    "differ from the single thread results\n",
+                    ta->ta_number,objpaths[o]);
+                ta->ta_failcount++;
+            }
+            ta->ta_failcount +=
+                provoke_static_error(ta->ta_number);
+        }
+    }
+    return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    pthread_t threads[THREAD_COUNT];
+    struct thread_arg_s args[THREAD_COUNT];
+    int failcount = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        build_path(objpaths[i],base,testobjects[i]);
+        walk_object(objpaths[i],0,&expected[i]);
+        if (expected[i].wc_failed || !expected[i].wc_dies) {
+            printf("FAIL cannot read test object %s\n",
+                objpaths[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (i = 0; i < THREAD_COUNT; ++i) {
+        args[i].ta_number = i;
+        args[i].ta_failcount = 0;
+        if (pthread_create(&threads[i],0,thread_main,&args[i])) {
+            printf("FAIL pthread_create\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (i = 0; i < THREAD_COUNT; ++i) {
+        pthread_join(threads[i],0);
+        failcount += args[i].ta_failcount;
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        failcount += shared_object_check(i);
+    }
+    failcount += direct_cu_check(base);
+    if (failcount) {
+        printf("FAIL test_threads %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_threads\n");
+    return 0;
+}
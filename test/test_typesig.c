@@ -0,0 +1,253 @@
+/*
+Copyright (c) 2026, David Anderson All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*  Usage:  ./test_typesig -f <base of source tree>
+    or with DWTOPSRCDIR set in the environment.
+
+    Every type unit found by dwarf_next_cu_header_e()
+    must be found again, from a freshly opened object
+    and from the one just read, by
+    dwarf_find_die_given_sig8() and
+    dwarf_die_from_hash_signature("tu"), and
+    an unknown signature must give DW_DLV_NO_ENTRY. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() getenv() */
+#include <string.h> /* memcpy() memset() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#define PATHLEN 2000
+#define MAXTU   100
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static const char *testobjects[] = {
+"/test/typeunitsDW4.testme",
+"/test/typeunitsDW5.testme",
+0
+};
+
+struct typeunit_s {
+    Dwarf_Sig8 sig;
+    Dwarf_Bool is_info;
+    Dwarf_Off  typedie_offset;
+};
+
+static struct typeunit_s typeunits[MAXTU];
+static int typeunitcount;
+static int failcount;
+
+static void
+collect_typeunits(Dwarf_Debug dbg, Dwarf_Bool is_info,
+    const char *path)
+{
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Sig8 sig;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next = 0;
+        Dwarf_Half unittype = 0;
+        Dwarf_Off cuoff = 0;
+        Dwarf_Off culen = 0;
+        int res = 0;
+
+        memset(&sig,0,sizeof(sig));
+        res = dwarf_next_cu_header_e(dbg,is_info,&cudie,
+            0,0,0,0,0,0,&sig,&typeoffset,&next,&unittype,0);
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                printf("FAIL %s reading unit headers\n",path);
+                ++failcount;
+            }
+            return;
+        }
+        if (unittype == DW_UT_type ||
+            unittype == DW_UT_split_type) {
+            res = dwarf_die_CU_offset_range(cudie,&cuoff,
+                &culen,0);
+            if (res != DW_DLV_OK || typeunitcount >= MAXTU) {
+                printf("FAIL %s type unit offsets\n",path);
+                ++failcount;
+            } else {
+                struct typeunit_s *t = &typeunits[typeunitcount];
+                t->sig = sig;
+                t->is_info = is_info;
+                t->typedie_offset = cuoff + typeoffset;
+                ++typeunitcount;
+            }
+        }
+        dwarf_dealloc_die(cudie);
+    }
+}
+
+static void
+check_lookups(Dwarf_Debug dbg, const char *path,
+    const char *which)
+{
+    int i = 0;
+    Dwarf_Sig8 unknown;
+    Dwarf_Die die = 0;
+    Dwarf_Bool is_info = FALSE;
+    int res = 0;
+
+    /*  Reverse order so the first lookup is for
+        the last unit. */
+    for (i = typeunitcount-1; i >= 0; --i) {
+        struct typeunit_s *t = &typeunits[i];
+        Dwarf_Off off = 0;
+
+        res = dwarf_find_die_given_sig8(dbg,&t->sig,&die,
+            &is_info,0);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s %s unit %d sig8 res %d\n",
+                path,which,i,res);
+            ++failcount;
+            continue;
+        }
+        dwarf_dieoffset(die,&off,0);
+        if (off != t->typedie_offset ||
+            is_info != t->is_info) {
+            printf("FAIL %s %s unit %d die 0x%lx expected"
+                " 0x%lx\n",path,which,i,(unsigned long)off,
+                (unsigned long)t->typedie_offset);
+            ++failcount;
+        }
+        dwarf_dealloc_die(die);
+        die = 0;
+        res = dwarf_die_from_hash_signature(dbg,&t->sig,"tu",
+            &die,0);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s %s unit %d hash signature res %d\n",
+                path,which,i,res);
+            ++failcount;
+            continue;
+        }
+        dwarf_dieoffset(die,&off,0);
+        if (off != t->typedie_offset) {
+            printf("FAIL %s %s unit %d hash signature die"
+                " 0x%lx\n",path,which,i,(unsigned long)off);
+            ++failcount;
+        }
+        dwarf_dealloc_die(die);
+        die = 0;
+    }
+    memset(&unknown,0x5a,sizeof(unknown));
+    res = dwarf_find_die_given_sig8(dbg,&unknown,&die,
+        &is_info,0);
+    if (res != DW_DLV_NO_ENTRY) {
+        printf("FAIL %s %s unknown signature res %d\n",
+            path,which,res);
+        ++failcount;
+        if (res == DW_DLV_OK) {
+            dwarf_dealloc_die(die);
+        }
+    }
+}
+
+static int
+check_object(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Debug cold = 0;
+    int res = 0;
+
+    typeunitcount = 0;
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    collect_typeunits(dbg,TRUE,path);
+    collect_typeunits(dbg,FALSE,path);
+    if (!typeunitcount) {
+        printf("FAIL %s has no type units\n",path);
+        ++failcount;
+    }
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&cold,0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n",path);
+        exit(EXIT_FAILURE);
+    }
+    check_lookups(cold,path,"fresh");
+    dwarf_finish(cold);
+    check_lookups(dbg,path,"read");
+    dwarf_finish(dbg);
+    return typeunitcount;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *base = 0;
+    char path[PATHLEN];
+    int checked = 0;
+    int i = 0;
+
+    if (argc == 3 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc == 1) {
+        base = getenv("DWTOPSRCDIR");
+    }
+    if (!base) {
+        printf("Expected -f <path> or environment variable "
+            " DWTOPSRCDIR with path of "
+            "base directory (usually called 'code')\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; testobjects[i]; ++i) {
+        size_t blen = strlen(base);
+        size_t tlen = strlen(testobjects[i]);
+
+        if ((blen + tlen + 1) > PATHLEN) {
+            printf("FAIL path too long for test_typesig: %s\n",
+                base);
+            exit(EXIT_FAILURE);
+        }
+        memcpy(path,base,blen);
+        memcpy(path+blen,testobjects[i],tlen+1);
+        checked += check_object(path);
+    }
+    if (failcount) {
+        printf("FAIL test_typesig %d failures\n",failcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS test_typesig %d type units\n",checked);
+    return 0;
+}
@@ -0,0 +1,57 @@
+/*  Source of typeunitsDW4.testme and typeunitsDW5.testme,
+    which have type units (DW_UT_type) for test_typesig.c.
+    Also the base of debugnamesDW5.testme, see
+    debugnamesbuild.py, and part of gdbindexLE64.testme,
+    see gdbindexpart.c, and of debugframeDW4.testme
+    for test_frameiter.c:
+    cc -g -gdwarf-4 -fno-asynchronous-unwind-tables \
+        -fno-unwind-tables typeunitsource.c gdbindexpart.c \
+        -o debugframeDW4.testme
+    cc -g -gdwarf-4 -fdebug-types-section typeunitsource.c \
+        -o typeunitsDW4.testme
+    cc -g -gdwarf-5 -fdebug-types-section typeunitsource.c \
+        -o typeunitsDW5.testme
+    abbrevshareDW4.testme (for test_attrvalues.c) has three
+    copies of the CU, all using abbrev offset 0. It is
+    made from cc -g -gdwarf-4 -S output by repeating the
+    .debug_info unit twice with its local labels renamed.
+    macrosDW5.testme (for test_dwarfdumpjobs.sh) has two
+    CUs and .debug_macro:
+    cc -g3 -gdwarf-5 typeunitsource.c gdbindexpart.c \
+        -o macrosDW5.testme
+*/
+struct point {
+    int x;
+    int y;
+};
+struct line {
+    struct point from;
+    struct point to;
+};
+struct shape {
+    struct line *edges;
+    unsigned edgecount;
+    const char *name;
+};
+union value {
+    long l;
+    double d;
+    struct shape *s;
+};
+
+static struct point p = {1,2};
+static struct line l;
+static struct shape s;
+union value v;
+
+int
+main(void)
+{
+    l.from = p;
+    l.to = p;
+    s.edges = &l;
+    s.edgecount = 1;
+    s.name = "line";
+    v.s = &s;
+    return (int)v.s->edgecount - 1;
+}
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+# Creates zstdframesLE64.testme for test_decompress.c.
+# objcopy writes each SHF_COMPRESSED zstd section as one
+# zstd frame. Linkers that compress in parallel (lld)
+# write several frames, each with its content size,
+# which is what lets libdwarf decompress them in
+# parallel. This recompresses every zstd section
+# as frames of at most CHUNK uncompressed bytes.
+#   cc -g -gdwarf-4 typeunitsource.c gdbindexpart.c -o zf.base
+#   objcopy --compress-debug-sections=zstd zf.base zf.z
+#   python3 zstdframesbuild.py zf.z zstdframesLE64.testme
+# Needs the zstd command.  Only for 64bit little-endian ELF.
+# Not run as part of testing.
+
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+CHUNK = 64
+SHF_COMPRESSED = 0x800
+ELFCOMPRESS_ZSTD = 2
+
+
+def zstd(args, data):
+    with tempfile.TemporaryDirectory() as d:
+        inp = os.path.join(d, "in")
+        with open(inp, "wb") as f:
+            f.write(data)
+        # From a file so each frame records its content size.
+        return subprocess.check_output(["zstd", "-q", "-c"] +
+            args + [inp])
+
+
+def reframe(sec):
+    chdr = sec[:24]
+    ctype, _, size, _ = struct.unpack("<IIQQ", chdr)
+    if ctype != ELFCOMPRESS_ZSTD:
+        return None
+    data = zstd(["-d"], sec[24:])
+    if len(data) != size:
+        sys.exit("bad uncompressed size")
+    frames = b"".join(zstd(["-19", "--content-size"],
+        data[i:i+CHUNK]) for i in range(0, len(data), CHUNK))
+    return chdr + frames
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: zstdframesbuild.py in out")
+    elf = bytearray(open(sys.argv[1], "rb").read())
+    if elf[:4] != b"\x7fELF" or elf[4] != 2 or elf[5] != 1:
+        sys.exit("not 64bit little-endian ELF")
+    shoff, = struct.unpack_from("<Q", elf, 0x28)
+    shentsize, shnum = struct.unpack_from("<HH", elf, 0x3a)
+    for i in range(shnum):
+        hdr = shoff + i*shentsize
+        flags, = struct.unpack_from("<Q", elf, hdr + 8)
+        offset, size = struct.unpack_from("<QQ", elf, hdr + 24)
+        if not flags & SHF_COMPRESSED:
+            continue
+        new = reframe(bytes(elf[offset:offset+size]))
+        if new is None:
+            continue
+        while len(elf) % 8:
+            elf.append(0)
+        struct.pack_into("<QQ", elf, hdr + 24, len(elf), len(new))
+        elf += new
+    open(sys.argv[2], "wb").write(elf)
+
+
+main()